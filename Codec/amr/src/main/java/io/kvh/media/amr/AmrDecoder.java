@@ -1,5 +1,8 @@
 package io.kvh.media.amr;
 
+import java.nio.ByteBuffer;
+import java.nio.ShortBuffer;
+
 /**
  * Created by kv.h on 14/11/21.
  */
@@ -11,6 +14,39 @@ public class AmrDecoder {
 
 	public static native void decode(long state, byte[] in, short[] out);
 
+	/**
+	 * Decodes the frame at {@code in[inOffset]} straight into 160 samples at
+	 * {@code out[outOffset]}, without intermediate copies.
+	 *
+	 * @return number of samples written (160), or -1 if the frame or the
+	 * output does not fit in the arrays
+	 */
+	public static native int decode(long state, byte[] in, int inOffset, short[] out, int outOffset);
+
+	/**
+	 * Same as {@link #decode(long, byte[], int, short[], int)} for direct
+	 * buffers; offsets are in buffer elements, positions and limits are ignored.
+	 *
+	 * @return number of samples written (160), or -1 if a buffer is not
+	 * direct or the frame or the output does not fit
+	 */
+	public static native int decode(long state, ByteBuffer in, int inOffset, ShortBuffer out, int outOffset);
+
+	/**
+	 * Decodes as many complete frames as possible from {@code length} bytes of
+	 * {@code in} starting at {@code offset}. Frames are in IETF storage format
+	 * (ToC byte followed by the frame data, any mode or SID/no-data); the
+	 * "#!AMR\n" file header must already be skipped. Decoding stops at the
+	 * first incomplete frame or when {@code out} is full.
+	 *
+	 * @param consumed if not null, {@code consumed[0]} receives the number of
+	 *                 bytes used; any remaining bytes belong to the next call
+	 * @return number of samples written to {@code out} (160 per frame), or -1
+	 * if offset/length are out of bounds
+	 */
+	public static native int decodeStream(long state, byte[] in, int offset, int length,
+			short[] out, int[] consumed);
+
 	static {
 		System.loadLibrary("amr-codec");
 	}
@@ -1,5 +1,8 @@
 package io.kvh.media.amr;
 
+import java.nio.ByteBuffer;
+import java.nio.ShortBuffer;
+
 /**
  * Created by kv.h on 14/11/21.
  */
@@ -32,8 +35,63 @@ public class AmrEncoder {
         N_MODES   /* Not Used  */
     }
 
-    public static native void init(int dtx);
+    /**
+     * Creates an encoder instance. Each instance is independent, so one
+     * encoder per stream can be used from different threads concurrently.
+     *
+     * @param dtx 1 to enable DTX, 0 to disable it
+     * @return handle to pass to {@link #encode(long, int, short[], byte[])},
+     * {@link #reset(long)} and {@link #exit(long)}
+     */
+    public static native long init(int dtx);
 
+    public static native int encode(long state, int mode, short[] in, byte[] out);
+
+    /**
+     * Encodes the 160 samples at {@code in[inOffset]} into the frame at
+     * {@code out[outOffset]} without copying the output; {@code out} needs 32
+     * bytes of room after the offset.
+     *
+     * @return size of the encoded frame, or -1 if an offset is out of bounds
+     */
+    public static native int encode(long state, int mode, short[] in, int inOffset,
+                                    byte[] out, int outOffset);
+
+    /**
+     * Same as {@link #encode(long, int, short[], int, byte[], int)} for direct
+     * buffers; offsets are in buffer elements, positions and limits are ignored.
+     *
+     * @return size of the encoded frame, or -1 if a buffer is not direct or
+     * an offset is out of bounds
+     */
+    public static native int encode(long state, int mode, ShortBuffer in, int inOffset,
+                                    ByteBuffer out, int outOffset);
+
+    /**
+     * Encodes {@code frames} consecutive 160-sample frames in one call. The
+     * frames are written back to back to {@code out} in IETF storage format
+     * (without the "#!AMR\n" file header), so {@code out} needs room for
+     * {@code frames * 32} bytes.
+     *
+     * @param sizes if not null, receives the size in bytes of each frame
+     * @param types if not null, receives the frame type of each frame
+     *              (0-7: speech mode, 8: SID, 15: no data)
+     * @return total number of bytes written to {@code out}, or -1 if one of
+     * the arrays is too small
+     */
+    public static native int encodeBatch(long state, int mode, short[] in, int frames,
+                                         byte[] out, int[] sizes, int[] types);
+
+    public static native void reset(long state);
+
+    public static native void exit(long state);
+
+    /**
+     * Legacy static API: operates on the instance most recently returned by
+     * {@link #init(int)}. Calls are serialized against init/exit on other
+     * threads, but all of them share that one instance: use the handle
+     * methods for more than one stream at a time.
+     */
     public static native int encode(int mode, short[] in, byte[] out);
 
     public static native void reset();
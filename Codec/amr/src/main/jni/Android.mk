@@ -21,7 +21,8 @@ LOCAL_PATH := $(PV_TOP)/..
 LOCAL_MODULE := amr-codec
 LOCAL_SRC_FILES := $(LOCAL_PATH)/amr_encoder.cpp \
 				$(LOCAL_PATH)/amr_decoder.cpp \
-				$(LOCAL_PATH)/wrapper.cpp
+				$(LOCAL_PATH)/wrapper.cpp \
+				$(LOCAL_PATH)/pool.cpp
 
 LOCAL_C_INCLUDES := $(PV_INCLUDES)
 
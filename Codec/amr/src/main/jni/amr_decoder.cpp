@@ -4,6 +4,14 @@
 
 namespace amr_decode {
 
+#define PCM_FRAME_SIZE 160
+#define AMR_MAX_FRAME_SIZE 32
+
+    /* IETF storage-format frame size, ToC byte included */
+    static jint frame_size(jbyte toc) {
+        return Decoder_Interface_FrameSize((toc >> 3) & 0x0f);
+    }
+
 #ifndef _Included_com_hikvh_media_amr_AmrDecoder
 #define _Included_com_hikvh_media_amr_AmrDecoder
 
@@ -22,20 +30,101 @@ namespace amr_decode {
     }
 
     JNIEXPORT void JNICALL
-    Java_io_kvh_media_amr_AmrDecoder_decode(JNIEnv *env, jclass, jlong state, jbyteArray in, jshortArray out) {
+    Java_io_kvh_media_amr_AmrDecoder_decode__J_3B_3S(JNIEnv *env, jclass, jlong state, jbyteArray in,
+                                                     jshortArray out) {
 
+        jbyte inBuf[AMR_MAX_FRAME_SIZE] = {0};
         jsize inLen = env->GetArrayLength(in);
-        jbyte inBuf[inLen];
+        if (inLen > AMR_MAX_FRAME_SIZE)
+            inLen = AMR_MAX_FRAME_SIZE;
         env->GetByteArrayRegion(in, 0, inLen, inBuf);
 
-        jsize outLen = env->GetArrayLength(out);
-        short outBuf[outLen];
+        short outBuf[PCM_FRAME_SIZE];
 
         Decoder_Interface_Decode((void *) state, (const unsigned char *) inBuf, (short *) outBuf);
 
+        jsize outLen = env->GetArrayLength(out);
+        if (outLen > PCM_FRAME_SIZE)
+            outLen = PCM_FRAME_SIZE;
         env->SetShortArrayRegion(out, 0, outLen, outBuf);
     }
 
+    /* Heap arrays, decoded in place through critical access (no copies). */
+    JNIEXPORT jint JNICALL
+    Java_io_kvh_media_amr_AmrDecoder_decode__J_3BI_3SI(JNIEnv *env, jclass, jlong state, jbyteArray in,
+                                                       jint inOffset, jshortArray out, jint outOffset) {
+
+        if (inOffset < 0 || inOffset >= env->GetArrayLength(in) ||
+            outOffset < 0 || outOffset > env->GetArrayLength(out) - PCM_FRAME_SIZE)
+            return -1;
+        jbyte toc;
+        env->GetByteArrayRegion(in, inOffset, 1, &toc);
+        if (inOffset + frame_size(toc) > env->GetArrayLength(in))
+            return -1;
+
+        jbyte *inBuf = (jbyte *) env->GetPrimitiveArrayCritical(in, NULL);
+        jshort *outBuf = (jshort *) env->GetPrimitiveArrayCritical(out, NULL);
+        if (inBuf == NULL || outBuf == NULL) {
+            if (outBuf != NULL)
+                env->ReleasePrimitiveArrayCritical(out, outBuf, JNI_ABORT);
+            if (inBuf != NULL)
+                env->ReleasePrimitiveArrayCritical(in, inBuf, JNI_ABORT);
+            return -1;
+        }
+
+        Decoder_Interface_Decode((void *) state, (const unsigned char *) inBuf + inOffset,
+                                 (short *) outBuf + outOffset);
+
+        env->ReleasePrimitiveArrayCritical(out, outBuf, 0);
+        env->ReleasePrimitiveArrayCritical(in, inBuf, JNI_ABORT);
+        return PCM_FRAME_SIZE;
+    }
+
+    /* Direct buffers, decoded in place on their addresses. */
+    JNIEXPORT jint JNICALL
+    Java_io_kvh_media_amr_AmrDecoder_decode__JLjava_nio_ByteBuffer_2ILjava_nio_ShortBuffer_2I(
+            JNIEnv *env, jclass, jlong state, jobject in, jint inOffset, jobject out, jint outOffset) {
+
+        jbyte *inBuf = (jbyte *) env->GetDirectBufferAddress(in);
+        jshort *outBuf = (jshort *) env->GetDirectBufferAddress(out);
+        if (inBuf == NULL || outBuf == NULL)
+            return -1;
+
+        jlong inLen = env->GetDirectBufferCapacity(in);
+        if (inOffset < 0 || inOffset >= inLen || outOffset < 0 ||
+            outOffset > env->GetDirectBufferCapacity(out) - PCM_FRAME_SIZE)
+            return -1;
+        if (inOffset + frame_size(inBuf[inOffset]) > inLen)
+            return -1;
+
+        Decoder_Interface_Decode((void *) state, (const unsigned char *) inBuf + inOffset,
+                                 (short *) outBuf + outOffset);
+        return PCM_FRAME_SIZE;
+    }
+
+    JNIEXPORT jint JNICALL
+    Java_io_kvh_media_amr_AmrDecoder_decodeStream(JNIEnv *env, jclass, jlong state, jbyteArray in,
+                                                 jint offset, jint length, jshortArray out,
+                                                 jintArray consumed) {
+
+        if (offset < 0 || length < 0 || offset > env->GetArrayLength(in) - length)
+            return -1;
+
+        jbyte *inBuf = env->GetByteArrayElements(in, NULL);
+        jshort *outBuf = env->GetShortArrayElements(out, NULL);
+        int used = 0, produced = 0;
+
+        Decoder_Interface_DecodeStream((void *) state, (const unsigned char *) inBuf + offset, length,
+                                       (short *) outBuf, env->GetArrayLength(out), &used, &produced);
+
+        env->ReleaseShortArrayElements(out, outBuf, 0);
+        env->ReleaseByteArrayElements(in, inBuf, JNI_ABORT);
+
+        if (consumed != NULL && env->GetArrayLength(consumed) > 0)
+            env->SetIntArrayRegion(consumed, 0, 1, &used);
+        return produced;
+    }
+
 #ifdef __cplusplus
     }
 #endif
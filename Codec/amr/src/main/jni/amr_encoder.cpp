@@ -2,48 +2,184 @@
 #include <jni.h>
 #include <android/log.h>
 #include <interf_enc.h>
+#include <pthread.h>
 #include <string.h>
 
 #ifndef _Included_com_hikvh_media_amr_AmrEncoder
 #define _Included_com_hikvh_media_amr_AmrEncoder
 
-struct encoder_state *state;
+/*
+ * Instance used by the legacy static API (encode/reset/exit without a
+ * handle): the one most recently returned by init. The legacy API drives a
+ * single stream; default_lock only keeps init/exit on another thread from
+ * swapping or freeing the instance in the middle of a legacy call, so
+ * concurrent streams must use the handle entry points.
+ */
+static struct encoder_state *default_state;
+static pthread_mutex_t default_lock = PTHREAD_MUTEX_INITIALIZER;
+
+#define PCM_FRAME_SIZE 160
+#define AMR_MAX_FRAME_SIZE 32
+
+static jint encode(JNIEnv *env, struct encoder_state *state, jint mode, jshortArray in,
+                   jbyteArray out) {
+
+    jshort inBuf[PCM_FRAME_SIZE] = {0};
+    jsize inLen = env->GetArrayLength(in);
+    if (inLen > PCM_FRAME_SIZE)
+        inLen = PCM_FRAME_SIZE;
+    env->GetShortArrayRegion(in, 0, inLen, inBuf);
+
+    jbyte outBuf[AMR_MAX_FRAME_SIZE];
+    int encodeLength;
+
+    encodeLength = Encoder_Interface_Encode(state, (Mode) mode, (const short *) inBuf,
+                                            (unsigned char *) outBuf);
+
+    jsize outLen = env->GetArrayLength(out);
+    if (outLen > encodeLength)
+        outLen = encodeLength;
+    if (outLen > 0)
+        env->SetByteArrayRegion(out, 0, outLen, outBuf);
+    return encodeLength;
+}
 
 #ifdef __cplusplus
 extern "C" {
 #endif
 
-JNIEXPORT void JNICALL
+JNIEXPORT jlong JNICALL
 Java_io_kvh_media_amr_AmrEncoder_init(JNIEnv *env, jclass type, jint dtx) {
-    state = (encoder_state *) Encoder_Interface_init(dtx);
+    encoder_state *state = (encoder_state *) Encoder_Interface_init(dtx);
+    pthread_mutex_lock(&default_lock);
+    default_state = state;
+    pthread_mutex_unlock(&default_lock);
+    return (jlong) state;
 }
 
 JNIEXPORT void JNICALL
-Java_io_kvh_media_amr_AmrEncoder_reset(JNIEnv *env, jclass type) {
-    Encoder_Interface_reset(state);
+Java_io_kvh_media_amr_AmrEncoder_reset__J(JNIEnv *env, jclass type, jlong state) {
+    Encoder_Interface_reset((void *) state);
 }
 
 JNIEXPORT void JNICALL
-Java_io_kvh_media_amr_AmrEncoder_exit(JNIEnv *env, jclass type) {
-    Encoder_Interface_exit(state);
+Java_io_kvh_media_amr_AmrEncoder_exit__J(JNIEnv *env, jclass type, jlong state) {
+    pthread_mutex_lock(&default_lock);
+    if ((encoder_state *) state == default_state)
+        default_state = NULL;
+    pthread_mutex_unlock(&default_lock);
+    Encoder_Interface_exit((void *) state);
 }
 
 JNIEXPORT jint JNICALL
-Java_io_kvh_media_amr_AmrEncoder_encode
-        (JNIEnv *env, jclass, jint mode, jshortArray in, jbyteArray out) {
+Java_io_kvh_media_amr_AmrEncoder_encode__JI_3S_3B
+        (JNIEnv *env, jclass, jlong state, jint mode, jshortArray in, jbyteArray out) {
+    return encode(env, (encoder_state *) state, mode, in, out);
+}
 
-    jsize inLen = env->GetArrayLength(in);
-    jshort inBuf[inLen];
-    env->GetShortArrayRegion(in, 0, inLen, inBuf);
+/*
+ * Heap arrays through critical access. The encoder pre-processes its input
+ * in place, so the 160 samples are still copied to keep the caller's array
+ * intact; the frame is written straight into out.
+ */
+JNIEXPORT jint JNICALL
+Java_io_kvh_media_amr_AmrEncoder_encode__JI_3SI_3BI
+        (JNIEnv *env, jclass, jlong state, jint mode, jshortArray in, jint inOffset,
+         jbyteArray out, jint outOffset) {
 
-    jsize outLen = env->GetArrayLength(out);
-    jbyte outBuf[outLen];
-    int encodeLength;
+    if (inOffset < 0 || inOffset > env->GetArrayLength(in) - PCM_FRAME_SIZE ||
+        outOffset < 0 || outOffset > env->GetArrayLength(out) - AMR_MAX_FRAME_SIZE)
+        return -1;
 
-    encodeLength = Encoder_Interface_Encode(state, (Mode) mode, (const short *) inBuf,
-                                            (unsigned char *) outBuf);
+    jshort speech[PCM_FRAME_SIZE];
+    env->GetShortArrayRegion(in, inOffset, PCM_FRAME_SIZE, speech);
+
+    jbyte *outBuf = (jbyte *) env->GetPrimitiveArrayCritical(out, NULL);
+    if (outBuf == NULL)
+        return -1;
+
+    int encodeLength = Encoder_Interface_Encode((void *) state, (Mode) mode, (const short *) speech,
+                                                (unsigned char *) outBuf + outOffset);
 
-    env->SetByteArrayRegion(out, 0, outLen, outBuf);
+    env->ReleasePrimitiveArrayCritical(out, outBuf, 0);
+    return encodeLength;
+}
+
+/* Direct buffers: the frame is written straight to out's address. */
+JNIEXPORT jint JNICALL
+Java_io_kvh_media_amr_AmrEncoder_encode__JILjava_nio_ShortBuffer_2ILjava_nio_ByteBuffer_2I
+        (JNIEnv *env, jclass, jlong state, jint mode, jobject in, jint inOffset,
+         jobject out, jint outOffset) {
+
+    jshort *inBuf = (jshort *) env->GetDirectBufferAddress(in);
+    jbyte *outBuf = (jbyte *) env->GetDirectBufferAddress(out);
+    if (inBuf == NULL || outBuf == NULL)
+        return -1;
+    if (inOffset < 0 || inOffset > env->GetDirectBufferCapacity(in) - PCM_FRAME_SIZE ||
+        outOffset < 0 || outOffset > env->GetDirectBufferCapacity(out) - AMR_MAX_FRAME_SIZE)
+        return -1;
+
+    jshort speech[PCM_FRAME_SIZE];
+    memcpy(speech, inBuf + inOffset, sizeof(speech));
+
+    return Encoder_Interface_Encode((void *) state, (Mode) mode, (const short *) speech,
+                                    (unsigned char *) outBuf + outOffset);
+}
+
+JNIEXPORT jint JNICALL
+Java_io_kvh_media_amr_AmrEncoder_encodeBatch
+        (JNIEnv *env, jclass, jlong state, jint mode, jshortArray in, jint frames,
+         jbyteArray out, jintArray sizes, jintArray types) {
+
+    /* compare by division, frames * 160 may not fit in a jint */
+    if (frames < 0 || frames > env->GetArrayLength(in) / 160 ||
+        frames > env->GetArrayLength(out) / 32 ||
+        (sizes != NULL && env->GetArrayLength(sizes) < frames) ||
+        (types != NULL && env->GetArrayLength(types) < frames))
+        return -1;
+
+    jshort *inBuf = env->GetShortArrayElements(in, NULL);
+    jbyte *outBuf = env->GetByteArrayElements(out, NULL);
+    jint *sizesBuf = sizes != NULL ? env->GetIntArrayElements(sizes, NULL) : NULL;
+    jint *typesBuf = types != NULL ? env->GetIntArrayElements(types, NULL) : NULL;
+
+    int encodeLength = Encoder_Interface_EncodeBatch((void *) state, (Mode) mode,
+                                                     (const short *) inBuf, frames,
+                                                     (unsigned char *) outBuf,
+                                                     (int *) sizesBuf, (int *) typesBuf);
+
+    if (typesBuf != NULL)
+        env->ReleaseIntArrayElements(types, typesBuf, 0);
+    if (sizesBuf != NULL)
+        env->ReleaseIntArrayElements(sizes, sizesBuf, 0);
+    env->ReleaseByteArrayElements(out, outBuf, 0);
+    env->ReleaseShortArrayElements(in, inBuf, JNI_ABORT);
+    return encodeLength;
+}
+
+/* Legacy static API, kept as a shim over the most recently created instance. */
+
+JNIEXPORT void JNICALL
+Java_io_kvh_media_amr_AmrEncoder_reset__(JNIEnv *env, jclass type) {
+    pthread_mutex_lock(&default_lock);
+    Encoder_Interface_reset(default_state);
+    pthread_mutex_unlock(&default_lock);
+}
+
+JNIEXPORT void JNICALL
+Java_io_kvh_media_amr_AmrEncoder_exit__(JNIEnv *env, jclass type) {
+    pthread_mutex_lock(&default_lock);
+    Encoder_Interface_exit(default_state);
+    default_state = NULL;
+    pthread_mutex_unlock(&default_lock);
+}
+
+JNIEXPORT jint JNICALL
+Java_io_kvh_media_amr_AmrEncoder_encode__I_3S_3B
+        (JNIEnv *env, jclass, jint mode, jshortArray in, jbyteArray out) {
+    pthread_mutex_lock(&default_lock);
+    jint encodeLength = encode(env, default_state, mode, in, out);
+    pthread_mutex_unlock(&default_lock);
     return encodeLength;
 }
 
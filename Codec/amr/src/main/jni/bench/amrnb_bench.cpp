@@ -0,0 +1,416 @@
+/*
+ * amrnb_bench: end-to-end throughput benchmark for the AMR-NB codec.
+ *
+ * Synthesizes a deterministic speech-like corpus (voiced, unvoiced and
+ * silent segments), then runs it through Encoder_Interface_Encode and
+ * Decoder_Interface_Decode for every mode with DTX off and on. For each run
+ * it reports frames/sec, ns/frame and the realtime factor (seconds of audio
+ * processed per second of CPU time), plus checksums of the produced
+ * bitstream and PCM so that optimizations can be checked for bit-exactness.
+ * With -t it instead transcodes the corpus, coded in the given mode, to
+ * every mode, both by decoding and re-encoding and with the transcoder.
+ * With -p it also times Decoder_Interface_DecodeParams and reports how far
+ * its frame energies are from those of the decoded PCM.
+ */
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "interf_enc.h"
+#include "interf_dec.h"
+#include "interf_trans.h"
+
+#define SAMPLE_RATE     8000
+#define FRAME_SAMPLES   160
+#define MAX_FRAME_BYTES 32
+#define CODEC_DELAY     40
+
+static const char* const mode_names[] = {
+	"MR475", "MR515", "MR59", "MR67", "MR74", "MR795", "MR102", "MR122"
+};
+
+static unsigned int rnd_state;
+
+static int rnd(void) {
+	rnd_state = rnd_state * 1103515245u + 12345u;
+	return (int) ((rnd_state >> 16) & 0x7fff);
+}
+
+static short clip16(int v) {
+	if (v > 32767)
+		return 32767;
+	if (v < -32768)
+		return -32768;
+	return (short) v;
+}
+
+/*
+ * Integer-only synthesis so that the corpus, and therefore the checksums,
+ * are identical on every host and compiler.
+ */
+static void make_corpus(short* pcm, int frames) {
+	int n = 0;
+	int y1 = 0, y2 = 0, prev = 0;
+	int phase = 0;
+	rnd_state = 0x414d52u;
+
+	while (n < frames * FRAME_SAMPLES) {
+		int type = rnd() % 3;
+		int len = (20 + rnd() % 56) * FRAME_SAMPLES;
+		int period = SAMPLE_RATE / (90 + rnd() % 130);
+		int gain = 2000 + rnd() % 6000;
+		int i;
+
+		if (len > frames * FRAME_SAMPLES - n)
+			len = frames * FRAME_SAMPLES - n;
+
+		for (i = 0; i < len; i++, n++) {
+			int env, x, y;
+
+			/* 40 ms linear attack and release on every segment */
+			env = i < 320 ? i : (len - i < 320 ? len - i : 320);
+
+			if (type == 0) {
+				/* voiced: pulse train through a ~600 Hz resonance */
+				x = (phase == 0) ? gain : 0;
+				x += (rnd() & 0xff) - 128;
+				if (++phase >= period) {
+					phase = 0;
+					/* slow pitch drift */
+					period += (rnd() % 3) - 1;
+					if (period < 36)
+						period = 36;
+					if (period > 90)
+						period = 90;
+				}
+				y = x + ((27400 * y1 - 14800 * y2) >> 14);
+				y2 = y1;
+				y1 = y;
+				y = (y * env) / 320;
+			} else if (type == 1) {
+				/* unvoiced: high-passed noise */
+				x = ((rnd() - 16384) * gain) >> 14;
+				y = ((x - prev) * env) / 320;
+				prev = x;
+				y1 = y2 = 0;
+			} else {
+				/* background: low-level noise for the VAD/DTX path */
+				y = ((rnd() & 0x3f) - 32);
+				y1 = y2 = 0;
+			}
+			pcm[n] = clip16(y);
+		}
+	}
+}
+
+static unsigned int fnv1a(unsigned int h, const unsigned char* p, size_t len) {
+	while (len--) {
+		h ^= *p++;
+		h *= 16777619u;
+	}
+	return h;
+}
+
+/* SNR in dB of the decoded out against ref, past delay samples of codec delay */
+static double snr_db(const short* ref, const short* out, int n, int delay) {
+	double sig = 0, err = 0;
+	int i;
+	for (i = 0; i + delay < n; i++) {
+		double d = (double) out[i + delay] - ref[i];
+		sig += (double) ref[i] * ref[i];
+		err += d * d;
+	}
+	return err > 0 ? 10 * log10(sig / err) : 99.0;
+}
+
+static double now_ns(void) {
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+static void usage(const char* argv0) {
+	fprintf(stderr, "Usage: %s [-s seconds] [-r repeats] [-m mode] [-d dtx] [-c level] [-t mode] [-p]\n", argv0);
+	fprintf(stderr, "  -s seconds  corpus length (default 60)\n");
+	fprintf(stderr, "  -r repeats  passes per measurement, best is reported (default 3)\n");
+	fprintf(stderr, "  -m mode     only run mode 0-7 (default all)\n");
+	fprintf(stderr, "  -d dtx      only run with DTX 0 or 1 (default both)\n");
+	fprintf(stderr, "  -c level    encoder complexity 0-%d (default %d)\n",
+	        AMRNB_ENC_COMPLEXITY_MAX, AMRNB_ENC_COMPLEXITY_MAX);
+	fprintf(stderr, "  -t mode     transcode from mode 0-7 to the run modes\n");
+	fprintf(stderr, "  -p          also decode the parameters only\n");
+}
+
+static void report(const char* what, int frames, double ns) {
+	double audio_ns = frames * 20e6;
+	printf("  %s %9.0f fps %8.0f ns/frame %7.1fx RT", what,
+		frames * 1e9 / ns, ns / frames, audio_ns / ns);
+}
+
+/* log2 of the mean square of one frame of PCM, in Q10 like amrnb_frame_params */
+static int frame_log_energy(const short* pcm) {
+	double sum = 0;
+	int i;
+	for (i = 0; i < FRAME_SAMPLES; i++)
+		sum += (double) pcm[i] * pcm[i];
+	return sum > 0 ? (int) (1024 * log2(sum / FRAME_SAMPLES)) : 0;
+}
+
+/*
+ * Times Decoder_Interface_DecodeParams over the frames in bits and prints
+ * its time, and the mean distance in dB between its energies and those of
+ * the decoded PCM over the frames that are not silent.
+ */
+static void decode_params(const unsigned char* bits, int frames, int repeats,
+                          const short* decoded, double* best) {
+	struct amrnb_frame_params params;
+	void* dec;
+	double err = 0;
+	int n = 0;
+	int i, r;
+
+	for (r = 0; r < repeats; r++) {
+		dec = Decoder_Interface_init();
+		double t0 = now_ns(), t;
+		for (i = 0; i < frames; i++)
+			Decoder_Interface_DecodeParams(dec, bits + i * MAX_FRAME_BYTES, &params);
+		t = now_ns() - t0;
+		if (r == 0 || t < *best)
+			*best = t;
+		Decoder_Interface_exit(dec);
+	}
+
+	dec = Decoder_Interface_init();
+	for (i = 0; i < frames; i++) {
+		int energy;
+		Decoder_Interface_DecodeParams(dec, bits + i * MAX_FRAME_BYTES, &params);
+		energy = frame_log_energy(decoded + i * FRAME_SAMPLES);
+		/* skip frames below about 20 dB, where the 13-bit output dominates */
+		if (energy > 7 * 1024) {
+			err += fabs(params.energy - energy) * (10 * log10(2.0) / 1024);
+			n++;
+		}
+	}
+	Decoder_Interface_exit(dec);
+
+	report("par", frames, *best);
+	printf("  energy %4.2f dB off", n ? err / n : 0.0);
+}
+
+/* Decodes the frames in bits, each MAX_FRAME_BYTES apart, into out */
+static void decode_all(const unsigned char* bits, int frames, short* out) {
+	void* dec = Decoder_Interface_init();
+	int i;
+	for (i = 0; i < frames; i++)
+		Decoder_Interface_Decode(dec, bits + i * MAX_FRAME_BYTES, out + i * FRAME_SAMPLES);
+	Decoder_Interface_exit(dec);
+}
+
+/*
+ * Transcodes src, the corpus coded in another mode, to mode by decoding and
+ * re-encoding ("tandem") and with Transcoder_Interface_Transcode ("trans").
+ * Both are compared with the original pcm, two codec delays ahead of them.
+ */
+static void transcode(const short* pcm, const unsigned char* src, int frames, int repeats,
+                      int mode, int dtx, unsigned char* bits, int* sizes,
+                      short* decoded, double* tandem_best, double* trans_best) {
+	short frame[FRAME_SAMPLES];
+	double snr_tandem;
+	unsigned int bits_sum = 2166136261u;
+	int bytes = 0;
+	int i, r;
+
+	for (r = 0; r < repeats; r++) {
+		void* dec = Decoder_Interface_init();
+		void* enc = Encoder_Interface_init(dtx);
+		double t0 = now_ns(), t;
+		for (i = 0; i < frames; i++) {
+			Decoder_Interface_Decode(dec, src + i * MAX_FRAME_BYTES, frame);
+			Encoder_Interface_Encode(enc, (enum Mode) mode, frame, bits + i * MAX_FRAME_BYTES);
+		}
+		t = now_ns() - t0;
+		if (r == 0 || t < *tandem_best)
+			*tandem_best = t;
+		Decoder_Interface_exit(dec);
+		Encoder_Interface_exit(enc);
+	}
+	decode_all(bits, frames, decoded);
+	snr_tandem = snr_db(pcm, decoded, frames * FRAME_SAMPLES, 2 * CODEC_DELAY);
+
+	for (r = 0; r < repeats; r++) {
+		void* trans = Transcoder_Interface_init(dtx);
+		double t0 = now_ns(), t;
+		bytes = 0;
+		for (i = 0; i < frames; i++) {
+			sizes[i] = Transcoder_Interface_Transcode(trans, src + i * MAX_FRAME_BYTES,
+				(enum Mode) mode, bits + i * MAX_FRAME_BYTES);
+			bytes += sizes[i];
+		}
+		t = now_ns() - t0;
+		if (r == 0 || t < *trans_best)
+			*trans_best = t;
+		Transcoder_Interface_exit(trans);
+	}
+	decode_all(bits, frames, decoded);
+	for (i = 0; i < frames; i++)
+		bits_sum = fnv1a(bits_sum, bits + i * MAX_FRAME_BYTES, sizes[i]);
+
+	printf("%-5s dtx=%d", mode_names[mode], dtx);
+	report("tandem", frames, *tandem_best);
+	report("trans", frames, *trans_best);
+	printf("  %6d B  snr=%5.2f/%5.2f dB  bits=%08x\n", bytes, snr_tandem,
+		snr_db(pcm, decoded, frames * FRAME_SAMPLES, 2 * CODEC_DELAY), bits_sum);
+}
+
+int main(int argc, char* argv[]) {
+	int seconds = 60, repeats = 3;
+	int mode_first = MR475, mode_last = MR122;
+	int dtx_first = 0, dtx_last = 1;
+	int complexity = AMRNB_ENC_COMPLEXITY_MAX;
+	int source = -1;
+	int params = 0;
+	int frames, i, dtx, mode;
+	short frame[FRAME_SAMPLES];
+	short* pcm;
+	short* decoded;
+	unsigned char* bits;
+	unsigned char* src;
+	int* sizes;
+	double enc_total = 0, dec_total = 0, par_total = 0;
+	int frames_total = 0;
+
+	for (i = 1; i < argc; i++) {
+		if (i + 1 < argc && !strcmp(argv[i], "-s")) {
+			seconds = atoi(argv[++i]);
+		} else if (i + 1 < argc && !strcmp(argv[i], "-r")) {
+			repeats = atoi(argv[++i]);
+		} else if (i + 1 < argc && !strcmp(argv[i], "-m")) {
+			mode_first = mode_last = atoi(argv[++i]);
+		} else if (i + 1 < argc && !strcmp(argv[i], "-d")) {
+			dtx_first = dtx_last = atoi(argv[++i]);
+		} else if (i + 1 < argc && !strcmp(argv[i], "-c")) {
+			complexity = atoi(argv[++i]);
+		} else if (i + 1 < argc && !strcmp(argv[i], "-t")) {
+			source = atoi(argv[++i]);
+		} else if (!strcmp(argv[i], "-p")) {
+			params = 1;
+		} else {
+			usage(argv[0]);
+			return 1;
+		}
+	}
+	if (seconds <= 0 || repeats <= 0 || mode_first < MR475 || mode_last > MR122 ||
+	    dtx_first < 0 || dtx_last > 1 ||
+	    complexity < 0 || complexity > AMRNB_ENC_COMPLEXITY_MAX || source > MR122) {
+		usage(argv[0]);
+		return 1;
+	}
+
+	frames = seconds * (SAMPLE_RATE / FRAME_SAMPLES);
+	pcm = (short*) malloc(frames * FRAME_SAMPLES * sizeof(short));
+	decoded = (short*) malloc(frames * FRAME_SAMPLES * sizeof(short));
+	bits = (unsigned char*) malloc(frames * MAX_FRAME_BYTES);
+	src = (unsigned char*) malloc(frames * MAX_FRAME_BYTES);
+	sizes = (int*) malloc(frames * sizeof(int));
+	if (!pcm || !decoded || !bits || !src || !sizes) {
+		fprintf(stderr, "Out of memory\n");
+		return 1;
+	}
+	make_corpus(pcm, frames);
+
+	printf("corpus: %d frames (%d s), best of %d\n", frames, seconds, repeats);
+
+	for (dtx = dtx_first; dtx <= dtx_last; dtx++) {
+		if (source >= 0) {
+			void* enc = Encoder_Interface_init(dtx);
+			for (i = 0; i < frames; i++) {
+				memcpy(frame, pcm + i * FRAME_SAMPLES, sizeof(frame));
+				Encoder_Interface_Encode(enc, (enum Mode) source, frame, src + i * MAX_FRAME_BYTES);
+			}
+			Encoder_Interface_exit(enc);
+			printf("from %s dtx=%d, snr tandem/trans:\n", mode_names[source], dtx);
+		}
+		for (mode = mode_first; mode <= mode_last; mode++) {
+			double enc_best = 0, dec_best = 0;
+			unsigned int bits_sum = 2166136261u, pcm_sum = 2166136261u;
+			int bytes = 0;
+			int r;
+
+			if (source >= 0) {
+				transcode(pcm, src, frames, repeats, mode, dtx, bits, sizes,
+					decoded, &enc_best, &dec_best);
+				enc_total += enc_best;
+				dec_total += dec_best;
+				frames_total += frames;
+				continue;
+			}
+
+			for (r = 0; r < repeats; r++) {
+				void* enc = Encoder_Interface_init(dtx);
+				Encoder_Interface_SetComplexity(enc, complexity);
+				double t0 = now_ns(), t;
+				bytes = 0;
+				for (i = 0; i < frames; i++) {
+					/* the encoder pre-processes its input in place */
+					memcpy(frame, pcm + i * FRAME_SAMPLES, sizeof(frame));
+					sizes[i] = Encoder_Interface_Encode(enc, (enum Mode) mode,
+						frame, bits + i * MAX_FRAME_BYTES);
+					bytes += sizes[i];
+				}
+				t = now_ns() - t0;
+				if (r == 0 || t < enc_best)
+					enc_best = t;
+				Encoder_Interface_exit(enc);
+			}
+
+			for (r = 0; r < repeats; r++) {
+				void* dec = Decoder_Interface_init();
+				double t0 = now_ns(), t;
+				for (i = 0; i < frames; i++)
+					Decoder_Interface_Decode(dec, bits + i * MAX_FRAME_BYTES,
+						decoded + i * FRAME_SAMPLES);
+				t = now_ns() - t0;
+				if (r == 0 || t < dec_best)
+					dec_best = t;
+				Decoder_Interface_exit(dec);
+			}
+
+			for (i = 0; i < frames; i++)
+				bits_sum = fnv1a(bits_sum, bits + i * MAX_FRAME_BYTES, sizes[i]);
+			pcm_sum = fnv1a(pcm_sum, (const unsigned char*) decoded,
+				frames * FRAME_SAMPLES * sizeof(short));
+
+			printf("%-5s dtx=%d", mode_names[mode], dtx);
+			report("enc", frames, enc_best);
+			report("dec", frames, dec_best);
+			if (params) {
+				double par_best = 0;
+				decode_params(bits, frames, repeats, decoded, &par_best);
+				par_total += par_best;
+			}
+			printf("  %6d B  snr=%5.2f dB  bits=%08x pcm=%08x\n", bytes,
+				snr_db(pcm, decoded, frames * FRAME_SAMPLES, CODEC_DELAY), bits_sum, pcm_sum);
+
+			enc_total += enc_best;
+			dec_total += dec_best;
+			frames_total += frames;
+		}
+	}
+
+	printf("%-11s", "total");
+	report(source >= 0 ? "tandem" : "enc", frames_total, enc_total);
+	report(source >= 0 ? "trans" : "dec", frames_total, dec_total);
+	if (params && source < 0)
+		report("par", frames_total, par_total);
+	printf("\n");
+
+	free(pcm);
+	free(decoded);
+	free(bits);
+	free(src);
+	free(sizes);
+	return 0;
+}
@@ -0,0 +1,517 @@
+/*
+ * amrnb_kernels: microbenchmark and bit-exactness check for the DSP kernels
+ * that have SIMD implementations.
+ *
+ * Every kernel is first run on a few thousand random inputs (all magnitudes,
+ * plus saturating extremes) through both its portable C implementation and
+ * its dispatcher, which runs the SIMD implementation selected for this CPU
+ * (narrowed with AMRNB_CPU, see amrnb_cpu.h), and the outputs and overflow
+ * flags are compared. Then each implementation is timed on the same input
+ * and the ns/call and speedup are reported. The exit status is non-zero if
+ * any kernel differs.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "typedef.h"
+#include "cnst.h"
+#include "cor_h.h"
+#include "cor_h_x.h"
+#include "cor_h_x2.h"
+#include "set_sign.h"
+#include "syn_filt.h"
+#include "residu.h"
+#include "convolve.h"
+#include "calc_cor.h"
+#include "autocorr.h"
+#include "az_lsp.h"
+#include "pred_lt.h"
+#include "inter_36.h"
+#include "window_tab.h"
+#include "amrnb_cpu.h"
+#include "amrnb_enc_cpu.h"
+
+#if defined(AMRNB_SIMD_SSE2) || defined(AMRNB_SIMD_NEON)
+#define SIMD_NAME simd_name()
+#define SIMD(f) f
+
+static const char* simd_name(void) {
+	Word32 features = amrnb_cpu_features();
+	if (features & AMRNB_CPU_AVX2)
+		return "avx2";
+	if (features & AMRNB_CPU_SSE2)
+		return "sse2";
+	if (features & AMRNB_CPU_NEON)
+		return "neon";
+	return "c";
+}
+#endif
+
+#define MAX_OUT 8192
+
+static unsigned int rnd_state;
+
+static unsigned int rnd32(void) {
+	rnd_state = rnd_state * 1664525u + 1013904223u;
+	return rnd_state;
+}
+
+/* magnitude of the current input set: values are 16-bit randoms >> shift */
+static int rnd_shift;
+static int rnd_extreme;
+/* speech-like inputs for timing, where the kernel has a preference */
+static int timing;
+
+static Word16 rnd16(void) {
+	unsigned int r = rnd32();
+	if (rnd_extreme)
+		return (r >> 30) == 0 ? -32768 : ((r >> 30) == 1 ? 32767 : (Word16) (r >> 16));
+	return (Word16) ((Word16) (r >> 16) >> rnd_shift);
+}
+
+static void rnd_vec(Word16* v, int n) {
+	int i;
+	for (i = 0; i < n; i++)
+		v[i] = rnd16();
+}
+
+static void rnd_sign(Word16* v, int n) {
+	int i;
+	for (i = 0; i < n; i++)
+		v[i] = (rnd32() & 0x10000) ? 32767 : -32767;
+}
+
+/* inputs shared by the kernels; refilled for every trial */
+static Word16 in_h[L_CODE];
+static Word16 in_x[L_CODE];
+static Word16 in_sign[L_CODE];
+static Word16 in_dn[L_CODE];
+static Word16 in_cn[L_CODE];
+static Word16 in_a[M + 1];
+static Word16 in_sig[M + L_SUBFR];
+static Word16 in_mem[M];
+static Word16 in_wsp[PIT_MAX + L_FRAME];
+static Word16 in_speech[L_WINDOW];
+static Word16 in_wind[L_WINDOW];
+static Word16 in_exc[PIT_MAX + L_INTERPOL + L_SUBFR];
+static Word16 in_lag, in_frac, in_flag3;
+
+struct out {
+	unsigned char* p;
+	size_t len;
+};
+
+static void put(struct out* o, const void* p, size_t len) {
+	memcpy(o->p + o->len, p, len);
+	o->len += len;
+}
+
+/* ----------------------------------------------------------------------- */
+
+static void fill_cor_h(void) {
+	rnd_vec(in_h, L_CODE);
+	if (rnd32() & 1)
+		rnd_sign(in_sign, L_CODE);
+	else
+		rnd_vec(in_sign, L_CODE);
+}
+
+static void run_cor_h(int simd, struct out* o) {
+	Word16 rr[L_CODE][L_CODE];
+	Flag overflow = 0;
+	if (!simd)
+		cor_h_c(in_h, in_sign, rr, &overflow);
+#ifdef SIMD_NAME
+	else
+		SIMD(cor_h)(in_h, in_sign, rr, &overflow);
+#endif
+	put(o, rr, sizeof(rr));
+	put(o, &overflow, sizeof(overflow));
+}
+
+static void fill_cor_h_x(void) {
+	rnd_vec(in_h, L_CODE);
+	rnd_vec(in_x, L_CODE);
+}
+
+static void run_cor_h_x(int simd, struct out* o) {
+	Word16 dn[L_CODE];
+	Flag overflow = 0;
+	Word16 sf;
+	for (sf = 1; sf <= 2; sf++) {
+		if (!simd)
+			cor_h_x_c(in_h, in_x, dn, sf, &overflow);
+#ifdef SIMD_NAME
+		else
+			SIMD(cor_h_x)(in_h, in_x, dn, sf, &overflow);
+#endif
+		put(o, dn, sizeof(dn));
+	}
+	put(o, &overflow, sizeof(overflow));
+}
+
+static void run_cor_h_x2(int simd, struct out* o) {
+	Word16 dn[L_CODE];
+	Flag overflow = 0;
+	if (!simd)
+		cor_h_x2_c(in_h, in_x, dn, 1, 4, 4, &overflow);
+#ifdef SIMD_NAME
+	else
+		SIMD(cor_h_x2)(in_h, in_x, dn, 1, 4, 4, &overflow);
+#endif
+	put(o, dn, sizeof(dn));
+	put(o, &overflow, sizeof(overflow));
+}
+
+static void fill_set_sign(void) {
+	rnd_vec(in_dn, L_CODE);
+	rnd_vec(in_cn, L_CODE);
+}
+
+static void run_set_sign(int simd, struct out* o) {
+	Word16 dn[L_CODE], sign[L_CODE], dn2[L_CODE];
+	memcpy(dn, in_dn, sizeof(dn));
+	if (!simd)
+		set_sign_c(dn, sign, dn2, 4);
+#ifdef SIMD_NAME
+	else
+		SIMD(set_sign)(dn, sign, dn2, 4);
+#endif
+	put(o, dn, sizeof(dn));
+	put(o, sign, sizeof(sign));
+	put(o, dn2, sizeof(dn2));
+}
+
+static void run_set_sign12k2(int simd, struct out* o) {
+	Word16 dn[L_CODE], sign[L_CODE], pos_max[NB_TRACK], ipos[2 * NB_TRACK];
+	Flag overflow = 0;
+	memcpy(dn, in_dn, sizeof(dn));
+	if (!simd)
+		set_sign12k2_c(dn, in_cn, sign, pos_max, NB_TRACK, ipos, STEP, &overflow);
+#ifdef SIMD_NAME
+	else
+		SIMD(set_sign12k2)(dn, in_cn, sign, pos_max, NB_TRACK, ipos, STEP, &overflow);
+#endif
+	put(o, dn, sizeof(dn));
+	put(o, sign, sizeof(sign));
+	put(o, pos_max, sizeof(pos_max));
+	put(o, ipos, sizeof(ipos));
+	put(o, &overflow, sizeof(overflow));
+}
+
+/* a stable 10th order LPC filter (poles at radius 0.75-0.92) in Q12 */
+static const Word16 lpc[M + 1] = {
+	4096, -3311, 1950, -1258, 749, -501, 394, -231, 228, 12, 698
+};
+
+static void fill_filter(void) {
+	rnd_vec(in_a, M + 1);
+	rnd_vec(in_sig, M + L_SUBFR);
+	rnd_vec(in_mem, M);
+	rnd_vec(in_h, L_SUBFR);
+	if (timing) {
+		/* random coefficients mostly saturate the synthesis filter */
+		memcpy(in_a, lpc, sizeof(lpc));
+	}
+}
+
+static void run_syn_filt(int simd, struct out* o) {
+	Word16 y[L_SUBFR], mem[M], h[L_SUBFR];
+	memcpy(mem, in_mem, sizeof(mem));
+	memcpy(h, in_sig, sizeof(h));
+	if (!simd) {
+		Syn_filt_c(in_a, &in_sig[M], y, L_SUBFR, mem, 1);
+		/* in place, with the memory inside the signal (Post_Filter) */
+		Syn_filt_c(in_a, h, h, 22, &h[M + 1], 0);
+	}
+#ifdef SIMD_NAME
+	else {
+		SIMD(Syn_filt)(in_a, &in_sig[M], y, L_SUBFR, mem, 1);
+		SIMD(Syn_filt)(in_a, h, h, 22, &h[M + 1], 0);
+	}
+#endif
+	put(o, y, sizeof(y));
+	put(o, mem, sizeof(mem));
+	put(o, h, sizeof(h));
+}
+
+static void run_residu(int simd, struct out* o) {
+	Word16 y[L_SUBFR];
+	if (!simd)
+		Residu_c(in_a, &in_sig[M], y, L_SUBFR);
+#ifdef SIMD_NAME
+	else
+		SIMD(Residu)(in_a, &in_sig[M], y, L_SUBFR);
+#endif
+	put(o, y, sizeof(y));
+}
+
+static void run_convolve(int simd, struct out* o) {
+	Word16 y[L_SUBFR];
+	if (!simd)
+		Convolve_c(in_sig, in_h, y, L_SUBFR);
+#ifdef SIMD_NAME
+	else
+		SIMD(Convolve)(in_sig, in_h, y, L_SUBFR);
+#endif
+	put(o, y, sizeof(y));
+}
+
+static void fill_comp_corr(void) {
+	rnd_vec(in_wsp, PIT_MAX + L_FRAME);
+}
+
+static void run_comp_corr(int simd, struct out* o) {
+	Word32 corr[2][PIT_MAX + 1];
+	memset(corr, 0, sizeof(corr));
+	/* half-frame search of most modes, and the MR122 lag range */
+	if (!simd) {
+		comp_corr_c(&in_wsp[PIT_MAX], L_FRAME_BY2, PIT_MAX, PIT_MIN, &corr[0][PIT_MAX]);
+		comp_corr_c(&in_wsp[PIT_MAX], L_FRAME, PIT_MAX, PIT_MIN_MR122, &corr[1][PIT_MAX]);
+	}
+#ifdef SIMD_NAME
+	else {
+		SIMD(comp_corr)(&in_wsp[PIT_MAX], L_FRAME_BY2, PIT_MAX, PIT_MIN, &corr[0][PIT_MAX]);
+		SIMD(comp_corr)(&in_wsp[PIT_MAX], L_FRAME, PIT_MAX, PIT_MIN_MR122, &corr[1][PIT_MAX]);
+	}
+#endif
+	put(o, corr, sizeof(corr));
+}
+
+static void fill_autocorr(void) {
+	rnd_vec(in_speech, L_WINDOW);
+	rnd_vec(in_wind, L_WINDOW);
+	if (timing)
+		memcpy(in_wind, window_200_40, sizeof(in_wind));
+}
+
+static void run_autocorr(int simd, struct out* o) {
+	Word16 r_h[M + 1], r_l[M + 1], norm = 0;
+	Flag overflow = 0;
+	if (!simd)
+		norm = Autocorr_c(in_speech, M, r_h, r_l, in_wind, &overflow);
+#ifdef SIMD_NAME
+	else
+		norm = SIMD(Autocorr)(in_speech, M, r_h, r_l, in_wind, &overflow);
+#endif
+	put(o, r_h, sizeof(r_h));
+	put(o, r_l, sizeof(r_l));
+	put(o, &norm, sizeof(norm));
+	put(o, &overflow, sizeof(overflow));
+}
+
+static void run_az_lsp(int simd, struct out* o) {
+	Word16 a[M + 1], lsp[2][M];
+	Flag overflow = 0;
+	int i;
+	/* random coefficients rarely have all ten roots: also search around
+	 * the stable filter */
+	for (i = 0; i <= M; i++)
+		a[i] = lpc[i] + (in_h[i] >> 6);
+	if (!simd) {
+		Az_lsp_c(in_a, lsp[0], in_mem, &overflow);
+		Az_lsp_c(a, lsp[1], in_mem, &overflow);
+	}
+#ifdef SIMD_NAME
+	else {
+		SIMD(Az_lsp)(in_a, lsp[0], in_mem, &overflow);
+		SIMD(Az_lsp)(a, lsp[1], in_mem, &overflow);
+	}
+#endif
+	put(o, lsp, sizeof(lsp));
+	put(o, &overflow, sizeof(overflow));
+}
+
+static void fill_pred_lt(void) {
+	rnd_vec(in_exc, PIT_MAX + L_INTERPOL + L_SUBFR);
+	in_flag3 = rnd32() & 1;
+	in_lag = PIT_MIN_MR122 + rnd32() % (PIT_MAX - PIT_MIN_MR122 + 1);
+	in_frac = (Word16) (rnd32() % (in_flag3 ? 5 : 7)) - (in_flag3 ? 2 : 3);
+}
+
+static void run_pred_lt(int simd, struct out* o) {
+	Word16 exc[PIT_MAX + L_INTERPOL + L_SUBFR];
+	Flag overflow = 0;
+	memcpy(exc, in_exc, sizeof(exc));
+	if (!simd)
+		Pred_lt_3or6_c(&exc[PIT_MAX + L_INTERPOL], in_lag, in_frac, L_SUBFR, in_flag3, &overflow);
+#ifdef SIMD_NAME
+	else
+		SIMD(Pred_lt_3or6)(&exc[PIT_MAX + L_INTERPOL], in_lag, in_frac, L_SUBFR, in_flag3, &overflow);
+#endif
+	put(o, &exc[PIT_MAX + L_INTERPOL], L_SUBFR * sizeof(Word16));
+}
+
+static void run_interpol(int simd, struct out* o) {
+	Word16 y[7 + 5][L_CODE];
+	Flag overflow = 0;
+	int i, frac;
+	memset(y, 0, sizeof(y));
+	/* every fraction searched by 1/6 and 1/3 resolution */
+	for (i = L_INTERPOL; i < L_CODE - L_INTERPOL; i++) {
+		for (frac = -3; frac <= 3; frac++) {
+			if (!simd)
+				y[frac + 3][i] = Interpol_3or6_c(&in_x[i], frac, 0, &overflow);
+#ifdef SIMD_NAME
+			else
+				y[frac + 3][i] = SIMD(Interpol_3or6)(&in_x[i], frac, 0, &overflow);
+#endif
+		}
+		for (frac = -2; frac <= 2; frac++) {
+			if (!simd)
+				y[frac + 9][i] = Interpol_3or6_c(&in_x[i], frac, 1, &overflow);
+#ifdef SIMD_NAME
+			else
+				y[frac + 9][i] = SIMD(Interpol_3or6)(&in_x[i], frac, 1, &overflow);
+#endif
+		}
+	}
+	put(o, y, sizeof(y));
+}
+
+/* ----------------------------------------------------------------------- */
+
+struct kernel {
+	const char* name;
+	void (*fill)(void);
+	void (*run)(int simd, struct out* o);
+};
+
+static const struct kernel kernels[] = {
+	{ "cor_h",        fill_cor_h,    run_cor_h },
+	{ "cor_h_x",      fill_cor_h_x,  run_cor_h_x },
+	{ "cor_h_x2",     fill_cor_h_x,  run_cor_h_x2 },
+	{ "set_sign",     fill_set_sign, run_set_sign },
+	{ "set_sign12k2", fill_set_sign, run_set_sign12k2 },
+	{ "Syn_filt",     fill_filter,   run_syn_filt },
+	{ "Residu",       fill_filter,   run_residu },
+	{ "Convolve",     fill_filter,   run_convolve },
+	{ "comp_corr",    fill_comp_corr, run_comp_corr },
+	{ "Autocorr",     fill_autocorr, run_autocorr },
+	{ "Az_lsp",       fill_filter,   run_az_lsp },
+	{ "Pred_lt_3or6", fill_pred_lt,  run_pred_lt },
+	{ "Interpol_3or6", fill_cor_h_x, run_interpol },
+};
+
+static double now_ns(void) {
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+static void new_inputs(const struct kernel* k, int trial) {
+	rnd_shift = timing ? 4 : rnd32() % 16;
+	rnd_extreme = (trial % 16) == 0;
+	k->fill();
+}
+
+/* best of three passes, after a warm-up pass */
+static double time_run(const struct kernel* k, int simd, int iterations) {
+	static unsigned char buf[MAX_OUT];
+	struct out o;
+	double best = 0;
+	int r, i;
+	for (r = 0; r < 4; r++) {
+		double t0 = now_ns(), t;
+		for (i = 0; i < iterations; i++) {
+			o.p = buf;
+			o.len = 0;
+			k->run(simd, &o);
+		}
+		t = (now_ns() - t0) / iterations;
+		if (r == 1 || (r > 1 && t < best))
+			best = t;
+	}
+	return best;
+}
+
+static void usage(const char* argv0) {
+	fprintf(stderr, "Usage: %s [-n iterations] [-t trials] [-k kernel]\n", argv0);
+	fprintf(stderr, "  -n iterations  timed calls per implementation (default 20000)\n");
+	fprintf(stderr, "  -t trials      random inputs compared per kernel (default 4000)\n");
+	fprintf(stderr, "  -k kernel      only run the named kernel\n");
+}
+
+int main(int argc, char* argv[]) {
+	static unsigned char ref[MAX_OUT], got[MAX_OUT];
+	int iterations = 20000, trials = 4000;
+	const char* only = NULL;
+	int failed = 0;
+	size_t n;
+	int i;
+
+	for (i = 1; i < argc; i++) {
+		if (i + 1 < argc && !strcmp(argv[i], "-n")) {
+			iterations = atoi(argv[++i]);
+		} else if (i + 1 < argc && !strcmp(argv[i], "-t")) {
+			trials = atoi(argv[++i]);
+		} else if (i + 1 < argc && !strcmp(argv[i], "-k")) {
+			only = argv[++i];
+		} else {
+			usage(argv[0]);
+			return 1;
+		}
+	}
+	if (iterations <= 0 || trials < 0) {
+		usage(argv[0]);
+		return 1;
+	}
+	/* no encoder is created here, so register the encoder kernels directly */
+	amrnb_enc_cpu_init();
+
+#ifdef SIMD_NAME
+	{
+		char simd_ns[16];
+		snprintf(simd_ns, sizeof(simd_ns), "%s ns", SIMD_NAME);
+		printf("%-14s %10s %10s %8s  %s\n", "kernel", "c ns", simd_ns, "speedup", "check");
+	}
+#else
+	printf("%-14s %10s  (no SIMD implementation built)\n", "kernel", "c ns");
+#endif
+	for (n = 0; n < sizeof(kernels) / sizeof(kernels[0]); n++) {
+		const struct kernel* k = &kernels[n];
+		int mismatches = 0;
+		double c_ns;
+
+		if (only && strcmp(only, k->name))
+			continue;
+
+		rnd_state = 0x4b524e4cu + (unsigned int) n;
+		for (i = 0; i < trials; i++) {
+			struct out a = { ref, 0 }, b = { got, 0 };
+			new_inputs(k, i);
+			k->run(0, &a);
+#ifdef SIMD_NAME
+			k->run(1, &b);
+			if (a.len != b.len || memcmp(ref, got, a.len))
+				mismatches++;
+#else
+			(void) b;
+#endif
+		}
+
+		rnd_state = 0x5445u;
+		timing = 1;
+		new_inputs(k, 1);
+		timing = 0;
+		c_ns = time_run(k, 0, iterations);
+#ifdef SIMD_NAME
+		{
+			double simd_ns = time_run(k, 1, iterations);
+			printf("%-14s %10.1f %10.1f %7.2fx  ", k->name, c_ns, simd_ns, c_ns / simd_ns);
+			if (mismatches)
+				printf("MISMATCH %d/%d\n", mismatches, trials);
+			else
+				printf("exact (%d)\n", trials);
+		}
+#else
+		printf("%-14s %10.1f\n", k->name, c_ns);
+#endif
+		if (mismatches)
+			failed = 1;
+	}
+	return failed;
+}
@@ -0,0 +1,22 @@
+# Cross build for AArch64 Linux with the GNU toolchain, e.g. from the
+# Debian/Ubuntu g++-aarch64-linux-gnu and qemu-user packages:
+#
+#   cmake -S . -B build-arm64 -DCMAKE_TOOLCHAIN_FILE=cmake/aarch64-linux-gnu.cmake \
+#         -DAMRNB_NEON=ON
+#
+# The programs built run on the host through qemu-aarch64 (see README.md).
+
+set(CMAKE_SYSTEM_NAME Linux)
+set(CMAKE_SYSTEM_PROCESSOR aarch64)
+
+set(AMRNB_CROSS_PREFIX aarch64-linux-gnu- CACHE STRING "Prefix of the cross toolchain")
+set(AMRNB_CROSS_SYSROOT /usr/aarch64-linux-gnu CACHE PATH "Target libraries for qemu-aarch64")
+
+set(CMAKE_CXX_COMPILER ${AMRNB_CROSS_PREFIX}g++)
+
+set(CMAKE_FIND_ROOT_PATH ${AMRNB_CROSS_SYSROOT})
+set(CMAKE_FIND_ROOT_PATH_MODE_PROGRAM NEVER)
+set(CMAKE_FIND_ROOT_PATH_MODE_LIBRARY ONLY)
+set(CMAKE_FIND_ROOT_PATH_MODE_INCLUDE ONLY)
+
+set(CMAKE_CROSSCOMPILING_EMULATOR qemu-aarch64 -L ${AMRNB_CROSS_SYSROOT})
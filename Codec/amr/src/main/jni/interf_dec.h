@@ -19,13 +19,73 @@
 #ifndef OPENCORE_AMRNB_INTERF_DEC_H
 #define OPENCORE_AMRNB_INTERF_DEC_H
 
+#include <stddef.h>
+
 #ifdef __cplusplus
 extern "C" {
 #endif
 
+#ifndef AMRNB_STATE_ALIGN
+/* Alignment required for blocks passed to the *_init_mem functions */
+#define AMRNB_STATE_ALIGN 64
+#endif
+
 void* Decoder_Interface_init(void);
+/*
+ * Caller-provided and custom-allocated decoder state, with the same
+ * contract as Encoder_Interface_state_size, Encoder_Interface_init_mem and
+ * Encoder_Interface_init_alloc.
+ */
+size_t Decoder_Interface_state_size(void);
+void* Decoder_Interface_init_mem(void* mem);
+void* Decoder_Interface_init_alloc(void* (*alloc_mem)(void* opaque, size_t size),
+                                   void (*free_mem)(void* opaque, void* ptr), void* opaque);
+void Decoder_Interface_reset(void* state);
 void Decoder_Interface_exit(void* state);
 void Decoder_Interface_Decode(void* state, const unsigned char* in, short* out);
+/*
+ * Size in bytes, ToC byte included, of an IETF storage-format frame of
+ * frame_type (0-15, bits 3-6 of the ToC byte), or -1 if out of range.
+ */
+int Decoder_Interface_FrameSize(int frame_type);
+/*
+ * Decodes consecutive IETF storage-format frames (each starting with its
+ * ToC byte, without the "#!AMR\n" file header) from the len bytes at in.
+ * Stops at the first incomplete frame or when out, which has room for
+ * out_len samples, cannot take another 160. *consumed and *produced (if
+ * non-NULL) receive the number of bytes used and samples written.
+ * Returns the number of frames decoded.
+ */
+int Decoder_Interface_DecodeStream(void* state, const unsigned char* in, int len,
+                                   short* out, int out_len, int* consumed, int* produced);
+
+/* Per-frame parameters, see Decoder_Interface_DecodeParams */
+struct amrnb_frame_params {
+	int frame_type;         /* 0-7 speech in that mode, 8 SID, 15 no data */
+	int mode;               /* mode decoded with, for SID the one it signals */
+	int speech;             /* 1 for a good speech frame, 0 when comfort
+	                           noise or concealment was generated */
+	short lsf[10];          /* LSFs at the end of the frame, 16384 = 4 kHz */
+	short pitch_lag[4];     /* integer pitch lag of each subframe, samples */
+	short pitch_gain[4];    /* pitch gain of each subframe, 16384 = 1.0 */
+	short code_gain[4];     /* fixed codebook gain of each subframe, 2 = 1.0 */
+	short energy;           /* log2 of the mean square of the frame's samples,
+	                           1024 = 1.0 (about 3 dB) */
+};
+
+/*
+ * Decodes only the parameters of the IETF storage-format frame at in (ToC
+ * byte first) into params, for indexing or speech/silence and loudness
+ * analysis, without producing PCM: the post-filter, output high-pass and
+ * phase dispersion are skipped. energy is that of the synthesis before them,
+ * which the post-filter preserves. Lags and gains are 0 for SID and no-data
+ * frames. The instance tracks the stream like Decoder_Interface_Decode, so
+ * frames must be passed in order; switching one instance between the two
+ * functions gives slightly different output for a few frames. Returns the
+ * size of the frame in bytes.
+ */
+int Decoder_Interface_DecodeParams(void* state, const unsigned char* in,
+                                   struct amrnb_frame_params* params);
 
 #ifdef __cplusplus
 }
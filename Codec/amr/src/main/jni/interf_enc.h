@@ -19,6 +19,8 @@
 #ifndef OPENCORE_AMRNB_INTERF_ENC_H
 #define OPENCORE_AMRNB_INTERF_ENC_H
 
+#include <stddef.h>
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -40,15 +42,61 @@ enum Mode {
 
 #endif
 
+#ifndef AMRNB_STATE_ALIGN
+/* Alignment required for blocks passed to the *_init_mem functions */
+#define AMRNB_STATE_ALIGN 64
+#endif
+
 struct encoder_state {
 	void* encCtx;
 	void* pidSyncCtx;
+	/* Set when the state owns its memory block, see Encoder_Interface_init_alloc */
+	void* mem;
+	void (*free_mem)(void* opaque, void* ptr);
+	void* opaque;
 };
 
 void* Encoder_Interface_init(int dtx);
+/*
+ * Size of the single block holding all state of one encoder instance.
+ * Encoder_Interface_init_mem initializes an instance inside such a block,
+ * which must be aligned to AMRNB_STATE_ALIGN bytes, without allocating;
+ * it returns NULL if mem is misaligned. Encoder_Interface_exit does not
+ * release that memory, the caller does once the instance is no longer used.
+ */
+size_t Encoder_Interface_state_size(void);
+void* Encoder_Interface_init_mem(void* mem, int dtx);
+/*
+ * Like Encoder_Interface_init, but the state block is obtained from
+ * alloc_mem(opaque, size) and handed back to free_mem(opaque, ptr) by
+ * Encoder_Interface_exit. The block needs no particular alignment.
+ */
+void* Encoder_Interface_init_alloc(int dtx, void* (*alloc_mem)(void* opaque, size_t size),
+                                   void (*free_mem)(void* opaque, void* ptr), void* opaque);
 void Encoder_Interface_reset(void* state);
 void Encoder_Interface_exit(void* state);
+/*
+ * Sets how hard the encoder searches, from 0 (fastest) to
+ * AMRNB_ENC_COMPLEXITY_MAX (the default: full search, bit exact with the
+ * reference encoder). Lower levels prune the pitch and codebook searches,
+ * cutting encode time at some cost in quality; the frames stay standard at
+ * every level. May be called between any two frames, e.g. to shed load.
+ * Encoder_Interface_reset restores AMRNB_ENC_COMPLEXITY_MAX, so a pooled
+ * encoder is acquired at full search whatever level its last user set.
+ * Returns 0, or -1 if complexity is out of range.
+ */
+#define AMRNB_ENC_COMPLEXITY_MAX 10
+int Encoder_Interface_SetComplexity(void* state, int complexity);
 int Encoder_Interface_Encode(void* state, enum Mode mode, const short* in, unsigned char* out);
+/*
+ * Encodes frames * 160 samples from in, writing the frames back to back
+ * into out in IETF storage format (out needs room for frames * 32 bytes).
+ * If non-NULL, sizes[i] and types[i] receive the byte size and the
+ * enum Frame_Type_3GPP of each frame. Returns the total number of bytes
+ * written, or -1 on error, e.g. if frames is negative or above INT_MAX / 160.
+ */
+int Encoder_Interface_EncodeBatch(void* state, enum Mode mode, const short* in, int frames,
+                                  unsigned char* out, int* sizes, int* types);
 
 #ifdef __cplusplus
 }
@@ -0,0 +1,64 @@
+/* ------------------------------------------------------------------
+ * Copyright (C) 2009 Martin Storsjo
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied.
+ * See the License for the specific language governing permissions
+ * and limitations under the License.
+ * -------------------------------------------------------------------
+ */
+
+#ifndef OPENCORE_AMRNB_INTERF_POOL_H
+#define OPENCORE_AMRNB_INTERF_POOL_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * Pools of pre-initialized encoder or decoder instances, carved out of one
+ * slab of count fixed-size chunks. Acquire and release are O(1); a released
+ * instance is reset when it is next acquired, or earlier by *_Pool_reset_idle.
+ * When the slab is exhausted, acquire falls back to Encoder_Interface_init /
+ * Decoder_Interface_init, and release hands such instances to *_exit.
+ * Instances stay valid for the Encoder_Interface_* / Decoder_Interface_*
+ * calls. A pool is not thread-safe; use one per thread or lock around it.
+ */
+
+struct amrnb_pool_stats {
+	unsigned int size;       /* instances in the slab */
+	unsigned int in_use;     /* currently acquired, including overflow */
+	unsigned int high_water; /* largest in_use seen */
+	unsigned int acquires;   /* acquire calls */
+	unsigned int hits;       /* acquires served from the slab */
+};
+
+void* Encoder_Pool_create(int count, int dtx);
+void* Encoder_Pool_acquire(void* pool);
+void Encoder_Pool_release(void* pool, void* state);
+/* Resets the released instances now, e.g. from an idle period */
+void Encoder_Pool_reset_idle(void* pool);
+void Encoder_Pool_stats(void* pool, struct amrnb_pool_stats* stats);
+/* All instances must have been released */
+void Encoder_Pool_destroy(void* pool);
+
+void* Decoder_Pool_create(int count);
+void* Decoder_Pool_acquire(void* pool);
+void Decoder_Pool_release(void* pool, void* state);
+void Decoder_Pool_reset_idle(void* pool);
+void Decoder_Pool_stats(void* pool, struct amrnb_pool_stats* stats);
+void Decoder_Pool_destroy(void* pool);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
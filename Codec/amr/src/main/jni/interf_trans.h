@@ -0,0 +1,49 @@
+/* ------------------------------------------------------------------
+ * Copyright (C) 2009 Martin Storsjo
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied.
+ * See the License for the specific language governing permissions
+ * and limitations under the License.
+ * -------------------------------------------------------------------
+ */
+#ifndef OPENCORE_AMRNB_INTERF_TRANS_H
+#define OPENCORE_AMRNB_INTERF_TRANS_H
+
+#include "interf_enc.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * Rate transcoder from any AMR-NB mode to another, e.g. MR122 to MR475.
+ * Each frame is decoded as usual, then re-encoded with the LSPs and pitch
+ * lags of the source frame standing in for the encoder's LP analysis and
+ * open-loop pitch search, which is cheaper than a decode and a full encode
+ * and avoids the encoder re-estimating what the source already carries.
+ * Bad, lost and SID frames fall back to the full analysis. The output is
+ * a standard bitstream but not bit exact with decode + encode.
+ * in and out are single frames in IETF storage format, like the
+ * Decoder_Interface_Decode input and the Encoder_Interface_Encode output.
+ */
+
+void* Transcoder_Interface_init(int dtx);
+void Transcoder_Interface_reset(void* state);
+void Transcoder_Interface_exit(void* state);
+/* Returns the number of bytes written to out, or -1 on error */
+int Transcoder_Interface_Transcode(void* state, const unsigned char* in, enum Mode mode, unsigned char* out);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
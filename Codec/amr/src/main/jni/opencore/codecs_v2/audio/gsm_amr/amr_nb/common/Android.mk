@@ -3,6 +3,7 @@ include $(CLEAR_VARS)
 
 LOCAL_SRC_FILES := \
 	src/add.cpp \
+ 	src/amrnb_cpu.cpp \
  	src/az_lsp.cpp \
  	src/bitno_tab.cpp \
  	src/bitreorder_tab.cpp \
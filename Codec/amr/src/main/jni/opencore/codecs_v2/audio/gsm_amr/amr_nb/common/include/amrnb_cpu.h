@@ -0,0 +1,147 @@
+/* ------------------------------------------------------------------
+ * Copyright (C) 1998-2009 PacketVideo
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied.
+ * See the License for the specific language governing permissions
+ * and limitations under the License.
+ * -------------------------------------------------------------------
+ */
+/*
+
+ Filename: amrnb_cpu.h
+
+------------------------------------------------------------------------------
+ INCLUDE DESCRIPTION
+
+ Run-time selection of the DSP kernels. The first call of
+ amrnb_cpu_features() finds out which of the instruction sets the library
+ was built for (see amrnb_simd.h) the CPU supports, from cpuid on x86-64 and
+ getauxval(AT_HWCAP) on AArch64 Linux. Every kernel with SIMD
+ implementations (Syn_filt, Residu, Convolve, cor_h, comp_corr, Autocorr,
+ the VQ searches, ...) calls through a function pointer, which the
+ *_cpu_select() function of its module points at the fastest one the
+ features allow. The select functions of each library form its kernel
+ table; the common library runs its own, and the encoder and decoder
+ libraries register theirs with amrnb_cpu_register() when an instance is
+ created. The tables are run again whenever the features change, never per
+ call. All implementations are bit-exact, so the choice only affects speed.
+
+ The selection can be narrowed for testing, either with the environment
+ variable AMRNB_CPU, read once at the first call, or with
+ amrnb_cpu_set_features():
+
+    AMRNB_CPU=c     portable C only
+    AMRNB_CPU=sse2  SSE2, not AVX2
+    AMRNB_CPU=avx2  SSE2 and AVX2
+    AMRNB_CPU=neon  NEON
+
+ Features the CPU or the build lacks are never enabled.
+
+ The inline vector helpers of basic_op_vec.h, which some C code paths use
+ too, are chosen at compile time and ignore this selection: they use
+ SSE2, which every x86-64 CPU has (AVX2 only in a library built with
+ -mavx2), and NEON on AArch64 builds with AMRNB_NEON. Build with
+ AMRNB_C_REFERENCE to run their portable C forms.
+
+------------------------------------------------------------------------------
+*/
+
+/*----------------------------------------------------------------------------
+; CONTINUE ONLY IF NOT ALREADY DEFINED
+----------------------------------------------------------------------------*/
+#ifndef AMRNB_CPU_H
+#define AMRNB_CPU_H
+
+/*----------------------------------------------------------------------------
+; INCLUDES
+----------------------------------------------------------------------------*/
+#include    "typedef.h"
+
+/*--------------------------------------------------------------------------*/
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+    /*----------------------------------------------------------------------------
+    ; DEFINES
+    ; Include all pre-processor statements here.
+    ----------------------------------------------------------------------------*/
+#define AMRNB_CPU_SSE2      0x0001
+#define AMRNB_CPU_AVX2      0x0002
+#define AMRNB_CPU_NEON      0x0004
+
+    /* amrnb_cpu_set_features(): back to the detected features */
+#define AMRNB_CPU_DETECT    (-1)
+
+    /* amrnb_cpu_register() slots, one per library with a kernel table */
+#define AMRNB_CPU_TABLE_ENC 0
+#define AMRNB_CPU_TABLE_DEC 1
+#define AMRNB_CPU_TABLES    2
+
+    /*----------------------------------------------------------------------------
+    ; STRUCTURES TYPEDEF'S
+    ----------------------------------------------------------------------------*/
+
+    /* Kernel table of a library: points its kernels at the implementations
+       for the given AMRNB_CPU_* features */
+    typedef void (*amrnb_cpu_select_fn)(Word32 features);
+
+    /*----------------------------------------------------------------------------
+    ; EXTERNAL VARIABLES REFERENCES
+    ; Declare variables used in this module but defined elsewhere
+    ----------------------------------------------------------------------------*/
+
+    /* Features the kernel tables were run for, AMRNB_CPU_DETECT until the
+       first call */
+    extern volatile Word32 amrnb_cpu_active;
+
+    /*----------------------------------------------------------------------------
+    ; GLOBAL FUNCTION DEFINITIONS
+    ; Function Prototype declaration
+    ----------------------------------------------------------------------------*/
+
+    /* Detects the features, applies AMRNB_CPU and runs the kernel tables;
+       returns amrnb_cpu_active */
+    Word32 amrnb_cpu_init(void);
+
+    /* Adds the kernel table of a library in slot table (AMRNB_CPU_TABLE_*),
+       runs it for the features in use, and again each time they change.
+       Registering the same table again is harmless. */
+    OSCL_IMPORT_REF void amrnb_cpu_register(Word16 table, amrnb_cpu_select_fn select);
+
+    /* Restricts the kernels to features & (detected features), or goes back
+       to the detected features for AMRNB_CPU_DETECT, and runs the kernel
+       tables; returns the features in use. Meant for tests and benchmarks:
+       it switches the kernels of every encoder and decoder in the process. */
+    OSCL_IMPORT_REF Word32 amrnb_cpu_set_features(Word32 features);
+
+    /* The AMRNB_CPU_* features the kernels may use */
+    static inline Word32 amrnb_cpu_features(void)
+    {
+        Word32 features = amrnb_cpu_active;
+
+        if (features == AMRNB_CPU_DETECT)
+        {
+            features = amrnb_cpu_init();
+        }
+        return (features);
+    }
+
+    /*----------------------------------------------------------------------------
+    ; END
+    ----------------------------------------------------------------------------*/
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* AMRNB_CPU_H */
@@ -0,0 +1,75 @@
+/* ------------------------------------------------------------------
+ * Copyright (C) 1998-2009 PacketVideo
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied.
+ * See the License for the specific language governing permissions
+ * and limitations under the License.
+ * -------------------------------------------------------------------
+ */
+/*
+
+ Filename: amrnb_simd.h
+
+------------------------------------------------------------------------------
+ INCLUDE DESCRIPTION
+
+ Selects the SIMD instruction sets the DSP kernels are built for, from the
+ compiler's target flags:
+
+    AMRNB_SIMD_SSE2  x86-64 (always available there)
+    AMRNB_SIMD_AVX2  x86-64 built with -mavx2, or with GCC/Clang, which can
+                     compile single functions for AVX2 (AMRNB_TARGET_AVX2)
+    AMRNB_SIMD_NEON  AArch64 built with AMRNB_NEON defined. Off by default:
+                     the NEON kernels have not yet been run on an AArch64
+                     target or under qemu-user (see README.md).
+
+ Which of the kernels that are built actually run is decided at run time
+ from the CPU features (see amrnb_cpu.h). Defining AMRNB_C_REFERENCE builds
+ the portable C code only.
+
+------------------------------------------------------------------------------
+*/
+
+/*----------------------------------------------------------------------------
+; CONTINUE ONLY IF NOT ALREADY DEFINED
+----------------------------------------------------------------------------*/
+#ifndef AMRNB_SIMD_H
+#define AMRNB_SIMD_H
+
+/*----------------------------------------------------------------------------
+; DEFINES
+; Include all pre-processor statements here.
+----------------------------------------------------------------------------*/
+#if !defined(AMRNB_C_REFERENCE)
+
+#if defined(__x86_64__) && defined(__SSE2__)
+#define AMRNB_SIMD_SSE2 1
+#include <emmintrin.h>
+#if defined(__AVX2__)
+#define AMRNB_SIMD_AVX2 1
+#define AMRNB_TARGET_AVX2
+#include <immintrin.h>
+#elif defined(__GNUC__)
+#define AMRNB_SIMD_AVX2 1
+#define AMRNB_TARGET_AVX2 __attribute__((target("avx2")))
+#include <immintrin.h>
+#endif
+#endif
+
+#if defined(__aarch64__) && defined(__ARM_NEON) && defined(AMRNB_NEON)
+#define AMRNB_SIMD_NEON 1
+#include <arm_neon.h>
+#endif
+
+#endif /* AMRNB_C_REFERENCE */
+
+#endif /* AMRNB_SIMD_H */
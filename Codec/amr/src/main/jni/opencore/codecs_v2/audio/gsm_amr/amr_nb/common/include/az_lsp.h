@@ -46,6 +46,7 @@ terms listed above has been obtained from the copyright holder.
 ; INCLUDES
 ----------------------------------------------------------------------------*/
 #include  "typedef.h"
+#include  "amrnb_simd.h"
 
 /*--------------------------------------------------------------------------*/
 #ifdef __cplusplus
@@ -93,6 +94,16 @@ extern "C"
         Flag   *pOverflow   /* (i/o): overflow flag                              */
     );
 
+    /* Implementations selected by Az_lsp() */
+    void Az_lsp_c(Word16 a[], Word16 lsp[], Word16 old_lsp[], Flag *pOverflow);
+#if defined(AMRNB_SIMD_SSE2)
+    void Az_lsp_sse2(Word16 a[], Word16 lsp[], Word16 old_lsp[], Flag *pOverflow);
+#endif
+
+
+    /* Selects the implementation of Az_lsp for the AMRNB_CPU_* features (see
+       amrnb_cpu.h) */
+    void az_lsp_cpu_select(Word32 features);
 
     /*----------------------------------------------------------------------------
     ; END
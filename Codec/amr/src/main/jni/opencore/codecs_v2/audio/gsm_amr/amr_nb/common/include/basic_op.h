@@ -52,6 +52,9 @@ terms listed above has been obtained from the copyright holder.
 #if   ((PV_CPU_ARCH_VERSION >=5) && (PV_COMPILER == EPV_ARM_GNUC))
 #include "basic_op_arm_gcc_v5.h"
 
+#elif ((defined(__x86_64__) || defined(__aarch64__)) && defined(__GNUC__) && !defined(AMRNB_C_REFERENCE))
+#include "basic_op_gcc.h"
+
 #else
 #include "basic_op_c_equivalent.h"
 
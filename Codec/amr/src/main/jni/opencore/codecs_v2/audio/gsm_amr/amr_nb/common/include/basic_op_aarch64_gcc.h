@@ -0,0 +1,211 @@
+/* ------------------------------------------------------------------
+ * Copyright (C) 1998-2009 PacketVideo
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied.
+ * See the License for the specific language governing permissions
+ * and limitations under the License.
+ * -------------------------------------------------------------------
+ */
+/****************************************************************************************
+Portions of this file are derived from the following 3GPP standard:
+
+    3GPP TS 26.073
+    ANSI-C code for the Adaptive Multi-Rate (AMR) speech codec
+    Available from http://www.3gpp.org
+
+(C) 2004, 3GPP Organizational Partners (ARIB, ATIS, CCSA, ETSI, TTA, TTC)
+Permission to distribute, modify and use this file under the standard license
+terms listed above has been obtained from the copyright holder.
+****************************************************************************************/
+/*
+
+ Filename: basic_op_aarch64_gcc.h
+
+------------------------------------------------------------------------------
+ INCLUDE DESCRIPTION
+
+ This file includes the AArch64 GCC/Clang versions of the saturating 32-bit
+ additions that the operations of basic_op_gcc.h are built on.
+
+ The 32-bit additions take their overflow from the V flag of adds/subs
+ (__builtin_add_overflow), and the saturated value is picked with csel; only
+ the (rare) *pOverflow store is left conditional. The Advanced SIMD scalar
+ saturating instructions (sqadd, sqdmlal) are not used: they would move
+ every operand between the general and the SIMD registers, they do not
+ report saturation without a read of FPSR.QC, and they saturate in the
+ cases where the C equivalents skip the check (L_var3 == product in L_mac).
+ Results are bit-exact with basic_op_c_equivalent.h.
+
+------------------------------------------------------------------------------
+*/
+
+/*----------------------------------------------------------------------------
+; CONTINUE ONLY IF NOT ALREADY DEFINED
+----------------------------------------------------------------------------*/
+#ifndef BASIC_OP_AARCH64_GCC_H
+#define BASIC_OP_AARCH64_GCC_H
+
+/*----------------------------------------------------------------------------
+; INCLUDES
+----------------------------------------------------------------------------*/
+#include    "basicop_malloc.h"
+
+/*--------------------------------------------------------------------------*/
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+    /*----------------------------------------------------------------------------
+    ; MACROS
+    ; Define module specific macros here
+    ----------------------------------------------------------------------------*/
+
+    /*----------------------------------------------------------------------------
+    ; DEFINES
+    ; Include all pre-processor statements here.
+    ----------------------------------------------------------------------------*/
+
+    /*----------------------------------------------------------------------------
+    ; EXTERNAL VARIABLES REFERENCES
+    ; Declare variables used in this module but defined elsewhere
+    ----------------------------------------------------------------------------*/
+
+    /*----------------------------------------------------------------------------
+    ; SIMPLE TYPEDEF'S
+    ----------------------------------------------------------------------------*/
+
+    /*----------------------------------------------------------------------------
+    ; ENUMERATED TYPEDEF'S
+    ----------------------------------------------------------------------------*/
+
+    /*----------------------------------------------------------------------------
+    ; STRUCTURES TYPEDEF'S
+    ----------------------------------------------------------------------------*/
+
+    /*----------------------------------------------------------------------------
+    ; GLOBAL FUNCTION DEFINITIONS
+    ; Function Prototype declaration
+    ----------------------------------------------------------------------------*/
+
+    /*
+    ------------------------------------------------------------------------------
+     FUNCTION NAME: amrnb_sat_acc
+    ------------------------------------------------------------------------------
+     INPUT AND OUTPUT DEFINITIONS
+
+     Inputs:
+        L_acc = 32 bit accumulator (Word32)
+        L_term = value whose sign decides whether L_acc + L_add can
+                 overflow (Word32)
+        L_add = value added to L_acc (Word32)
+        pOverflow = pointer to overflow (Flag)
+
+     Outputs:
+        pOverflow -> 1 if the addition saturated
+
+     Returns:
+        L_sum = L_acc + L_add, saturated only when L_acc and L_term have
+                the same sign and differ, as in the C equivalents (Word32)
+
+     L_add has the sign of L_term, so the addition can only overflow when
+     L_acc has that sign too; the one case the C equivalents leave to wrap
+     around is L_acc == L_term.
+    */
+    static inline Word32 amrnb_sat_acc(Word32 L_acc, Word32 L_term, Word32 L_add,
+                                       Flag *pOverflow)
+    {
+        Word32 L_sum;
+        Word32 ovf = __builtin_add_overflow(L_acc, L_add, &L_sum) & (L_acc != L_term);
+
+        if (ovf)
+        {
+            *pOverflow = 1;
+        }
+        return (ovf ? (L_acc >> 31) ^ MAX_32 : L_sum);
+    }
+
+    /*
+    ------------------------------------------------------------------------------
+     FUNCTION NAME: L_add
+    ------------------------------------------------------------------------------
+     INPUT AND OUTPUT DEFINITIONS
+
+     Inputs:
+        L_var1 = 32 bit long signed integer (Word32) whose value falls
+                 in the range : 0x8000 0000 <= L_var1 <= 0x7fff ffff.
+
+        L_var2 = 32 bit long signed integer (Word32) whose value falls
+                 in the range : 0x8000 0000 <= L_var1 <= 0x7fff ffff.
+
+        pOverflow = pointer to overflow (Flag)
+
+     Outputs:
+        pOverflow -> 1 if the 32 bit add operation resulted in overflow
+
+     Returns:
+        L_sum = 32-bit sum of L_var1 and L_var2 (Word32)
+    */
+    static inline Word32 L_add(register Word32 L_var1, register Word32 L_var2, Flag *pOverflow)
+    {
+        Word32 L_sum;
+        Word32 ovf = __builtin_add_overflow(L_var1, L_var2, &L_sum);
+
+        if (ovf)
+        {
+            *pOverflow = 1;
+        }
+        return (ovf ? (L_var1 >> 31) ^ MAX_32 : L_sum);
+    }
+
+    /*
+    ------------------------------------------------------------------------------
+     FUNCTION NAME: L_sub
+    ------------------------------------------------------------------------------
+     INPUT AND OUTPUT DEFINITIONS
+
+     Inputs:
+        L_var1 = 32 bit long signed integer (Word32) whose value falls
+                 in the range : 0x8000 0000 <= L_var1 <= 0x7fff ffff.
+
+        L_var2 = 32 bit long signed integer (Word32) whose value falls
+                 in the range : 0x8000 0000 <= L_var1 <= 0x7fff ffff.
+
+        pOverflow = pointer to overflow (Flag)
+
+     Outputs:
+        pOverflow -> 1 if the 32 bit subtract operation resulted in overflow
+
+     Returns:
+        L_diff = 32-bit difference of L_var1 and L_var2 (Word32)
+    */
+    static inline Word32 L_sub(register Word32 L_var1, register Word32 L_var2,
+                               register Flag *pOverflow)
+    {
+        Word32 L_diff;
+        Word32 ovf = __builtin_sub_overflow(L_var1, L_var2, &L_diff);
+
+        if (ovf)
+        {
+            *pOverflow = 1;
+        }
+        return (ovf ? (L_var1 >> 31) ^ MAX_32 : L_diff);
+    }
+
+    /*----------------------------------------------------------------------------
+    ; END
+    ----------------------------------------------------------------------------*/
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* BASIC_OP_AARCH64_GCC_H */
@@ -0,0 +1,586 @@
+/* ------------------------------------------------------------------
+ * Copyright (C) 1998-2009 PacketVideo
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied.
+ * See the License for the specific language governing permissions
+ * and limitations under the License.
+ * -------------------------------------------------------------------
+ */
+/*
+
+ Filename: basic_op_vec.h
+
+------------------------------------------------------------------------------
+ INCLUDE DESCRIPTION
+
+ Vector forms of the multiply-accumulate chains that the DSP kernels run
+ over 16-bit arrays. Each helper returns exactly what the equivalent loop of
+ basic operations returns, using 16 lanes (AVX2) or 8 lanes (SSE2, NEON)
+ where available and the basic operations themselves otherwise. The helpers
+ run in the SSE2 kernels, so they only use 16 lanes when the whole library
+ is built for AVX2; the *_256 helpers are for the kernels compiled for AVX2
+ and the amrnb_*_s16 and amrnb_*_s32 helpers for the NEON kernels.
+
+ Unlike the kernels, the helpers are chosen at compile time and do not
+ follow AMRNB_CPU or amrnb_cpu_set_features() (see amrnb_cpu.h): a run-time
+ test would cost more than the short loops they replace. They only need the
+ instruction sets the whole library is built for, so they run on any CPU
+ the library runs on. AMRNB_C_REFERENCE builds their portable C forms.
+
+------------------------------------------------------------------------------
+*/
+
+/*----------------------------------------------------------------------------
+; CONTINUE ONLY IF NOT ALREADY DEFINED
+----------------------------------------------------------------------------*/
+#ifndef BASIC_OP_VEC_H
+#define BASIC_OP_VEC_H
+
+/*----------------------------------------------------------------------------
+; INCLUDES
+----------------------------------------------------------------------------*/
+#include    "basic_op.h"
+#include    "amrnb_simd.h"
+#include    "oscl_types.h"
+
+/*--------------------------------------------------------------------------*/
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+    /*----------------------------------------------------------------------------
+    ; DEFINES
+    ; Include all pre-processor statements here.
+    ----------------------------------------------------------------------------*/
+
+    /* Largest amount by which max(|x|, 32767) * max(|y|, 32767) can
+       underestimate |x * y| for 16-bit x, y */
+#define AMRNB_ABS_SAT_SLACK 65535
+
+    /*----------------------------------------------------------------------------
+    ; GLOBAL FUNCTION DEFINITIONS
+    ; Function Prototype declaration
+    ----------------------------------------------------------------------------*/
+
+#if defined(AMRNB_SIMD_SSE2)
+    static inline Word32 amrnb_hsum_epi32(__m128i v)
+    {
+        v = _mm_add_epi32(v, _mm_shuffle_epi32(v, _MM_SHUFFLE(1, 0, 3, 2)));
+        v = _mm_add_epi32(v, _mm_shuffle_epi32(v, _MM_SHUFFLE(2, 3, 0, 1)));
+        return _mm_cvtsi128_si32(v);
+    }
+
+    static inline int64 amrnb_hsum_epi64(__m128i v)
+    {
+        v = _mm_add_epi64(v, _mm_unpackhi_epi64(v, v));
+        return (int64) _mm_cvtsi128_si64(v);
+    }
+
+    /* {a, b} in every 32-bit lane, the coefficient operand of _mm_madd_epi16
+       against interleaved data */
+    static inline __m128i amrnb_pair_epi16(Word16 a, Word16 b)
+    {
+        return _mm_set1_epi32((Word32)((UWord32)(UWord16) a | ((UWord32)(UWord16) b << 16)));
+    }
+
+    /* {hsum(a), hsum(b), hsum(c), hsum(d)} */
+    static inline __m128i amrnb_hsum4_epi32(__m128i a, __m128i b, __m128i c, __m128i d)
+    {
+        __m128i ab = _mm_add_epi32(_mm_unpacklo_epi32(a, b), _mm_unpackhi_epi32(a, b));
+        __m128i cd = _mm_add_epi32(_mm_unpacklo_epi32(c, d), _mm_unpackhi_epi32(c, d));
+        return _mm_add_epi32(_mm_unpacklo_epi64(ab, cd), _mm_unpackhi_epi64(ab, cd));
+    }
+
+    /* |v| per 16-bit lane, with -32768 saturated to 32767 */
+    static inline __m128i amrnb_abs_sat_epi16(__m128i v)
+    {
+        return _mm_max_epi16(v, _mm_subs_epi16(_mm_setzero_si128(), v));
+    }
+
+    /* widen the four non-negative 32-bit lanes of v and add them to acc */
+    static inline __m128i amrnb_acc_epu32_epi64(__m128i acc, __m128i v)
+    {
+        __m128i zero = _mm_setzero_si128();
+        acc = _mm_add_epi64(acc, _mm_unpacklo_epi32(v, zero));
+        return _mm_add_epi64(acc, _mm_unpackhi_epi32(v, zero));
+    }
+
+    /* (Word16)(((Word32) a * b) >> 15) per lane, truncated like the C casts */
+    static inline __m128i amrnb_mul_shr15_epi16(__m128i a, __m128i b)
+    {
+        return _mm_or_si128(_mm_slli_epi16(_mm_mulhi_epi16(a, b), 1),
+                            _mm_srli_epi16(_mm_mullo_epi16(a, b), 15));
+    }
+
+    /* low 16 bits of the 32-bit lanes of a (lanes 0-3) and b (lanes 4-7) */
+    static inline __m128i amrnb_pack_trunc_epi32(__m128i a, __m128i b)
+    {
+        a = _mm_srai_epi32(_mm_slli_epi32(a, 16), 16);
+        b = _mm_srai_epi32(_mm_slli_epi32(b, 16), 16);
+        return _mm_packs_epi32(a, b);
+    }
+
+    /* transpose of the 8x8 block of 16-bit values held in r[0..7] */
+    static inline void amrnb_transpose8x8_epi16(__m128i r[8])
+    {
+        __m128i a0 = _mm_unpacklo_epi16(r[0], r[1]);
+        __m128i a1 = _mm_unpackhi_epi16(r[0], r[1]);
+        __m128i a2 = _mm_unpacklo_epi16(r[2], r[3]);
+        __m128i a3 = _mm_unpackhi_epi16(r[2], r[3]);
+        __m128i a4 = _mm_unpacklo_epi16(r[4], r[5]);
+        __m128i a5 = _mm_unpackhi_epi16(r[4], r[5]);
+        __m128i a6 = _mm_unpacklo_epi16(r[6], r[7]);
+        __m128i a7 = _mm_unpackhi_epi16(r[6], r[7]);
+        __m128i b0 = _mm_unpacklo_epi32(a0, a2);
+        __m128i b1 = _mm_unpackhi_epi32(a0, a2);
+        __m128i b2 = _mm_unpacklo_epi32(a1, a3);
+        __m128i b3 = _mm_unpackhi_epi32(a1, a3);
+        __m128i b4 = _mm_unpacklo_epi32(a4, a6);
+        __m128i b5 = _mm_unpackhi_epi32(a4, a6);
+        __m128i b6 = _mm_unpacklo_epi32(a5, a7);
+        __m128i b7 = _mm_unpackhi_epi32(a5, a7);
+
+        r[0] = _mm_unpacklo_epi64(b0, b4);
+        r[1] = _mm_unpackhi_epi64(b0, b4);
+        r[2] = _mm_unpacklo_epi64(b1, b5);
+        r[3] = _mm_unpackhi_epi64(b1, b5);
+        r[4] = _mm_unpacklo_epi64(b2, b6);
+        r[5] = _mm_unpackhi_epi64(b2, b6);
+        r[6] = _mm_unpacklo_epi64(b3, b7);
+        r[7] = _mm_unpackhi_epi64(b3, b7);
+    }
+
+    /* lanes of v in reverse order */
+    static inline __m128i amrnb_reverse_epi16(__m128i v)
+    {
+        v = _mm_shufflelo_epi16(v, _MM_SHUFFLE(0, 1, 2, 3));
+        v = _mm_shufflehi_epi16(v, _MM_SHUFFLE(0, 1, 2, 3));
+        return _mm_shuffle_epi32(v, _MM_SHUFFLE(1, 0, 3, 2));
+    }
+
+    /* {a0 + a1, a2 + a3, b0 + b1, b2 + b3} */
+    static inline __m128i amrnb_hadd_pairs_epi32(__m128i a, __m128i b)
+    {
+        __m128 fa = _mm_castsi128_ps(a);
+        __m128 fb = _mm_castsi128_ps(b);
+        return _mm_add_epi32(_mm_castps_si128(_mm_shuffle_ps(fa, fb, _MM_SHUFFLE(2, 0, 2, 0))),
+                             _mm_castps_si128(_mm_shuffle_ps(fa, fb, _MM_SHUFFLE(3, 1, 3, 1))));
+    }
+
+    /* fields 0..3 of the eight 4-word table entries at p, one vector each */
+    static inline void amrnb_deinterleave4_epi16(const Word16 *p, __m128i v[4])
+    {
+        __m128i a = _mm_loadu_si128((const __m128i *) p);
+        __m128i b = _mm_loadu_si128((const __m128i *)(p + 8));
+        __m128i c = _mm_loadu_si128((const __m128i *)(p + 16));
+        __m128i d = _mm_loadu_si128((const __m128i *)(p + 24));
+        __m128i t0 = _mm_unpacklo_epi16(a, b);
+        __m128i t1 = _mm_unpackhi_epi16(a, b);
+        __m128i t2 = _mm_unpacklo_epi16(c, d);
+        __m128i t3 = _mm_unpackhi_epi16(c, d);
+        __m128i u0 = _mm_unpacklo_epi16(t0, t1);
+        __m128i u1 = _mm_unpackhi_epi16(t0, t1);
+        __m128i u2 = _mm_unpacklo_epi16(t2, t3);
+        __m128i u3 = _mm_unpackhi_epi16(t2, t3);
+
+        v[0] = _mm_unpacklo_epi64(u0, u2);
+        v[1] = _mm_unpackhi_epi64(u0, u2);
+        v[2] = _mm_unpacklo_epi64(u1, u3);
+        v[3] = _mm_unpackhi_epi64(u1, u3);
+    }
+
+    /* Mpy_32_16(hi, lo, n) / 2 = hi * n + ((lo * n) >> 15) for the 16-bit
+       lanes of n (lanes 0-3 into *h_lo, 4-7 into *h_hi), with hi_1 =
+       amrnb_pair_epi16(hi, 1) and lo in every lane. For lo in 0..32767,
+       as L_Extract gives it, and n >= 0, Mpy_32_16 cannot saturate and is
+       exactly twice this. */
+    static inline void amrnb_mpy_32_16_half(__m128i hi_1, __m128i lo, __m128i n,
+                                            __m128i *h_lo, __m128i *h_hi)
+    {
+        __m128i m = amrnb_mul_shr15_epi16(lo, n);
+
+        *h_lo = _mm_madd_epi16(_mm_unpacklo_epi16(n, m), hi_1);
+        *h_hi = _mm_madd_epi16(_mm_unpackhi_epi16(n, m), hi_1);
+    }
+
+    /* acc + inc with wrap-around, setting bit 31 of *ovf in the lanes where
+       the signed sum overflowed; wherever L_mac or L_add saturate, it is set */
+    static inline __m128i amrnb_add_ovf_epi32(__m128i acc, __m128i inc, __m128i *ovf)
+    {
+        __m128i sum = _mm_add_epi32(acc, inc);
+
+        *ovf = _mm_or_si128(*ovf, _mm_and_si128(_mm_xor_si128(acc, sum),
+                                                _mm_xor_si128(inc, sum)));
+        return sum;
+    }
+
+    /* add_16(a, b) per lane, setting *ovf in the lanes where it saturates */
+    static inline __m128i amrnb_adds_ovf_epi16(__m128i a, __m128i b, __m128i *ovf)
+    {
+        __m128i sum = _mm_adds_epi16(a, b);
+
+        *ovf = _mm_or_si128(*ovf, _mm_xor_si128(sum, _mm_add_epi16(a, b)));
+        return sum;
+    }
+
+    /* sub(a, b) per lane, setting *ovf in the lanes where it saturates */
+    static inline __m128i amrnb_subs_ovf_epi16(__m128i a, __m128i b, __m128i *ovf)
+    {
+        __m128i diff = _mm_subs_epi16(a, b);
+
+        *ovf = _mm_or_si128(*ovf, _mm_xor_si128(diff, _mm_sub_epi16(a, b)));
+        return diff;
+    }
+
+    /* keep, per 16-bit lane, the candidate sq2 / alp2 when its ratio beats
+       the kept sq / alp: the lane-wise form of "if (sq2 * alp > sq * alp2)
+       { sq = sq2; alp = alp2; }" for positive alp and alp2. Returns the mask
+       of the lanes that took the candidate. */
+    static inline __m128i amrnb_max_ratio_epi16(__m128i *sq, __m128i *alp,
+                                                __m128i sq2, __m128i alp2)
+    {
+        __m128i zero = _mm_setzero_si128();
+        __m128i neg = _mm_sub_epi16(zero, alp2);
+        __m128i d_lo = _mm_madd_epi16(_mm_unpacklo_epi16(sq2, *sq), _mm_unpacklo_epi16(*alp, neg));
+        __m128i d_hi = _mm_madd_epi16(_mm_unpackhi_epi16(sq2, *sq), _mm_unpackhi_epi16(*alp, neg));
+        __m128i gt = _mm_packs_epi32(_mm_cmpgt_epi32(d_lo, zero), _mm_cmpgt_epi32(d_hi, zero));
+
+        *sq = _mm_or_si128(_mm_and_si128(gt, sq2), _mm_andnot_si128(gt, *sq));
+        *alp = _mm_or_si128(_mm_and_si128(gt, alp2), _mm_andnot_si128(gt, *alp));
+        return gt;
+    }
+
+    /* keep, per lane, the first strictly smaller dist and its index: the
+       lane-wise form of "if (dist < dist_min) { dist_min = dist; index = i; }"
+       when every lane sees its candidates in increasing index order */
+    static inline void amrnb_min_index_epi32(__m128i *dist_min, __m128i *index,
+                                             __m128i dist, __m128i i)
+    {
+        __m128i lt = _mm_cmplt_epi32(dist, *dist_min);
+        *dist_min = _mm_or_si128(_mm_and_si128(lt, dist), _mm_andnot_si128(lt, *dist_min));
+        *index = _mm_or_si128(_mm_and_si128(lt, i), _mm_andnot_si128(lt, *index));
+    }
+
+    /* index of the smallest of the four lanes of dist_min, the lowest index
+       among equal distances, as a sequential search would find it */
+    static inline Word16 amrnb_min_index_reduce(__m128i dist_min, __m128i index)
+    {
+        Word32 d[4];
+        Word32 idx[4];
+        Word32 best = 0;
+        int j;
+
+        _mm_storeu_si128((__m128i *) d, dist_min);
+        _mm_storeu_si128((__m128i *) idx, index);
+        for (j = 1; j < 4; j++)
+        {
+            if (d[j] < d[best] || (d[j] == d[best] && idx[j] < idx[best]))
+            {
+                best = j;
+            }
+        }
+        return (Word16) idx[best];
+    }
+#endif
+
+#if defined(AMRNB_SIMD_NEON)
+    /* {sum(a), sum(b), sum(c), sum(d)} */
+    static inline int32x4_t amrnb_hsum4_s32(int32x4_t a, int32x4_t b, int32x4_t c, int32x4_t d)
+    {
+        return vpaddq_s32(vpaddq_s32(a, b), vpaddq_s32(c, d));
+    }
+
+    /* (Word16)((a * b) >> 15) in every lane */
+    static inline int16x8_t amrnb_mul_shr15_s16(int16x8_t a, int16x8_t b)
+    {
+        return vcombine_s16(vshrn_n_s32(vmull_s16(vget_low_s16(a), vget_low_s16(b)), 15),
+                            vshrn_n_s32(vmull_high_s16(a, b), 15));
+    }
+
+    /* amrnb_min_index_epi32 for NEON */
+    static inline void amrnb_min_index_s32(int32x4_t *dist_min, int32x4_t *index,
+                                           int32x4_t dist, int32x4_t i)
+    {
+        uint32x4_t lt = vcltq_s32(dist, *dist_min);
+        *dist_min = vbslq_s32(lt, dist, *dist_min);
+        *index = vbslq_s32(lt, i, *index);
+    }
+
+    /* amrnb_min_index_reduce for NEON */
+    static inline Word16 amrnb_min_index_reduce_s32(int32x4_t dist_min, int32x4_t index)
+    {
+        uint32x4_t eq = vceqq_s32(dist_min, vdupq_n_s32(vminvq_s32(dist_min)));
+
+        return (Word16) vminvq_s32(vbslq_s32(eq, index, vdupq_n_s32(MAX_32)));
+    }
+#endif
+
+#if defined(AMRNB_SIMD_AVX2)
+    static inline AMRNB_TARGET_AVX2 __m128i amrnb_fold_epi32_256(__m256i v)
+    {
+        return _mm_add_epi32(_mm256_castsi256_si128(v), _mm256_extracti128_si256(v, 1));
+    }
+
+    static inline AMRNB_TARGET_AVX2 __m128i amrnb_fold_epi64_256(__m256i v)
+    {
+        return _mm_add_epi64(_mm256_castsi256_si128(v), _mm256_extracti128_si256(v, 1));
+    }
+
+    /* amrnb_pair_epi16(a, b) in both halves */
+    static inline AMRNB_TARGET_AVX2 __m256i amrnb_pair_epi16_256(Word16 a, Word16 b)
+    {
+        return _mm256_set1_epi32((Word32)((UWord32)(UWord16) a | ((UWord32)(UWord16) b << 16)));
+    }
+
+    /* amrnb_pack_trunc_epi32 on each 128-bit half, which puts the sums of
+       the unpacklo (a) and unpackhi (b) products of 16 lanes back in order */
+    static inline AMRNB_TARGET_AVX2 __m256i amrnb_pack_trunc_epi32_256(__m256i a, __m256i b)
+    {
+        a = _mm256_srai_epi32(_mm256_slli_epi32(a, 16), 16);
+        b = _mm256_srai_epi32(_mm256_slli_epi32(b, 16), 16);
+        return _mm256_packs_epi32(a, b);
+    }
+#endif
+
+    /*
+    ------------------------------------------------------------------------------
+     FUNCTION NAME: amrnb_dot_16x16
+    ------------------------------------------------------------------------------
+     INPUT AND OUTPUT DEFINITIONS
+
+     Inputs:
+        x = 16-bit input vector (Word16)
+        y = 16-bit input vector (Word16)
+        n = number of elements (Word16)
+
+     Returns:
+        sum = x[0] * y[0] + ... + x[n-1] * y[n-1] with 32-bit wrap-around,
+              the same as a chain of amrnb_fxp_mac_16_by_16bb starting at
+              zero (Word32)
+    */
+    static inline Word32 amrnb_dot_16x16(const Word16 *x, const Word16 *y, Word16 n)
+    {
+        Word32 sum = 0;
+        int i = 0;
+
+#if defined(AMRNB_SIMD_SSE2)
+        __m128i acc = _mm_setzero_si128();
+#if defined(__AVX2__)
+        if (n >= 16)
+        {
+            __m256i acc256 = _mm256_setzero_si256();
+            for (; i + 16 <= n; i += 16)
+            {
+                acc256 = _mm256_add_epi32(acc256,
+                                          _mm256_madd_epi16(_mm256_loadu_si256((const __m256i *)(x + i)),
+                                                            _mm256_loadu_si256((const __m256i *)(y + i))));
+            }
+            acc = amrnb_fold_epi32_256(acc256);
+        }
+#endif
+        for (; i + 8 <= n; i += 8)
+        {
+            acc = _mm_add_epi32(acc,
+                                _mm_madd_epi16(_mm_loadu_si128((const __m128i *)(x + i)),
+                                               _mm_loadu_si128((const __m128i *)(y + i))));
+        }
+        sum = amrnb_hsum_epi32(acc);
+#elif defined(AMRNB_SIMD_NEON)
+        int32x4_t acc = vdupq_n_s32(0);
+        for (; i + 8 <= n; i += 8)
+        {
+            int16x8_t vx = vld1q_s16(x + i);
+            int16x8_t vy = vld1q_s16(y + i);
+
+            acc = vmlal_s16(acc, vget_low_s16(vx), vget_low_s16(vy));
+            acc = vmlal_high_s16(acc, vx, vy);
+        }
+        sum = vaddvq_s32(acc);
+#endif
+        for (; i < n; i++)
+        {
+            sum = amrnb_fxp_mac_16_by_16bb((Word32) x[i], (Word32) y[i], sum);
+        }
+        return (sum);
+    }
+
+    /*
+    ------------------------------------------------------------------------------
+     FUNCTION NAME: amrnb_energy_16
+    ------------------------------------------------------------------------------
+     INPUT AND OUTPUT DEFINITIONS
+
+     Inputs:
+        x = 16-bit input vector (Word16)
+        n = number of elements (Word16)
+
+     Returns:
+        sum = x[0] * x[0] + ... + x[n-1] * x[n-1] without wrap-around (int64)
+    */
+    static inline int64 amrnb_energy_16(const Word16 *x, Word16 n)
+    {
+        int64 sum = 0;
+        int i = 0;
+
+#if defined(AMRNB_SIMD_SSE2)
+        __m128i acc = _mm_setzero_si128();
+        for (; i + 8 <= n; i += 8)
+        {
+            __m128i vx = _mm_loadu_si128((const __m128i *)(x + i));
+            /* a pair of squares is at most 2^31, so the lanes are unsigned */
+            acc = amrnb_acc_epu32_epi64(acc, _mm_madd_epi16(vx, vx));
+        }
+        sum = amrnb_hsum_epi64(acc);
+#elif defined(AMRNB_SIMD_NEON)
+        int64x2_t acc = vdupq_n_s64(0);
+        for (; i + 8 <= n; i += 8)
+        {
+            int16x8_t vx = vld1q_s16(x + i);
+
+            acc = vpadalq_s32(acc, vmull_s16(vget_low_s16(vx), vget_low_s16(vx)));
+            acc = vpadalq_s32(acc, vmull_high_s16(vx, vx));
+        }
+        sum = vaddvq_s64(acc);
+#endif
+        for (; i < n; i++)
+        {
+            sum += (Word32) x[i] * x[i];
+        }
+        return (sum);
+    }
+
+    /*
+    ------------------------------------------------------------------------------
+     FUNCTION NAME: amrnb_L_mac_n
+    ------------------------------------------------------------------------------
+     INPUT AND OUTPUT DEFINITIONS
+
+     Inputs:
+        L_acc = 32-bit accumulator (Word32)
+        x = 16-bit input vector (Word16)
+        y = 16-bit input vector (Word16)
+        n = number of elements (Word16)
+        pOverflow = pointer to overflow (Flag)
+
+     Outputs:
+        pOverflow -> 1 if any of the L_mac operations saturated
+
+     Returns:
+        L_acc after L_acc = L_mac(L_acc, x[i], y[i]) for i = 0..n-1 (Word32)
+
+    ------------------------------------------------------------------------------
+     FUNCTION DESCRIPTION
+
+     When |L_acc| + 2 * sum(|x[i] * y[i]|) fits in 32 bits, none of the L_mac
+     steps can saturate and the result is L_acc + 2 * (x . y), which the
+     vector units compute directly; the bound is evaluated along with the dot
+     product. Otherwise the L_mac chain is run as is.
+
+    ------------------------------------------------------------------------------
+    */
+    static inline Word32 amrnb_L_mac_n(Word32 L_acc, const Word16 *x, const Word16 *y,
+                                       Word16 n, Flag *pOverflow)
+    {
+        int i = 0;
+
+#if defined(AMRNB_SIMD_SSE2) || defined(AMRNB_SIMD_NEON)
+        Word32 sum;
+        int64 abs_sum;
+        int64 abs_acc = L_acc < 0 ? -(int64) L_acc : (int64) L_acc;
+
+#if defined(AMRNB_SIMD_SSE2)
+        __m128i acc = _mm_setzero_si128();
+        __m128i bound = _mm_setzero_si128();
+
+#if defined(__AVX2__)
+        if (n >= 16)
+        {
+            __m256i acc256 = _mm256_setzero_si256();
+            __m256i bound256 = _mm256_setzero_si256();
+            __m256i zero = _mm256_setzero_si256();
+            for (; i + 16 <= n; i += 16)
+            {
+                __m256i vx = _mm256_loadu_si256((const __m256i *)(x + i));
+                __m256i vy = _mm256_loadu_si256((const __m256i *)(y + i));
+                __m256i ax = _mm256_max_epi16(vx, _mm256_subs_epi16(zero, vx));
+                __m256i ay = _mm256_max_epi16(vy, _mm256_subs_epi16(zero, vy));
+                __m256i pa = _mm256_madd_epi16(ax, ay);
+
+                acc256 = _mm256_add_epi32(acc256, _mm256_madd_epi16(vx, vy));
+                bound256 = _mm256_add_epi64(bound256, _mm256_unpacklo_epi32(pa, zero));
+                bound256 = _mm256_add_epi64(bound256, _mm256_unpackhi_epi32(pa, zero));
+            }
+            acc = amrnb_fold_epi32_256(acc256);
+            bound = amrnb_fold_epi64_256(bound256);
+        }
+#endif
+        for (; i + 8 <= n; i += 8)
+        {
+            __m128i vx = _mm_loadu_si128((const __m128i *)(x + i));
+            __m128i vy = _mm_loadu_si128((const __m128i *)(y + i));
+
+            acc = _mm_add_epi32(acc, _mm_madd_epi16(vx, vy));
+            bound = amrnb_acc_epu32_epi64(bound,
+                                          _mm_madd_epi16(amrnb_abs_sat_epi16(vx),
+                                                         amrnb_abs_sat_epi16(vy)));
+        }
+        sum = amrnb_hsum_epi32(acc);
+        abs_sum = amrnb_hsum_epi64(bound) + (int64) i * AMRNB_ABS_SAT_SLACK;
+#else
+        int32x4_t acc = vdupq_n_s32(0);
+        int64x2_t bound = vdupq_n_s64(0);
+
+        for (; i + 8 <= n; i += 8)
+        {
+            int16x8_t vx = vld1q_s16(x + i);
+            int16x8_t vy = vld1q_s16(y + i);
+            int16x8_t ax = vqabsq_s16(vx);
+            int16x8_t ay = vqabsq_s16(vy);
+
+            acc = vmlal_s16(acc, vget_low_s16(vx), vget_low_s16(vy));
+            acc = vmlal_high_s16(acc, vx, vy);
+            bound = vpadalq_s32(bound, vmull_s16(vget_low_s16(ax), vget_low_s16(ay)));
+            bound = vpadalq_s32(bound, vmull_high_s16(ax, ay));
+        }
+        sum = vaddvq_s32(acc);
+        abs_sum = vaddvq_s64(bound) + (int64) i * AMRNB_ABS_SAT_SLACK;
+#endif
+
+        for (; i < n; i++)
+        {
+            Word32 p = (Word32) x[i] * y[i];
+            sum = amrnb_fxp_mac_16_by_16bb((Word32) x[i], (Word32) y[i], sum);
+            abs_sum += p < 0 ? -(int64) p : (int64) p;
+        }
+
+        if (abs_acc + 2 * abs_sum <= (int64) MAX_32)
+        {
+            return (L_acc + (sum << 1));
+        }
+        i = 0;
+#endif
+        for (; i < n; i++)
+        {
+            L_acc = L_mac(L_acc, x[i], y[i], pOverflow);
+        }
+        return (L_acc);
+    }
+
+    /*----------------------------------------------------------------------------
+    ; END
+    ----------------------------------------------------------------------------*/
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* BASIC_OP_VEC_H */
@@ -81,6 +81,17 @@ extern "C"
 
     extern const Word16 *const reorderBits[];
     extern const Word16 numCompressedBytes[];
+
+    extern const Word16 packBits_MR475[];
+    extern const Word16 packBits_MR515[];
+    extern const Word16 packBits_MR59[];
+    extern const Word16 packBits_MR67[];
+    extern const Word16 packBits_MR74[];
+    extern const Word16 packBits_MR795[];
+    extern const Word16 packBits_MR102[];
+    extern const Word16 packBits_MR122[];
+
+    extern const Word16 *const packBits[];
     /*----------------------------------------------------------------------------
     ; SIMPLE TYPEDEF'S
     ----------------------------------------------------------------------------*/
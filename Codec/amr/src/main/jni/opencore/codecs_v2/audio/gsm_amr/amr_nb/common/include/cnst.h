@@ -101,6 +101,11 @@ extern "C"
 
 #define EHF_MASK 0x0008        /* encoder homing frame pattern             */
 
+#define COMPLEXITY_MAX 10      /* Encoder search effort: full search       */
+    /* Number of candidates a search tries at the given effort, from 1 at  */
+    /* complexity 0 up to all n at COMPLEXITY_MAX                          */
+#define COMPLEXITY_SCALE(n, c)  (1 + ((((n) - 1) * (c)) / COMPLEXITY_MAX))
+
     /*----------------------------------------------------------------------------
     ; EXTERNAL VARIABLES REFERENCES
     ; Declare variables used in this module but defined elsewhere
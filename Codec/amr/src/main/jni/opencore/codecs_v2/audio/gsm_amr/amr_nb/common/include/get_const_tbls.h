@@ -53,6 +53,7 @@ extern "C"
         const Word16* numOfBits_ptr;
         const Word16* const* reorderBits_ptr;
         const Word16* numCompressedBytes_ptr;
+        const Word16* const* packBits_ptr;
         const Word16* window_200_40_ptr;
         const Word16* window_160_80_ptr;
         const Word16* window_232_8_ptr;
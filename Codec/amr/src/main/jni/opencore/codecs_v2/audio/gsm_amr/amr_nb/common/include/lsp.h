@@ -147,7 +147,8 @@ extern "C"
     *                LP coefficients. These LSPs are quantized with
     *                Matrix/Vector quantization (depending on the mode)
     *                and interpolated for the subframes not yet having
-    *                their own LSPs.
+    *                their own LSPs. LSPs passed in lsp_in are quantized
+    *                instead of those of the LP coefficients.
     *
     **************************************************************************
     */
@@ -158,6 +159,7 @@ extern "C"
                              Word16 azQ[],       /* o   : quantization interpol. LP parameters Q12*/
                              Word16 lsp_new[],   /* o   : new lsp vector                          */
                              Word16 **anap,      /* o   : analysis parameters                     */
+                             Word16 lsp_in[],    /* i   : LSPs at the 2nd and 4th subframe, or NULL */
                              Flag   *pOverflow   /* o   : Flag set when overflow occurs           */
                             );
 
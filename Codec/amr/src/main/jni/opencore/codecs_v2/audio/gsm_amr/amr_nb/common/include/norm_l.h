@@ -104,6 +104,17 @@ extern "C"
         }
         return (var_out);
     }
+#elif (defined(__aarch64__) && defined(__GNUC__) && !defined(AMRNB_C_REFERENCE))
+    /* cls on L_var1 - 1 for negative inputs, which is what the C equivalent
+       counts (it differs from clz(L_var1 ^ (L_var1 << 1)) for -2^n) */
+    static inline Word16 norm_l(Word32 L_var1)
+    {
+        if (L_var1 == 0)
+        {
+            return (0);
+        }
+        return ((Word16) __builtin_clrsb((Word32)((UWord32) L_var1 - (L_var1 < 0))));
+    }
 #else
     /* C EQUIVALENT */
     OSCL_IMPORT_REF Word16 norm_l(Word32 L_var1);
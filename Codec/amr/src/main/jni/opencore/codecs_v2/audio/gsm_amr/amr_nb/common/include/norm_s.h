@@ -104,6 +104,17 @@ extern "C"
         }
         return (var_out);
     }
+#elif (defined(__aarch64__) && defined(__GNUC__) && !defined(AMRNB_C_REFERENCE))
+    /* cls on var1 - 1 for negative inputs, wrapped to 16 bits as in the C
+       equivalent */
+    static inline Word16 norm_s(Word16 var1)
+    {
+        if (var1 == 0)
+        {
+            return (0);
+        }
+        return ((Word16)(__builtin_clrsb((Word32)(Word16)(var1 - (var1 < 0))) - 16));
+    }
 #else
     /*C EQUIVALENT */
     OSCL_IMPORT_REF Word16 norm_s(Word16 var1);
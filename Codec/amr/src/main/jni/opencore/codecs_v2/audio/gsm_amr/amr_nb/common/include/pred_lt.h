@@ -48,6 +48,7 @@ terms listed above has been obtained from the copyright holder.
 ; INCLUDES
 ----------------------------------------------------------------------------*/
 #include "typedef.h"
+#include "amrnb_simd.h"
 
 /*--------------------------------------------------------------------------*/
 #ifdef __cplusplus
@@ -95,6 +96,18 @@ extern "C"
         Flag  *pOverflow  /* output: if set, overflow occurred in this function */
     );
 
+    /* Implementations selected by Pred_lt_3or6() */
+    void Pred_lt_3or6_c(Word16 exc[], Word16 T0, Word16 frac, Word16 L_subfr,
+                        Word16 flag3, Flag *pOverflow);
+#if defined(AMRNB_SIMD_SSE2)
+    void Pred_lt_3or6_sse2(Word16 exc[], Word16 T0, Word16 frac, Word16 L_subfr,
+                           Word16 flag3, Flag *pOverflow);
+#endif
+
+    /* Selects the implementation of Pred_lt_3or6 for the AMRNB_CPU_*
+       features (see amrnb_cpu.h) */
+    void pred_lt_cpu_select(Word32 features);
+
     /*----------------------------------------------------------------------------
     ; END
     ----------------------------------------------------------------------------*/
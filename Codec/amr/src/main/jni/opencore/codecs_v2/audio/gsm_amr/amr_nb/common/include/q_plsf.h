@@ -145,6 +145,14 @@ extern "C"
         Word16 *indice,    /* o  : quantization indices of 5 matrices, Q0  */
         Flag  *pOverflow   /* o : Flag set when overflow occurs            */
     );
+    /* Selects the implementation of the Vq_subvec3 and Vq_subvec4 searches
+       of Q_plsf_3 for the AMRNB_CPU_* features (see amrnb_cpu.h) */
+    void q_plsf_3_cpu_select(Word32 features);
+
+    /* Selects the implementation of the Vq_subvec and Vq_subvec_s searches
+       of Q_plsf_5 for the AMRNB_CPU_* features (see amrnb_cpu.h) */
+    void q_plsf_5_cpu_select(Word32 features);
+
     /*----------------------------------------------------------------------------
     ; END
     ----------------------------------------------------------------------------*/
@@ -40,6 +40,7 @@ terms listed above has been obtained from the copyright holder.
 ; INCLUDES
 ----------------------------------------------------------------------------*/
 #include "typedef.h"
+#include "amrnb_simd.h"
 
 /*--------------------------------------------------------------------------*/
 #ifdef __cplusplus
@@ -94,6 +95,13 @@ extern "C"
     extern const Word16 mr795_1_lsf[];
 
     extern const Word16 past_rq_init[];
+
+#if defined(AMRNB_SIMD_SSE2) || defined(AMRNB_SIMD_NEON)
+    /* dico1_lsf_3, dico2_lsf_3 and mr795_1_lsf in groups of eight entries */
+    extern const Word16 dico1_lsf_3_x8[];
+    extern const Word16 dico2_lsf_3_x8[];
+    extern const Word16 mr795_1_lsf_x8[];
+#endif
     /*----------------------------------------------------------------------------
     ; SIMPLE TYPEDEF'S
     ----------------------------------------------------------------------------*/
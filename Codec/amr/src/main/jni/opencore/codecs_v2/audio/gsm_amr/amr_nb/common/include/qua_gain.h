@@ -113,6 +113,10 @@ extern "C"
         CommonAmrTbls* common_amr_tbls, /* i : ptr to struct of table ptrs     */
         Flag   *pOverflow       /* o  : overflow indicator                     */
     );
+    /* Selects the implementation of the codebook search of Qua_gain for the
+       AMRNB_CPU_* features (see amrnb_cpu.h) */
+    void qua_gain_cpu_select(Word32 features);
+
     /*----------------------------------------------------------------------------
     ; END
     ----------------------------------------------------------------------------*/
@@ -52,6 +52,7 @@ terms listed above has been obtained from the copyright holder.
 ********************************************************************************
 */
 #include "typedef.h"
+#include "amrnb_simd.h"
 
 #ifdef __cplusplus
 extern "C"
@@ -76,6 +77,19 @@ extern "C"
         Word16 lg          /* (i)  : size of filtering                          */
     );
 
+    /* Implementations selected by Residu() */
+    void Residu_c(Word16 a[], Word16 x[], Word16 y[], Word16 lg);
+#if defined(AMRNB_SIMD_SSE2)
+    void Residu_sse2(Word16 a[], Word16 x[], Word16 y[], Word16 lg);
+#endif
+#if defined(AMRNB_SIMD_AVX2)
+    AMRNB_TARGET_AVX2 void Residu_avx2(Word16 a[], Word16 x[], Word16 y[], Word16 lg);
+#endif
+
+    /* Selects the implementation of Residu for the AMRNB_CPU_* features (see
+       amrnb_cpu.h) */
+    void residu_cpu_select(Word32 features);
+
 #ifdef __cplusplus
 }
 #endif
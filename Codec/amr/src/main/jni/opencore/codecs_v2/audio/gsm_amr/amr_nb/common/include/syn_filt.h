@@ -50,6 +50,7 @@ terms listed above has been obtained from the copyright holder.
 ********************************************************************************
 */
 #include "typedef.h"
+#include "amrnb_simd.h"
 
 #ifdef __cplusplus
 extern "C"
@@ -76,6 +77,18 @@ extern "C"
         Word16 update      /* (i)  : 0=no update, 1=update of memory.           */
     );
 
+    /* Implementations selected by Syn_filt() */
+    void Syn_filt_c(Word16 a[], Word16 x[], Word16 y[], Word16 lg, Word16 mem[],
+                    Word16 update);
+#if defined(AMRNB_SIMD_SSE2)
+    void Syn_filt_sse2(Word16 a[], Word16 x[], Word16 y[], Word16 lg, Word16 mem[],
+                       Word16 update);
+#endif
+
+    /* Selects the implementation of Syn_filt for the AMRNB_CPU_* features
+       (see amrnb_cpu.h) */
+    void syn_filt_cpu_select(Word32 features);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,343 @@
+/* ------------------------------------------------------------------
+ * Copyright (C) 1998-2009 PacketVideo
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied.
+ * See the License for the specific language governing permissions
+ * and limitations under the License.
+ * -------------------------------------------------------------------
+ */
+/*
+
+ Filename: amrnb_cpu.cpp
+
+------------------------------------------------------------------------------
+ MODULE DESCRIPTION
+
+ Detection of the CPU features that select the DSP kernels, and the kernel
+ tables that apply them (see amrnb_cpu.h).
+
+------------------------------------------------------------------------------
+*/
+
+/*----------------------------------------------------------------------------
+; INCLUDES
+----------------------------------------------------------------------------*/
+#include <stdlib.h>
+#include <string.h>
+
+#include    "amrnb_cpu.h"
+#include    "amrnb_simd.h"
+#include    "az_lsp.h"
+#include    "pred_lt.h"
+#include    "q_plsf.h"
+#include    "residu.h"
+#include    "syn_filt.h"
+
+#if defined(AMRNB_SIMD_NEON) && defined(__linux__)
+#include <sys/auxv.h>
+#include <asm/hwcap.h>
+#endif
+
+/*----------------------------------------------------------------------------
+; LOCAL VARIABLE DEFINITIONS
+; Variable declaration - defined here and used outside this module
+----------------------------------------------------------------------------*/
+volatile Word32 amrnb_cpu_active = AMRNB_CPU_DETECT;
+
+/* Kernel table of the common library */
+static const amrnb_cpu_select_fn amrnb_cpu_common[] =
+{
+    az_lsp_cpu_select,
+    pred_lt_cpu_select,
+    q_plsf_3_cpu_select,
+    q_plsf_5_cpu_select,
+    residu_cpu_select,
+    syn_filt_cpu_select
+};
+
+/* Kernel tables of the encoder and decoder libraries, once registered */
+static amrnb_cpu_select_fn amrnb_cpu_tables[AMRNB_CPU_TABLES];
+
+/*
+------------------------------------------------------------------------------
+ FUNCTION NAME: amrnb_cpu_detect
+------------------------------------------------------------------------------
+ INPUT AND OUTPUT DEFINITIONS
+
+ Inputs:
+    None
+
+ Outputs:
+    None
+
+ Returns:
+    features = the AMRNB_CPU_* instruction sets that the library was built
+               for and the CPU supports (Word32)
+
+------------------------------------------------------------------------------
+ FUNCTION DESCRIPTION
+
+ SSE2 is part of x86-64. AVX2 is asked from cpuid (which also checks that
+ the OS saves the AVX registers) unless the whole library is built for it.
+ AArch64 Linux reports Advanced SIMD in the hardware capabilities; other
+ AArch64 systems always have it.
+
+------------------------------------------------------------------------------
+*/
+static Word32 amrnb_cpu_detect(void)
+{
+    Word32 features = 0;
+
+#if defined(AMRNB_SIMD_SSE2)
+    features |= AMRNB_CPU_SSE2;
+#endif
+
+#if defined(AMRNB_SIMD_AVX2)
+#if defined(__AVX2__)
+    features |= AMRNB_CPU_AVX2;
+#else
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2"))
+    {
+        features |= AMRNB_CPU_AVX2;
+    }
+#endif
+#endif
+
+#if defined(AMRNB_SIMD_NEON)
+#if defined(__linux__)
+    if (getauxval(AT_HWCAP) & HWCAP_ASIMD)
+    {
+        features |= AMRNB_CPU_NEON;
+    }
+#else
+    features |= AMRNB_CPU_NEON;
+#endif
+#endif
+
+    return (features);
+}
+
+/*
+------------------------------------------------------------------------------
+ FUNCTION NAME: amrnb_cpu_env_mask
+------------------------------------------------------------------------------
+ INPUT AND OUTPUT DEFINITIONS
+
+ Inputs:
+    None
+
+ Outputs:
+    None
+
+ Returns:
+    mask = the features that the AMRNB_CPU environment variable allows, all
+           of them if it is not set or not recognized (Word32)
+
+------------------------------------------------------------------------------
+*/
+static Word32 amrnb_cpu_env_mask(void)
+{
+    const char *env = getenv("AMRNB_CPU");
+    Word32 mask = ~(Word32) 0;
+
+    if (env == NULL)
+    {
+        return (mask);
+    }
+
+    if (strcmp(env, "c") == 0)
+    {
+        mask = 0;
+    }
+    else if (strcmp(env, "sse2") == 0)
+    {
+        mask = AMRNB_CPU_SSE2;
+    }
+    else if (strcmp(env, "avx2") == 0)
+    {
+        mask = AMRNB_CPU_SSE2 | AMRNB_CPU_AVX2;
+    }
+    else if (strcmp(env, "neon") == 0)
+    {
+        mask = AMRNB_CPU_NEON;
+    }
+
+    return (mask);
+}
+
+/*
+------------------------------------------------------------------------------
+ FUNCTION NAME: amrnb_cpu_supported
+------------------------------------------------------------------------------
+ INPUT AND OUTPUT DEFINITIONS
+
+ Returns:
+    features = amrnb_cpu_detect(), run once (Word32)
+
+------------------------------------------------------------------------------
+*/
+static Word32 amrnb_cpu_supported(void)
+{
+    static const Word32 supported = amrnb_cpu_detect();
+
+    return (supported);
+}
+
+/*
+------------------------------------------------------------------------------
+ FUNCTION NAME: amrnb_cpu_apply
+------------------------------------------------------------------------------
+ INPUT AND OUTPUT DEFINITIONS
+
+ Inputs:
+    features = AMRNB_CPU_* features to use (Word32)
+
+ Outputs:
+    the kernels of the common library and of the registered tables point at
+    the implementations for features
+    amrnb_cpu_active = features
+
+ Returns:
+    None
+
+------------------------------------------------------------------------------
+ FUNCTION DESCRIPTION
+
+ The tables run before amrnb_cpu_active is stored, so a kernel called
+ meanwhile at worst still runs the portable C implementation, which gives
+ the same results.
+
+------------------------------------------------------------------------------
+*/
+static void amrnb_cpu_apply(Word32 features)
+{
+    Word16 i;
+
+    for (i = 0; i < (Word16)(sizeof(amrnb_cpu_common) / sizeof(amrnb_cpu_common[0])); i++)
+    {
+        amrnb_cpu_common[i](features);
+    }
+    for (i = 0; i < AMRNB_CPU_TABLES; i++)
+    {
+        if (amrnb_cpu_tables[i] != NULL)
+        {
+            amrnb_cpu_tables[i](features);
+        }
+    }
+
+    amrnb_cpu_active = features;
+}
+
+/*
+------------------------------------------------------------------------------
+ FUNCTION NAME: amrnb_cpu_init
+------------------------------------------------------------------------------
+ INPUT AND OUTPUT DEFINITIONS
+
+ Inputs:
+    None
+
+ Outputs:
+    amrnb_cpu_active = the detected features, narrowed by AMRNB_CPU
+    the kernel tables are run for them
+
+ Returns:
+    features = amrnb_cpu_active (Word32)
+
+------------------------------------------------------------------------------
+ FUNCTION DESCRIPTION
+
+ Called by amrnb_cpu_features() while no features are selected yet. Threads
+ that get here at the same time all store the same values.
+
+------------------------------------------------------------------------------
+*/
+Word32 amrnb_cpu_init(void)
+{
+    Word32 features = amrnb_cpu_supported() & amrnb_cpu_env_mask();
+
+    amrnb_cpu_apply(features);
+
+    return (features);
+}
+
+/*
+------------------------------------------------------------------------------
+ FUNCTION NAME: amrnb_cpu_set_features
+------------------------------------------------------------------------------
+ INPUT AND OUTPUT DEFINITIONS
+
+ Inputs:
+    features = AMRNB_CPU_* features to allow, or AMRNB_CPU_DETECT (Word32)
+
+ Outputs:
+    amrnb_cpu_active = features & the detected features, or what
+                       amrnb_cpu_init() selects for AMRNB_CPU_DETECT
+    the kernel tables are run for them
+
+ Returns:
+    features = amrnb_cpu_active (Word32)
+
+------------------------------------------------------------------------------
+ FUNCTION DESCRIPTION
+
+ Overrides AMRNB_CPU, so that tests and benchmarks can run the same input
+ through each implementation in turn.
+
+------------------------------------------------------------------------------
+*/
+OSCL_EXPORT_REF Word32 amrnb_cpu_set_features(Word32 features)
+{
+    if (features == AMRNB_CPU_DETECT)
+    {
+        return (amrnb_cpu_init());
+    }
+
+    features &= amrnb_cpu_supported();
+    amrnb_cpu_apply(features);
+
+    return (features);
+}
+
+/*
+------------------------------------------------------------------------------
+ FUNCTION NAME: amrnb_cpu_register
+------------------------------------------------------------------------------
+ INPUT AND OUTPUT DEFINITIONS
+
+ Inputs:
+    table = AMRNB_CPU_TABLE_* slot of the library (Word16)
+    select = kernel table of the library (amrnb_cpu_select_fn)
+
+ Outputs:
+    the kernels of the library point at the implementations for the
+    features in use
+
+ Returns:
+    None
+
+------------------------------------------------------------------------------
+ FUNCTION DESCRIPTION
+
+ Called by the encoder and decoder libraries each time an instance is
+ initialized; each library only ever stores the same select function in its
+ own slot.
+
+------------------------------------------------------------------------------
+*/
+OSCL_EXPORT_REF void amrnb_cpu_register(Word16 table, amrnb_cpu_select_fn select)
+{
+    amrnb_cpu_tables[table] = select;
+
+    select(amrnb_cpu_features());
+}
@@ -48,6 +48,9 @@ terms listed above has been obtained from the copyright holder.
 #include "az_lsp.h"
 #include "cnst.h"
 #include "basic_op.h"
+#include "basic_op_vec.h"
+#include "oscl_mem.h"
+#include "amrnb_cpu.h"
 
 /*----------------------------------------------------------------------------
 ; MACROS
@@ -62,6 +65,9 @@ terms listed above has been obtained from the copyright holder.
 ----------------------------------------------------------------------------*/
 #define NC   M/2                  /* M = LPC order, NC = M/2 */
 
+/* grid_points + 1 rounded up to a multiple of 8 */
+#define GRID_PAD ((grid_points + 8) & ~7)
+
 /*----------------------------------------------------------------------------
 ; LOCAL FUNCTION DEFINITIONS
 ; Function Prototype declaration
@@ -261,9 +267,152 @@ static Word16 Chebps(Word16 x,
 }
 
 
+#if defined(AMRNB_SIMD_SSE2)
 /*
 ------------------------------------------------------------------------------
- FUNCTION NAME: Az_lsp
+ FUNCTION NAME: Chebps_step_sse2
+------------------------------------------------------------------------------
+ INPUT AND OUTPUT DEFINITIONS
+
+ Inputs:
+    t0 = b1 for four points (__m128i)
+    xz = the four input values, zero-extended to 32 bits (__m128i)
+
+ Returns:
+    x * b1 for the four points, computed as in Chebps (__m128i)
+
+------------------------------------------------------------------------------
+ FUNCTION DESCRIPTION
+
+ b1 is kept as the 32-bit value it is split from: b1_h is t0 >> 16 and b1_l
+ is (t0 >> 1) & 0x7fff, and both products are 16 x 16 multiply-adds
+ against the zero-extended x.
+
+------------------------------------------------------------------------------
+*/
+
+static inline __m128i Chebps_step_sse2(__m128i t0, __m128i xz)
+{
+    __m128i b1_h = _mm_srai_epi32(t0, 16);
+    __m128i b1_l = _mm_and_si128(_mm_srli_epi32(t0, 1), _mm_set1_epi32(0x7fff));
+
+    return (_mm_add_epi32(_mm_madd_epi16(b1_h, xz),
+                          _mm_srai_epi32(_mm_madd_epi16(b1_l, xz), 15)));
+}
+
+/*
+------------------------------------------------------------------------------
+ FUNCTION NAME: Chebps_sse2
+------------------------------------------------------------------------------
+ INPUT AND OUTPUT DEFINITIONS
+
+ Inputs:
+    x = eight input values (__m128i)
+    f = polynomial (Word16)
+    n = polynomial order (Word16)
+
+ Returns:
+    Chebps(x, f, n) for the eight values (__m128i)
+
+------------------------------------------------------------------------------
+ FUNCTION DESCRIPTION
+
+ Chebps for eight points at once, as two independent sets of four 32-bit
+ lanes. The b2 term (b1_h << 16) + (b1_l << 1) is the previous t0 with its
+ lowest bit cleared. The final saturation follows Chebps, including its
+ treatment of 0x01ffffff.
+
+------------------------------------------------------------------------------
+*/
+
+static inline __m128i Chebps_sse2(__m128i x, const Word16 f[], Word16 n)
+{
+    Word16 i;
+    __m128i xz_lo = _mm_unpacklo_epi16(x, _mm_setzero_si128());
+    __m128i xz_hi = _mm_unpackhi_epi16(x, _mm_setzero_si128());
+    __m128i even = _mm_set1_epi32(~1L);
+    __m128i fi;
+    __m128i t0_lo;
+    __m128i t0_hi;
+    __m128i b2_lo = _mm_set1_epi32(0x01000000L);
+    __m128i b2_hi = b2_lo;
+    __m128i t1_lo;
+    __m128i t1_hi;
+    __m128i edge;
+
+    /* b1 = t0 = 2*x + f[1]  */
+    fi = _mm_set1_epi32((Word32) f[1] << 14);
+    t0_lo = _mm_add_epi32(_mm_srai_epi32(_mm_unpacklo_epi16(_mm_setzero_si128(), x), 6), fi);
+    t0_hi = _mm_add_epi32(_mm_srai_epi32(_mm_unpackhi_epi16(_mm_setzero_si128(), x), 6), fi);
+
+    for (i = 2; i < n; i++)
+    {
+        /* b0 = 2.0*x*b1 - b2 + f[i] */
+        fi = _mm_set1_epi32((Word32) f[i] << 14);
+        t1_lo = _mm_sub_epi32(_mm_slli_epi32(Chebps_step_sse2(t0_lo, xz_lo), 2), b2_lo);
+        t1_hi = _mm_sub_epi32(_mm_slli_epi32(Chebps_step_sse2(t0_hi, xz_hi), 2), b2_hi);
+        b2_lo = _mm_and_si128(t0_lo, even);
+        b2_hi = _mm_and_si128(t0_hi, even);
+        t0_lo = _mm_add_epi32(t1_lo, fi);
+        t0_hi = _mm_add_epi32(t1_hi, fi);
+    }
+
+    /* t0 = x*b1 - b2 + f[i]/2 */
+    fi = _mm_set1_epi32((Word32) f[n] << 13);
+    t0_lo = _mm_sub_epi32(_mm_slli_epi32(Chebps_step_sse2(t0_lo, xz_lo), 1), b2_lo);
+    t0_hi = _mm_sub_epi32(_mm_slli_epi32(Chebps_step_sse2(t0_hi, xz_hi), 1), b2_hi);
+    t0_lo = _mm_add_epi32(t0_lo, fi);
+    t0_hi = _mm_add_epi32(t0_hi, fi);
+
+    /* Chebps saturates 0x01ffffff to MIN_16, the pack handles the rest */
+    edge = _mm_set1_epi32(0x01ffffffL);
+    t0_lo = _mm_sub_epi32(_mm_srai_epi32(t0_lo, 10),
+                          _mm_and_si128(_mm_cmpeq_epi32(t0_lo, edge), _mm_set1_epi32(0x10000L)));
+    t0_hi = _mm_sub_epi32(_mm_srai_epi32(t0_hi, 10),
+                          _mm_and_si128(_mm_cmpeq_epi32(t0_hi, edge), _mm_set1_epi32(0x10000L)));
+
+    return (_mm_packs_epi32(t0_lo, t0_hi));
+}
+
+/*
+------------------------------------------------------------------------------
+ FUNCTION NAME: Chebps_n_sse2
+------------------------------------------------------------------------------
+ INPUT AND OUTPUT DEFINITIONS
+
+ Inputs:
+    x = input values, count rounded up to a multiple of 8 (Word16)
+    f = polynomial (Word16)
+    cheb = buffer of count values, rounded up to a multiple of 8 (Word16)
+    count = number of input values (Word16)
+
+ Outputs:
+    cheb[j] = Chebps(x[j], f, NC) for j = 0..count-1
+
+------------------------------------------------------------------------------
+ FUNCTION DESCRIPTION
+
+ Evaluates the polynomial at count independent points, eight per pass.
+
+------------------------------------------------------------------------------
+*/
+
+static void Chebps_n_sse2(const Word16 x[], Word16 f[], Word16 cheb[], Word16 count)
+{
+    Word16 j;
+
+    for (j = 0; j < count; j += 8)
+    {
+        _mm_storeu_si128((__m128i *) &cheb[j],
+                         Chebps_sse2(_mm_loadu_si128((const __m128i *) &x[j]), f, NC));
+    }
+}
+#endif
+
+
+/*
+------------------------------------------------------------------------------
+ FUNCTION NAME: Az_lsp_c
 ------------------------------------------------------------------------------
  INPUT AND OUTPUT DEFINITIONS FOR Az_lsp
 
@@ -482,7 +631,7 @@ void Az_lsp (
 ------------------------------------------------------------------------------
 */
 
-void Az_lsp(
+void Az_lsp_c(
     Word16 a[],         /* (i)  : predictor coefficients (MP1)               */
     Word16 lsp[],       /* (o)  : line spectral pairs (M)                    */
     Word16 old_lsp[],   /* (i)  : old lsp[] (in case not found 10 roots) (M) */
@@ -655,6 +804,205 @@ void Az_lsp(
 
 }
 
+#if defined(AMRNB_SIMD_SSE2)
+/*
+------------------------------------------------------------------------------
+ FUNCTION NAME: Az_lsp_sse2
+------------------------------------------------------------------------------
+ INPUT AND OUTPUT DEFINITIONS
+
+ Same as Az_lsp_c.
+
+------------------------------------------------------------------------------
+ FUNCTION DESCRIPTION
+
+ Same search as Az_lsp_c, but F1 and F2 are first evaluated at all the grid
+ points in one batch and the scan reads those values. Only the bisection
+ midpoints and the interpolated roots, which are not on the grid, go
+ through Chebps, so the same roots are found. The division of the linear
+ interpolation is done with a single integer division instead of div_s.
+
+------------------------------------------------------------------------------
+*/
+
+void Az_lsp_sse2(
+    Word16 a[],         /* (i)  : predictor coefficients (MP1)               */
+    Word16 lsp[],       /* (o)  : line spectral pairs (M)                    */
+    Word16 old_lsp[],   /* (i)  : old lsp[] (in case not found 10 roots) (M) */
+    Flag   *pOverflow   /* (i/o): overflow flag                              */
+)
+{
+    register Word16 i;
+    register Word16 j;
+    register Word16 nf;
+    register Word16 ip;
+    Word16 xlow;
+    Word16 ylow;
+    Word16 xhigh;
+    Word16 yhigh;
+    Word16 xmid;
+    Word16 ymid;
+    Word16 xint;
+    Word16 x;
+    Word16 y;
+    Word16 sign;
+    Word16 exp;
+    Word16 *coef;
+    Word16 *cheb;
+    Word16 f1[NC + 1];
+    Word16 f2[NC + 1];
+    Word16 xgrid[GRID_PAD];
+    Word16 cheb1[GRID_PAD];
+    Word16 cheb2[GRID_PAD];
+    Word32 L_temp1;
+    Word32 L_temp2;
+    Word16 *p_f1 = f1;
+    Word16 *p_f2 = f2;
+
+    /*-------------------------------------------------------------*
+     *  find the sum and diff. pol. F1(z) and F2(z)                *
+     *-------------------------------------------------------------*/
+
+    *p_f1 = 1024;                       /* f1[0] = 1.0 */
+    *p_f2 = 1024;                       /* f2[0] = 1.0 */
+
+    for (i = 0; i < NC; i++)
+    {
+        L_temp1 = (Word32) * (a + i + 1);
+        L_temp2 = (Word32) * (a + M - i);
+        /* x = (a[i+1] + a[M-i]) >> 2  */
+        x = (Word16)((L_temp1 + L_temp2) >> 2);
+        /* y = (a[i+1] - a[M-i]) >> 2 */
+        y = (Word16)((L_temp1 - L_temp2) >> 2);
+        /* f1[i+1] = a[i+1] + a[M-i] - f1[i] */
+        x -= *(p_f1++);
+        *(p_f1) = x;
+        /* f2[i+1] = a[i+1] - a[M-i] + f2[i] */
+        y += *(p_f2++);
+        *(p_f2) = y;
+    }
+
+    /* grid[] padded to a multiple of 8 points */
+    oscl_memcpy(xgrid, grid, (grid_points + 1) * sizeof(*grid));
+    oscl_memset(&xgrid[grid_points + 1], 0, (GRID_PAD - grid_points - 1) * sizeof(*grid));
+    Chebps_n_sse2(xgrid, f1, cheb1, grid_points + 1);
+    Chebps_n_sse2(xgrid, f2, cheb2, grid_points + 1);
+
+    /*-------------------------------------------------------------*
+     * find the LSPs using the Chebychev pol. evaluation           *
+     *-------------------------------------------------------------*/
+
+    nf = 0;                         /* number of found frequencies */
+    ip = 0;                         /* indicator for f1 or f2      */
+
+    coef = f1;
+    cheb = cheb1;
+
+    xlow = *(grid);
+    ylow = *(cheb);
+
+    j = 0;
+
+    while ((nf < M) && (j < grid_points))
+    {
+        j++;
+        xhigh = xlow;
+        yhigh = ylow;
+        xlow = *(grid + j);
+        ylow = *(cheb + j);
+
+        if (((Word32)ylow*yhigh) <= 0)
+        {
+            /* divide 4 times the interval */
+            for (i = 4; i != 0; i--)
+            {
+                /* xmid = (xlow + xhigh)/2 */
+                x = xlow >> 1;
+                y = xhigh >> 1;
+                xmid = x + y;
+
+                ymid = Chebps(xmid, coef, NC, pOverflow);
+
+                if (((Word32)ylow*ymid) <= 0)
+                {
+                    yhigh = ymid;
+                    xhigh = xmid;
+                }
+                else
+                {
+                    ylow = ymid;
+                    xlow = xmid;
+                }
+            }
+
+            /*-------------------------------------------------------------*
+             * Linear interpolation                                        *
+             *    xint = xlow - ylow*(xhigh-xlow)/(yhigh-ylow);            *
+             *-------------------------------------------------------------*/
+
+            x = xhigh - xlow;
+            y = yhigh - ylow;
+
+            if (y == 0)
+            {
+                xint = xlow;
+            }
+            else
+            {
+                sign = y;
+                y = abs_s(y);
+                exp = norm_s(y);
+                y <<= exp;
+                /* div_s(16383, y) for 16384 <= y: its 15 quotient bits */
+                y = (Word16)(((Word32) 16383 << 15) / y);
+
+                y = ((Word32)x * y) >> (19 - exp);
+
+                if (sign < 0)
+                {
+                    y = -y;
+                }
+
+                /* xint = xlow - ylow*y */
+                xint = xlow - (((Word32) ylow * y) >> 10);
+            }
+
+            *(lsp + nf) = xint;
+            xlow = xint;
+            nf++;
+
+            if (ip == 0)
+            {
+                ip = 1;
+                coef = f2;
+                cheb = cheb2;
+            }
+            else
+            {
+                ip = 0;
+                coef = f1;
+                cheb = cheb1;
+            }
+
+            ylow = Chebps(xlow, coef, NC, pOverflow);
+
+        }
+    }
+
+    /* Check if M roots found */
+
+    if (nf < M)
+    {
+        for (i = NC; i != 0 ; i--)
+        {
+            *lsp++ = *old_lsp++;
+            *lsp++ = *old_lsp++;
+        }
+    }
+
+}
+#endif
+
 Word16 Chebps_Wrapper(Word16 x,
                       Word16 f[], /* (n) */
                       Word16 n,
@@ -663,3 +1011,67 @@ Word16 Chebps_Wrapper(Word16 x,
     return Chebps(x, f, n, pOverflow);
 }
 
+/* Implementation of Az_lsp that az_lsp_cpu_select() selected */
+static void (*Az_lsp_impl)(Word16 a[], Word16 lsp[], Word16 old_lsp[],
+                           Flag *pOverflow) = Az_lsp_c;
+
+/*
+------------------------------------------------------------------------------
+ FUNCTION NAME: Az_lsp
+------------------------------------------------------------------------------
+ INPUT AND OUTPUT DEFINITIONS
+
+ Same as Az_lsp_c.
+
+------------------------------------------------------------------------------
+ FUNCTION DESCRIPTION
+
+ Runs the implementation of Az_lsp that az_lsp_cpu_select() selected
+ (see amrnb_cpu.h).
+
+------------------------------------------------------------------------------
+*/
+
+void Az_lsp(
+    Word16 a[],         /* (i)  : predictor coefficients (MP1)               */
+    Word16 lsp[],       /* (o)  : line spectral pairs (M)                    */
+    Word16 old_lsp[],   /* (i)  : old lsp[] (in case not found 10 roots) (M) */
+    Flag   *pOverflow   /* (i/o): overflow flag                              */
+)
+{
+    Az_lsp_impl(a, lsp, old_lsp, pOverflow);
+}
+
+/*
+------------------------------------------------------------------------------
+ FUNCTION NAME: az_lsp_cpu_select
+------------------------------------------------------------------------------
+ INPUT AND OUTPUT DEFINITIONS
+
+ Inputs:
+    features = AMRNB_CPU_* features the kernels may use (Word32)
+
+ Outputs:
+    Az_lsp_impl = the Az_lsp implementation for features
+
+ Returns:
+    None
+
+------------------------------------------------------------------------------
+ FUNCTION DESCRIPTION
+
+ Part of the kernel table of the common library, run when the features in
+ use are set (see amrnb_cpu.h).
+
+------------------------------------------------------------------------------
+*/
+void az_lsp_cpu_select(Word32 features)
+{
+    Az_lsp_impl = Az_lsp_c;
+#if defined(AMRNB_SIMD_SSE2)
+    if (features & AMRNB_CPU_SSE2)
+    {
+        Az_lsp_impl = Az_lsp_sse2;
+    }
+#endif
+}
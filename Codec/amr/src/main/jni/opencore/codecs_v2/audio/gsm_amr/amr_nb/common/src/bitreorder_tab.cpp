@@ -340,6 +340,179 @@ extern "C"
         0, /*future use*/
         1  /*No transmission*/
     };
+
+    /* The bits of the reordered frame (the order of reorderBits[]) as
+       (parameter index << 4) | bit position within the parameter, so that
+       the parameters can be packed into, and unpacked from, the frame
+       without the bit-per-word serial form. Derived from reorderBits[]
+       and bitno[]. */
+    const Word16 packBits_MR475[NUMBIT_MR475] =
+    {
+           7,    6,    5,    4,    3,    2,    1,    0,   23,   22,
+          21,   20,   19,   18,   17,   16,   55,   54,   53,   52,
+          51,   50,  115,  114,  163,  162,  227,  226,   96,   97,
+          98,   99,  208,  209,  210,  211,   37,   36,   34,   32,
+         212,  213,  214,  215,   49,   48,  100,  101,  102,  103,
+          81,   80,   38,   35,   33,  113,  112,  145,  144,  161,
+         160,  193,  192,  225,  224,  257,  256,   69,   68,   66,
+          65,  133,  132,  130,  129,  181,  180,  178,  177,  245,
+         244,  242,  241,   67,  131,  179,  243,   64,  128,  176,
+         240,   70,  134,  182,  246
+    };
+
+    const Word16 packBits_MR515[NUMBIT_MR515] =
+    {
+           0,    1,    2,    3,    4,    5,    6,    7,   16,   17,
+          18,   19,   20,   21,   22,   23,   55,   54,   53,   52,
+          51,  115,  179,  243,   96,   97,   98,  160,  161,  162,
+         224,  225,  226,  288,  289,  290,   99,  163,  227,  291,
+          50,  114,  178,  242,   36,  100,  164,  228,  292,   49,
+         113,  177,   37,   34,   32,  101,  165,  229,  293,   33,
+          48,  112,  176,  241,   35,   38,  240,   80,   81,  144,
+         145,  208,   66,  130,  194,  258,  209,  272,  273,   65,
+         129,  193,  257,   69,  133,   68,  132,  197,  196,  261,
+         260,   70,  134,  198,  262,   64,  128,  192,  256,   67,
+         131,  195,  259
+    };
+
+    const Word16 packBits_MR59[NUMBIT_MR59] =
+    {
+           7,    6,    3,    2,    4,    1,    0,    5,   19,   17,
+          24,   23,   21,   20,   18,   22,   16,   53,  181,   52,
+         180,   54,  182,   55,  183,   51,  179,  115,  243,   96,
+         160,  224,  288,   50,  178,  114,  242,   97,  161,  225,
+         289,  113,  241,   49,  177,   48,  176,   98,  162,  226,
+         290,   99,  163,  227,  291,  100,  164,  228,  292,   38,
+          36,   34,   35,   39,   40,   37,   33,  272,   81,  209,
+         273,  145,  144,   80,  208,   32,  101,  165,  229,  293,
+         112,  240,   66,  130,  194,  258,   67,  131,  195,  259,
+          70,  134,  198,  262,   71,  135,  199,  263,   72,  136,
+         200,  264,   64,  128,  192,  256,   65,  129,  193,  257,
+          68,  132,  196,  260,   69,  133,  197,  261
+    };
+
+    const Word16 packBits_MR67[NUMBIT_MR67] =
+    {
+           7,    6,    3,    4,    2,    1,   19,    0,    5,   24,
+          23,   21,   17,   20,   18,   22,   53,  181,   52,  180,
+          54,  182,   55,  183,   51,  179,   16,  115,  243,  114,
+         242,   50,  178,  113,  241,  102,  166,  230,  294,   49,
+         177,   99,  163,  227,  291,   98,  162,  226,  290,  112,
+         240,   48,  176,   38,   34,   97,  161,  225,  289,   36,
+          35,   39,   40,   37,   33,   32,  100,  164,  228,  292,
+          80,  144,  208,  272,   96,  160,  224,  288,   81,  145,
+         209,  273,  293,  229,  165,  101,   82,  146,  210,  274,
+          66,  130,  194,  258,   69,  133,  197,  261,   70,  134,
+         198,  262,   73,  137,  201,  265,   74,  138,  202,  266,
+          64,  128,  192,  256,   65,  129,  193,  257,   67,  131,
+         195,  259,   68,  132,  196,  260,   71,  135,  199,  263,
+          72,  136,  200,  264
+    };
+
+    const Word16 packBits_MR74[NUMBIT_MR74] =
+    {
+           7,    6,    5,    4,    3,    2,    1,    0,   24,   23,
+          22,   21,   20,   19,   18,   17,   16,   55,  183,   54,
+         182,   53,  181,   52,  180,   51,  179,  102,  166,  230,
+         294,  101,  165,  229,  293,   99,  163,  227,  291,   98,
+         162,  226,  290,  116,  244,  115,  243,   36,   35,   34,
+          40,   39,   38,   50,  114,  178,  242,   97,  161,  225,
+         289,   37,   33,   32,   80,  144,  208,  272,   96,  160,
+         224,  288,   81,  145,  209,  273,   82,  146,  100,  164,
+         228,  292,  210,  274,   83,  147,  211,  275,   49,   48,
+         113,  112,  177,  176,  241,  240,   69,   68,   67,   66,
+          65,   64,  133,  132,  131,  130,  129,  128,  197,  196,
+         195,  194,  193,  192,  261,  260,  259,  258,  257,  256,
+          76,  140,  204,  268,   75,  139,  203,  267,   74,  138,
+         202,  266,   73,  137,  201,  265,   72,  136,  200,  264,
+          71,  135,  199,  263,   70,  134,  198,  262
+    };
+
+    const Word16 packBits_MR795[NUMBIT_MR795] =
+    {
+           0,    1,    2,    3,    4,    5,    6,   19,   17,   24,
+          23,   21,   20,   18,   22,   16,   38,   36,   34,   35,
+          39,   40,   37,  116,  196,  276,  356,  115,  195,  275,
+         355,  114,  194,  274,  354,   99,  179,  259,  339,   98,
+         178,  258,  338,   55,  215,   54,  214,   53,  213,   52,
+         212,   51,  211,  133,  293,  132,  292,  131,  291,  113,
+         193,  273,  353,   50,  210,  130,  290,    7,    8,   33,
+          32,   49,  209,   48,  208,  129,  289,  128,  288,   97,
+         177,  257,  337,  112,  192,  272,  352,   96,  176,  256,
+         336,  240,  241,  242,   65,  145,  225,  305,   68,  148,
+         228,  308,   71,  151,  231,  311,   75,  155,  235,  315,
+         243,  320,  321,  322,  323,  160,  161,  162,  163,   80,
+          81,   82,   83,   64,   66,   67,   69,   72,   76,  144,
+         146,  147,  149,  152,  156,  224,  226,  227,  229,  232,
+         236,  304,  306,  307,  309,  312,  316,   70,  150,  230,
+         310,   74,  154,  234,  314,   73,  153,  233,  313
+    };
+
+    const Word16 packBits_MR102[NUMBIT_MR102] =
+    {
+           0,    1,    2,    3,    4,    5,    6,    7,   16,   17,
+          18,   19,   20,   21,   22,   23,   24,   55,   54,   53,
+          52,   51,   50,  343,  342,  341,  340,  339,  338,  196,
+         195,  484,  483,  182,  179,  178,  326,  323,  322,  470,
+         467,  466,  614,  611,  610,   49,   48,  337,  336,  194,
+         193,  482,  481,  181,  325,  469,  613,   38,   34,   36,
+          35,   39,   40,   37,   33,   32,  112,   96,   80,   64,
+         256,  240,  224,  208,  400,  384,  368,  352,  544,  528,
+         512,  496,  177,  180,  176,  321,  324,  320,  465,  468,
+         464,  609,  612,  608,  192,  480,  281,  280,  296,  297,
+         295,  279,  293,  277,  278,  294,  310,  309,  292,  307,
+         276,  308,  275,  291,  425,  424,  440,  441,  439,  423,
+         437,  421,  422,  438,  454,  453,  436,  451,  420,  452,
+         419,  435,  569,  568,  584,  585,  583,  567,  581,  565,
+         566,  582,  598,  597,  580,  595,  564,  596,  563,  579,
+         137,  136,  152,  153,  151,  135,  149,  133,  134,  150,
+         166,  165,  148,  163,  132,  164,  131,  147,  594,  560,
+         576,  592,  562,  593,  561,  578,  577,  450,  416,  432,
+         448,  418,  449,  417,  434,  433,  306,  272,  288,  304,
+         274,  305,  273,  290,  289,  162,  128,  144,  160,  130,
+         161,  129,  146,  145
+    };
+
+    const Word16 packBits_MR122[NUMBIT_MR122] =
+    {
+           6,    5,    4,    3,    2,    1,    0,   23,   22,   21,
+          20,   19,   18,   17,   16,   32,   40,   39,   38,   37,
+          36,   35,   34,   33,   55,   54,   53,   52,   51,   88,
+         504,   87,  503,   86,  502,   85,  501,   84,  500,   83,
+         499,   82,  498,   81,  497,   80,  496,   99,  307,  515,
+         723,   98,  306,  514,  722,   97,  305,  513,  721,  276,
+         484,  692,  900,  275,  483,  691,  899,  274,  482,  690,
+         898,  293,  709,  292,  708,  291,  707,  290,  706,  289,
+         705,   50,   49,   48,   69,   68,   67,   66,   96,  304,
+         512,  720,  273,  481,  689,  897,  115,  323,  531,  739,
+         131,  339,  547,  755,  272,  480,  688,  896,  147,  355,
+         563,  771,  163,  371,  579,  787,  179,  387,  595,  803,
+          65,   64,  112,  113,  114,  128,  129,  130,  144,  145,
+         146,  160,  161,  162,  176,  177,  178,  320,  321,  322,
+         336,  337,  338,  352,  353,  354,  368,  369,  370,  384,
+         385,  386,  528,  529,  530,  544,  545,  546,  560,  561,
+         562,  576,  577,  578,  592,  593,  594,  736,  737,  738,
+         752,  753,  754,  768,  769,  770,  784,  785,  786,  800,
+         801,  802,  192,  193,  194,  208,  209,  210,  224,  225,
+         226,  240,  241,  242,  256,  257,  258,  400,  401,  402,
+         416,  417,  418,  432,  433,  434,  448,  449,  450,  464,
+         465,  466,  608,  609,  610,  624,  625,  626,  640,  641,
+         642,  656,  657,  658,  672,  673,  674,  816,  817,  818,
+         832,  833,  834,  848,  849,  850,  864,  865,  866,  880,
+         881,  882,  288,  704
+    };
+
+    const Word16 * const packBits[NUM_MODES-1] =
+    {
+        packBits_MR475,
+        packBits_MR515,
+        packBits_MR59,
+        packBits_MR67,
+        packBits_MR74,
+        packBits_MR795,
+        packBits_MR102,
+        packBits_MR122
+    };
     /*----------------------------------------------------------------------------
     ; EXTERNAL FUNCTION REFERENCES
     ; Declare functions defined elsewhere and referenced in this module
@@ -51,6 +51,7 @@ extern "C"
     extern const Word16 numOfBits[];
     extern const Word16* const reorderBits[];
     extern const Word16 numCompressedBytes[];
+    extern const Word16* const packBits[];
     extern const Word16 window_200_40[];
     extern const Word16 window_160_80[];
     extern const Word16 window_232_8[];
@@ -92,6 +93,7 @@ OSCL_EXPORT_REF void get_const_tbls(CommonAmrTbls* tbl_struct_ptr)
     tbl_struct_ptr->numOfBits_ptr = numOfBits;
     tbl_struct_ptr->reorderBits_ptr = reorderBits;
     tbl_struct_ptr->numCompressedBytes_ptr = numCompressedBytes;
+    tbl_struct_ptr->packBits_ptr = packBits;
     tbl_struct_ptr->window_200_40_ptr = window_200_40;
     tbl_struct_ptr->window_160_80_ptr = window_160_80;
     tbl_struct_ptr->window_232_8_ptr = window_232_8;
@@ -44,6 +44,7 @@ terms listed above has been obtained from the copyright holder.
 #include "typedef.h"
 #include "q_plsf.h"
 #include "az_lsp.h"
+#include "lsp_az.h"
 #include "int_lpc.h"
 #include "lsp_tab.h"
 #include "oscl_mem.h"
@@ -305,6 +306,8 @@ OSCL_EXPORT_REF void lsp_exit(lspState **st)
     req_mode = enum Mode -- requested coder mode
     used_mode = enum Mode -- used coder mode
     az = array of type Word16 -- interpolated LP parameters Q12
+    lsp_in = array of type Word16 -- LSPs at the 2nd and 4th subframe
+             (2 * M) to use instead of those of az[], or NULL
 
  Outputs:
     azQ = array of type Word16 -- quantization interpol. LP parameters Q12
@@ -326,6 +329,9 @@ OSCL_EXPORT_REF void lsp_exit(lspState **st)
 ------------------------------------------------------------------------------
  FUNCTION DESCRIPTION
 
+ With lsp_in given (see AMREncodeSetHints), its LSPs are quantized instead
+ of the roots of az[], and az[] of the 2nd (MR122 only) and 4th subframe
+ is rebuilt from them, so that no LP analysis is needed for the frame.
 
 ------------------------------------------------------------------------------
  REQUIREMENTS
@@ -354,6 +360,7 @@ OSCL_EXPORT_REF void lsp(lspState *st,       /* i/o : State struct            */
                          Word16 azQ[],       /* o   : quantization interpol. LP parameters Q12*/
                          Word16 lsp_new[],   /* o   : new lsp vector                          */
                          Word16 **anap,      /* o   : analysis parameters                     */
+                         Word16 lsp_in[],    /* i   : LSPs at the 2nd and 4th subframe, or NULL */
                          Flag   *pOverflow)  /* o   : Flag set when overflow occurs           */
 
 {
@@ -364,8 +371,18 @@ OSCL_EXPORT_REF void lsp(lspState *st,       /* i/o : State struct            */
 
     if (req_mode == MR122)
     {
-        Az_lsp(&az[MP1], lsp_mid, st->lsp_old, pOverflow);
-        Az_lsp(&az[MP1 * 3], lsp_new, lsp_mid, pOverflow);
+        if (lsp_in != NULL)
+        {
+            oscl_memcpy(lsp_mid, lsp_in, M*sizeof(Word16));
+            oscl_memcpy(lsp_new, &lsp_in[M], M*sizeof(Word16));
+            Lsp_Az(lsp_mid, &az[MP1], pOverflow);
+            Lsp_Az(lsp_new, &az[MP1 * 3], pOverflow);
+        }
+        else
+        {
+            Az_lsp(&az[MP1], lsp_mid, st->lsp_old, pOverflow);
+            Az_lsp(&az[MP1 * 3], lsp_new, lsp_mid, pOverflow);
+        }
 
         /*--------------------------------------------------------------------*
          * Find interpolated LPC parameters in all subframes (both quantized  *
@@ -395,7 +412,15 @@ OSCL_EXPORT_REF void lsp(lspState *st,       /* i/o : State struct            */
     }
     else
     {
-        Az_lsp(&az[MP1 * 3], lsp_new, st->lsp_old, pOverflow);  /* From A(z) to lsp  */
+        if (lsp_in != NULL)
+        {
+            oscl_memcpy(lsp_new, &lsp_in[M], M*sizeof(Word16));
+            Lsp_Az(lsp_new, &az[MP1 * 3], pOverflow);
+        }
+        else
+        {
+            Az_lsp(&az[MP1 * 3], lsp_new, st->lsp_old, pOverflow);  /* From A(z) to lsp  */
+        }
 
         /*--------------------------------------------------------------------*
          * Find interpolated LPC parameters in all subframes (both quantized  *
@@ -153,7 +153,8 @@ Word16 norm_s (Word16 var1)
 /*----------------------------------------------------------------------------
 ; FUNCTION CODE
 ----------------------------------------------------------------------------*/
-#if !((PV_CPU_ARCH_VERSION >=5) && ((PV_COMPILER == EPV_ARM_GNUC) || (PV_COMPILER == EPV_ARM_RVCT)))
+#if !((PV_CPU_ARCH_VERSION >=5) && ((PV_COMPILER == EPV_ARM_GNUC) || (PV_COMPILER == EPV_ARM_RVCT))) && \
+    !(defined(__aarch64__) && defined(__GNUC__) && !defined(AMRNB_C_REFERENCE))
 
 OSCL_EXPORT_REF Word16 norm_s(register Word16 var1)
 {
@@ -37,6 +37,8 @@ terms listed above has been obtained from the copyright holder.
 ----------------------------------------------------------------------------*/
 #include "pred_lt.h"
 #include "cnst.h"
+#include "basic_op_vec.h"
+#include "amrnb_cpu.h"
 
 /*----------------------------------------------------------------------------
 ; MACROS
@@ -88,7 +90,7 @@ const Word16 inter_6_pred_lt[FIR_SIZE] =
 
 /*
 ------------------------------------------------------------------------------
- FUNCTION NAME: Pred_lt_3or6
+ FUNCTION NAME: Pred_lt_3or6_c
 ------------------------------------------------------------------------------
  INPUT AND OUTPUT DEFINITIONS
 
@@ -193,7 +195,7 @@ void Pred_lt_3or6 (
 ------------------------------------------------------------------------------
 */
 
-OSCL_EXPORT_REF void Pred_lt_3or6(
+void Pred_lt_3or6_c(
     Word16 exc[],     /* in/out: excitation buffer                          */
     Word16 T0,        /* input : integer pitch lag                          */
     Word16 frac,      /* input : fraction of lag                            */
@@ -289,3 +291,183 @@ OSCL_EXPORT_REF void Pred_lt_3or6(
 
     return;
 }
+
+#if defined(AMRNB_SIMD_SSE2)
+/*
+------------------------------------------------------------------------------
+ FUNCTION NAME: Pred_lt_3or6_sse2
+------------------------------------------------------------------------------
+ INPUT AND OUTPUT DEFINITIONS
+
+ Same as Pred_lt_3or6_c.
+
+------------------------------------------------------------------------------
+ FUNCTION DESCRIPTION
+
+ The two ten-tap halves of the interpolation filter are laid out as one
+ twenty-tap filter over x[n-9..n+10] (x being the past excitation at the
+ delay), and eight outputs are computed at a time with multiply-adds on
+ the interleaved input {x[n+k], x[n+k+1]}. Because exc[] is both the input
+ and the output, a block of eight may only read samples written before the
+ block starts, which holds for T0 >= L_INTER10 + 8; shorter lags are left
+ to Pred_lt_3or6_c.
+
+------------------------------------------------------------------------------
+*/
+
+void Pred_lt_3or6_sse2(
+    Word16 exc[],     /* in/out: excitation buffer                          */
+    Word16 T0,        /* input : integer pitch lag                          */
+    Word16 frac,      /* input : fraction of lag                            */
+    Word16 L_subfr,   /* input : subframe size                              */
+    Word16 flag3,     /* input : if set, upsampling rate = 3 (6 otherwise)  */
+    Flag  *pOverflow  /* output: if set, overflow occurred in this function */
+)
+{
+    Word16 i;
+    Word16 k;
+    Word16 *pX0;
+    const Word16 *pC1_ref;
+    const Word16 *pC2_ref;
+    Word16 taps[L_INTER10 << 1];
+    __m128i coef[L_INTER10];
+    __m128i round = _mm_set1_epi32(0x00004000L);
+
+    if (T0 < L_INTER10 + 8)
+    {
+        Pred_lt_3or6_c(exc, T0, frac, L_subfr, flag3, pOverflow);
+        return;
+    }
+
+    pX0 = &(exc[-T0]);
+
+    frac = -frac;
+
+    if (flag3 != 0)
+    {
+        frac <<= 1;   /* inter_3l[k] = inter_6[2*k] -> k' = 2*k */
+    }
+
+    if (frac < 0)
+    {
+        frac += UP_SAMP_MAX;
+        pX0--;
+    }
+
+    pC1_ref = &inter_6_pred_lt[frac];
+    pC2_ref = &inter_6_pred_lt[UP_SAMP_MAX-frac];
+
+    /* taps[0..9] apply to x[n-9..n], taps[10..19] to x[n+1..n+10] */
+    for (k = 0; k < L_INTER10; k++)
+    {
+        taps[L_INTER10 - 1 - k] = pC1_ref[k * UP_SAMP_MAX];
+        taps[L_INTER10 + k]     = pC2_ref[k * UP_SAMP_MAX];
+    }
+    for (k = 0; k < L_INTER10; k++)
+    {
+        coef[k] = amrnb_pair_epi16(taps[2*k], taps[2*k + 1]);
+    }
+
+    pX0 += 1 - L_INTER10;
+
+    for (i = 0; i + 8 <= L_subfr; i += 8)
+    {
+        __m128i s_lo = round;
+        __m128i s_hi = round;
+
+        for (k = 0; k < L_INTER10; k++)
+        {
+            __m128i w0 = _mm_loadu_si128((__m128i *) &pX0[i + 2*k]);
+            __m128i w1 = _mm_loadu_si128((__m128i *) &pX0[i + 2*k + 1]);
+
+            s_lo = _mm_add_epi32(s_lo, _mm_madd_epi16(_mm_unpacklo_epi16(w0, w1), coef[k]));
+            s_hi = _mm_add_epi32(s_hi, _mm_madd_epi16(_mm_unpackhi_epi16(w0, w1), coef[k]));
+        }
+
+        _mm_storeu_si128((__m128i *) &exc[i],
+                         amrnb_pack_trunc_epi32(_mm_srai_epi32(s_lo, 15),
+                                                _mm_srai_epi32(s_hi, 15)));
+    }
+
+    for (; i < L_subfr; i++)
+    {
+        Word32 s = 0x00004000L;
+
+        for (k = 0; k < (L_INTER10 << 1); k++)
+        {
+            s = amrnb_fxp_mac_16_by_16bb((Word32) pX0[i + k], (Word32) taps[k], s);
+        }
+        exc[i] = (Word16)(s >> 15);
+    }
+
+    return;
+}
+#endif
+
+/* Implementation of Pred_lt_3or6 that pred_lt_cpu_select() selected */
+static void (*Pred_lt_3or6_impl)(Word16 exc[], Word16 T0, Word16 frac,
+                                 Word16 L_subfr, Word16 flag3,
+                                 Flag *pOverflow) = Pred_lt_3or6_c;
+
+/*
+------------------------------------------------------------------------------
+ FUNCTION NAME: Pred_lt_3or6
+------------------------------------------------------------------------------
+ INPUT AND OUTPUT DEFINITIONS
+
+ Same as Pred_lt_3or6_c.
+
+------------------------------------------------------------------------------
+ FUNCTION DESCRIPTION
+
+ Runs the implementation of Pred_lt_3or6 that pred_lt_cpu_select() selected
+ (see amrnb_cpu.h).
+
+------------------------------------------------------------------------------
+*/
+
+OSCL_EXPORT_REF void Pred_lt_3or6(
+    Word16 exc[],     /* in/out: excitation buffer                          */
+    Word16 T0,        /* input : integer pitch lag                          */
+    Word16 frac,      /* input : fraction of lag                            */
+    Word16 L_subfr,   /* input : subframe size                              */
+    Word16 flag3,     /* input : if set, upsampling rate = 3 (6 otherwise)  */
+    Flag  *pOverflow  /* output: if set, overflow occurred in this function */
+)
+{
+    Pred_lt_3or6_impl(exc, T0, frac, L_subfr, flag3, pOverflow);
+}
+
+/*
+------------------------------------------------------------------------------
+ FUNCTION NAME: pred_lt_cpu_select
+------------------------------------------------------------------------------
+ INPUT AND OUTPUT DEFINITIONS
+
+ Inputs:
+    features = AMRNB_CPU_* features the kernels may use (Word32)
+
+ Outputs:
+    Pred_lt_3or6_impl = the Pred_lt_3or6 implementation for features
+
+ Returns:
+    None
+
+------------------------------------------------------------------------------
+ FUNCTION DESCRIPTION
+
+ Part of the kernel table of the common library, run when the features in
+ use are set (see amrnb_cpu.h).
+
+------------------------------------------------------------------------------
+*/
+void pred_lt_cpu_select(Word32 features)
+{
+    Pred_lt_3or6_impl = Pred_lt_3or6_c;
+#if defined(AMRNB_SIMD_SSE2)
+    if (features & AMRNB_CPU_SSE2)
+    {
+        Pred_lt_3or6_impl = Pred_lt_3or6_sse2;
+    }
+#endif
+}
@@ -54,6 +54,8 @@ terms listed above has been obtained from the copyright holder.
 #include "reorder.h"
 #include "lsfwt.h"
 #include "oscl_mem.h"
+#include "basic_op_vec.h"
+#include "amrnb_cpu.h"
 
 /*--------------------------------------------------------------------------*/
 #ifdef __cplusplus
@@ -101,6 +103,12 @@ extern "C"
 
     extern const Word16 past_rq_init[];
 
+#if defined(AMRNB_SIMD_SSE2) || defined(AMRNB_SIMD_NEON)
+    extern const Word16 dico1_lsf_3_x8[];
+    extern const Word16 dico2_lsf_3_x8[];
+    extern const Word16 mr795_1_lsf_x8[];
+#endif
+
     /*--------------------------------------------------------------------------*/
 #ifdef __cplusplus
 }
@@ -108,7 +116,7 @@ extern "C"
 
 /*
 ------------------------------------------------------------------------------
- FUNCTION NAME: Vq_subvec4
+ FUNCTION NAME: Vq_subvec4_c
 ------------------------------------------------------------------------------
  INPUT AND OUTPUT DEFINITIONS
 
@@ -208,7 +216,7 @@ Vq_subvec4(             // o: quantization index,            Q0
 ------------------------------------------------------------------------------
 */
 
-static Word16 Vq_subvec4( /* o: quantization index,            Q0  */
+static Word16 Vq_subvec4_c( /* o: quantization index,          Q0  */
     Word16 * lsf_r1,      /* i: 1st LSF residual vector,       Q15 */
     const Word16 * dico,  /* i: quantization codebook,         Q15 */
     Word16 * wf1,         /* i: 1st LSF weighting factors,     Q13 */
@@ -287,6 +295,199 @@ static Word16 Vq_subvec4( /* o: quantization index,            Q0  */
 
 /****************************************************************************/
 
+#if defined(AMRNB_SIMD_SSE2)
+/*
+------------------------------------------------------------------------------
+ FUNCTION NAME: Vq_subvec4_sse2
+------------------------------------------------------------------------------
+ INPUT AND OUTPUT DEFINITIONS
+
+ Same as Vq_subvec4_c.
+
+------------------------------------------------------------------------------
+ FUNCTION DESCRIPTION
+
+ Two codebook entries fit in a vector, so the weighted errors of four
+ entries are formed from two loads and their distances summed pairwise.
+ Each lane keeps the first entry with the smallest distance, and the
+ lanes are merged at the end, giving the index of the sequential search.
+
+------------------------------------------------------------------------------
+*/
+
+static Word16 Vq_subvec4_sse2( /* o: quantization index,       Q0  */
+    Word16 * lsf_r1,      /* i: 1st LSF residual vector,       Q15 */
+    const Word16 * dico,  /* i: quantization codebook,         Q15 */
+    Word16 * wf1,         /* i: 1st LSF weighting factors,     Q13 */
+    Word16 dico_size,     /* i: size of quantization codebook, Q0  */
+    Flag  *pOverflow      /* o : Flag set when overflow occurs     */
+)
+{
+    Word16 i;
+    Word16 index;
+    const Word16 *p_dico;
+    __m128i lsf;
+    __m128i wf;
+    __m128i dist_min = _mm_set1_epi32(MAX_32);
+    __m128i index_min = _mm_setzero_si128();
+    __m128i entry = _mm_setr_epi32(0, 1, 2, 3);
+
+    if ((dico_size & 3) != 0)
+    {
+        return Vq_subvec4_c(lsf_r1, dico, wf1, dico_size, pOverflow);
+    }
+
+    lsf = _mm_loadl_epi64((__m128i *) lsf_r1);
+    lsf = _mm_unpacklo_epi64(lsf, lsf);
+    wf = _mm_loadl_epi64((__m128i *) wf1);
+    wf = _mm_unpacklo_epi64(wf, wf);
+
+    p_dico = dico;
+
+    for (i = 0; i < dico_size; i += 4)
+    {
+        __m128i t0 = _mm_sub_epi16(lsf, _mm_loadu_si128((__m128i *) p_dico));
+        __m128i t1 = _mm_sub_epi16(lsf, _mm_loadu_si128((__m128i *)(p_dico + 8)));
+
+        t0 = amrnb_mul_shr15_epi16(wf, t0);
+        t1 = amrnb_mul_shr15_epi16(wf, t1);
+
+        amrnb_min_index_epi32(&dist_min, &index_min,
+                              amrnb_hadd_pairs_epi32(_mm_madd_epi16(t0, t0),
+                                                     _mm_madd_epi16(t1, t1)),
+                              entry);
+
+        entry = _mm_add_epi32(entry, _mm_set1_epi32(4));
+        p_dico += 16;
+    }
+
+    index = amrnb_min_index_reduce(dist_min, index_min);
+
+    /* Reading the selected vector */
+
+    p_dico = dico + (index << 2);
+    *lsf_r1++ = *p_dico++;
+    *lsf_r1++ = *p_dico++;
+    *lsf_r1++ = *p_dico++;
+    *lsf_r1 = *p_dico;
+
+    return(index);
+}
+#endif
+
+#if defined(AMRNB_SIMD_NEON)
+/*
+------------------------------------------------------------------------------
+ FUNCTION NAME: Vq_subvec4_neon
+------------------------------------------------------------------------------
+ INPUT AND OUTPUT DEFINITIONS
+
+ Same as Vq_subvec4_c.
+
+------------------------------------------------------------------------------
+ FUNCTION DESCRIPTION
+
+ Two codebook entries fit in a vector, so the weighted errors of four
+ entries are formed from two loads and their distances summed pairwise.
+ Each lane keeps the first entry with the smallest distance, and the
+ lanes are merged at the end, giving the index of the sequential search.
+
+------------------------------------------------------------------------------
+*/
+
+static Word16 Vq_subvec4_neon( /* o: quantization index,       Q0  */
+    Word16 * lsf_r1,      /* i: 1st LSF residual vector,       Q15 */
+    const Word16 * dico,  /* i: quantization codebook,         Q15 */
+    Word16 * wf1,         /* i: 1st LSF weighting factors,     Q13 */
+    Word16 dico_size,     /* i: size of quantization codebook, Q0  */
+    Flag  *pOverflow      /* o : Flag set when overflow occurs     */
+)
+{
+    static const Word32 entry_init[4] = {0, 1, 2, 3};
+    Word16 i;
+    Word16 index;
+    const Word16 *p_dico;
+    int16x8_t lsf;
+    int16x8_t wf;
+    int32x4_t dist_min = vdupq_n_s32(MAX_32);
+    int32x4_t index_min = vdupq_n_s32(0);
+    int32x4_t entry = vld1q_s32(entry_init);
+
+    if ((dico_size & 3) != 0)
+    {
+        return Vq_subvec4_c(lsf_r1, dico, wf1, dico_size, pOverflow);
+    }
+
+    lsf = vcombine_s16(vld1_s16(lsf_r1), vld1_s16(lsf_r1));
+    wf = vcombine_s16(vld1_s16(wf1), vld1_s16(wf1));
+
+    p_dico = dico;
+
+    for (i = 0; i < dico_size; i += 4)
+    {
+        int16x8_t t0 = amrnb_mul_shr15_s16(wf, vsubq_s16(lsf, vld1q_s16(p_dico)));
+        int16x8_t t1 = amrnb_mul_shr15_s16(wf, vsubq_s16(lsf, vld1q_s16(p_dico + 8)));
+
+        amrnb_min_index_s32(&dist_min, &index_min,
+                            vpaddq_s32(vpaddq_s32(vmull_s16(vget_low_s16(t0), vget_low_s16(t0)),
+                                                  vmull_high_s16(t0, t0)),
+                                       vpaddq_s32(vmull_s16(vget_low_s16(t1), vget_low_s16(t1)),
+                                                  vmull_high_s16(t1, t1))),
+                            entry);
+
+        entry = vaddq_s32(entry, vdupq_n_s32(4));
+        p_dico += 16;
+    }
+
+    index = amrnb_min_index_reduce_s32(dist_min, index_min);
+
+    /* Reading the selected vector */
+
+    p_dico = dico + (index << 2);
+    *lsf_r1++ = *p_dico++;
+    *lsf_r1++ = *p_dico++;
+    *lsf_r1++ = *p_dico++;
+    *lsf_r1 = *p_dico;
+
+    return(index);
+}
+#endif
+
+/* Implementation of Vq_subvec4 that q_plsf_3_cpu_select() selected */
+static Word16 (*Vq_subvec4_impl)(Word16 *lsf_r1, const Word16 *dico,
+                                 Word16 *wf1, Word16 dico_size,
+                                 Flag *pOverflow) = Vq_subvec4_c;
+
+/*
+------------------------------------------------------------------------------
+ FUNCTION NAME: Vq_subvec4
+------------------------------------------------------------------------------
+ INPUT AND OUTPUT DEFINITIONS
+
+ Same as Vq_subvec4_c.
+
+------------------------------------------------------------------------------
+ FUNCTION DESCRIPTION
+
+ Runs the implementation of Vq_subvec4 that q_plsf_3_cpu_select() selected
+ (see amrnb_cpu.h).
+
+------------------------------------------------------------------------------
+*/
+
+static Word16 Vq_subvec4( /* o: quantization index,            Q0  */
+    Word16 * lsf_r1,      /* i: 1st LSF residual vector,       Q15 */
+    const Word16 * dico,  /* i: quantization codebook,         Q15 */
+    Word16 * wf1,         /* i: 1st LSF weighting factors,     Q13 */
+    Word16 dico_size,     /* i: size of quantization codebook, Q0  */
+    Flag  *pOverflow      /* o : Flag set when overflow occurs     */
+)
+{
+    return Vq_subvec4_impl(lsf_r1, dico, wf1, dico_size, pOverflow);
+}
+
+/****************************************************************************/
+
 
 /*
 ------------------------------------------------------------------------------
@@ -380,7 +581,7 @@ Word16 Test_Vq_subvec4(
 
 /*
 ------------------------------------------------------------------------------
- FUNCTION NAME: Vq_subvec3
+ FUNCTION NAME: Vq_subvec3_c
 ------------------------------------------------------------------------------
  INPUT AND OUTPUT DEFINITIONS
 
@@ -502,7 +703,7 @@ Vq_subvec3(             // o: quantization index,            Q0
 ------------------------------------------------------------------------------
 */
 
-static Word16 Vq_subvec3( /* o: quantization index,            Q0  */
+static Word16 Vq_subvec3_c( /* o: quantization index,          Q0  */
     Word16 * lsf_r1,      /* i: 1st LSF residual vector,       Q15 */
     const Word16 * dico,  /* i: quantization codebook,         Q15 */
     Word16 * wf1,         /* i: 1st LSF weighting factors,     Q13 */
@@ -587,6 +788,295 @@ static Word16 Vq_subvec3( /* o: quantization index,            Q0  */
 
 /****************************************************************************/
 
+#if defined(AMRNB_SIMD_SSE2)
+/*
+------------------------------------------------------------------------------
+ FUNCTION NAME: Vq_subvec3_sse2
+------------------------------------------------------------------------------
+ INPUT AND OUTPUT DEFINITIONS
+
+ Same as Vq_subvec3_c.
+
+------------------------------------------------------------------------------
+ FUNCTION DESCRIPTION
+
+ Searches the copy of the codebook grouped by eight entries (*_x8), so
+ that each coefficient of eight entries is a single load and the eight
+ distances come out of two multiply-adds per half. With use_half the odd
+ entries are given the distance MAX_32, which never replaces a minimum.
+ Each lane keeps the first entry with the smallest distance and the lanes
+ are merged at the end, giving the index of the sequential search.
+ Codebooks without a grouped copy are left to Vq_subvec3_c.
+
+------------------------------------------------------------------------------
+*/
+
+static Word16 Vq_subvec3_sse2( /* o: quantization index,       Q0  */
+    Word16 * lsf_r1,      /* i: 1st LSF residual vector,       Q15 */
+    const Word16 * dico,  /* i: quantization codebook,         Q15 */
+    Word16 * wf1,         /* i: 1st LSF weighting factors,     Q13 */
+    Word16 dico_size,     /* i: size of quantization codebook, Q0  */
+    Flag use_half,        /* i: use every second entry in codebook */
+    Flag  *pOverflow)     /* o : Flag set when overflow occurs     */
+{
+    Word16 i;
+    Word16 n;
+    Word16 index;
+    const Word16 *p_dico;
+    const Word16 *dico_x8;
+    __m128i lsf_0 = _mm_set1_epi16(lsf_r1[0]);
+    __m128i lsf_1 = _mm_set1_epi16(lsf_r1[1]);
+    __m128i lsf_2 = _mm_set1_epi16(lsf_r1[2]);
+    __m128i wf_0 = _mm_set1_epi16(wf1[0]);
+    __m128i wf_1 = _mm_set1_epi16(wf1[1]);
+    __m128i wf_2 = _mm_set1_epi16(wf1[2]);
+    __m128i zero = _mm_setzero_si128();
+    __m128i odd = _mm_setzero_si128();
+    __m128i odd_dist;
+    __m128i dist_min = _mm_set1_epi32(MAX_32);
+    __m128i index_min = _mm_setzero_si128();
+    __m128i entry = _mm_setr_epi32(0, 1, 2, 3);
+
+    if (dico == dico1_lsf_3)
+    {
+        dico_x8 = dico1_lsf_3_x8;
+    }
+    else if (dico == dico2_lsf_3)
+    {
+        dico_x8 = dico2_lsf_3_x8;
+    }
+    else if (dico == mr795_1_lsf)
+    {
+        dico_x8 = mr795_1_lsf_x8;
+    }
+    else
+    {
+        dico_x8 = NULL;
+    }
+
+    if (dico_x8 == NULL || (dico_size & 7) != 0)
+    {
+        return Vq_subvec3_c(lsf_r1, dico, wf1, dico_size, use_half, pOverflow);
+    }
+
+    n = dico_size;
+    if (use_half != 0)
+    {
+        n <<= 1;
+        odd = _mm_setr_epi32(0, -1, 0, -1);
+    }
+    odd_dist = _mm_and_si128(odd, _mm_set1_epi32(MAX_32));
+
+    p_dico = dico_x8;
+
+    for (i = 0; i < n; i += 8)
+    {
+        __m128i t0 = amrnb_mul_shr15_epi16(wf_0, _mm_sub_epi16(lsf_0, _mm_loadu_si128((__m128i *) p_dico)));
+        __m128i t1 = amrnb_mul_shr15_epi16(wf_1, _mm_sub_epi16(lsf_1, _mm_loadu_si128((__m128i *)(p_dico + 8))));
+        __m128i t2 = amrnb_mul_shr15_epi16(wf_2, _mm_sub_epi16(lsf_2, _mm_loadu_si128((__m128i *)(p_dico + 16))));
+        __m128i t01;
+        __m128i t2z;
+        __m128i dist;
+
+        t01 = _mm_unpacklo_epi16(t0, t1);
+        t2z = _mm_unpacklo_epi16(t2, zero);
+        dist = _mm_add_epi32(_mm_madd_epi16(t01, t01), _mm_madd_epi16(t2z, t2z));
+        dist = _mm_or_si128(_mm_andnot_si128(odd, dist), odd_dist);
+        amrnb_min_index_epi32(&dist_min, &index_min, dist, entry);
+
+        t01 = _mm_unpackhi_epi16(t0, t1);
+        t2z = _mm_unpackhi_epi16(t2, zero);
+        dist = _mm_add_epi32(_mm_madd_epi16(t01, t01), _mm_madd_epi16(t2z, t2z));
+        dist = _mm_or_si128(_mm_andnot_si128(odd, dist), odd_dist);
+        amrnb_min_index_epi32(&dist_min, &index_min, dist, _mm_add_epi32(entry, _mm_set1_epi32(4)));
+
+        entry = _mm_add_epi32(entry, _mm_set1_epi32(8));
+        p_dico += 24;
+    }
+
+    index = amrnb_min_index_reduce(dist_min, index_min);
+
+    if (use_half != 0)
+    {
+        index >>= 1;
+    }
+
+    p_dico = dico + (3 * index);
+
+    if (use_half != 0)
+    {
+        p_dico += (3 * index);
+    }
+
+    /* Reading the selected vector */
+    *lsf_r1++ = *p_dico++;
+    *lsf_r1++ = *p_dico++;
+    *lsf_r1 = *p_dico;
+
+    return(index);
+}
+#endif
+
+#if defined(AMRNB_SIMD_NEON)
+/*
+------------------------------------------------------------------------------
+ FUNCTION NAME: Vq_subvec3_neon
+------------------------------------------------------------------------------
+ INPUT AND OUTPUT DEFINITIONS
+
+ Same as Vq_subvec3_c.
+
+------------------------------------------------------------------------------
+ FUNCTION DESCRIPTION
+
+ Searches the copy of the codebook grouped by eight entries (*_x8), as
+ Vq_subvec3_sse2 does: each coefficient of eight entries is a single load,
+ and the distances of four entries are one widening multiply and two
+ multiply-accumulates. With use_half the odd entries are given the distance
+ MAX_32, which never replaces a minimum. Codebooks without a grouped copy
+ are left to Vq_subvec3_c.
+
+------------------------------------------------------------------------------
+*/
+
+static Word16 Vq_subvec3_neon( /* o: quantization index,       Q0  */
+    Word16 * lsf_r1,      /* i: 1st LSF residual vector,       Q15 */
+    const Word16 * dico,  /* i: quantization codebook,         Q15 */
+    Word16 * wf1,         /* i: 1st LSF weighting factors,     Q13 */
+    Word16 dico_size,     /* i: size of quantization codebook, Q0  */
+    Flag use_half,        /* i: use every second entry in codebook */
+    Flag  *pOverflow)     /* o : Flag set when overflow occurs     */
+{
+    static const Word32 entry_init[4] = {0, 1, 2, 3};
+    static const Word32 odd_lanes[4] = {0, -1, 0, -1};
+    Word16 i;
+    Word16 n;
+    Word16 index;
+    const Word16 *p_dico;
+    const Word16 *dico_x8;
+    int16x8_t lsf_0 = vdupq_n_s16(lsf_r1[0]);
+    int16x8_t lsf_1 = vdupq_n_s16(lsf_r1[1]);
+    int16x8_t lsf_2 = vdupq_n_s16(lsf_r1[2]);
+    int16x8_t wf_0 = vdupq_n_s16(wf1[0]);
+    int16x8_t wf_1 = vdupq_n_s16(wf1[1]);
+    int16x8_t wf_2 = vdupq_n_s16(wf1[2]);
+    uint32x4_t odd = vdupq_n_u32(0);
+    int32x4_t max_dist = vdupq_n_s32(MAX_32);
+    int32x4_t dist_min = vdupq_n_s32(MAX_32);
+    int32x4_t index_min = vdupq_n_s32(0);
+    int32x4_t entry = vld1q_s32(entry_init);
+
+    if (dico == dico1_lsf_3)
+    {
+        dico_x8 = dico1_lsf_3_x8;
+    }
+    else if (dico == dico2_lsf_3)
+    {
+        dico_x8 = dico2_lsf_3_x8;
+    }
+    else if (dico == mr795_1_lsf)
+    {
+        dico_x8 = mr795_1_lsf_x8;
+    }
+    else
+    {
+        dico_x8 = NULL;
+    }
+
+    if (dico_x8 == NULL || (dico_size & 7) != 0)
+    {
+        return Vq_subvec3_c(lsf_r1, dico, wf1, dico_size, use_half, pOverflow);
+    }
+
+    n = dico_size;
+    if (use_half != 0)
+    {
+        n <<= 1;
+        odd = vreinterpretq_u32_s32(vld1q_s32(odd_lanes));
+    }
+
+    p_dico = dico_x8;
+
+    for (i = 0; i < n; i += 8)
+    {
+        int16x8_t t0 = amrnb_mul_shr15_s16(wf_0, vsubq_s16(lsf_0, vld1q_s16(p_dico)));
+        int16x8_t t1 = amrnb_mul_shr15_s16(wf_1, vsubq_s16(lsf_1, vld1q_s16(p_dico + 8)));
+        int16x8_t t2 = amrnb_mul_shr15_s16(wf_2, vsubq_s16(lsf_2, vld1q_s16(p_dico + 16)));
+        int32x4_t dist;
+
+        dist = vmull_s16(vget_low_s16(t0), vget_low_s16(t0));
+        dist = vmlal_s16(dist, vget_low_s16(t1), vget_low_s16(t1));
+        dist = vmlal_s16(dist, vget_low_s16(t2), vget_low_s16(t2));
+        amrnb_min_index_s32(&dist_min, &index_min, vbslq_s32(odd, max_dist, dist), entry);
+
+        dist = vmull_high_s16(t0, t0);
+        dist = vmlal_high_s16(dist, t1, t1);
+        dist = vmlal_high_s16(dist, t2, t2);
+        amrnb_min_index_s32(&dist_min, &index_min, vbslq_s32(odd, max_dist, dist),
+                            vaddq_s32(entry, vdupq_n_s32(4)));
+
+        entry = vaddq_s32(entry, vdupq_n_s32(8));
+        p_dico += 24;
+    }
+
+    index = amrnb_min_index_reduce_s32(dist_min, index_min);
+
+    if (use_half != 0)
+    {
+        index >>= 1;
+    }
+
+    p_dico = dico + (3 * index);
+
+    if (use_half != 0)
+    {
+        p_dico += (3 * index);
+    }
+
+    /* Reading the selected vector */
+    *lsf_r1++ = *p_dico++;
+    *lsf_r1++ = *p_dico++;
+    *lsf_r1 = *p_dico;
+
+    return(index);
+}
+#endif
+
+/* Implementation of Vq_subvec3 that q_plsf_3_cpu_select() selected */
+static Word16 (*Vq_subvec3_impl)(Word16 *lsf_r1, const Word16 *dico,
+                                 Word16 *wf1, Word16 dico_size, Flag use_half,
+                                 Flag *pOverflow) = Vq_subvec3_c;
+
+/*
+------------------------------------------------------------------------------
+ FUNCTION NAME: Vq_subvec3
+------------------------------------------------------------------------------
+ INPUT AND OUTPUT DEFINITIONS
+
+ Same as Vq_subvec3_c.
+
+------------------------------------------------------------------------------
+ FUNCTION DESCRIPTION
+
+ Runs the implementation of Vq_subvec3 that q_plsf_3_cpu_select() selected
+ (see amrnb_cpu.h).
+
+------------------------------------------------------------------------------
+*/
+
+static Word16 Vq_subvec3( /* o: quantization index,            Q0  */
+    Word16 * lsf_r1,      /* i: 1st LSF residual vector,       Q15 */
+    const Word16 * dico,  /* i: quantization codebook,         Q15 */
+    Word16 * wf1,         /* i: 1st LSF weighting factors,     Q13 */
+    Word16 dico_size,     /* i: size of quantization codebook, Q0  */
+    Flag use_half,        /* i: use every second entry in codebook */
+    Flag  *pOverflow)     /* o : Flag set when overflow occurs     */
+{
+    return Vq_subvec3_impl(lsf_r1, dico, wf1, dico_size, use_half, pOverflow);
+}
+
+/****************************************************************************/
+
 
 /*
 ------------------------------------------------------------------------------
@@ -1095,3 +1585,47 @@ OSCL_EXPORT_REF void Q_plsf_3(
     return;
 
 }
+
+/*
+------------------------------------------------------------------------------
+ FUNCTION NAME: q_plsf_3_cpu_select
+------------------------------------------------------------------------------
+ INPUT AND OUTPUT DEFINITIONS
+
+ Inputs:
+    features = AMRNB_CPU_* features the kernels may use (Word32)
+
+ Outputs:
+    Vq_subvec4_impl = the Vq_subvec4 implementation for features
+    Vq_subvec3_impl = the Vq_subvec3 implementation for features
+
+ Returns:
+    None
+
+------------------------------------------------------------------------------
+ FUNCTION DESCRIPTION
+
+ Part of the kernel table of the common library, run when the features in
+ use are set (see amrnb_cpu.h).
+
+------------------------------------------------------------------------------
+*/
+void q_plsf_3_cpu_select(Word32 features)
+{
+    Vq_subvec4_impl = Vq_subvec4_c;
+    Vq_subvec3_impl = Vq_subvec3_c;
+#if defined(AMRNB_SIMD_NEON)
+    if (features & AMRNB_CPU_NEON)
+    {
+        Vq_subvec4_impl = Vq_subvec4_neon;
+        Vq_subvec3_impl = Vq_subvec3_neon;
+    }
+#endif
+#if defined(AMRNB_SIMD_SSE2)
+    if (features & AMRNB_CPU_SSE2)
+    {
+        Vq_subvec4_impl = Vq_subvec4_sse2;
+        Vq_subvec3_impl = Vq_subvec3_sse2;
+    }
+#endif
+}
@@ -2080,4 +2080,500 @@ const Word16 mr795_1_lsf[MR795_1_SIZE*3] =
 };
 
 
+#if defined(AMRNB_SIMD_SSE2) || defined(AMRNB_SIMD_NEON)
+/* The three-dimensional codebooks above, regrouped for the vector searches
+ * of Vq_subvec3: every run of eight entries is stored as their eight first,
+ * eight second and eight third coefficients. */
 
+const Word16 dico1_lsf_3_x8[DICO1_SIZE*3] =
+{
+        6,   154,   183,     9,   113,  1010,   857,   827,
+       82,   -56,   -65,  -210,   718,  1214,  1333,  1568,
+     -131,  -735,  -265,  -361,  1817,  1573,  2276,  1933,
+      717,   838,   721,   286,  -247,   147,    26,   -27,
+     1989,  1172,  1000,   476,  -531,   -82,  -177,  -273,
+     2206,  1823,  2154,  1509,   230,   569,  -944,   692,
+     -164,   224,   899,   485,   524,  -140,   410,   301,
+     -264,   790,   946,   771,   677,   375,   676,   530,
+     -183,  1039,   601,  1150,   903,   778,   429,  1009,
+      719,   226,   145,   290,   302,  -124,  -358,   715,
+      646,   367,   -45,   121,   127,  -383,  -455,   878,
+       38,    40,  -505,  -121,   166,  -956,  -977,   894,
+      978,   477,   188,  -143,   643,  -134,   347,  1188,
+      923,   272,   -78,   -65,   586,  -426,   545,  2726,
+      211,    64,    17,    38,   621,  -651,  2820,  2442,
+      142,   283,  -262,  -411,   329,    53,  -129,   285,
+      -80,   130,  -399,   155,   375,  -226,  -236,   744,
+     1735,   461, -1145,   430,   779,  -139,  1682,  1327,
+      738,   312,   325,     1,     8,   299,    29,   103,
+      697,   409,   720,   221,   203,   640,   468,   429,
+     1664,   266,   135,   453,   145,   760,   638,   379,
+      420,  1326,   704,  -166,  -316,   191,  -240,  -112,
+      954,  1210,  1012,  -444,  -130,  1151,  -543,   268,
+      932,  1258,  1152,  -266,  -376,  1904, -1260,  1207,
+       70,   278,  -258,    19,    -3,  -295,   140,  -260,
+     1062,  1360,  -272,   563,  -265,  -591,   354,  -504,
+     1583,  1574,  -768,  2240,   135,  -388,  -206,  -795,
+     -433,   109,  -429,  -296,  -239,   489,  -334,   543,
+     -718,   331,   -87,   426,   775,  1334,  -332,  1206,
+    -1319,   962,   652,  1019,   851,  1073,    25,  1807,
+      326,   578,  -208,  -152,  -434,  -454,   605,  -482,
+       61,   849,  -277,    64,  -678,   -71,   480,    11,
+      727,  1405,   329,   669,  -727,   251,   254,   996,
+     -289,   722,   -30,  -106,   861,  1055,   812,    42,
+      395,  1049,  -316,  -115,  1474,  1366,  1237,  -251,
+      486,  1440,  -786,  -619,  1412,  1184,   925,  -576,
+      342,  -168,  -342,   100,   990,   332,   663,   112,
+      141,   -80,  -656,   821,   747,   440,   379,   165,
+     -454,  1359, -1763,   725,   800,   568,   852,  -369,
+      597,    -8,  -352,   462,   345,   416,   168,  -516,
+      910,   834,   572,  2246,   190,   915,   -82,  -446,
+      282,  1281,   695,  1806,  1374,  2166,   280,   840,
+       47,  -362,    22,   -85,   -62,   550,   723,   972,
+      533,  -711,   193,   233,   579,   944,   650,   884,
+       44, -1143,  1472,  1813,  1504,  1749,  1148,  1395,
+     -425,  1000,   249,  -334,  -554,   140,   920,  1076,
+      643,   952,  1446,   -87,  1882,  1826,  1749,  1933,
+        0,  1098,   672,  2172,  2672,  1853,  2590,  2038,
+     -137,  1269,  -493,  -451,   482,   815,  -446,  -319,
+     -443,  1174,  -122,  1033,  1695,   649,  -692,  -605,
+    -1555,   468,  1521,  1214,  1118,   384,   107,  -118,
+     -207,  -468,    75,   880,  1285,   -48,  -435,  -366,
+     -505,   -12,  1934,  2358,  1575,  -304,  -461,  -404,
+      525,  2736,  1305,  2267,  2004, -1186,  -251,  -547,
+     -289,  -538,  -120,   639,    96,  -435,  -356,  -485,
+     -605,  -810,     3,  1241,   177,  -585,   109,   288,
+     -597,  -165,   356,  1502,   750, -1174,   -79,  2005,
+        9,   880,  -265,  1157,  -498,   374,  1440,   449,
+     1116,  2134,  1585,  1210,  -668,   321,  2101,   461,
+      731,   946,  1065,   843,   431,  -229,  1381,  1155,
+     -105,  -263,  -371,  -188,  1333,   774,  -482,  -237,
+       39,   367,  -660,  1151,  1632,  1267,  -832,  -210,
+     -384,   182,   773,   971,  1435,  1221, -1489,   860,
+      890,   472,   185,  -568,  -449,  -142,  -210,   -11,
+     1615,  1062,  1077,  -992,  -902,  -377,  -554,  1133,
+     1064,  1192,   989, -1704, -2043,  -458, -1029,  2265,
+     -329,  -250,   519,   520,   527,  -563,  -147,   -76,
+     -675,   657,  1510,   539,  1421,  -871,  -463,  2334,
+     -893,  1187,  1779,  1403,  1302, -1248,   879,  2840,
+      563,   632,   719,  -545,   129,  1417,   -94,  -341,
+     2573,  1926,  2023,  -723,  -125,  1632,  1566,  1533,
+     2385,  2920,  1840,  1108,   884,   925,  1751,  1551,
+      591,   -76,   153,  1032,  1508,   791,  -190,  -278,
+      395,   981,  2985,  2565,  2832,  1199,  -453,  -548,
+     -274,  2831,  1844,  2749,  1879,   538,  1489,  1158,
+     -245,  1024,   512,   -62,  -473,  -433,   899,   134,
+     1941,  1560,   253,  -323,  -376,  1380,  1943,   704,
+     2044,  1650,   466,  1151,   507,  2162,  1445,   440,
+      460,  -450,     0,  -445,  -348,   398,  -107,    93,
+      525,   279,   971,  -627,  -602,   712,   314,  2226,
+      -28,  1338,   252,  -991, -1424,  1656,  -178,  2238,
+      518,  -462,   174,  -119,  -372,  1036,   675,   430,
+      849,  -711,   -34,    42,   274,  2352,  1724,  1286,
+      656,  -447,  1191,  1005,   758,  1838,  1498,  2133,
+     -129,  -373,     6,   478,  -428,   385,   139,  -526,
+     -439,   800,  1587,   596,  -736,   178,   449,  -842,
+        0,  2144,  2478,  2128,  1505,   980,  1225,  -982,
+      145,   623,   349,    31,  -316,   360,  -436,  -355,
+     1554,  1448,  1016,  -280,   724,  1058,  -358,  1123,
+     1242,   656,  1482,   415,  1641,   556,  1201,  1939,
+      401,  -527,   233,  -550,  -365,   389,   162,  -237,
+     1584, -1012,   238,  -897,  -501,  1860,  1132,  1174,
+     2248,   355,  2233,  -639,  1957,  1621,  1264,  1390,
+     -640,  -228,  1639,   562,   323,   578,    22,  -143,
+     -411,  1694,  2186,  1273,   338,  1107,   594,   718,
+      116,  2298,  2267,  2658,  1774,   852,   934,   446
+};
+
+const Word16 dico2_lsf_3_x8[DICO2_SIZE*3] =
+{
+       50,  -338,   102,  -310,   414,  1060,  1548,  1754,
+       71,  -698,  -138,  -469,    67,   814,  1360,  1895,
+       -9, -1407,  -820, -1147,  -267,  1441,  1272,  1661,
+     2019,  1808,   644,   858,   489,  -198,   -52,   346,
+     2133,  2318,   -93,   329,  -258,  -745,  -265,   137,
+     1820,  1845,   454,  -136,  -128,   -41,  -985,   479,
+    -1741, -1163,  -895,  -488,   -85,   215,  1020,   564,
+     -748, -1725, -1145,  -946,  -390,  -340,   916,   179,
+     -684,  -367,  -784,  -968,  -725,  -171,  1969,   746,
+      662,   887,   939,   309,   917,   118,  -816, -1228,
+      977,   622,   856,   688,   161,   -20,   -42,  -325,
+     1734,   914,  1165,   803,   570,  -283,   204,  -462,
+     -963,  -988,  -702,  -302,  -100, -1054,  -202, -1039,
+     -202,  -484,  -978,  -790,  -786,  -947,  -843, -1378,
+     -143,  -361,  -477, -1188, -1088, -1684,  -782,  -901,
+     -624,   356,  -493,   425,   -83,  -992,  -603,  -502,
+     -110,   213,   364,   822,   557, -1560,  -741,  -638,
+      -85,   -10,   774,   479,   520,  -572,   -26,  -903,
+      209,  -316,   -85,  -918,   233,  1101,  1457,  1765,
+      306,  -593,  -211,  -529,  -439,   751,  1716,  1457,
+      147,  -596,  -225,   117,  -738,   633,  1511,   910,
+     1122,  1354,  -871,  -871,  -118, -1051, -1117, -1019,
+     1156,   868, -1150,  -861,   155,  -849, -1849, -1427,
+      849,   470, -1796,  -992,   212,  -606, -2750, -1869,
+      370,   959,   958,   154,  1249,   663,   623,   659,
+     -184,   493,  1039,   653,   507,   503,   777,    88,
+     -414,   104,   543,   201,   150,   230,   675,  -110,
+      843,   382,   724,  1166,  -138, -1183,  -321,  1333,
+      244,   541,   433,   734,    20,  -424,  -352,  1021,
+      224,   302,   666,   341,  -397,   -46,  -124,  1080,
+      262,   922,    31,  -689,  -952, -1329,  -953,   493,
+      366,   283,  -636,  -697,  -779,  -598, -1285,   305,
+      723,  -551,  -611,  -415,  -201,  -359,   166,   221,
+      846,   840,  -723,  -357, -1096, -1416, -1798,  -545,
+      703,   936, -1324, -1025, -1376, -1881, -1727, -1173,
+      610,   774, -1261, -1388,  -365,  -608,  -674,  -703,
+      678,  -123,   644,   414,   137,  -814,  -391,    47,
+      786,   696,   350,   614,   344, -1512,  -930,  -591,
+      148,  1288,   -10,    15,  -211,  -819,  -588,  -898,
+     -909, -1272, -1464, -1274,   671,   124,  -729, -1344,
+    -1097, -1167, -1525, -1188,   213,  -274,  -496,   122,
+     -163,  -157,  -389,  -624,   454,  -525,  -152,   135,
+    -2905, -1728,  1476,   316,  -347,  -911,  -455,   -92,
+     -589,   441,   904,   236,   217,  -917,  -932,  -465,
+     -394,   -50,   787,  -440,   413,   121,   202,  -375,
+      488,   876, -1815,    87,   563,   250,  1141, -1038,
+      390,   729, -1312,   962,  -249,   285,   427, -1664,
+      474,   316,  -669,   432, -1058,  1105,   696, -1582,
+     -948,  -309,   670,  -944,  -606,  -492,   334,   -16,
+      346,  -272,   624,  -408,  -320,   230,   -50,  -690,
+      160,  -858,  1250,  -666,  -384,    65,   -16, -1397,
+     1791,  2478,  1245,  -382,   173,  1491,   772,  1429,
+     1716,  2063,  1471, -1037,  -398,  2024,  1274,  1735,
+     1399,  1404,  1426,    -2,  1145,  1801,  1506,  2001,
+     1079, -1154,  -808,  -451,    65, -1476,  -765,  -218,
+     1218, -1851, -1133, -1033,   578, -2434, -1366,  -594,
+     1273, -1329, -1096, -1722,   -84, -1778,  -494,  -931,
+      337,  2357,  1489,   189, -1519,  -967,  -628,  1661,
+     -236,  2662,  1276,   358, -2281, -1271, -1188,  1043,
+      562,  1938,   874,   374, -2346, -2095, -1542,   546,
+      565,   -64,  -436,  1078,   907,   326,   142,   470,
+     1061,  -836,   -96,  1216,  1534,   965,   -84,  2379,
+      732,  -434,   203,  1636,   986,   845,   197,  1570,
+     1133,   395,  1125,  -543,  -215, -1947,  -750,    29,
+      470,  1376,  1042, -1234,  -181, -1621, -1185,  -399,
+     1214,  1200,   348,  -376,   481,  -210,   390,    27,
+      820,   695,  -174,   912,  -992, -1485,  -412,  -271,
+     1236,   979,  1197,  1356, -1437, -1700,  1204,   896,
+      755,   409,  1035,  1846,   484,   208,  1432,  1144,
+     -416, -1696, -1789, -1656, -1253,  -669,  -682,   659,
+     1777, -2644, -1551, -1559, -1589, -1095,   320,   305,
+     1434,  -204,  1033,  1303,  1081,   -66,  -345,  1069,
+    -1292, -1635, -1683,  -287,  -494,   852, -1217,  -660,
+     -804, -1291,  -497,    -7,  -962,  1881, -1387,   302,
+      -19,    29,    71,  -100,  -237,  1740,   227,   373,
+       96, -1074,   485,  -934,  -596,   336,   643,  1267,
+     1087, -1669,  2076,  -220,  -612,  1720,   629,   522,
+     1257,   160,  1798,   552,   237,   879,   434,  1633,
+       15,  1475,  1819,   988,  2093,  2139,  -577,  -956,
+      244,   717,  1590,   261,  2345,  1858,  -579,   135,
+     -441,   184,  1709,   937,  1520,  1606, -1203,  -488,
+     -464,  -629,  1146,  2192, -1444,  1400,  1335,  1434,
+       51,  -348,  2073,  1466, -1572,   710,   633,  2194,
+     -338,  -723,  1442,   911, -2278,  1297,   928,  2594,
+     2422,   982,   380,   -63,  -252, -1261,  -831, -1666,
+     2204,  2242,   792,  -539,  -964,  -683,  -526, -1135,
+     1881,  1854,  1145,   414,  -314,  -780, -1005,  -424,
+    -1611,  1268,  1147,  -675,  2268,    29, -1224, -1318,
+     -452,  1048,   853,  -336,  1343,   768,   423, -1082,
+     -299,   642,   856,   139,  1418,   797,   564,   245,
+    -1302, -1298,  -968,   993,  -191,   662,   626,  1648,
+     -812, -1617,   834,  1652,  -817,    60,   997,  1963,
+      573,   646,   723,  2027,   432,   198,  1330,  1289,
+    -1597, -1088,  1653,  1065,  1139,   859,   664,   479,
+      -93,    37,  2607,  2040,  2326,   357,  1227,  1360,
+      -45,   -84,  2337,  2377,  2118,  1510,  1099,   912,
+     1897,  1168,   399,  -593,   547,   647,  1492,    38,
+     1754,  1909,    34,  -304,  1694,   -99,  1647,  -644,
+     2019,  1784,   256, -1053,  1407,  -341,  1190,  -212,
+      395,  -704,  -724,  -150,  1233,  -140,   439, -1529,
+      846,  -765, -1964,   291,  1459,  -155,   297,  -410,
+      222,  -716, -2804,   -82,  1007,   153,  1568,  -636,
+     1536, -1328,   531,   269,  -233,   742,   -73,  -439,
+      455,  -139,   554,  1264,   883,   600,   421,   -58,
+     -237,  -260,   868,   606,   463,  -120,   212,   804,
+    -1286,   294,  -591,    42,   -25,  -311,  -754,   429,
+    -1241,  -490,  -905,  -687,   273,  1213,   849,   607,
+      728,    50, -1254,   147,   596,   601,   584,   587,
+     -602,  -796,  1380,   119,  -219, -1049,  -713,     0,
+     -166,  -823,   910,  1417,  -880, -1010, -1379,  -447,
+      461,   777,  1755,   972, -1596,   438,    78, -1179,
+    -1136,  2248,   946,  1150,  -469,  -447, -1252, -1104,
+    -1319,  1767,  1583,   482, -1108,  -966, -1515, -2008,
+    -1573,  1309,  1432,   436,   618,  1088,  -114,  -579,
+      210, -1975, -1269, -1646, -1555, -1692,  -979,   539,
+      613, -1437,  -856, -1185,  -672, -1114, -1326,  -147,
+      497,   642,  1011,  1063,  1204,   623, -1277,   894,
+    -1354,   888,   153, -1492,  -974,   105,  -937,   380,
+     -897,   475,  -384,  -511, -1115,  -550, -1145,  -260,
+     -434,   428,   338,   359,  -470,   677,   877,   210,
+     1685,  1775,  1419,   627,  -411,  -650,  -378,  1402,
+      924,  1190,   631,   299,  -534,    29, -1367,  1121,
+     1256,  1095,   533,  -347,   647,  -595,  1563,  1465,
+     1089, -2096,   311,  -639, -1162, -1247, -2193,  -619,
+     1410, -1090,  -194,  -831, -1224,  -941, -1987, -1367,
+      648,    -6,  -869,   416,  1349,  1813,   453,  -956,
+    -1606, -1175,  -377,  1876,  -430, -1397, -1007, -1401,
+    -1972, -1057,   601,   825, -1323, -1249, -1504, -2009,
+    -1507, -1104,   201,   374,    29, -1331,   960,   197,
+    -1379, -1077,   615,  -306,  1194,  -626,   199, -1065,
+    -1949,   123,  1269,  1526,  1788,  -884,   766,   862,
+     -236,   422,   546,   904,  1177, -1526,  1504,   197,
+    -1034,  -800, -1134, -1205,  -910, -1476,  -523,  1794,
+    -1773,   145,  -519, -1926, -1041, -1567,   842,   646,
+     -887,   599,   626,   500, -1395,  -969,    34,   862,
+    -1207,   -78,  1044,  -600,    57,  -833, -1202,  -461,
+    -1888,    -9,   759,  1139,  2000,  1414,  1630,  1420,
+    -1002,  -672,    80,  1019,  1422,  1121,  1260,  1244,
+     1537,  -283,   599,   588,  -757,    51, -1209,  -624,
+      975,   324,  -195,    62,   645,  1201,   673,  1581,
+      253,  -359,   106,  -587,   205,   758,  -390,   941,
+     -151,  2820,  -302,  -900,  1084,  2014,  1245, -1227,
+     1023,  1301,   524, -1588,   251,  1792,  1633, -1540,
+      735,   690,   -99, -1189,   238,  1010,  1741, -1208,
+     -621,    40,  -805,  -583,  -801,  1972, -1177,  -773,
+      456,   -65,  -699,   904,   532,  1408, -1880,   568,
+     -109,   788, -1350,   832,   594,  1351, -2114,   948,
+    -1015, -1111,  1778, -1491,  -316,  -536,  -785, -2003,
+     1079,   482,  1044,   245, -1141, -1442, -1546,   257,
+     1260,  -130,   780,   912,  -917, -2346, -1988,   909,
+    -1849, -1538,  1606,  -567, -1279,  -817,  -525, -1698,
+     -633, -1918,  2239, -1500,   195,   293,   630, -2425,
+    -1209, -1054,  1576, -1544,  1369,  1219,  1197, -1840,
+     -303, -1169,  -950, -1182, -1599, -2075,  -529,  -283,
+      731,  -251,   -75,  -453,   585,  -571, -1159,  -205,
+      747,   269,  1684,  1005,   378,  -427, -1171,  -564,
+     -796,  2277,  -454,  -717, -1030, -1169,   226, -1251,
+     1246,   927,   559,  1460,  1052,  -138,    39,  -106,
+      717,   539,   440,  1615,  1610,   847,  -612,  -729,
+     -651,  -714,   353,  -798,  -574, -1310,  1408,  1429,
+      968,  -636,  1069,  -156,   918,  1012,  1591,  1380,
+     1302,  1727,   410,  1099,   446,   466,   765,  1757,
+     1949,  1578,   916,  1893,   348,   152,  -267, -1166,
+     1956,  2047,    98,  1418,  1405,  1134,   154,   469,
+     2378,  2148,    -7,  2141,  1579,  1801,  1395,  1054,
+    -1142, -1341,  -364, -1162, -1225, -1485, -1727, -1897,
+     -405, -2264,   869,   549, -1932, -1977,  -906,   233,
+    -1073, -1581,  1706,  1550, -1666, -2055,   -98,  1492,
+      892, -1728, -1060, -1070,   -11, -1600,   421, -1578,
+      108, -1170,  1980, -1741,  1539,    94,   443,  -349,
+     -331, -1700,  1790, -1909,  1317,   497,  -197,  -994,
+     -599,  -965, -1341,  -375,  -371, -1073, -2057,   652,
+     -539, -1419,   175,  1311,  -650,   605,  -113,   914,
+     1140,  -129,  -447,  2055,  -307,   365,   430,   967,
+    -1012,  1505,   262, -1727,    50,  -330, -1517,   946,
+    -1586,  1248,  -486,  1342,    56,   119, -1080,  1127,
+    -2323,   559,  -401,  1546,   432,  -604,  -810,  1055,
+    -1400, -1270,   807,  2760,  1120,  -147,  2439,  -906,
+    -1703,  -704,  1821,  1606,   409,   404,  1911,  -141,
+    -1712, -1317,  1143,  2171,  -150,   959,  2189,  -866,
+     -904,  -557,  -830, -1842, -1604, -1196,  -638,  -500,
+     -142,  -708, -1431, -1346,  -272,   772, -1234,   -81,
+     -458, -1679, -1583, -1086,   915,  1056, -1897,  -822,
+    -1289,  -117, -1090, -1096,   287, -1376, -2176, -1511,
+    -1613,   785,  1133,  -746,  -547, -2201, -1570, -2241,
+     -735,   168,   922,  1384, -1063, -1204, -1757,  -771,
+    -1737, -1588, -1542, -1690, -1700,  2149,  -818,  -764,
+     1099,   724,   693,  -240,    -4,   816, -1841,  -507,
+      830,  1243,   805,  1665,  -668,  1042,    22,   449,
+    -1151,  -843,   498,  -752,  -319,  -811, -2128,  1717,
+     -617, -1596,  -234,   480,  -481,   171,  -202,  1140,
+      289,  -240,  -657,  1678,   193,  -119,  -848,  1700
+};
+
+const Word16 mr795_1_lsf_x8[MR795_1_SIZE*3] =
+{
+     -890,  -819,  -826,  -599,  -811,  -323,  -383,  -399,
+    -1550,  -970, -1234,   -22,  -987,   203,  -235,  1262,
+    -2541,   175,  -762,   634,  -902,    26,  -781,   906,
+     -932,  -624,  -414,    37,  -387,   399,  -407,  -417,
+    -1399,    93,  -539,   633,  -476,    66,   -49,  1041,
+    -1380,    87,  -691,   510, -1330,   263,  -335,  1865,
+     -779,  -746,  -581,  -673,  -560,   271,  -438,   463,
+    -1089,  -858,  -759,  -506,  -634,   241,  -244,  1202,
+    -1440,   832,  -371,  2088, -1179,    14,  -397,  1047,
+     -606,   -51,  -224,   494,  -433,   554,   171,   681,
+     -797,  -323,  -584,   881,  -306,   659,  -160,  1798,
+    -1438,   481,  -527,   682, -1002,   222,  -353,  1565,
+     -852,  -336,  -581,  -195,  -465,   154,   -50,   323,
+    -1181,  -666,  -756,   375,  -804,   282,  -191,   732,
+    -1695,   114,  -744,   497, -1098,  -131,  -719,  1542,
+     -722,   105,  -178,   321,  -323,   127,  -160,   732,
+     -819,  -250,  -502,   510,  -567,   484,    52,  1367,
+    -1404,   185,  -742,  1111,  -966,   338,  -338,  1554,
+     -626,  -286,  -695,  -490,  -630,   -80,    -6,   782,
+     -802,  -586,  -343,   295,  -574,   645,  -318,  1450,
+    -1696,   676,  -370,  1893, -1014,   -69,  -364,  1038,
+     -313,   120,  -264,   711,   -91,   771,   253,   930,
+     -733,    60,  -585,  1245,  -355,   758,    81,  2215,
+    -1395,   477,  -123,   633, -1016,   261,  -474,  1720,
+     -808,  -560,  -804,  -626,  -694,  -660,  -514,   366,
+    -1099,  -782, -1074,   -55,  -716,   354,   -55,  1033,
+    -1925,   169,  -188,  1405, -1194,   329,  -543,  1182,
+     -658,   -55,  -605,   404,  -286,   628,   -16,   186,
+     -959,  -184,  -286,   449,  -350,   306,   147,   923,
+    -1357,    93,  -662,   827, -1263,   227,  -623,  2146,
+     -674,  -443,  -369,   231,  -448,   594,  -124,   671,
+     -890,  -228,  -790,    86,  -581,   450,  -170,  1159,
+    -1606,   339,  -409,  1469, -1061,  -177,  -447,  1404,
+     -476,   -77,  -177,   451,  -250,   272,    26,   698,
+     -667,  -138,  -372,   934,  -432,   828,    19,  1692,
+    -1511,   716,  -381,   915,  -822,   446,   -31,  2168,
+     -646,  -179,  -379,    11,  -488,    61,   147,   685,
+     -977,  -473,  -745,   127,  -917,   323,  -145,   786,
+    -1924,   268,  -691,  1033,  -825,   135,  -686,  1682,
+     -506,    35,   -23,   455,  -203,   652,    39,   841,
+     -848,    90,  -346,   591,  -593,   352,    63,  1265,
+    -1297,   222,  -670,  1287, -1086,   437,  -457,  2105,
+     -520,  -328,  -596,   209,  -423,   421,    -2,   896,
+     -882,  -711,  -342,   173,  -598,   605,  -245,  1969,
+    -1584,  1421,   -70,  1928,  -921,   -38,  -127,  1135,
+     -379,   173,   -55,   985,    -2,   753,   264,   895,
+     -518,   118,  -381,  1021,  -291,   992,   131,  2274,
+    -1579,   753,   -52,   753,  -891,   423,  -196,  2543,
+     -635,  -529,  -764,  -436,  -675,   -57,  -201,    16,
+    -1088,  -982,  -830,   316,  -940,   236,   -81,   845,
+    -2499,   526,  -548,   599,  -746,   -11,  -798,  1558,
+     -737,  -468,  -279,   183,  -265,   421,  -390,    39,
+     -985,    17,  -584,   822,  -492,   152,   166,  1550,
+    -1212,   290,  -700,   705, -1187,   468,  -268,  1868,
+     -635,  -453,  -284,  -181,  -445,   420,  -389,   707,
+     -966,  -492, -1027,  -133,  -624,   367,  -212,  1073,
+    -1571,   910,   -75,  1852, -1174,   -49,  -169,  1208,
+     -539,    83,  -236,   338,  -246,   606,   166,  -306,
+     -710,  -163,  -543,  1175,  -309,   760,    -8,  1849,
+    -1449,   484,  -355,   814,  -958,    60,  -163,  2563,
+     -747,  -419,  -718,  -506,  -463,   325,   -15,   545,
+    -1025,  -446,  -566,   693,  -697,   431,    -8,   919,
+    -1783,   209,  -534,   857, -1082,  -206,  -763,  1518,
+     -611,   256,  -165,   321,  -326,   484,  -197,   909,
+     -783,   -55,  -348,   680,  -429,   446,    72,  1455,
+    -1313,   208,  -662,   930,  -951,   570,   -73,  1741,
+     -563,  -124,  -478,   -16,  -551,   -58,    55,  1148,
+     -737,  -416,  -404,   446,  -537,   638,  -185,  1301,
+    -1974,   718,  -314,  1636,  -750,   214,  -271,  1212,
+     -483,   117,  -204,   513,  -114,   877,   260,   748,
+     -671,   285,  -391,  1538,  -190,   595,   260,  2283,
+    -1264,   543,  -111,   854,  -978,   464,  -311,  2216,
+     -517,  -326,  -812,  -560,  -732,  -359,  -265,   145,
+     -945,  -708,  -691,   687,  -690,   645,    62,  1644,
+    -2171,   378,  -232,  1409,  -836,   386,  -678,  1208,
+     -555,   -78,  -327,   392,  -201,   693,  -243,   611,
+     -988,    14,  -358,   677,  -236,   449,   256,  1385,
+    -1233,   114,  -489,   697, -1140,   178,  -433,  2456,
+     -612,  -307,  -315,   256,  -486,   655,  -102,   755,
+     -901,   -17,  -667,   428,  -422,   370,  -185,  1578,
+    -1464,   499,  -254,  1463, -1056,    18,  -276,  1335,
+     -488,   182,   -73,   835,  -282,   547,   273,   940,
+     -603,   -93,  -458,   862,  -333,   839,   -89,  1708,
+    -1418,   870,  -348,   957,  -746,   428,    13,  2576,
+     -418,   -44,  -497,    99,  -421,   295,   175,   532,
+    -1084,  -358,  -643,   557,  -766,   326,    15,   878,
+    -1758,   259,  -560,   961,  -917,   184,  -626,  1981,
+     -443,   221,    39,   695,  -162,   709,    25,  1268,
+     -768,   156,  -363,   772,  -459,   444,   303,  1410,
+    -1275,   268,  -505,  1140,  -912,   658,  -312,  1715,
+     -297,  -263,  -406,    57,  -374,   304,   104,  1611,
+     -766,  -108,   -13,   438,  -487,   696,  -235,  1900,
+    -1836,  1070,  -129,  2734,  -835,   164,     5,  1399,
+     -229,   405,   -87,  1028,    68,  1033,   478,  2127,
+     -582,   192,  -438,  1199,  -175,  1117,   200,  2696,
+    -1325,   817,   111,   993,  -934,   451,  -248,  2042,
+     -835,  -799,  -812,  -622,  -701,  -411,  -390,   -30,
+    -1323,  -692, -1032,   288,  -841,   512,   -91,  1043,
+    -2131,   466,  -469,   920, -1070,     8,  -744,  1161,
+     -822,  -294,  -411,   214,  -406,   487,  -318,   123,
+    -1148,   -46,  -374,   531,  -420,   232,    91,  1232,
+    -1156,   110,  -678,   668, -1194,   303,  -472,  2445,
+     -722,  -738,  -543,   -95,  -549,   473,  -288,   537,
+     -952,  -675,  -606,   -98,  -514,   211,  -112,  1332,
+    -1495,  1332,  -211,  1508, -1193,    73,  -389,  1258,
+     -567,    71,  -170,   681,  -356,   419,   241,   377,
+     -755,  -283,  -481,  1002,  -331,   706,   -34,  1950,
+    -1545,   632,  -493,   817,  -877,   346,  -326,  1883,
+     -727,  -233,  -524,   -73,  -288,   173,    68,   449,
+    -1075,  -543,  -806,   478,  -925,   447,  -229,   529,
+    -1625,   116,  -585,   729, -1143,   -52,  -606,  1797,
+     -591,   183,  -103,   623,  -238,   326,   136,   626,
+     -875,  -144,  -452,   488,  -511,   552,   108,  1343,
+    -1363,   324,  -666,  1176, -1004,   458,  -319,  1883,
+     -490,  -186,  -738,  -550,  -496,   210,    84,  1090,
+     -646,  -449,   -76,   755,  -510,   694,  -322,  1625,
+    -1730,   984,  -170,  2560,  -947,   -52,  -199,  1224,
+     -376,   343,  -175,   972,    52,  1065,   393,  1214,
+     -603,    74,  -502,  1332,  -295,   918,   107,  2649,
+    -1396,   632,   -32,   734, -1113,   160,  -397,  1741,
+     -632,  -719,  -651,  -211,  -562,  -208,  -320,   293,
+    -1201,  -277,  -880,   209,  -714,   388,   -61,  1092,
+    -1891,   353,  -122,  1338, -1059,   159,  -551,  1443,
+     -648,   -49,  -401,   561,  -117,   507,   -79,   671,
+     -865,  -143,  -227,   532,  -443,   436,   233,  1025,
+    -1253,   305,  -585,   927, -1188,   292,  -458,  2396,
+     -633,  -308,  -373,   418,  -315,   572,    61,   991,
+     -842,  -286,  -621,   253,  -581,   685,   -68,  1101,
+    -1525,   640,  -407,  1305, -1137,  -281,  -371,  1498,
+     -493,   -47,  -256,   631,  -118,    68,   152,  1113,
+     -683,   164,  -314,   949,  -348,  1180,   117,  1902,
+    -1362,   704,  -268,  1052,  -833,   568,    34,  2239,
+     -601,  -143,  -332,    54,  -462,   150,   195,   679,
+     -959,  -489,  -655,   353,  -652,   549,  -111,  1108,
+    -1706,   480,  -574,  1192,  -796,   112,  -515,  1647,
+     -558,    -9,   -53,   489,  -120,   632,   179,  1124,
+     -749,   272,  -265,   843,  -482,   543,   306,  1464,
+    -1217,   341,  -535,  1298, -1032,   408,  -526,  2244,
+     -417,  -224,  -377,   385,  -332,   544,    22,  1128,
+     -786,  -384,  -459,   489,  -651,   553,  -113,  1725,
+    -1562,  1364,   -25,  2174,  -829,    61,   -89,  1524,
+     -216,   161,  -165,  1362,    73,   738,   362,   787,
+     -373,   316,  -222,  1175,  -252,   932,   246,  2654,
+    -1653,   908,   -67,   789,  -767,   616,  -126,  3027,
+     -691,  -565,  -590,  -263,  -577,   -22,  -190,   -88,
+    -1106,  -588,  -979,   397,  -837,   435,  -118,  1240,
+    -2190,   524,  -490,   982,  -945,   -49,  -629,  1513,
+     -636,  -291,  -257,   145,  -326,   543,  -202,   357,
+    -1051,   189,  -470,   945,  -364,   260,   189,  1379,
+    -1019,   259,  -629,   894, -1094,   630,  -209,  2091,
+     -569,  -714,  -420,  -109,  -413,   482,  -186,   861,
+    -1075,  -239,  -705,  -114,  -529,   368,   -72,  1255,
+    -1449,   919,   -84,  2407, -1177,   131,  -131,  1220,
+     -611,   227,  -176,   745,  -321,   671,   340,   469,
+     -658,  -121,  -489,  1175,  -148,   966,    -3,  1848,
+    -1341,   631,  -218,   957,  -936,   216,  -143,  2437,
+     -729,  -213,  -511,  -126,  -340,   316,    23,   353,
+     -961,  -254,  -438,   725,  -685,   480,   -89,  1051,
+    -1683,   321,  -521,   903, -1032,    20,  -551,  1789,
+     -544,   298,  -100,   467,  -210,   620,    33,   921,
+     -757,   -25,  -392,   754,  -398,   658,   147,  1687,
+    -1364,   436,  -519,  1078, -1078,   630,  -178,  1921,
+     -325,     2,  -371,     0,  -496,    37,   181,  1481,
+     -528,  -285,  -490,   597,  -395,   945,  -160,  1373,
+    -1978,   910,  -230,  2010,  -834,   245,  -144,  1357,
+     -355,   298,  -193,  1089,   177,   996,   456,  1415,
+     -601,   322,  -336,  1533,   -39,   781,   366,  2440,
+    -1270,   672,    77,   922, -1125,   536,  -432,  2279,
+     -466,  -303,  -727,  -145,  -544,  -225,  -152,   423,
+     -758,  -509,  -557,   643,  -676,   862,    40,  1423,
+    -2325,   387,    66,  1248,  -916,   588,  -533,  1558,
+     -572,  -128,  -238,   605,    24,   797,  -181,   616,
+     -843,    85,  -257,   748,  -202,   487,   364,  1378,
+    -1145,   461,  -584,   861, -1409,   303,  -182,  2942,
+     -494,  -292,   -84,   555,  -365,   822,   -14,  1001,
+     -852,    61,  -723,   532,  -493,   588,   -18,  1401,
+    -1441,   812,  -182,  1506, -1057,    11,  -230,  1451,
+     -474,   302,   -70,   982,  -196,   479,   362,  1147,
+     -569,    62,  -376,   974,  -234,  1098,    58,  2069,
+    -1292,  1062,  -222,  1149,  -795,   499,    70,  2857,
+     -487,    73,  -358,   199,   -78,   361,   374,   847,
+     -878,  -288,  -500,   721,  -697,   536,   110,  1051,
+    -1824,   348,  -508,  1242,  -795,   196,  -735,  1896,
+     -366,   315,    72,   759,   -30,   861,   118,  1355,
+     -713,   320,  -215,   886,  -428,   627,   468,  1883,
+    -1182,   429,  -450,  1363,  -834,   796,  -279,  1893,
+     -188,    63,  -418,   414,  -234,   424,   136,  1413,
+     -642,  -175,  -211,   587,  -557,   889,  -101,  2278,
+    -1612,  1198,    51,  2601,  -858,   222,    83,  1383,
+      -84,   414,    29,  1552,   183,  1273,   553,  1587,
+     -445,   313,  -343,  1647,   -91,  1413,   272,  3149,
+    -1389,  1045,    65,   980,  -829,   360,  -107,  2603
+};
+#endif
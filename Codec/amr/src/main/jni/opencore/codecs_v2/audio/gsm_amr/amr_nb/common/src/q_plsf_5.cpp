@@ -45,6 +45,8 @@ terms listed above has been obtained from the copyright holder.
 #include "lsp_lsf.h"
 #include "reorder.h"
 #include "lsfwt.h"
+#include "basic_op_vec.h"
+#include "amrnb_cpu.h"
 
 /*--------------------------------------------------------------------------*/
 #ifdef __cplusplus
@@ -93,7 +95,7 @@ extern "C"
 
 /*
 ------------------------------------------------------------------------------
- FUNCTION NAME: Vq_subvec
+ FUNCTION NAME: Vq_subvec_c
 ------------------------------------------------------------------------------
  INPUT AND OUTPUT DEFINITIONS
 
@@ -143,7 +145,7 @@ extern "C"
 */
 /* Quantization of a 4 dimensional subvector */
 
-static Word16 Vq_subvec( /* o : quantization index,            Q0  */
+static Word16 Vq_subvec_c( /* o : quantization index,          Q0  */
     Word16 *lsf_r1,      /* i : 1st LSF residual vector,       Q15 */
     Word16 *lsf_r2,      /* i : 2nd LSF residual vector,       Q15 */
     const Word16 *dico,  /* i : quantization codebook,         Q15 */
@@ -238,9 +240,258 @@ static Word16 Vq_subvec( /* o : quantization index,            Q0  */
 }
 
 
+#if defined(AMRNB_SIMD_SSE2)
 /*
 ------------------------------------------------------------------------------
- FUNCTION NAME: Vq_subvec_s
+ FUNCTION NAME: Vq_subvec_sse2
+------------------------------------------------------------------------------
+ INPUT AND OUTPUT DEFINITIONS
+
+ Same as Vq_subvec_c.
+
+------------------------------------------------------------------------------
+ FUNCTION DESCRIPTION
+
+ Two codebook entries fit in a vector. Each weighted error
+ (lsf * wf - dico * wf) >> 15 is formed exactly by a multiply-add of
+ {lsf, dico} with {wf, -wf}, and the distances of four entries are summed
+ pairwise. Each lane keeps the first entry with the smallest distance, and
+ the lanes are merged at the end.
+
+ As long as no distance reaches 2^31, the early exits of Vq_subvec_c only
+ skip entries that could not have been chosen, so this is the same
+ search. When a distance does wrap around, the search is left to
+ Vq_subvec_c.
+
+------------------------------------------------------------------------------
+*/
+
+static Word16 Vq_subvec_sse2( /* o : quantization index,        Q0  */
+    Word16 *lsf_r1,      /* i : 1st LSF residual vector,       Q15 */
+    Word16 *lsf_r2,      /* i : 2nd LSF residual vector,       Q15 */
+    const Word16 *dico,  /* i : quantization codebook,         Q15 */
+    Word16 *wf1,         /* i : 1st LSF weighting factors      Q13 */
+    Word16 *wf2,         /* i : 2nd LSF weighting factors      Q13 */
+    Word16 dico_size,    /* i : size of quantization codebook, Q0  */
+    Flag   *pOverflow    /* o : overflow indicator                 */
+)
+{
+    Word16 index;
+    Word16 i;
+    const Word16 *p_dico;
+    __m128i lsf;
+    __m128i wf;
+    __m128i wrap = _mm_setzero_si128();
+    __m128i dist_min = _mm_set1_epi32(MAX_32);
+    __m128i index_min = _mm_setzero_si128();
+    __m128i entry = _mm_setr_epi32(0, 1, 2, 3);
+
+    if ((dico_size & 3) != 0 || wf1[0] == MIN_16 || wf1[1] == MIN_16 ||
+            wf2[0] == MIN_16 || wf2[1] == MIN_16)
+    {
+        return Vq_subvec_c(lsf_r1, lsf_r2, dico, wf1, wf2, dico_size, pOverflow);
+    }
+
+    lsf = _mm_setr_epi16(lsf_r1[0], lsf_r1[1], lsf_r2[0], lsf_r2[1],
+                         lsf_r1[0], lsf_r1[1], lsf_r2[0], lsf_r2[1]);
+    wf = _mm_setr_epi16(wf1[0], -wf1[0], wf1[1], -wf1[1],
+                        wf2[0], -wf2[0], wf2[1], -wf2[1]);
+
+    p_dico = dico;
+
+    for (i = 0; i < dico_size; i += 4)
+    {
+        __m128i d0 = _mm_loadu_si128((__m128i *) p_dico);
+        __m128i d1 = _mm_loadu_si128((__m128i *)(p_dico + 8));
+        __m128i t0;
+        __m128i t1;
+        __m128i dist;
+
+        t0 = amrnb_pack_trunc_epi32(_mm_srai_epi32(_mm_madd_epi16(_mm_unpacklo_epi16(lsf, d0), wf), 15),
+                                    _mm_srai_epi32(_mm_madd_epi16(_mm_unpackhi_epi16(lsf, d0), wf), 15));
+        t1 = amrnb_pack_trunc_epi32(_mm_srai_epi32(_mm_madd_epi16(_mm_unpacklo_epi16(lsf, d1), wf), 15),
+                                    _mm_srai_epi32(_mm_madd_epi16(_mm_unpackhi_epi16(lsf, d1), wf), 15));
+        t0 = _mm_madd_epi16(t0, t0);
+        t1 = _mm_madd_epi16(t1, t1);
+        dist = amrnb_hadd_pairs_epi32(t0, t1);
+
+        /* the partial sums are non-negative unless they wrapped around */
+        wrap = _mm_or_si128(wrap, _mm_or_si128(dist, _mm_or_si128(t0, t1)));
+        amrnb_min_index_epi32(&dist_min, &index_min, dist, entry);
+
+        entry = _mm_add_epi32(entry, _mm_set1_epi32(4));
+        p_dico += 16;
+    }
+
+    if (_mm_movemask_ps(_mm_castsi128_ps(wrap)) != 0)
+    {
+        return Vq_subvec_c(lsf_r1, lsf_r2, dico, wf1, wf2, dico_size, pOverflow);
+    }
+
+    index = amrnb_min_index_reduce(dist_min, index_min);
+
+    /* Reading the selected vector */
+
+    p_dico = &dico[ index<<2];
+    lsf_r1[0] = *p_dico++;
+    lsf_r1[1] = *p_dico++;
+    lsf_r2[0] = *p_dico++;
+    lsf_r2[1] = *p_dico;
+
+    return index;
+}
+#endif
+
+#if defined(AMRNB_SIMD_NEON)
+/*
+------------------------------------------------------------------------------
+ FUNCTION NAME: Vq_subvec_neon
+------------------------------------------------------------------------------
+ INPUT AND OUTPUT DEFINITIONS
+
+ Same as Vq_subvec_c.
+
+------------------------------------------------------------------------------
+ FUNCTION DESCRIPTION
+
+ Two codebook entries fit in a vector. The weighted errors
+ (lsf * wf - dico * wf) >> 15 of an entry are a widening multiply-subtract
+ from the four lsf * wf products, narrowed with the same truncation as
+ Vq_subvec_c, and the distances of four entries are summed pairwise. Each
+ lane keeps the first entry with the smallest distance, and the lanes are
+ merged at the end.
+
+ As in Vq_subvec_sse2, the early exits of Vq_subvec_c only skip entries
+ that could not have been chosen as long as no distance reaches 2^31; when
+ one does, the search is left to Vq_subvec_c.
+
+------------------------------------------------------------------------------
+*/
+
+static Word16 Vq_subvec_neon( /* o : quantization index,        Q0  */
+    Word16 *lsf_r1,      /* i : 1st LSF residual vector,       Q15 */
+    Word16 *lsf_r2,      /* i : 2nd LSF residual vector,       Q15 */
+    const Word16 *dico,  /* i : quantization codebook,         Q15 */
+    Word16 *wf1,         /* i : 1st LSF weighting factors      Q13 */
+    Word16 *wf2,         /* i : 2nd LSF weighting factors      Q13 */
+    Word16 dico_size,    /* i : size of quantization codebook, Q0  */
+    Flag   *pOverflow    /* o : overflow indicator                 */
+)
+{
+    static const Word32 entry_init[4] = {0, 1, 2, 3};
+    Word16 index;
+    Word16 i;
+    const Word16 *p_dico;
+    Word16 v[4];
+    int16x4_t wf;
+    int32x4_t aux;
+    int32x4_t wrap = vdupq_n_s32(0);
+    int32x4_t dist_min = vdupq_n_s32(MAX_32);
+    int32x4_t index_min = vdupq_n_s32(0);
+    int32x4_t entry = vld1q_s32(entry_init);
+
+    if ((dico_size & 3) != 0)
+    {
+        return Vq_subvec_c(lsf_r1, lsf_r2, dico, wf1, wf2, dico_size, pOverflow);
+    }
+
+    v[0] = wf1[0];
+    v[1] = wf1[1];
+    v[2] = wf2[0];
+    v[3] = wf2[1];
+    wf = vld1_s16(v);
+    v[0] = lsf_r1[0];
+    v[1] = lsf_r1[1];
+    v[2] = lsf_r2[0];
+    v[3] = lsf_r2[1];
+    aux = vmull_s16(vld1_s16(v), wf);
+
+    p_dico = dico;
+
+    for (i = 0; i < dico_size; i += 4)
+    {
+        int16x8_t d0 = vld1q_s16(p_dico);
+        int16x8_t d1 = vld1q_s16(p_dico + 8);
+        int16x8_t t0;
+        int16x8_t t1;
+        int32x4_t p0;
+        int32x4_t p1;
+        int32x4_t dist;
+
+        t0 = vcombine_s16(vshrn_n_s32(vmlsl_s16(aux, wf, vget_low_s16(d0)), 15),
+                          vshrn_n_s32(vmlsl_s16(aux, wf, vget_high_s16(d0)), 15));
+        t1 = vcombine_s16(vshrn_n_s32(vmlsl_s16(aux, wf, vget_low_s16(d1)), 15),
+                          vshrn_n_s32(vmlsl_s16(aux, wf, vget_high_s16(d1)), 15));
+        p0 = vpaddq_s32(vmull_s16(vget_low_s16(t0), vget_low_s16(t0)), vmull_high_s16(t0, t0));
+        p1 = vpaddq_s32(vmull_s16(vget_low_s16(t1), vget_low_s16(t1)), vmull_high_s16(t1, t1));
+        dist = vpaddq_s32(p0, p1);
+
+        /* the partial sums are non-negative unless they wrapped around */
+        wrap = vorrq_s32(wrap, vorrq_s32(dist, vorrq_s32(p0, p1)));
+        amrnb_min_index_s32(&dist_min, &index_min, dist, entry);
+
+        entry = vaddq_s32(entry, vdupq_n_s32(4));
+        p_dico += 16;
+    }
+
+    if (vminvq_s32(wrap) < 0)
+    {
+        return Vq_subvec_c(lsf_r1, lsf_r2, dico, wf1, wf2, dico_size, pOverflow);
+    }
+
+    index = amrnb_min_index_reduce_s32(dist_min, index_min);
+
+    /* Reading the selected vector */
+
+    p_dico = &dico[ index<<2];
+    lsf_r1[0] = *p_dico++;
+    lsf_r1[1] = *p_dico++;
+    lsf_r2[0] = *p_dico++;
+    lsf_r2[1] = *p_dico;
+
+    return index;
+}
+#endif
+
+/* Implementation of Vq_subvec that q_plsf_5_cpu_select() selected */
+static Word16 (*Vq_subvec_impl)(Word16 *lsf_r1, Word16 *lsf_r2,
+                                const Word16 *dico, Word16 *wf1, Word16 *wf2,
+                                Word16 dico_size,
+                                Flag *pOverflow) = Vq_subvec_c;
+
+/*
+------------------------------------------------------------------------------
+ FUNCTION NAME: Vq_subvec
+------------------------------------------------------------------------------
+ INPUT AND OUTPUT DEFINITIONS
+
+ Same as Vq_subvec_c.
+
+------------------------------------------------------------------------------
+ FUNCTION DESCRIPTION
+
+ Runs the implementation of Vq_subvec that q_plsf_5_cpu_select() selected
+ (see amrnb_cpu.h).
+
+------------------------------------------------------------------------------
+*/
+
+static Word16 Vq_subvec( /* o : quantization index,            Q0  */
+    Word16 *lsf_r1,      /* i : 1st LSF residual vector,       Q15 */
+    Word16 *lsf_r2,      /* i : 2nd LSF residual vector,       Q15 */
+    const Word16 *dico,  /* i : quantization codebook,         Q15 */
+    Word16 *wf1,         /* i : 1st LSF weighting factors      Q13 */
+    Word16 *wf2,         /* i : 2nd LSF weighting factors      Q13 */
+    Word16 dico_size,    /* i : size of quantization codebook, Q0  */
+    Flag   *pOverflow    /* o : overflow indicator                 */
+)
+{
+    return Vq_subvec_impl(lsf_r1, lsf_r2, dico, wf1, wf2, dico_size, pOverflow);
+}
+
+/*
+------------------------------------------------------------------------------
+ FUNCTION NAME: Vq_subvec_s_c
 ------------------------------------------------------------------------------
  INPUT AND OUTPUT DEFINITIONS
 
@@ -293,7 +544,7 @@ static Word16 Vq_subvec( /* o : quantization index,            Q0  */
 
 /* Quantization of a 4 dimensional subvector with a signed codebook */
 
-static Word16 Vq_subvec_s(  /* o : quantization index            Q0  */
+static Word16 Vq_subvec_s_c( /* o : quantization index          Q0  */
     Word16 *lsf_r1,         /* i : 1st LSF residual vector       Q15 */
     Word16 *lsf_r2,         /* i : and LSF residual vector       Q15 */
     const Word16 *dico,     /* i : quantization codebook         Q15 */
@@ -421,6 +672,153 @@ static Word16 Vq_subvec_s(  /* o : quantization index            Q0  */
 
 }
 
+#if defined(AMRNB_SIMD_SSE2)
+/*
+------------------------------------------------------------------------------
+ FUNCTION NAME: Vq_subvec_s_sse2
+------------------------------------------------------------------------------
+ INPUT AND OUTPUT DEFINITIONS
+
+ Same as Vq_subvec_s_c.
+
+------------------------------------------------------------------------------
+ FUNCTION DESCRIPTION
+
+ Computes the distances to four codebook entries and to their negatives
+ at a time, as in Vq_subvec_sse2. Entry i is tracked as 2 * i and its
+ negative as 2 * i + 1, which is both the order of the sequential search
+ and the index returned. Searches in which a distance wraps around are
+ left to Vq_subvec_s_c.
+
+------------------------------------------------------------------------------
+*/
+
+static Word16 Vq_subvec_s_sse2( /* o : quantization index       Q0  */
+    Word16 *lsf_r1,         /* i : 1st LSF residual vector       Q15 */
+    Word16 *lsf_r2,         /* i : and LSF residual vector       Q15 */
+    const Word16 *dico,     /* i : quantization codebook         Q15 */
+    Word16 *wf1,            /* i : 1st LSF weighting factors     Q13 */
+    Word16 *wf2,            /* i : 2nd LSF weighting factors     Q13 */
+    Word16 dico_size,       /* i : size of quantization codebook Q0  */
+    Flag   *pOverflow)      /* o : overflow indicator                */
+{
+    Word16 index;
+    Word16 i;
+    const Word16 *p_dico;
+    __m128i lsf;
+    __m128i wf;
+    __m128i wrap = _mm_setzero_si128();
+    __m128i dist_min = _mm_set1_epi32(MAX_32);
+    __m128i index_min = _mm_setzero_si128();
+    __m128i entry = _mm_setr_epi32(0, 2, 4, 6);
+
+    if ((dico_size & 3) != 0)
+    {
+        return Vq_subvec_s_c(lsf_r1, lsf_r2, dico, wf1, wf2, dico_size, pOverflow);
+    }
+
+    lsf = _mm_setr_epi16(lsf_r1[0], lsf_r1[1], lsf_r2[0], lsf_r2[1],
+                         lsf_r1[0], lsf_r1[1], lsf_r2[0], lsf_r2[1]);
+    wf = _mm_setr_epi16(wf1[0], wf1[1], wf2[0], wf2[1],
+                        wf1[0], wf1[1], wf2[0], wf2[1]);
+
+    p_dico = dico;
+
+    for (i = 0; i < dico_size; i += 4)
+    {
+        __m128i d0 = _mm_loadu_si128((__m128i *) p_dico);
+        __m128i d1 = _mm_loadu_si128((__m128i *)(p_dico + 8));
+        __m128i p0 = amrnb_mul_shr15_epi16(wf, _mm_sub_epi16(lsf, d0));
+        __m128i p1 = amrnb_mul_shr15_epi16(wf, _mm_sub_epi16(lsf, d1));
+        __m128i n0 = amrnb_mul_shr15_epi16(wf, _mm_add_epi16(lsf, d0));
+        __m128i n1 = amrnb_mul_shr15_epi16(wf, _mm_add_epi16(lsf, d1));
+        __m128i dist1;
+        __m128i dist2;
+
+        p0 = _mm_madd_epi16(p0, p0);
+        p1 = _mm_madd_epi16(p1, p1);
+        n0 = _mm_madd_epi16(n0, n0);
+        n1 = _mm_madd_epi16(n1, n1);
+        dist1 = amrnb_hadd_pairs_epi32(p0, p1);
+        dist2 = amrnb_hadd_pairs_epi32(n0, n1);
+
+        /* the partial sums are non-negative unless they wrapped around */
+        wrap = _mm_or_si128(wrap, _mm_or_si128(_mm_or_si128(p0, p1), _mm_or_si128(n0, n1)));
+        wrap = _mm_or_si128(wrap, _mm_or_si128(dist1, dist2));
+
+        /* test positive, then negative */
+        amrnb_min_index_epi32(&dist_min, &index_min, dist1, entry);
+        amrnb_min_index_epi32(&dist_min, &index_min, dist2,
+                              _mm_add_epi32(entry, _mm_set1_epi32(1)));
+
+        entry = _mm_add_epi32(entry, _mm_set1_epi32(8));
+        p_dico += 16;
+    }
+
+    if (_mm_movemask_ps(_mm_castsi128_ps(wrap)) != 0)
+    {
+        return Vq_subvec_s_c(lsf_r1, lsf_r2, dico, wf1, wf2, dico_size, pOverflow);
+    }
+
+    index = amrnb_min_index_reduce(dist_min, index_min);
+
+    /* Reading the selected vector */
+
+    p_dico = &dico[(index >> 1) << 2];
+    if (index & 1)
+    {
+        lsf_r1[0] = - (*p_dico++);
+        lsf_r1[1] = - (*p_dico++);
+        lsf_r2[0] = - (*p_dico++);
+        lsf_r2[1] = - (*p_dico);
+    }
+    else
+    {
+        lsf_r1[0] = *p_dico++;
+        lsf_r1[1] = *p_dico++;
+        lsf_r2[0] = *p_dico++;
+        lsf_r2[1] = *p_dico;
+    }
+
+    return index;
+}
+#endif
+
+/* Implementation of Vq_subvec_s that q_plsf_5_cpu_select() selected */
+static Word16 (*Vq_subvec_s_impl)(Word16 *lsf_r1, Word16 *lsf_r2,
+                                  const Word16 *dico, Word16 *wf1, Word16 *wf2,
+                                  Word16 dico_size,
+                                  Flag *pOverflow) = Vq_subvec_s_c;
+
+/*
+------------------------------------------------------------------------------
+ FUNCTION NAME: Vq_subvec_s
+------------------------------------------------------------------------------
+ INPUT AND OUTPUT DEFINITIONS
+
+ Same as Vq_subvec_s_c.
+
+------------------------------------------------------------------------------
+ FUNCTION DESCRIPTION
+
+ Runs the implementation of Vq_subvec_s that q_plsf_5_cpu_select() selected
+ (see amrnb_cpu.h).
+
+------------------------------------------------------------------------------
+*/
+
+static Word16 Vq_subvec_s(  /* o : quantization index            Q0  */
+    Word16 *lsf_r1,         /* i : 1st LSF residual vector       Q15 */
+    Word16 *lsf_r2,         /* i : and LSF residual vector       Q15 */
+    const Word16 *dico,     /* i : quantization codebook         Q15 */
+    Word16 *wf1,            /* i : 1st LSF weighting factors     Q13 */
+    Word16 *wf2,            /* i : 2nd LSF weighting factors     Q13 */
+    Word16 dico_size,       /* i : size of quantization codebook Q0  */
+    Flag   *pOverflow)      /* o : overflow indicator                */
+{
+    return Vq_subvec_s_impl(lsf_r1, lsf_r2, dico, wf1, wf2, dico_size, pOverflow);
+}
+
 /*
 ------------------------------------------------------------------------------
  FUNCTION NAME: Q_plsf_5
@@ -598,3 +996,45 @@ OSCL_EXPORT_REF void Q_plsf_5(
     Lsf_lsp(lsf2_q, lsp2_q, M, pOverflow);
 }
 
+/*
+------------------------------------------------------------------------------
+ FUNCTION NAME: q_plsf_5_cpu_select
+------------------------------------------------------------------------------
+ INPUT AND OUTPUT DEFINITIONS
+
+ Inputs:
+    features = AMRNB_CPU_* features the kernels may use (Word32)
+
+ Outputs:
+    Vq_subvec_impl = the Vq_subvec implementation for features
+    Vq_subvec_s_impl = the Vq_subvec_s implementation for features
+
+ Returns:
+    None
+
+------------------------------------------------------------------------------
+ FUNCTION DESCRIPTION
+
+ Part of the kernel table of the common library, run when the features in
+ use are set (see amrnb_cpu.h).
+
+------------------------------------------------------------------------------
+*/
+void q_plsf_5_cpu_select(Word32 features)
+{
+    Vq_subvec_impl = Vq_subvec_c;
+    Vq_subvec_s_impl = Vq_subvec_s_c;
+#if defined(AMRNB_SIMD_NEON)
+    if (features & AMRNB_CPU_NEON)
+    {
+        Vq_subvec_impl = Vq_subvec_neon;
+    }
+#endif
+#if defined(AMRNB_SIMD_SSE2)
+    if (features & AMRNB_CPU_SSE2)
+    {
+        Vq_subvec_impl = Vq_subvec_sse2;
+        Vq_subvec_s_impl = Vq_subvec_s_sse2;
+    }
+#endif
+}
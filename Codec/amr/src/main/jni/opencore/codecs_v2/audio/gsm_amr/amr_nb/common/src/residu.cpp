@@ -39,6 +39,8 @@ terms listed above has been obtained from the copyright holder.
 #include "residu.h"
 #include "typedef.h"
 #include "cnst.h"
+#include "basic_op_vec.h"
+#include "amrnb_cpu.h"
 
 /*----------------------------------------------------------------------------
 ; MACROS
@@ -143,7 +145,7 @@ void Residu (
 ------------------------------------------------------------------------------
 */
 
-OSCL_EXPORT_REF void Residu(
+void Residu_c(
     Word16 coef_ptr[],      /* (i)     : prediction coefficients*/
     Word16 input_ptr[],     /* (i)     : speech signal          */
     Word16 residual_ptr[],  /* (o)     : residual signal        */
@@ -203,3 +205,222 @@ OSCL_EXPORT_REF void Residu(
 
     return;
 }
+
+#if defined(AMRNB_SIMD_SSE2)
+/*
+------------------------------------------------------------------------------
+ FUNCTION NAME: Residu_sse2
+------------------------------------------------------------------------------
+ INPUT AND OUTPUT DEFINITIONS
+
+ Same as Residu_c.
+
+------------------------------------------------------------------------------
+ FUNCTION DESCRIPTION
+
+ Computes eight outputs at a time: the eleven taps and the rounding
+ constant are paired up as {a[k], a[k+1]} and {a[M], 1} and applied with
+ multiply-adds to the interleaved input {x[n-k], x[n-k-1]} and
+ {x[n-M], 0x800}. Blocks are processed from the end of the signal, as in
+ Residu_c.
+
+------------------------------------------------------------------------------
+*/
+
+void Residu_sse2(
+    Word16 coef_ptr[],      /* (i)     : prediction coefficients*/
+    Word16 input_ptr[],     /* (i)     : speech signal          */
+    Word16 residual_ptr[],  /* (o)     : residual signal        */
+    Word16 input_len        /* (i)     : size of filtering      */
+)
+{
+    Word16 i, k;
+    __m128i coef[M / 2 + 1];
+    __m128i round = _mm_set1_epi16(0x0800);
+
+    for (k = 0; k < M / 2; k++)
+    {
+        coef[k] = amrnb_pair_epi16(coef_ptr[2*k], coef_ptr[2*k + 1]);
+    }
+    coef[M / 2] = amrnb_pair_epi16(coef_ptr[M], 1);
+
+    for (i = input_len - 8; i >= 0; i -= 8)
+    {
+        __m128i s_lo;
+        __m128i s_hi;
+        __m128i w0 = _mm_loadu_si128((__m128i *) &input_ptr[i - M]);
+
+        s_lo = _mm_madd_epi16(_mm_unpacklo_epi16(w0, round), coef[M / 2]);
+        s_hi = _mm_madd_epi16(_mm_unpackhi_epi16(w0, round), coef[M / 2]);
+
+        for (k = 0; k < M / 2; k++)
+        {
+            __m128i w1;
+
+            w0 = _mm_loadu_si128((__m128i *) &input_ptr[i - 2*k]);
+            w1 = _mm_loadu_si128((__m128i *) &input_ptr[i - 2*k - 1]);
+            s_lo = _mm_add_epi32(s_lo, _mm_madd_epi16(_mm_unpacklo_epi16(w0, w1), coef[k]));
+            s_hi = _mm_add_epi32(s_hi, _mm_madd_epi16(_mm_unpackhi_epi16(w0, w1), coef[k]));
+        }
+
+        _mm_storeu_si128((__m128i *) &residual_ptr[i],
+                         amrnb_pack_trunc_epi32(_mm_srai_epi32(s_lo, 12),
+                                                _mm_srai_epi32(s_hi, 12)));
+    }
+
+    /* the rest of the groups of four that Residu_c computes */
+    for (i += 7; i >= (input_len & 3); i--)
+    {
+        Word32 s = 0x0000800L;
+
+        for (k = 0; k <= M; k++)
+        {
+            s = amrnb_fxp_mac_16_by_16bb((Word32) coef_ptr[k], (Word32) input_ptr[i - k], s);
+        }
+        residual_ptr[i] = (Word16)(s >> 12);
+    }
+
+    return;
+}
+#endif
+
+#if defined(AMRNB_SIMD_AVX2)
+/*
+------------------------------------------------------------------------------
+ FUNCTION NAME: Residu_avx2
+------------------------------------------------------------------------------
+ INPUT AND OUTPUT DEFINITIONS
+
+ Same as Residu_c.
+
+------------------------------------------------------------------------------
+ FUNCTION DESCRIPTION
+
+ Residu_sse2 with blocks of sixteen outputs. The fewer than sixteen outputs
+ left at the start of the signal are handed to Residu_sse2, which stops at
+ the same input_len & 3 as Residu_c since the blocks keep the length
+ modulo 4.
+
+------------------------------------------------------------------------------
+*/
+
+AMRNB_TARGET_AVX2 void Residu_avx2(
+    Word16 coef_ptr[],      /* (i)     : prediction coefficients*/
+    Word16 input_ptr[],     /* (i)     : speech signal          */
+    Word16 residual_ptr[],  /* (o)     : residual signal        */
+    Word16 input_len        /* (i)     : size of filtering      */
+)
+{
+    Word16 i, k;
+    __m256i coef[M / 2 + 1];
+    __m256i round = _mm256_set1_epi16(0x0800);
+
+    for (k = 0; k < M / 2; k++)
+    {
+        coef[k] = amrnb_pair_epi16_256(coef_ptr[2*k], coef_ptr[2*k + 1]);
+    }
+    coef[M / 2] = amrnb_pair_epi16_256(coef_ptr[M], 1);
+
+    for (i = input_len - 16; i >= 0; i -= 16)
+    {
+        __m256i s_lo;
+        __m256i s_hi;
+        __m256i w0 = _mm256_loadu_si256((__m256i *) &input_ptr[i - M]);
+
+        s_lo = _mm256_madd_epi16(_mm256_unpacklo_epi16(w0, round), coef[M / 2]);
+        s_hi = _mm256_madd_epi16(_mm256_unpackhi_epi16(w0, round), coef[M / 2]);
+
+        for (k = 0; k < M / 2; k++)
+        {
+            __m256i w1;
+
+            w0 = _mm256_loadu_si256((__m256i *) &input_ptr[i - 2*k]);
+            w1 = _mm256_loadu_si256((__m256i *) &input_ptr[i - 2*k - 1]);
+            s_lo = _mm256_add_epi32(s_lo, _mm256_madd_epi16(_mm256_unpacklo_epi16(w0, w1), coef[k]));
+            s_hi = _mm256_add_epi32(s_hi, _mm256_madd_epi16(_mm256_unpackhi_epi16(w0, w1), coef[k]));
+        }
+
+        _mm256_storeu_si256((__m256i *) &residual_ptr[i],
+                            amrnb_pack_trunc_epi32_256(_mm256_srai_epi32(s_lo, 12),
+                                                       _mm256_srai_epi32(s_hi, 12)));
+    }
+
+    if (i + 16 > 0)
+    {
+        Residu_sse2(coef_ptr, input_ptr, residual_ptr, i + 16);
+    }
+
+    return;
+}
+#endif
+
+/* Implementation of Residu that residu_cpu_select() selected */
+static void (*Residu_impl)(Word16 coef_ptr[], Word16 input_ptr[],
+                           Word16 residual_ptr[], Word16 input_len) = Residu_c;
+
+/*
+------------------------------------------------------------------------------
+ FUNCTION NAME: Residu
+------------------------------------------------------------------------------
+ INPUT AND OUTPUT DEFINITIONS
+
+ Same as Residu_c.
+
+------------------------------------------------------------------------------
+ FUNCTION DESCRIPTION
+
+ Runs the implementation of Residu that residu_cpu_select() selected
+ (see amrnb_cpu.h).
+
+------------------------------------------------------------------------------
+*/
+
+OSCL_EXPORT_REF void Residu(
+    Word16 coef_ptr[],      /* (i)     : prediction coefficients*/
+    Word16 input_ptr[],     /* (i)     : speech signal          */
+    Word16 residual_ptr[],  /* (o)     : residual signal        */
+    Word16 input_len        /* (i)     : size of filtering      */
+)
+{
+    Residu_impl(coef_ptr, input_ptr, residual_ptr, input_len);
+}
+
+/*
+------------------------------------------------------------------------------
+ FUNCTION NAME: residu_cpu_select
+------------------------------------------------------------------------------
+ INPUT AND OUTPUT DEFINITIONS
+
+ Inputs:
+    features = AMRNB_CPU_* features the kernels may use (Word32)
+
+ Outputs:
+    Residu_impl = the Residu implementation for features
+
+ Returns:
+    None
+
+------------------------------------------------------------------------------
+ FUNCTION DESCRIPTION
+
+ Part of the kernel table of the common library, run when the features in
+ use are set (see amrnb_cpu.h).
+
+------------------------------------------------------------------------------
+*/
+void residu_cpu_select(Word32 features)
+{
+    Residu_impl = Residu_c;
+#if defined(AMRNB_SIMD_SSE2)
+    if (features & AMRNB_CPU_SSE2)
+    {
+        Residu_impl = Residu_sse2;
+    }
+#endif
+#if defined(AMRNB_SIMD_AVX2)
+    if (features & AMRNB_CPU_AVX2)
+    {
+        Residu_impl = Residu_avx2;
+    }
+#endif
+}
@@ -39,6 +39,8 @@ terms listed above has been obtained from the copyright holder.
 #include    "cnst.h"
 #include    "basic_op.h"
 #include    "oscl_mem.h"
+#include    "basic_op_vec.h"
+#include    "amrnb_cpu.h"
 
 #include    "basic_op.h"
 
@@ -172,7 +174,7 @@ void Syn_filt (
 ------------------------------------------------------------------------------
 */
 
-OSCL_EXPORT_REF void Syn_filt(
+void Syn_filt_c(
     Word16 a[],     /* (i)   : a[M+1] prediction coefficients   (M=10)  */
     Word16 x[],     /* (i)   : input signal                             */
     Word16 y[],     /* (o)   : output signal                            */
@@ -323,3 +325,209 @@ OSCL_EXPORT_REF void Syn_filt(
 
     return;
 }
+
+#if defined(AMRNB_SIMD_SSE2)
+/* the output saturation of Syn_filt_c, including its range test; the
+   result is a Word16 value */
+static inline Word32 syn_filt_sat(Word32 s)
+{
+    if ((UWord32) s + 134217728 < 0x0fffffffL)
+    {
+        return (s >> 12);
+    }
+    else if (s > 0x07ffffffL)
+    {
+        return (MAX_16);
+    }
+    return (MIN_16);
+}
+#endif
+
+#if defined(AMRNB_SIMD_SSE2)
+/*
+------------------------------------------------------------------------------
+ FUNCTION NAME: Syn_filt_sse2
+------------------------------------------------------------------------------
+ INPUT AND OUTPUT DEFINITIONS
+
+ Same as Syn_filt_c.
+
+------------------------------------------------------------------------------
+ FUNCTION DESCRIPTION
+
+ Block form of the recursion: for each block of eight outputs, the input
+ term and the part of the feedback sum that only involves outputs of
+ earlier blocks are computed for all eight outputs at once with
+ multiply-adds over the output history (in which the positions of the
+ current block are still zero). Only the remaining triangle of feedback
+ terms, 28 products per block, runs sample by sample. The accumulators wrap
+ around exactly as in Syn_filt_c, and the output saturation is the same, so
+ the result is bit-exact. Like Syn_filt_c, x and y may be the same array and
+ mem may point into it.
+
+------------------------------------------------------------------------------
+*/
+
+void Syn_filt_sse2(
+    Word16 a[],     /* (i)   : a[M+1] prediction coefficients   (M=10)  */
+    Word16 x[],     /* (i)   : input signal                             */
+    Word16 y[],     /* (o)   : output signal                            */
+    Word16 lg,      /* (i)   : size of filtering   (40)                 */
+    Word16 mem[],   /* (i/o) : memory associated with this filtering.   */
+    Word16 update   /* (i)   : 0=no update, 1=update of memory.         */
+)
+{
+    Word16 i, j, k;
+    Word16 yy[M + L_SUBFR + 8];     /* mem[], then the outputs */
+    Word32 p[8];
+    Word32 out[8];
+    Word32 s;
+    __m128i c_x;
+    __m128i c_y[M / 2];
+    __m128i round;
+
+    if (lg > L_SUBFR)
+    {
+        Syn_filt_c(a, x, y, lg, mem, update);
+        return;
+    }
+
+    oscl_memcpy(yy, mem, M*sizeof(Word16));
+    oscl_memset(&yy[M], 0, (L_SUBFR + 8)*sizeof(Word16));
+
+    /* {a[0], 1} against {x[n], 0x800}, {a[k], a[k+1]} against
+       {yy[n-k], yy[n-k-1]} */
+    c_x = amrnb_pair_epi16(a[0], 1);
+    round = _mm_set1_epi16(0x0800);
+    for (k = 0; k < M / 2; k++)
+    {
+        c_y[k] = amrnb_pair_epi16(a[2*k + 1], a[2*k + 2]);
+    }
+
+    for (i = 0; i + 8 <= lg; i += 8)
+    {
+        __m128i vx = _mm_loadu_si128((__m128i *) &x[i]);
+        __m128i x_lo = _mm_madd_epi16(_mm_unpacklo_epi16(vx, round), c_x);
+        __m128i x_hi = _mm_madd_epi16(_mm_unpackhi_epi16(vx, round), c_x);
+        __m128i s_lo = _mm_setzero_si128();
+        __m128i s_hi = _mm_setzero_si128();
+
+        for (k = 0; k < M / 2; k++)
+        {
+            __m128i w0 = _mm_loadu_si128((__m128i *) &yy[M + i - 2*k - 1]);
+            __m128i w1 = _mm_loadu_si128((__m128i *) &yy[M + i - 2*k - 2]);
+
+            s_lo = _mm_add_epi32(s_lo, _mm_madd_epi16(_mm_unpacklo_epi16(w0, w1), c_y[k]));
+            s_hi = _mm_add_epi32(s_hi, _mm_madd_epi16(_mm_unpackhi_epi16(w0, w1), c_y[k]));
+        }
+        _mm_storeu_si128((__m128i *) &p[0], _mm_sub_epi32(x_lo, s_lo));
+        _mm_storeu_si128((__m128i *) &p[4], _mm_sub_epi32(x_hi, s_hi));
+
+        /* feedback from the outputs of this block, kept in registers;
+           a[1] * out[j-1] goes last to keep the dependency chain short */
+        for (j = 0; j < 8; j++)
+        {
+            s = p[j];
+            for (k = 7; k > 0; k--)
+            {
+                if (k <= j)
+                {
+                    s = amrnb_fxp_msu_16_by_16bb((Word32) a[k], out[j - k], s);
+                }
+            }
+            out[j] = syn_filt_sat(s);
+        }
+        for (j = 0; j < 8; j++)
+        {
+            yy[M + i + j] = (Word16) out[j];
+            y[i + j] = (Word16) out[j];
+        }
+    }
+
+    for (; i < lg; i++)
+    {
+        s = amrnb_fxp_mac_16_by_16bb((Word32) x[i], (Word32) a[0], 0x00000800L);
+        for (k = M; k > 0; k--)
+        {
+            s = amrnb_fxp_msu_16_by_16bb((Word32) a[k], (Word32) yy[M + i - k], s);
+        }
+        yy[M + i] = (Word16) syn_filt_sat(s);
+        y[i] = yy[M + i];
+    }
+
+    /* Update of memory if update==1 */
+    if (update != 0)
+    {
+        oscl_memcpy(mem, &y[lg-M], M*sizeof(Word16));
+    }
+
+    return;
+}
+#endif
+
+/* Implementation of Syn_filt that syn_filt_cpu_select() selected */
+static void (*Syn_filt_impl)(Word16 a[], Word16 x[], Word16 y[], Word16 lg,
+                             Word16 mem[], Word16 update) = Syn_filt_c;
+
+/*
+------------------------------------------------------------------------------
+ FUNCTION NAME: Syn_filt
+------------------------------------------------------------------------------
+ INPUT AND OUTPUT DEFINITIONS
+
+ Same as Syn_filt_c.
+
+------------------------------------------------------------------------------
+ FUNCTION DESCRIPTION
+
+ Runs the implementation of Syn_filt that syn_filt_cpu_select() selected
+ (see amrnb_cpu.h).
+
+------------------------------------------------------------------------------
+*/
+
+OSCL_EXPORT_REF void Syn_filt(
+    Word16 a[],     /* (i)   : a[M+1] prediction coefficients   (M=10)  */
+    Word16 x[],     /* (i)   : input signal                             */
+    Word16 y[],     /* (o)   : output signal                            */
+    Word16 lg,      /* (i)   : size of filtering   (40)                 */
+    Word16 mem[],   /* (i/o) : memory associated with this filtering.   */
+    Word16 update   /* (i)   : 0=no update, 1=update of memory.         */
+)
+{
+    Syn_filt_impl(a, x, y, lg, mem, update);
+}
+
+/*
+------------------------------------------------------------------------------
+ FUNCTION NAME: syn_filt_cpu_select
+------------------------------------------------------------------------------
+ INPUT AND OUTPUT DEFINITIONS
+
+ Inputs:
+    features = AMRNB_CPU_* features the kernels may use (Word32)
+
+ Outputs:
+    Syn_filt_impl = the Syn_filt implementation for features
+
+ Returns:
+    None
+
+------------------------------------------------------------------------------
+ FUNCTION DESCRIPTION
+
+ Part of the kernel table of the common library, run when the features in
+ use are set (see amrnb_cpu.h).
+
+------------------------------------------------------------------------------
+*/
+void syn_filt_cpu_select(Word32 features)
+{
+    Syn_filt_impl = Syn_filt_c;
+#if defined(AMRNB_SIMD_SSE2)
+    if (features & AMRNB_CPU_SSE2)
+    {
+        Syn_filt_impl = Syn_filt_sse2;
+    }
+#endif
+}
@@ -6,6 +6,7 @@ LOCAL_SRC_FILES := \
  	src/a_refl.cpp \
  	src/agc.cpp \
  	src/amrdecode.cpp \
+ 	src/amrnb_dec_cpu.cpp \
  	src/b_cn_cod.cpp \
  	src/bgnscd.cpp \
  	src/c_g_aver.cpp \
@@ -58,6 +58,7 @@ terms listed above has been obtained from the copyright holder.
 #include    "cnst.h"
 #include    "inv_sqrt.h"
 #include    "basic_op.h"
+#include    "basic_op_vec.h"
 
 /*----------------------------------------------------------------------------
 ; MACROS
@@ -326,18 +327,13 @@ static Word32 energy_new(       /* o : return energy of signal      */
 )
 
 {
-    Word32  s = 0;
-    Word16  i;
+    Word32  s;
     Flag    ov_save;
 
     ov_save = *(pOverflow);  /* save overflow flag in case energy_old */
     /* must be called                        */
 
-
-    for (i = 0; i < l_trm; i++)
-    {
-        s = L_mac(s, in[i], in[i], pOverflow);
-    }
+    s = amrnb_L_mac_n(0, in, in, l_trm, pOverflow);
 
     /* check for overflow */
     if (s != MAX_32)
@@ -324,6 +324,8 @@ Word16 AMRDecode(
     int tempInt;
     enum RXFrameType rx_type = RX_NO_DATA;
     Word16 dec_ets_input_bfr[MAX_SERIAL_SIZE];
+    Word16 dec_prm[MAX_PRM_SIZE + 1];
+    Word16 *prm_ptr = NULL;
     Word16 i;
     Word16 byte_offset = -1;
 
@@ -338,24 +340,47 @@ Word16 AMRDecode(
     /* WMF or IF2 frames */
     if ((input_format == MIME_IETF) | (input_format == IF2))
     {
+#ifndef CONSOLE_DECODER_REF
+        if (frame_type <= AMR_122)
+        {
+            /* Unpack speech frames straight into codec parameters */
+            prm_ptr = dec_prm;
+        }
+#endif
+
         if (input_format == MIME_IETF)
         {
-            /* Convert incoming packetized raw WMF data to ETS format */
-            wmf_to_ets(frame_type, speech_bits_ptr, dec_ets_input_bfr, &(decoder_state->decoder_amrState.common_amr_tbls));
+            if (prm_ptr != NULL)
+            {
+                wmf_to_prm(frame_type, speech_bits_ptr, prm_ptr, &(decoder_state->decoder_amrState.common_amr_tbls));
+            }
+            else
+            {
+                /* Convert incoming packetized raw WMF data to ETS format */
+                wmf_to_ets(frame_type, speech_bits_ptr, dec_ets_input_bfr, &(decoder_state->decoder_amrState.common_amr_tbls));
+            }
 
             /* Address offset of the start of next frame */
             byte_offset = WmfDecBytesPerFrame[frame_type];
         }
         else   /* else has to be input_format  IF2 */
         {
-            /* Convert incoming packetized raw IF2 data to ETS format */
-            if2_to_ets(frame_type, speech_bits_ptr, dec_ets_input_bfr, &(decoder_state->decoder_amrState.common_amr_tbls));
+            if (prm_ptr != NULL)
+            {
+                if2_to_prm(frame_type, speech_bits_ptr, prm_ptr, &(decoder_state->decoder_amrState.common_amr_tbls));
+            }
+            else
+            {
+                /* Convert incoming packetized raw IF2 data to ETS format */
+                if2_to_ets(frame_type, speech_bits_ptr, dec_ets_input_bfr, &(decoder_state->decoder_amrState.common_amr_tbls));
+            }
 
             /* Address offset of the start of next frame */
             byte_offset = If2DecBytesPerFrame[frame_type];
         }
 
-        /* At this point, input data is in ETS format     */
+        /* At this point, input data is in ETS format (or, for speech, */
+        /* already unpacked into prm_ptr)                              */
         /* Determine AMR codec mode and AMR RX frame type */
         if (frame_type <= AMR_122)
         {
@@ -448,8 +473,16 @@ Word16 AMRDecode(
 
 #ifndef CONSOLE_DECODER_REF
         /* Use PV version of sp_dec.c */
-        GSMFrameDecode(decoder_state, mode, dec_ets_input_bfr, rx_type,
-                       raw_pcm_buffer);
+        if (prm_ptr != NULL)
+        {
+            GSMFrameDecodePrm(decoder_state, mode, prm_ptr, rx_type,
+                              raw_pcm_buffer);
+        }
+        else
+        {
+            GSMFrameDecode(decoder_state, mode, dec_ets_input_bfr, rx_type,
+                           raw_pcm_buffer);
+        }
 
 #else
         /* Use ETS version of sp_dec.c */
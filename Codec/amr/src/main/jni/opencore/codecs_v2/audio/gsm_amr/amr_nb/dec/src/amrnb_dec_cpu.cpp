@@ -0,0 +1,99 @@
+/* ------------------------------------------------------------------
+ * Copyright (C) 1998-2009 PacketVideo
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied.
+ * See the License for the specific language governing permissions
+ * and limitations under the License.
+ * -------------------------------------------------------------------
+ */
+/*
+
+ Filename: amrnb_dec_cpu.cpp
+
+------------------------------------------------------------------------------
+ MODULE DESCRIPTION
+
+ Kernel table of the decoder library (see amrnb_cpu.h).
+
+------------------------------------------------------------------------------
+*/
+
+/*----------------------------------------------------------------------------
+; INCLUDES
+----------------------------------------------------------------------------*/
+#include    "amrnb_dec_cpu.h"
+#include    "amrnb_cpu.h"
+#include    "ph_disp.h"
+#include    "preemph.h"
+
+/*----------------------------------------------------------------------------
+; LOCAL VARIABLE DEFINITIONS
+; Variable declaration - defined here and used outside this module
+----------------------------------------------------------------------------*/
+
+/* The modules of this library with SIMD kernels */
+static const amrnb_cpu_select_fn amrnb_dec_kernels[] =
+{
+    ph_disp_cpu_select,
+    preemph_cpu_select
+};
+
+/*
+------------------------------------------------------------------------------
+ FUNCTION NAME: amrnb_dec_cpu_select
+------------------------------------------------------------------------------
+ INPUT AND OUTPUT DEFINITIONS
+
+ Inputs:
+    features = AMRNB_CPU_* features the kernels may use (Word32)
+
+ Outputs:
+    the kernels of the decoder library point at the implementations for
+    features
+
+ Returns:
+    None
+
+------------------------------------------------------------------------------
+*/
+static void amrnb_dec_cpu_select(Word32 features)
+{
+    Word16 i;
+
+    for (i = 0; i < (Word16)(sizeof(amrnb_dec_kernels) / sizeof(amrnb_dec_kernels[0])); i++)
+    {
+        amrnb_dec_kernels[i](features);
+    }
+}
+
+/*
+------------------------------------------------------------------------------
+ FUNCTION NAME: amrnb_dec_cpu_init
+------------------------------------------------------------------------------
+ INPUT AND OUTPUT DEFINITIONS
+
+ Inputs:
+    None
+
+ Outputs:
+    the kernels of the decoder library point at the implementations for
+    the features in use, and follow amrnb_cpu_set_features() from now on
+
+ Returns:
+    None
+
+------------------------------------------------------------------------------
+*/
+void amrnb_dec_cpu_init(void)
+{
+    amrnb_cpu_register(AMRNB_CPU_TABLE_DEC, amrnb_dec_cpu_select);
+}
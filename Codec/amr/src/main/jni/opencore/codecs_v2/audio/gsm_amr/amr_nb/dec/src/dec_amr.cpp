@@ -80,6 +80,7 @@ terms listed above has been obtained from the copyright holder.
 #include "frame.h"
 #include "b_cn_cod.h"
 #include "basic_op.h"
+#include "log2.h"
 #include "oscl_mem.h"
 
 /*----------------------------------------------------------------------------
@@ -98,6 +99,43 @@ terms listed above has been obtained from the copyright holder.
 ; Function Prototype declaration
 ----------------------------------------------------------------------------*/
 
+/* log2 of the mean square of frame[0..L_FRAME-1] in Q10, computed as in
+   dtx_dec_activity_update() */
+static Word16 frame_log_en(Word16 frame[], Flag *pOverflow)
+{
+    Word16 i;
+    Word16 tmp;
+    Word16 log_en_e;
+    Word16 log_en_m;
+    Word16 scale = 0;
+    Word32 L_frame_en = 0;
+    Flag ov_save = *pOverflow;
+
+    for (i = 0; i < L_FRAME; i++)
+    {
+        L_frame_en = L_mac(L_frame_en, frame[i], frame[i], pOverflow);
+    }
+
+    /* The sum saturates from an rms of about 2600. Redo it on the samples
+       divided by 16, which cannot (2 * L_FRAME * 2048^2 < 2^31), and add
+       log2(16^2) back. The sum is even, so MAX_32 only means saturation. */
+    if (L_frame_en == MAX_32)
+    {
+        *pOverflow = ov_save;
+        L_frame_en = 0;
+        for (i = 0; i < L_FRAME; i++)
+        {
+            tmp = frame[i] >> 4;
+            L_frame_en = L_mac(L_frame_en, tmp, tmp, pOverflow);
+        }
+        scale = 8;
+    }
+    Log2(L_frame_en, &log_en_e, &log_en_m, pOverflow);
+
+    /* divide by 2 * L_FRAME, i.e. subtract 1 + log2(L_FRAME) = 8.32193 */
+    return ((Word16)(((log_en_e + scale) << 10) + (log_en_m >> 5) - (7497 + 1024)));
+}
+
 /*----------------------------------------------------------------------------
 ; LOCAL VARIABLE DEFINITIONS
 ; Variable declaration - defined here and used outside this module
@@ -241,6 +279,10 @@ Word16 Decoder_amr_init(Decoder_amrState *s)
     dtx_dec_reset(&s->dtxDecoderState);
     gc_pred_reset(&s->pred_state);
 
+    s->params.valid = 0;
+    s->record_params = 0;
+    s->params_only = 0;
+
     Decoder_amr_reset(s, MR475);
 
     return(0);
@@ -1347,8 +1389,11 @@ void Decoder_amr(
 
     enum DTXStateType newDTXState;  /* SPEECH , DTX, DTX_MUTE */
     Flag   *pOverflow = &(st->overflow);     /* Overflow flag            */
+    Flag   record = st->record_params || st->params_only; /* fill st->params */
 
 
+    st->params.valid = 0;
+
     /* find the new  DTX state  SPEECH OR DTX */
     newDTXState = rx_dtx_handler(&(st->dtxDecoderState), frame_type, pOverflow);
 
@@ -1379,6 +1424,15 @@ void Decoder_amr(
             st->lsfState.past_lsf_q,
             pOverflow);
 
+        if (record)
+        {
+            oscl_memset(st->params.T0, 0, sizeof(st->params.T0));
+            oscl_memset(st->params.gain_pit, 0, sizeof(st->params.gain_pit));
+            oscl_memset(st->params.gain_code, 0, sizeof(st->params.gain_code));
+            oscl_memcpy(st->params.lsf, st->lsfState.past_lsf_q, M*sizeof(Word16));
+            st->params.energy = frame_log_en(synth, pOverflow);
+        }
+
         goto the_end;
     }
 
@@ -1469,6 +1523,14 @@ void Decoder_amr(
             lsp_new,
             A_t,
             pOverflow);
+
+        if (record)
+        {
+            for (i = 0; i < M; i++)
+            {
+                st->params.lsp_mid[i] = (st->lsp_old[i] >> 1) + (lsp_new[i] >> 1);
+            }
+        }
     }
     else
     {
@@ -1490,6 +1552,17 @@ void Decoder_amr(
             lsp_new,
             A_t,
             pOverflow);
+
+        if (record)
+        {
+            oscl_memcpy(st->params.lsp_mid, lsp_mid, M*sizeof(Word16));
+        }
+    }
+
+    if (record)
+    {
+        oscl_memcpy(st->params.lsp_old, st->lsp_old, M*sizeof(Word16));
+        oscl_memcpy(st->params.lsp_new, lsp_new, M*sizeof(Word16));
     }
 
     /* update the LSPs for the next frame */
@@ -2042,6 +2115,12 @@ void Decoder_amr(
             st->ltpGainHistory[8] = gain_pit;
         }
 
+        if (record)
+        {
+            st->params.gain_pit[subfrNr] = gain_pit;
+            st->params.gain_code[subfrNr] = gain_code;
+        }
+
         /*-------------------------------------------------------*
         * - Limit gain_pit if in background noise and BFI       *
         *   for MR475, MR515, MR59                              *
@@ -2067,33 +2146,39 @@ void Decoder_amr(
         /*-------------------------------------------------------*
          *  Calculate CB mixed gain                              *
          *-------------------------------------------------------*/
-        Int_lsf(
-            prev_lsf,
-            st->lsfState.past_lsf_q,
-            i_subfr,
-            lsf_i,
-            pOverflow);
+        /* smoothed gain for the phase dispersion, skipped with it below */
+        gain_code_mix = gain_code;
 
-        gain_code_mix =
-            Cb_gain_average(
-                &(st->Cb_gain_averState),
-                mode,
-                gain_code,
+        if (!st->params_only)
+        {
+            Int_lsf(
+                prev_lsf,
+                st->lsfState.past_lsf_q,
+                i_subfr,
                 lsf_i,
-                st->lsp_avg_st.lsp_meanSave,
-                bfi,
-                st->prev_bf,
-                pdfi,
-                st->prev_pdf,
-                st->inBackgroundNoise,
-                st->voicedHangover,
                 pOverflow);
 
-        /* make sure that MR74, MR795, MR122 have original code_gain*/
-        if ((mode > MR67) && (mode != MR102))
-            /* MR74, MR795, MR122 */
-        {
-            gain_code_mix = gain_code;
+            gain_code_mix =
+                Cb_gain_average(
+                    &(st->Cb_gain_averState),
+                    mode,
+                    gain_code,
+                    lsf_i,
+                    st->lsp_avg_st.lsp_meanSave,
+                    bfi,
+                    st->prev_bf,
+                    pdfi,
+                    st->prev_pdf,
+                    st->inBackgroundNoise,
+                    st->voicedHangover,
+                    pOverflow);
+
+            /* make sure that MR74, MR795, MR122 have original code_gain*/
+            if ((mode > MR67) && (mode != MR102))
+                /* MR74, MR795, MR122 */
+            {
+                gain_code_mix = gain_code;
+            }
         }
 
         /*-------------------------------------------------------*
@@ -2139,29 +2224,37 @@ void Decoder_amr(
         /*-------------------------------------------------------*
          * - Adaptive phase dispersion                           *
          *-------------------------------------------------------*/
-        ph_disp_release(&(st->ph_disp_st)); /* free phase dispersion adaption */
+        if (st->params_only)
+        {
+            /* synthesize the total excitation as it is */
+            oscl_memcpy(exc_enhanced, st->exc, L_SUBFR*sizeof(Word16));
+        }
+        else
+        {
+            ph_disp_release(&(st->ph_disp_st)); /* free phase dispersion adaption */
 
 
-        if (((mode == MR475) || (mode == MR515) || (mode == MR59)) &&
-                (st->voicedHangover > 3) && (st->inBackgroundNoise != 0) &&
-                (bfi != 0))
-        {
-            ph_disp_lock(&(st->ph_disp_st)); /* Always Use full Phase Disp. */
-        }                                 /* if error in bg noise       */
+            if (((mode == MR475) || (mode == MR515) || (mode == MR59)) &&
+                    (st->voicedHangover > 3) && (st->inBackgroundNoise != 0) &&
+                    (bfi != 0))
+            {
+                ph_disp_lock(&(st->ph_disp_st)); /* Always Use full Phase Disp. */
+            }                                 /* if error in bg noise       */
 
-        /* apply phase dispersion to innovation (if enabled) and
-           compute total excitation for synthesis part           */
-        ph_disp(
-            &(st->ph_disp_st),
-            mode,
-            exc_enhanced,
-            gain_code_mix,
-            gain_pit,
-            code,
-            pitch_fac,
-            tmp_shift,
-            &(st->common_amr_tbls),
-            pOverflow);
+            /* apply phase dispersion to innovation (if enabled) and
+               compute total excitation for synthesis part           */
+            ph_disp(
+                &(st->ph_disp_st),
+                mode,
+                exc_enhanced,
+                gain_code_mix,
+                gain_pit,
+                code,
+                pitch_fac,
+                tmp_shift,
+                &(st->common_amr_tbls),
+                pOverflow);
+        }
 
         /*-------------------------------------------------------*
          * - The Excitation control module are active during BFI.*
@@ -2228,7 +2321,7 @@ void Decoder_amr(
         /*-------------------------------------------------------*
          * Excitation control module end.                        *
          *-------------------------------------------------------*/
-        if (pit_sharp > 16384)
+        if ((pit_sharp > 16384) && !st->params_only)
         {
             for (i = 0; i < L_SUBFR; i++)
             {
@@ -2292,6 +2385,10 @@ void Decoder_amr(
 
         /* store T0 for next subframe */
         st->old_T0 = T0;
+        if (record)
+        {
+            st->params.T0[subfrNr] = T0;
+        }
     }
 
     /*-------------------------------------------------------*
@@ -2317,6 +2414,13 @@ void Decoder_amr(
     st->prev_bf = bfi;
     st->prev_pdf = pdfi;
 
+    if (record)
+    {
+        st->params.valid = (bfi == 0);
+        oscl_memcpy(st->params.lsf, st->lsfState.past_lsf_q, M*sizeof(Word16));
+        st->params.energy = frame_log_en(synth, pOverflow);
+    }
+
     /*--------------------------------------------------*
      * Calculate the LSF averages on the eight          *
      * previous frames                                  *
@@ -98,6 +98,21 @@ extern "C"
     /*----------------------------------------------------------------------------
     ; STRUCTURES TYPEDEF'S
     ----------------------------------------------------------------------------*/
+    /* Parameters of the last frame decoded, e.g. for transcoding; */
+    /* only filled in with record_params or params_only set        */
+    typedef struct
+    {
+        Word16 valid;          /* set after a good speech frame            */
+        Word16 lsp_old[M];     /* LSPs at the end of the previous frame    */
+        Word16 lsp_mid[M];     /* LSPs at the 2nd subframe                 */
+        Word16 lsp_new[M];     /* LSPs at the 4th subframe                 */
+        Word16 lsf[M];         /* LSFs at the 4th subframe, Q15 (0..0.5)   */
+        Word16 T0[4];          /* integer pitch lag of each subframe       */
+        Word16 gain_pit[4];    /* pitch gain of each subframe, Q14         */
+        Word16 gain_code[4];   /* codebook gain of each subframe, Q1       */
+        Word16 energy;         /* log2 of the mean square of synth[], Q10  */
+    } Decoder_amrParams;
+
     typedef struct
     {
         /* Excitation vector */
@@ -143,6 +158,14 @@ extern "C"
         dtx_decState dtxDecoderState;
         Flag overflow;
         CommonAmrTbls common_amr_tbls;
+
+        Decoder_amrParams params;
+        /* If set, params is filled in for every frame                   */
+        Flag record_params;
+        /* If set, decode the parameters only: the excitation is not     */
+        /* enhanced and synth[] is not post-filtered (GSMFrameDecodePrm) */
+        /* params is filled in as with record_params                     */
+        Flag params_only;
     } Decoder_amrState;
 
     /*----------------------------------------------------------------------------
@@ -30,7 +30,7 @@ terms listed above has been obtained from the copyright holder.
 ------------------------------------------------------------------------------
 
  Filename: if2_to_ets.cpp
- Funtions: if2_to_ets
+ Funtions: if2_to_ets, if2_to_prm
 
 */
 
@@ -181,3 +181,69 @@ void if2_to_ets(
 
     return;
 }
+
+/*
+------------------------------------------------------------------------------
+ FUNCTION NAME: if2_to_prm
+------------------------------------------------------------------------------
+ INPUT AND OUTPUT DEFINITIONS
+
+ Inputs:
+    frame_type_3gpp = speech bit rate, AMR_475 .. AMR_122 (enum Frame_Type_3GPP)
+    if2_input_ptr   = pointer to input encoded speech bits in IF2 format (Word8)
+    prm             = pointer to output codec parameters (Word16)
+
+ Outputs:
+    prm             = the prmno[] parameters of the frame (Word16)
+
+ Returns:
+    None
+
+ Global Variables Used:
+    prmno, numOfBits, packBits (see bitreorder_tab.cpp)
+
+------------------------------------------------------------------------------
+ FUNCTION DESCRIPTION
+
+ Produces the same parameters as if2_to_ets() followed by Bits2prm() for a
+ speech frame, moving each bit of the IF2 bytes (first bit in bit 4 of the
+ first byte, then LSB first) straight into the parameter bit that packBits
+ names for it.
+
+------------------------------------------------------------------------------
+*/
+void if2_to_prm(
+    enum Frame_Type_3GPP frame_type_3gpp,
+    UWord8   *if2_input_ptr,
+    Word16   *prm,
+    CommonAmrTbls* common_amr_tbls)
+{
+    Word16 i;
+    Word16 e;
+    Word16 pos;
+    UWord32 accum = *(if2_input_ptr++) >> 4;
+    const Word16 *pack_tbl = common_amr_tbls->packBits_ptr[frame_type_3gpp];
+    Word16 n = common_amr_tbls->numOfBits_ptr[frame_type_3gpp];
+
+    for (i = common_amr_tbls->prmno_ptr[frame_type_3gpp] - 1; i >= 0; i--)
+    {
+        prm[i] = 0;
+    }
+
+    pos = 4;
+    for (i = 0; i < n; i++)
+    {
+        if (pos == 8)
+        {
+            accum = *(if2_input_ptr++);
+            pos = 0;
+        }
+
+        e = pack_tbl[i];
+        prm[e >> 4] |= (Word16)((accum & 1) << (e & 15));
+        accum >>= 1;
+        pos++;
+    }
+
+    return;
+}
@@ -99,6 +99,12 @@ extern "C"
     Word16   *ets_output_ptr,
     CommonAmrTbls* common_amr_tbls);
 
+    /* Speech frames only: same output as if2_to_ets() + Bits2prm() */
+    void if2_to_prm(enum Frame_Type_3GPP frame_type_3gpp,
+                    UWord8   *if2_input_ptr,
+                    Word16   *prm,
+                    CommonAmrTbls* common_amr_tbls);
+
 
 
     /*----------------------------------------------------------------------------
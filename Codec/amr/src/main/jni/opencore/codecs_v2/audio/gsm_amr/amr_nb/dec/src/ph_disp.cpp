@@ -56,6 +56,9 @@ terms listed above has been obtained from the copyright holder.
 #include "typedef.h"
 #include "basic_op.h"
 #include "cnst.h"
+#include "basic_op_vec.h"
+#include "oscl_mem.h"
+#include "amrnb_cpu.h"
 
 /*----------------------------------------------------------------------------
 ; MACROS
@@ -290,6 +293,366 @@ void ph_disp_release(ph_dispState *state)
 
 /****************************************************************************/
 
+/*
+------------------------------------------------------------------------------
+ FUNCTION NAME: disperse_c
+------------------------------------------------------------------------------
+ INPUT AND OUTPUT DEFINITIONS
+
+ Inputs:
+    inno = innovation buffer, cleared (Word16)
+    inno_sav = saved innovation (Word16)
+    ps_poss = positions of the nonzero pulses of inno_sav (Word16)
+    nze = number of nonzero pulses (Word16)
+    ph_imp = pointer to the phase dispersion filter (const Word16)
+    pOverflow = pointer to overflow indicator (Flag)
+
+ Outputs:
+    inno buffer contains the dispersed innovation
+    pOverflow -> 1 if there is overflow
+
+ Returns:
+    None
+
+------------------------------------------------------------------------------
+ FUNCTION DESCRIPTION
+
+ Adds the circular convolution of every pulse with the impulse response
+ to inno[], pulse by pulse.
+
+------------------------------------------------------------------------------
+*/
+
+static void disperse_c(
+    Word16 inno[],
+    const Word16 inno_sav[],
+    const Word16 ps_poss[],
+    Word16 nze,
+    const Word16 *ph_imp,
+    Flag   *pOverflow
+)
+{
+    register Word16 i;
+    register Word16 nPulse;
+    Word16 ppos;
+    Word16 c_inno_sav;
+    Word16 tmp1;
+    Word32 L_temp;
+    Word16 *p_inno;
+    const Word16 *p_ph_imp;
+
+    for (nPulse = 0; nPulse < nze; nPulse++)
+    {
+        ppos = ps_poss[nPulse];
+
+        /* circular convolution with impulse response */
+        c_inno_sav = inno_sav[ppos];
+        p_inno = &inno[ppos];
+        p_ph_imp = ph_imp;
+
+        for (i = ppos; i < L_SUBFR; i++)
+        {
+            /* inno[i1] += inno_sav[ppos] * ph_imp[i1-ppos] */
+            L_temp = ((Word32) c_inno_sav * *(p_ph_imp++)) >> 15;
+            tmp1 = (Word16) L_temp;
+            *(p_inno) = add_16(*(p_inno), tmp1, pOverflow);
+            p_inno += 1;
+        }
+
+        p_inno = &inno[0];
+
+        for (i = 0; i < ppos; i++)
+        {
+            /* inno[i] += inno_sav[ppos] * ph_imp[L_SUBFR-ppos+i] */
+            L_temp = ((Word32) c_inno_sav * *(p_ph_imp++)) >> 15;
+            tmp1 = (Word16) L_temp;
+            *(p_inno) = add_16(*(p_inno), tmp1, pOverflow);
+            p_inno += 1;
+        }
+    }
+}
+
+#if defined(AMRNB_SIMD_SSE2)
+/*
+------------------------------------------------------------------------------
+ FUNCTION NAME: disperse_sse2
+------------------------------------------------------------------------------
+ INPUT AND OUTPUT DEFINITIONS
+
+ Same as disperse_c.
+
+------------------------------------------------------------------------------
+ FUNCTION DESCRIPTION
+
+ Keeps inno[] in registers and adds each pulse eight samples at a time,
+ reading the impulse response from a doubled copy so that the wrap-around
+ of the circular convolution becomes a plain offset. The pulses are still
+ added in order, so every saturation happens as in disperse_c.
+
+------------------------------------------------------------------------------
+*/
+
+static void disperse_sse2(
+    Word16 inno[],
+    const Word16 inno_sav[],
+    const Word16 ps_poss[],
+    Word16 nze,
+    const Word16 *ph_imp,
+    Flag   *pOverflow
+)
+{
+    Word16 i;
+    Word16 nPulse;
+    Word16 ph_imp2[2*L_SUBFR];
+    const Word16 *p_ph_imp;
+    __m128i c;
+    __m128i ovf = _mm_setzero_si128();
+    __m128i acc[L_SUBFR / 8];
+
+    oscl_memcpy(ph_imp2, ph_imp, L_SUBFR * sizeof(*ph_imp));
+    oscl_memcpy(&ph_imp2[L_SUBFR], ph_imp, L_SUBFR * sizeof(*ph_imp));
+
+    for (i = 0; i < L_SUBFR / 8; i++)
+    {
+        acc[i] = _mm_loadu_si128((__m128i *) &inno[8*i]);
+    }
+
+    for (nPulse = 0; nPulse < nze; nPulse++)
+    {
+        /* inno[i] += inno_sav[ppos] * ph_imp[(i - ppos) mod L_SUBFR] */
+        c = _mm_set1_epi16(inno_sav[ps_poss[nPulse]]);
+        p_ph_imp = &ph_imp2[L_SUBFR - ps_poss[nPulse]];
+
+        for (i = 0; i < L_SUBFR / 8; i++)
+        {
+            acc[i] = amrnb_adds_ovf_epi16(acc[i],
+                                          amrnb_mul_shr15_epi16(c, _mm_loadu_si128((__m128i *) &p_ph_imp[8*i])),
+                                          &ovf);
+        }
+    }
+
+    for (i = 0; i < L_SUBFR / 8; i++)
+    {
+        _mm_storeu_si128((__m128i *) &inno[8*i], acc[i]);
+    }
+
+    if (_mm_movemask_epi8(ovf) != 0)
+    {
+        *pOverflow = 1;
+    }
+}
+#endif
+
+/* Implementation of disperse that ph_disp_cpu_select() selected */
+static void (*disperse_impl)(Word16 inno[], const Word16 inno_sav[],
+                             const Word16 ps_poss[], Word16 nze,
+                             const Word16 *ph_imp,
+                             Flag *pOverflow) = disperse_c;
+
+/*
+------------------------------------------------------------------------------
+ FUNCTION NAME: disperse
+------------------------------------------------------------------------------
+ INPUT AND OUTPUT DEFINITIONS
+
+ Same as disperse_c.
+
+------------------------------------------------------------------------------
+ FUNCTION DESCRIPTION
+
+ Runs the implementation of disperse that ph_disp_cpu_select() selected
+ (see amrnb_cpu.h).
+
+------------------------------------------------------------------------------
+*/
+
+static void disperse(
+    Word16 inno[],
+    const Word16 inno_sav[],
+    const Word16 ps_poss[],
+    Word16 nze,
+    const Word16 *ph_imp,
+    Flag   *pOverflow
+)
+{
+    disperse_impl(inno, inno_sav, ps_poss, nze, ph_imp, pOverflow);
+}
+
+/*
+------------------------------------------------------------------------------
+ FUNCTION NAME: total_exc_c
+------------------------------------------------------------------------------
+ INPUT AND OUTPUT DEFINITIONS
+
+ Inputs:
+    x = LTP excitation signal buffer (Word16)
+    inno = innovation buffer (Word16)
+    pitch_fac = pitch factor used to scale the LTP excitation (Word16)
+    cbGain = codebook gain (Word16)
+    tmp_shift = shift factor applied to the sum before rounding (Word16)
+    pOverflow = pointer to overflow indicator (Flag)
+
+ Outputs:
+    x buffer contains the total excitation signal
+    pOverflow -> 1 if there is overflow
+
+ Returns:
+    None
+
+------------------------------------------------------------------------------
+ FUNCTION DESCRIPTION
+
+ Computes x[i] = round((pitch_fac * x[i] + cbGain * inno[i]) << tmp_shift).
+
+------------------------------------------------------------------------------
+*/
+
+static void total_exc_c(
+    Word16 x[],
+    Word16 inno[],
+    Word16 pitch_fac,
+    Word16 cbGain,
+    Word16 tmp_shift,
+    Flag   *pOverflow
+)
+{
+    register Word16 i;
+    Word32 L_temp;
+    Word32 L_temp2;
+    Word16 *p_inno = &inno[0];
+    Word16 *p_x = &x[0];
+
+    for (i = 0; i < L_SUBFR; i++)
+    {
+        /* x[i] = gain_pit*x[i] + cbGain*code[i]; */
+        L_temp = L_mult(x[i], pitch_fac, pOverflow);
+        /* 12.2: Q0 * Q13 */
+        /*  7.4: Q0 * Q14 */
+        L_temp2 = ((Word32) * (p_inno++) * cbGain) << 1;
+        L_temp = L_add(L_temp, L_temp2, pOverflow);
+        /* 12.2: Q12 * Q1 */
+        /*  7.4: Q13 * Q1 */
+        L_temp = L_shl(L_temp, tmp_shift, pOverflow);                  /* Q16 */
+        *(p_x++) = pv_round(L_temp, pOverflow);
+    }
+}
+
+#if defined(AMRNB_SIMD_SSE2)
+/*
+------------------------------------------------------------------------------
+ FUNCTION NAME: total_exc_sse2
+------------------------------------------------------------------------------
+ INPUT AND OUTPUT DEFINITIONS
+
+ Same as total_exc_c.
+
+------------------------------------------------------------------------------
+ FUNCTION DESCRIPTION
+
+ With neither gain at -32768, s = pitch_fac * x[i] + cbGain * inno[i] is
+ exact in 32 bits and the L_mult / L_add / L_shl chain of total_exc_c is
+ s << (1 + tmp_shift), saturated; only L_add and pv_round report their
+ saturation, as L_shl does not. Other gains and shifts use total_exc_c.
+
+------------------------------------------------------------------------------
+*/
+
+static void total_exc_sse2(
+    Word16 x[],
+    Word16 inno[],
+    Word16 pitch_fac,
+    Word16 cbGain,
+    Word16 tmp_shift,
+    Flag   *pOverflow
+)
+{
+    Word16 i;
+    Word16 j;
+    __m128i coef;
+    __m128i sh;
+    __m128i vx;
+    __m128i vi;
+    __m128i s[2];
+    __m128i L;
+    __m128i sat;
+    __m128i max_32 = _mm_set1_epi32(MAX_32);
+    __m128i ovf = _mm_setzero_si128();
+
+    if (pitch_fac == MIN_16 || cbGain == MIN_16 || tmp_shift < 0 || tmp_shift > 14)
+    {
+        total_exc_c(x, inno, pitch_fac, cbGain, tmp_shift, pOverflow);
+        return;
+    }
+
+    coef = amrnb_pair_epi16(pitch_fac, cbGain);
+    sh = _mm_cvtsi32_si128(tmp_shift + 1);
+
+    for (i = 0; i < L_SUBFR; i += 8)
+    {
+        vx = _mm_loadu_si128((__m128i *) &x[i]);
+        vi = _mm_loadu_si128((__m128i *) &inno[i]);
+        s[0] = _mm_madd_epi16(_mm_unpacklo_epi16(vx, vi), coef);
+        s[1] = _mm_madd_epi16(_mm_unpackhi_epi16(vx, vi), coef);
+
+        for (j = 0; j < 2; j++)
+        {
+            /* L_add saturates when s + s overflows */
+            ovf = _mm_or_si128(ovf, _mm_srai_epi32(_mm_xor_si128(_mm_add_epi32(s[j], s[j]), s[j]), 31));
+
+            L = _mm_sll_epi32(s[j], sh);
+            sat = _mm_cmpeq_epi32(_mm_sra_epi32(L, sh), s[j]);
+            L = _mm_or_si128(_mm_and_si128(sat, L),
+                             _mm_andnot_si128(sat, _mm_xor_si128(_mm_srai_epi32(s[j], 31), max_32)));
+
+            /* pv_round: (L + 0x8000) >> 16 reaches 32768 where L_add saturates */
+            s[j] = _mm_srai_epi32(_mm_add_epi32(_mm_srai_epi32(L, 15), _mm_set1_epi32(1)), 1);
+            ovf = _mm_or_si128(ovf, _mm_cmpeq_epi32(s[j], _mm_set1_epi32(32768)));
+        }
+
+        _mm_storeu_si128((__m128i *) &x[i], _mm_packs_epi32(s[0], s[1]));
+    }
+
+    if (_mm_movemask_epi8(ovf) != 0)
+    {
+        *pOverflow = 1;
+    }
+}
+#endif
+
+/* Implementation of total_exc that ph_disp_cpu_select() selected */
+static void (*total_exc_impl)(Word16 x[], Word16 inno[], Word16 pitch_fac,
+                              Word16 cbGain, Word16 tmp_shift,
+                              Flag *pOverflow) = total_exc_c;
+
+/*
+------------------------------------------------------------------------------
+ FUNCTION NAME: total_exc
+------------------------------------------------------------------------------
+ INPUT AND OUTPUT DEFINITIONS
+
+ Same as total_exc_c.
+
+------------------------------------------------------------------------------
+ FUNCTION DESCRIPTION
+
+ Runs the implementation of total_exc that ph_disp_cpu_select() selected
+ (see amrnb_cpu.h).
+
+------------------------------------------------------------------------------
+*/
+
+static void total_exc(
+    Word16 x[],
+    Word16 inno[],
+    Word16 pitch_fac,
+    Word16 cbGain,
+    Word16 tmp_shift,
+    Flag   *pOverflow
+)
+{
+    total_exc_impl(x, inno, pitch_fac, cbGain, tmp_shift, pOverflow);
+}
+
 /*
 ------------------------------------------------------------------------------
  FUNCTION NAME: ph_disp
@@ -563,20 +926,15 @@ void ph_disp(
     register Word16 i, i1;
     register Word16 tmp1;
     Word32 L_temp;
-    Word32 L_temp2;
     Word16 impNr;           /* indicator for amount of disp./filter used */
 
     Word16 inno_sav[L_SUBFR];
     Word16 ps_poss[L_SUBFR];
-    register Word16 nze, nPulse;
-    Word16 ppos;
+    register Word16 nze;
     const Word16 *ph_imp;   /* Pointer to phase dispersion filter */
 
     Word16 *p_inno;
     Word16 *p_inno_sav;
-    Word16 *p_x;
-    const Word16 *p_ph_imp;
-    Word16 c_inno_sav;
 
     const Word16* ph_imp_low_MR795_ptr = common_amr_tbls->ph_imp_low_MR795_ptr;
     const Word16* ph_imp_mid_MR795_ptr = common_amr_tbls->ph_imp_mid_MR795_ptr;
@@ -742,55 +1100,49 @@ void ph_disp(
         }
 
         /* Do phase dispersion of innovation */
-        for (nPulse = 0; nPulse < nze; nPulse++)
-        {
-            ppos = ps_poss[nPulse];
+        disperse(inno, inno_sav, ps_poss, nze, ph_imp, pOverflow);
+    }
 
-            /* circular convolution with impulse response */
-            c_inno_sav = inno_sav[ppos];
-            p_inno = &inno[ppos];
-            p_ph_imp = ph_imp;
+    /* compute total excitation for synthesis part of decoder
+       (using modified innovation if phase dispersion is active) */
+    total_exc(x, inno, pitch_fac, cbGain, tmp_shift, pOverflow);
 
-            for (i = ppos; i < L_SUBFR; i++)
-            {
-                /* inno[i1] += inno_sav[ppos] * ph_imp[i1-ppos] */
-                L_temp = ((Word32) c_inno_sav * *(p_ph_imp++)) >> 15;
-                tmp1 = (Word16) L_temp;
-                *(p_inno) = add_16(*(p_inno), tmp1, pOverflow);
-                p_inno += 1;
-            }
+    return;
+}
 
-            p_inno = &inno[0];
+/*
+------------------------------------------------------------------------------
+ FUNCTION NAME: ph_disp_cpu_select
+------------------------------------------------------------------------------
+ INPUT AND OUTPUT DEFINITIONS
 
-            for (i = 0; i < ppos; i++)
-            {
-                /* inno[i] += inno_sav[ppos] * ph_imp[L_SUBFR-ppos+i] */
-                L_temp = ((Word32) c_inno_sav * *(p_ph_imp++)) >> 15;
-                tmp1 = (Word16) L_temp;
-                *(p_inno) = add_16(*(p_inno), tmp1, pOverflow);
-                p_inno += 1;
-            }
-        }
-    }
+ Inputs:
+    features = AMRNB_CPU_* features the kernels may use (Word32)
 
-    /* compute total excitation for synthesis part of decoder
-       (using modified innovation if phase dispersion is active) */
-    p_inno = &inno[0];
-    p_x = &x[0];
+ Outputs:
+    disperse_impl = the disperse implementation for features
+    total_exc_impl = the total_exc implementation for features
 
-    for (i = 0; i < L_SUBFR; i++)
+ Returns:
+    None
+
+------------------------------------------------------------------------------
+ FUNCTION DESCRIPTION
+
+ Part of the kernel table of the decoder library, run when the features in
+ use are set (see amrnb_cpu.h).
+
+------------------------------------------------------------------------------
+*/
+void ph_disp_cpu_select(Word32 features)
+{
+    disperse_impl = disperse_c;
+    total_exc_impl = total_exc_c;
+#if defined(AMRNB_SIMD_SSE2)
+    if (features & AMRNB_CPU_SSE2)
     {
-        /* x[i] = gain_pit*x[i] + cbGain*code[i]; */
-        L_temp = L_mult(x[i], pitch_fac, pOverflow);
-        /* 12.2: Q0 * Q13 */
-        /*  7.4: Q0 * Q14 */
-        L_temp2 = ((Word32) * (p_inno++) * cbGain) << 1;
-        L_temp = L_add(L_temp, L_temp2, pOverflow);
-        /* 12.2: Q12 * Q1 */
-        /*  7.4: Q13 * Q1 */
-        L_temp = L_shl(L_temp, tmp_shift, pOverflow);                  /* Q16 */
-        *(p_x++) = pv_round(L_temp, pOverflow);
+        disperse_impl = disperse_sse2;
+        total_exc_impl = total_exc_sse2;
     }
-
-    return;
+#endif
 }
@@ -162,6 +162,10 @@ extern "C"
         Flag   *pOverflow       /* i/o     : oveflow indicator                  */
     );
 
+    /* Selects the implementation of disperse and total_exc for the
+       AMRNB_CPU_* features (see amrnb_cpu.h) */
+    void ph_disp_cpu_select(Word32 features);
+
     /*----------------------------------------------------------------------------
     ; END
     ----------------------------------------------------------------------------*/
@@ -49,6 +49,8 @@ terms listed above has been obtained from the copyright holder.
 #include "preemph.h"
 #include "typedef.h"
 #include "basic_op.h"
+#include "basic_op_vec.h"
+#include "amrnb_cpu.h"
 
 /*----------------------------------------------------------------------------
 ; MACROS
@@ -134,7 +136,7 @@ Word16 preemphasis_reset(preemphasisState *state)
 
 /*
 ------------------------------------------------------------------------------
- FUNCTION NAME:  preemphasis
+ FUNCTION NAME:  preemphasis_c
 ------------------------------------------------------------------------------
  INPUT AND OUTPUT DEFINITIONS
 
@@ -183,7 +185,7 @@ Word16 preemphasis_reset(preemphasisState *state)
 */
 
 
-void preemphasis(
+void preemphasis_c(
     preemphasisState *st, /* (i/o) : preemphasis filter state               */
     Word16 *signal,       /* (i/o) : input signal overwritten by the output */
     Word16 g,             /* (i)   : preemphasis coefficient                */
@@ -218,5 +220,148 @@ void preemphasis(
     return;
 }
 
+#if defined(AMRNB_SIMD_SSE2)
+/*
+------------------------------------------------------------------------------
+ FUNCTION NAME: preemphasis_sse2
+------------------------------------------------------------------------------
+ INPUT AND OUTPUT DEFINITIONS
+
+ Same as preemphasis_c.
+
+------------------------------------------------------------------------------
+ FUNCTION DESCRIPTION
+
+ Every output is signal[i] - g * signal[i-1] of the input samples, so the
+ blocks of eight are filtered from the end of the signal, before their
+ preceding samples are overwritten. The leading L % 8 samples and a g of
+ -32768, for which mult() saturates, use the code of preemphasis_c.
+
+------------------------------------------------------------------------------
+*/
+
+void preemphasis_sse2(
+    preemphasisState *st, /* (i/o) : preemphasis filter state               */
+    Word16 *signal,       /* (i/o) : input signal overwritten by the output */
+    Word16 g,             /* (i)   : preemphasis coefficient                */
+    Word16 L,             /* (i)   : size of filtering                      */
+    Flag  *pOverflow      /* (o)   : overflow indicator                     */
+)
+{
+    Word16 i;
+    Word16 temp;
+    __m128i vg;
+    __m128i cur;
+    __m128i prev;
+    __m128i ovf = _mm_setzero_si128();
+
+    if (g == MIN_16 || L < 8)
+    {
+        preemphasis_c(st, signal, g, L, pOverflow);
+        return;
+    }
+
+    vg = _mm_set1_epi16(g);
+    temp = signal[L - 1];
+
+    for (i = L - 8; i >= 0; i -= 8)
+    {
+        cur = _mm_loadu_si128((__m128i *) &signal[i]);
+        if (i > 0)
+        {
+            prev = _mm_loadu_si128((__m128i *) &signal[i - 1]);
+        }
+        else
+        {
+            prev = _mm_insert_epi16(_mm_slli_si128(cur, 2), st->mem_pre, 0);
+        }
+        _mm_storeu_si128((__m128i *) &signal[i],
+                         amrnb_subs_ovf_epi16(cur, amrnb_mul_shr15_epi16(vg, prev), &ovf));
+    }
+
+    /* the first L % 8 samples */
+    for (i += 7; i > 0; i--)
+    {
+        signal[i] = sub(signal[i], mult(g, signal[i - 1], pOverflow), pOverflow);
+    }
+    if (i == 0)
+    {
+        signal[0] = sub(signal[0], mult(g, st->mem_pre, pOverflow), pOverflow);
+    }
+
+    st->mem_pre = temp;
+
+    if (_mm_movemask_epi8(ovf) != 0)
+    {
+        *pOverflow = 1;
+    }
+
+    return;
+}
+#endif
+
+/* Implementation of preemphasis that preemph_cpu_select() selected */
+static void (*preemphasis_impl)(preemphasisState *st, Word16 *signal, Word16 g,
+                                Word16 L, Flag *pOverflow) = preemphasis_c;
 
+/*
+------------------------------------------------------------------------------
+ FUNCTION NAME: preemphasis
+------------------------------------------------------------------------------
+ INPUT AND OUTPUT DEFINITIONS
+
+ Same as preemphasis_c.
+
+------------------------------------------------------------------------------
+ FUNCTION DESCRIPTION
+
+ Runs the implementation of preemphasis that preemph_cpu_select() selected
+ (see amrnb_cpu.h).
+
+------------------------------------------------------------------------------
+*/
+
+void preemphasis(
+    preemphasisState *st, /* (i/o) : preemphasis filter state               */
+    Word16 *signal,       /* (i/o) : input signal overwritten by the output */
+    Word16 g,             /* (i)   : preemphasis coefficient                */
+    Word16 L,             /* (i)   : size of filtering                      */
+    Flag  *pOverflow      /* (o)   : overflow indicator                     */
+)
+{
+    preemphasis_impl(st, signal, g, L, pOverflow);
+}
 
+/*
+------------------------------------------------------------------------------
+ FUNCTION NAME: preemph_cpu_select
+------------------------------------------------------------------------------
+ INPUT AND OUTPUT DEFINITIONS
+
+ Inputs:
+    features = AMRNB_CPU_* features the kernels may use (Word32)
+
+ Outputs:
+    preemphasis_impl = the preemphasis implementation for features
+
+ Returns:
+    None
+
+------------------------------------------------------------------------------
+ FUNCTION DESCRIPTION
+
+ Part of the kernel table of the decoder library, run when the features in
+ use are set (see amrnb_cpu.h).
+
+------------------------------------------------------------------------------
+*/
+void preemph_cpu_select(Word32 features)
+{
+    preemphasis_impl = preemphasis_c;
+#if defined(AMRNB_SIMD_SSE2)
+    if (features & AMRNB_CPU_SSE2)
+    {
+        preemphasis_impl = preemphasis_sse2;
+    }
+#endif
+}
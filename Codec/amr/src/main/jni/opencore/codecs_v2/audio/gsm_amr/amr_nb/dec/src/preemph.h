@@ -52,6 +52,7 @@ terms listed above has been obtained from the copyright holder.
 ----------------------------------------------------------------------------*/
 
 #include "typedef.h"
+#include "amrnb_simd.h"
 
 /*--------------------------------------------------------------------------*/
 #ifdef __cplusplus
@@ -112,6 +113,18 @@ extern "C"
         Flag   *pOverflow  /* (o)  : overflow indicator                         */
     );
 
+    /* Implementations selected by preemphasis() */
+    void preemphasis_c(preemphasisState *st, Word16 *signal, Word16 g, Word16 L,
+                       Flag *pOverflow);
+#if defined(AMRNB_SIMD_SSE2)
+    void preemphasis_sse2(preemphasisState *st, Word16 *signal, Word16 g, Word16 L,
+                          Flag *pOverflow);
+#endif
+
+    /* Selects the implementation of preemphasis for the AMRNB_CPU_* features
+       (see amrnb_cpu.h) */
+    void preemph_cpu_select(Word32 features);
+
     /*----------------------------------------------------------------------------
     ; END
     ----------------------------------------------------------------------------*/
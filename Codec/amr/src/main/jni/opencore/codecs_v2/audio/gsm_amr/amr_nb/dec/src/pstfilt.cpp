@@ -54,6 +54,7 @@ terms listed above has been obtained from the copyright holder.
 #include "mode.h"
 #include "basicop_malloc.h"
 #include "basic_op.h"
+#include "basic_op_vec.h"
 #include "weight_a.h"
 #include "residu.h"
 #include "syn_filt.h"
@@ -384,6 +385,7 @@ void Post_Filter(
     Word16 temp2;
     Word32 L_tmp;
     Word32 L_tmp2;
+    int64 energy;
     Word16 *syn_work = &st->synth_buf[M];
 
 
@@ -422,49 +424,63 @@ void Post_Filter(
         oscl_memset(&h[M + 1], 0, sizeof(Word16)*(L_H - M - 1));
         Syn_filt(Ap4, h, h, L_H, &h[M + 1], 0);
 
-        /* 1st correlation of h[] */
+        /* 1st and 2nd correlation of h[] */
 
-        L_tmp = 0;
+        /* With sum(h[i]^2) < 2^30 no L_add below can saturate and no
+           product is 0x40000000: the correlations are plain dot products */
+        energy = amrnb_energy_16(h, L_H);
 
-        for (i = L_H - 1; i >= 0; i--)
+        if (energy < (int64) 0x40000000L)
         {
-            L_tmp2 = ((Word32) h[i]) * h[i];
-
-            if (L_tmp2 != (Word32) 0x40000000L)
-            {
-                L_tmp2 = L_tmp2 << 1;
-            }
-            else
-            {
-                *pOverflow = 1;
-                L_tmp2 = MAX_32;
-                break;
-            }
-
-            L_tmp = L_add(L_tmp, L_tmp2, pOverflow);
+            temp1 = (Word16)(((Word32) energy << 1) >> 16);
+            temp2 = (Word16)((amrnb_dot_16x16(h, &h[1], L_H - 1) << 1) >> 16);
         }
-        temp1 = (Word16)(L_tmp >> 16);
-
-        L_tmp = 0;
-
-        for (i = L_H - 2; i >= 0; i--)
+        else
         {
-            L_tmp2 = ((Word32) h[i]) * h[i + 1];
+            /* 1st correlation of h[] */
+
+            L_tmp = 0;
 
-            if (L_tmp2 != (Word32) 0x40000000L)
+            for (i = L_H - 1; i >= 0; i--)
             {
-                L_tmp2 = L_tmp2 << 1;
+                L_tmp2 = ((Word32) h[i]) * h[i];
+
+                if (L_tmp2 != (Word32) 0x40000000L)
+                {
+                    L_tmp2 = L_tmp2 << 1;
+                }
+                else
+                {
+                    *pOverflow = 1;
+                    L_tmp2 = MAX_32;
+                    break;
+                }
+
+                L_tmp = L_add(L_tmp, L_tmp2, pOverflow);
             }
-            else
+            temp1 = (Word16)(L_tmp >> 16);
+
+            L_tmp = 0;
+
+            for (i = L_H - 2; i >= 0; i--)
             {
-                *pOverflow = 1;
-                L_tmp2 = MAX_32;
-                break;
+                L_tmp2 = ((Word32) h[i]) * h[i + 1];
+
+                if (L_tmp2 != (Word32) 0x40000000L)
+                {
+                    L_tmp2 = L_tmp2 << 1;
+                }
+                else
+                {
+                    *pOverflow = 1;
+                    L_tmp2 = MAX_32;
+                    break;
+                }
+
+                L_tmp = L_add(L_tmp, L_tmp2, pOverflow);
             }
-
-            L_tmp = L_add(L_tmp, L_tmp2, pOverflow);
+            temp2 = (Word16)(L_tmp >> 16);
         }
-        temp2 = (Word16)(L_tmp >> 16);
 
         if (temp2 <= 0)
         {
@@ -33,6 +33,7 @@ terms listed above has been obtained from the copyright holder.
 
  Filename: sp_dec.cpp
  Functions: GSMInitDecode
+            GSMInitDecodeInPlace
             Speech_Decode_Frame_reset
             GSMDecodeFrameExit
             GSMFrameDecode
@@ -58,6 +59,7 @@ terms listed above has been obtained from the copyright holder.
 #include "post_pro.h"
 #include "oscl_mem.h"
 #include "bitno_tab.h"
+#include "amrnb_dec_cpu.h"
 
 
 /*----------------------------------------------------------------------------
@@ -388,20 +390,65 @@ Word16 GSMInitDecode(void **state_data,
         return (-1);
     }
 
+    if (GSMInitDecodeInPlace(s, state_data))
+    {
+        oscl_free(s);
+        return (-1);
+    }
+
+    return (0);
+}
+
+
+/****************************************************************************/
+
+/*
+------------------------------------------------------------------------------
+ FUNCTION NAME: GSMInitDecodeInPlace
+------------------------------------------------------------------------------
+ INPUT AND OUTPUT DEFINITIONS
+
+ Inputs:
+    mem = pointer to a block of sizeof(Speech_Decode_FrameState) bytes (void)
+    state_data = pointer to a pointer to a structure of type
+                 Speech_Decode_FrameState
+
+ Outputs:
+    *state_data is set to mem on success
+
+ Returns:
+    return_value = set to zero, if initialization was successful; -1,
+                   otherwise (int)
+
+------------------------------------------------------------------------------
+ FUNCTION DESCRIPTION
+
+ This function initializes the decoder state in the caller-provided block
+ mem, without allocating memory. The instance must not be passed to
+ GSMDecodeFrameExit; it is released by releasing mem.
+
+------------------------------------------------------------------------------
+*/
+
+Word16 GSMInitDecodeInPlace(void *mem,
+                            void **state_data)
+{
+    Speech_Decode_FrameState* s = (Speech_Decode_FrameState *) mem;
+
+    if ((mem == NULL) || (state_data == NULL))
+    {
+        return (-1);
+    }
+    *state_data = NULL;
+
+    amrnb_dec_cpu_init();
+
     if (Decoder_amr_init(&s->decoder_amrState)
             || Post_Process_reset(&s->postHP_state))
     {
-        Speech_Decode_FrameState *tmp = s;
-        /*
-         *  dereferencing type-punned pointer avoid
-         *  breaking strict-aliasing rules
-         */
-        void** tempVoid = (void**) tmp;
-        GSMDecodeFrameExit(tempVoid);
         return (-1);
     }
 
-
     Speech_Decode_Frame_reset(s);
     *state_data = (void *)s;
 
@@ -715,13 +762,6 @@ void GSMFrameDecode(
 
 {
     Word16 parm[MAX_PRM_SIZE + 1];  /* Synthesis parameters                */
-    Word16 Az_dec[AZ_SIZE];         /* Decoded Az for post-filter          */
-    /* in 4 subframes                      */
-    Flag *pOverflow = &(st->decoder_amrState.overflow);  /* Overflow flag  */
-
-#if !defined(NO13BIT)
-    Word16 i;
-#endif
 
     /* Serial to parameters   */
     if ((frame_type == RX_SID_BAD) ||
@@ -735,6 +775,67 @@ void GSMFrameDecode(
         Bits2prm(mode, serial, parm, &st->decoder_amrState.common_amr_tbls);
     }
 
+    GSMFrameDecodePrm(st, mode, parm, frame_type, synth);
+
+    return;
+}
+
+/*
+------------------------------------------------------------------------------
+ FUNCTION NAME: GSMFrameDecodePrm
+------------------------------------------------------------------------------
+ INPUT AND OUTPUT DEFINITIONS
+
+ Inputs:
+    st = pointer to structures of type Speech_Decode_FrameState
+    mode = DTX mode of type enum Mode
+    parm = pointer to the synthesis parameters of the frame (Word16)
+    frame_type = frame type of type enum RXFrameType
+    synth = pointer to the output synthesis speech buffer of type Word16
+
+ Outputs:
+    synth contains the decoded speech samples
+
+ Returns:
+    None
+
+ Global Variables Used:
+    None
+
+ Local Variables Needed:
+    None
+
+------------------------------------------------------------------------------
+ FUNCTION DESCRIPTION
+
+ This function is the part of GSMFrameDecode() that follows Bits2prm(). It
+ lets callers that unpack a speech frame straight into its parameters (see
+ wmf_to_prm() and if2_to_prm()) skip the serial bit stream.
+
+ With decoder_amrState.params_only set, only Decoder_amr() runs, leaving its
+ parameters in decoder_amrState.params; synth then holds the synthesis
+ before post-filtering, at half the output scale.
+
+------------------------------------------------------------------------------
+*/
+
+void GSMFrameDecodePrm(
+    Speech_Decode_FrameState *st, /* io: post filter states                */
+    enum Mode mode,               /* i : AMR mode                          */
+    Word16 *parm,                 /* i : synthesis parameters              */
+    enum RXFrameType frame_type,  /* i : Frame type                        */
+    Word16 *synth)                /* o : synthesis speech (postfiltered    */
+/*     output)                           */
+
+{
+    Word16 Az_dec[AZ_SIZE];         /* Decoded Az for post-filter          */
+    /* in 4 subframes                      */
+    Flag *pOverflow = &(st->decoder_amrState.overflow);  /* Overflow flag  */
+
+#if !defined(NO13BIT)
+    Word16 i;
+#endif
+
     /* Synthesis */
     Decoder_amr(
         &(st->decoder_amrState),
@@ -744,6 +845,11 @@ void GSMFrameDecode(
         synth,
         Az_dec);
 
+    if (st->decoder_amrState.params_only)
+    {
+        return;
+    }
+
     /* Post-filter */
     Post_Filter(
         &(st->post_state),
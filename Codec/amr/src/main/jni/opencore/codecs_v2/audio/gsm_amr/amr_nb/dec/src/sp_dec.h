@@ -87,6 +87,14 @@ extern "C"
        returns 0 on success
      */
 
+    Word16 GSMInitDecodeInPlace(void *mem,
+                                void **state_data);
+    /* initialize one instance of the speech decoder in the caller-provided
+       block mem (sizeof(Speech_Decode_FrameState) bytes), without allocating.
+       The instance is released by releasing mem, not by GSMDecodeFrameExit.
+       returns 0 on success
+     */
+
     Word16 Speech_Decode_Frame_reset(void *state_data);
     /* reset speech decoder (i.e. set state memory to zero)
        returns 0 on success
@@ -107,6 +115,16 @@ extern "C"
     );
     /*    return 0 on success
      */
+
+    void GSMFrameDecodePrm(
+        Speech_Decode_FrameState *st, /* io: post filter states                */
+        enum Mode mode,               /* i : AMR mode                          */
+        Word16 *parm,                 /* i : synthesis parameters              */
+        enum RXFrameType frame_type,  /* i : Frame type                        */
+        Word16 *synth                 /* o : synthesis speech (postfiltered    */
+        /*     output)                           */
+    );
+    /* GSMFrameDecode() after Bits2prm(), for parameters unpacked directly */
 #if defined(__cplusplus)
 }
 #endif
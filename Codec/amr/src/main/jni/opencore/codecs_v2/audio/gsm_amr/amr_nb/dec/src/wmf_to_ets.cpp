@@ -32,7 +32,7 @@ terms listed above has been obtained from the copyright holder.
 
 
  Filename: wmf_to_ets.cpp
- Functions: wmf_to_ets
+ Functions: wmf_to_ets, wmf_to_prm
 
 ------------------------------------------------------------------------------
 */
@@ -161,3 +161,66 @@ void wmf_to_ets(
 
     return;
 }
+
+/*
+------------------------------------------------------------------------------
+ FUNCTION NAME: wmf_to_prm
+------------------------------------------------------------------------------
+ INPUT AND OUTPUT DEFINITIONS
+
+ Inputs:
+    frame_type_3gpp = speech bit rate, AMR_475 .. AMR_122 (enum Frame_Type_3GPP)
+    wmf_input_ptr   = pointer to input encoded speech bits in WMF (non-IF2) format
+                     (Word8)
+    prm             = pointer to output codec parameters (Word16)
+
+ Outputs:
+    prm             = the prmno[] parameters of the frame (Word16)
+
+ Returns:
+    None
+
+ Global Variables Used:
+    prmno, numOfBits, packBits (see bitreorder_tab.cpp)
+
+------------------------------------------------------------------------------
+ FUNCTION DESCRIPTION
+
+ Produces the same parameters as wmf_to_ets() followed by Bits2prm() for a
+ speech frame. Each packBits entry names the parameter and bit that the next
+ bit of the frame belongs to, so the bits are shifted out of the WMF bytes
+ straight into the parameters without the one-bit-per-word ETS form.
+
+------------------------------------------------------------------------------
+*/
+void wmf_to_prm(
+    enum Frame_Type_3GPP frame_type_3gpp,
+    UWord8   *wmf_input_ptr,
+    Word16   *prm,
+    CommonAmrTbls* common_amr_tbls)
+{
+    Word16 i;
+    Word16 e;
+    UWord32 accum = 0;
+    const Word16 *pack_tbl = common_amr_tbls->packBits_ptr[frame_type_3gpp];
+    Word16 n = common_amr_tbls->numOfBits_ptr[frame_type_3gpp];
+
+    for (i = common_amr_tbls->prmno_ptr[frame_type_3gpp] - 1; i >= 0; i--)
+    {
+        prm[i] = 0;
+    }
+
+    for (i = 0; i < n; i++)
+    {
+        if ((i & 7) == 0)
+        {
+            accum = *(wmf_input_ptr++);
+        }
+
+        e = pack_tbl[i];
+        prm[e >> 4] |= (Word16)(((accum >> 7) & 1) << (e & 15));
+        accum <<= 1;
+    }
+
+    return;
+}
@@ -3,6 +3,7 @@ include $(CLEAR_VARS)
 
 LOCAL_SRC_FILES := \
 	src/amrencode.cpp \
+ 	src/amrnb_enc_cpu.cpp \
  	src/autocorr.cpp \
  	src/c1035pf.cpp \
  	src/c2_11pf.cpp \
@@ -56,6 +57,7 @@ LOCAL_SRC_FILES := \
  	src/qgain795.cpp \
  	src/qua_gain.cpp \
  	src/s10_8pf.cpp \
+ 	src/score_trk.cpp \
  	src/set_sign.cpp \
  	src/sid_sync.cpp \
  	src/sp_enc.cpp \
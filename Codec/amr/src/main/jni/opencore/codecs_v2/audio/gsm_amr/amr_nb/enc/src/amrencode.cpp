@@ -34,6 +34,8 @@ terms listed above has been obtained from the copyright holder.
  Filename: amrencode.cpp
  Functions: AMREncode
             AMREncodeInit
+            AMREncodeStateSize
+            AMREncodeInitInPlace
             AMREncodeReset
             AMREncodeExit
 
@@ -60,6 +62,9 @@ terms listed above has been obtained from the copyright holder.
 #include "ets_to_wmf.h"
 #include "sid_sync.h"
 #include "sp_enc.h"
+#include "prm2bits.h"
+#include "amrnb_enc_cpu.h"
+#include "oscl_mem.h"
 
 /*----------------------------------------------------------------------------
 ; MACROS [optional]
@@ -72,6 +77,33 @@ terms listed above has been obtained from the copyright holder.
 ; compile variables also.]
 ----------------------------------------------------------------------------*/
 
+/*----------------------------------------------------------------------------
+; STRUCTURES TYPEDEF'S
+----------------------------------------------------------------------------*/
+
+/* Every state structure allocated by GSMInitEncode and sid_sync_init, laid
+   out in a single block for AMREncodeInitInPlace. The per-frame working set
+   (cod_amrState) comes first. */
+typedef struct
+{
+    Speech_Encode_FrameState speech_encode_frame;
+    cod_amrState cod_amr;
+    Pre_ProcessState pre_process;
+    lpcState lpc;
+    LevinsonState levinson;
+    lspState lsp;
+    Q_plsfState q_plsf;
+    clLtpState cl_ltp;
+    Pitch_frState pitch_fr;
+    gainQuantState gain_quant;
+    GainAdaptState gain_adapt;
+    pitchOLWghtState p_ol_wgh;
+    tonStabState ton_stab;
+    vadState vad;
+    dtx_encState dtx_enc;
+    sid_syncState sid_sync;
+} AMREncodeMemState;
+
 /*----------------------------------------------------------------------------
 ; LOCAL FUNCTION DEFINITIONS
 ; [List function prototypes here]
@@ -203,6 +235,121 @@ Word16 AMREncodeInit(
 }
 
 
+/****************************************************************************/
+
+/*
+------------------------------------------------------------------------------
+ FUNCTION NAME: AMREncodeStateSize
+------------------------------------------------------------------------------
+ INPUT AND OUTPUT DEFINITIONS
+
+ Inputs:
+    None
+
+ Outputs:
+    None
+
+ Returns:
+    size = number of bytes needed by AMREncodeInitInPlace (Word32)
+
+------------------------------------------------------------------------------
+ FUNCTION DESCRIPTION
+
+ This function returns the size of the memory block that holds the complete
+ state of one encoder instance, including SID synchronization.
+
+------------------------------------------------------------------------------
+*/
+Word32 AMREncodeStateSize(void)
+{
+    return (Word32) sizeof(AMREncodeMemState);
+}
+
+
+/****************************************************************************/
+
+/*
+------------------------------------------------------------------------------
+ FUNCTION NAME: AMREncodeInitInPlace
+------------------------------------------------------------------------------
+ INPUT AND OUTPUT DEFINITIONS
+
+ Inputs:
+    pMem = pointer to a block of AMREncodeStateSize() bytes, aligned at least
+           as strictly as a pointer (void)
+    pEncStructure = pointer containing the pointer to a structure used by
+                    the encoder (void)
+    pSidSyncStructure = pointer containing the pointer to a structure used for
+                        SID synchronization (void)
+    dtx_enable = flag to turn off or turn on DTX (Flag)
+
+ Outputs:
+    None
+
+ Returns:
+    init_status = 0, if initialization was successful; -1, otherwise (int)
+
+------------------------------------------------------------------------------
+ FUNCTION DESCRIPTION
+
+ This function initializes the encoder like AMREncodeInit, but instead of
+ allocating each sub-state separately it carves all of them out of pMem.
+ No memory is allocated, and the instance must not be passed to
+ AMREncodeExit; it is released by releasing pMem.
+
+------------------------------------------------------------------------------
+*/
+Word16 AMREncodeInitInPlace(
+    void *pMem,
+    void **pEncStructure,
+    void **pSidSyncStructure,
+    Flag dtx_enable)
+{
+    AMREncodeMemState *m = (AMREncodeMemState *) pMem;
+    Speech_Encode_FrameState *enc;
+    cod_amrState *cod;
+
+    if ((pMem == NULL) || (pEncStructure == NULL) || (pSidSyncStructure == NULL))
+    {
+        return(-1);
+    }
+
+    amrnb_enc_cpu_init();
+
+    oscl_memset(m, 0, sizeof(*m));
+
+    enc = &m->speech_encode_frame;
+    enc->pre_state = &m->pre_process;
+    enc->cod_amr_state = &m->cod_amr;
+    enc->dtx = dtx_enable;
+
+    cod = &m->cod_amr;
+    get_const_tbls(&cod->common_amr_tbls);
+    cod->lpcSt = &m->lpc;
+    cod->lpcSt->levinsonSt = &m->levinson;
+    cod->lspSt = &m->lsp;
+    cod->lspSt->qSt = &m->q_plsf;
+    cod->clLtpSt = &m->cl_ltp;
+    cod->clLtpSt->pitchSt = &m->pitch_fr;
+    cod->gainQuantSt = &m->gain_quant;
+    cod->gainQuantSt->adaptSt = &m->gain_adapt;
+    cod->pitchOLWghtSt = &m->p_ol_wgh;
+    cod->tonStabSt = &m->ton_stab;
+    cod->vadSt = &m->vad;
+    cod->dtx_encSt = &m->dtx_enc;
+    cod->dtx = dtx_enable;
+    cod->complexity = COMPLEXITY_MAX;
+
+    m->sid_sync.sid_update_rate = 8;
+
+    *pEncStructure = enc;
+    *pSidSyncStructure = &m->sid_sync;
+
+    /* The reset chain initializes every sub-state, as the *_init functions do */
+    return(AMREncodeReset(enc, &m->sid_sync));
+}
+
+
 /****************************************************************************/
 
 /*
@@ -299,6 +446,128 @@ Word16 AMREncodeReset(
 }
 
 
+/****************************************************************************/
+
+/*
+------------------------------------------------------------------------------
+ FUNCTION NAME: AMREncodeSetComplexity
+------------------------------------------------------------------------------
+ INPUT AND OUTPUT DEFINITIONS
+
+ Inputs:
+    pEncStructure = pointer to a structure used by the encoder (void)
+    complexity = search effort, 0..COMPLEXITY_MAX (Word16)
+
+ Outputs:
+    None
+
+ Returns:
+    status = 0, if complexity was set; -1, if it is out of range (Word16)
+
+------------------------------------------------------------------------------
+ FUNCTION DESCRIPTION
+
+ This function sets how much of the pitch and codebook searches the encoder
+ runs. COMPLEXITY_MAX, the default, is the full search and bit exact with
+ the reference encoder. Lower levels narrow the closed-loop pitch search,
+ try fewer fractional lags, correlate the open-loop pitch search over half
+ the samples and prune the fixed codebook search, trading quality for
+ speed. Every level produces a standard bit stream, and the level may be
+ changed between any two frames; the encoder state is not reset.
+ AMREncodeReset goes back to COMPLEXITY_MAX.
+
+------------------------------------------------------------------------------
+*/
+Word16 AMREncodeSetComplexity(
+    void *pEncStructure,
+    Word16 complexity)
+{
+    Speech_Encode_FrameState *enc = (Speech_Encode_FrameState *) pEncStructure;
+
+    if ((enc == NULL) || (complexity < 0) || (complexity > COMPLEXITY_MAX))
+    {
+        return(-1);
+    }
+
+    enc->cod_amr_state->complexity = complexity;
+
+    return(0);
+}
+
+
+/****************************************************************************/
+
+/*
+------------------------------------------------------------------------------
+ FUNCTION NAME: AMREncodeSetHints
+------------------------------------------------------------------------------
+ INPUT AND OUTPUT DEFINITIONS
+
+ Inputs:
+    pEncStructure = pointer to a structure used by the encoder (void)
+    lsp_mid = LSPs at the 2nd subframe of the next frame, Q15 (Word16)
+    lsp_new = LSPs at the 4th subframe of the next frame, Q15 (Word16)
+    T_op = open-loop pitch lags of the two half frames of the next frame
+           (Word16)
+
+ Outputs:
+    None
+
+ Returns:
+    status = 0, if the hints were set; -1, otherwise (Word16)
+
+------------------------------------------------------------------------------
+ FUNCTION DESCRIPTION
+
+ This function gives the encoder the spectral envelope and pitch of the
+ next frame it encodes, typically decoded from the same speech in another
+ mode. For that frame the LP analysis and the conversion to LSPs are
+ skipped and the hinted LSPs quantized instead, and, without DTX, the
+ open-loop pitch search is replaced by the hinted lags around which the
+ closed-loop search runs. lsp_mid is only used in MR122. The quantization
+ and the codebook searches run as usual, so the frame is standard. The
+ hints apply to the next call of AMREncode only.
+
+------------------------------------------------------------------------------
+*/
+Word16 AMREncodeSetHints(
+    void *pEncStructure,
+    Word16 lsp_mid[],
+    Word16 lsp_new[],
+    Word16 T_op[])
+{
+    Speech_Encode_FrameState *enc = (Speech_Encode_FrameState *) pEncStructure;
+    cod_amrState *cod;
+    Word16 i;
+
+    if ((enc == NULL) || (lsp_mid == NULL) || (lsp_new == NULL) || (T_op == NULL))
+    {
+        return(-1);
+    }
+
+    cod = enc->cod_amr_state;
+
+    oscl_memcpy(cod->hint_lsp, lsp_mid, M*sizeof(Word16));
+    oscl_memcpy(&cod->hint_lsp[M], lsp_new, M*sizeof(Word16));
+
+    for (i = 0; i < 2; i++)
+    {
+        cod->hint_T_op[i] = T_op[i];
+        if (cod->hint_T_op[i] < PIT_MIN)
+        {
+            cod->hint_T_op[i] = PIT_MIN;
+        }
+        if (cod->hint_T_op[i] > PIT_MAX)
+        {
+            cod->hint_T_op[i] = PIT_MAX;
+        }
+    }
+    cod->hint = 1;
+
+    return(0);
+}
+
+
 /****************************************************************************/
 
 /*
@@ -659,6 +928,8 @@ Word16 AMREncode(
 {
     Word16 ets_output_bfr[MAX_SERIAL_SIZE+2];
     UWord8 *ets_output_ptr;
+    Word16 enc_prm[MAX_PRM_SIZE];
+    Word16 *prm_ptr = NULL;
     Word16 num_enc_bytes = -1;
     Word16 i;
     enum TXFrameType tx_frame_type;
@@ -673,7 +944,23 @@ Word16 AMREncode(
 #ifndef CONSOLE_ENCODER_REF
 
         /* Use PV version of sp_enc.c */
-        GSMEncodeFrame(pEncState, mode, pEncInput, ets_output_bfr, &usedMode);
+        GSMEncodeFramePrm(pEncState, mode, pEncInput, enc_prm, &usedMode);
+
+        if (usedMode < MRDTX)
+        {
+            /* Speech frames are packed straight from the parameters */
+            prm_ptr = enc_prm;
+        }
+        else
+        {
+            /* SID and NO_DATA frames go through the ETS serial form */
+            for (i = 0; i < MAX_SERIAL_SIZE; i++)
+            {
+                ets_output_bfr[i] = 0;
+            }
+
+            Prm2bits(usedMode, enc_prm, ets_output_bfr, &(((Speech_Encode_FrameState*)pEncState)->cod_amr_state->common_amr_tbls));
+        }
 
 #else
         /* Use ETS version of sp_enc.c */
@@ -721,7 +1008,14 @@ Word16 AMREncode(
         if (output_format == AMR_TX_IETF)
         {
             /* Change output data format to WMF */
-            ets_to_ietf(*p3gpp_frame_type, ets_output_bfr, pEncOutput, &(((Speech_Encode_FrameState*)pEncState)->cod_amr_state->common_amr_tbls));
+            if (prm_ptr != NULL)
+            {
+                prm_to_ietf(*p3gpp_frame_type, prm_ptr, pEncOutput, &(((Speech_Encode_FrameState*)pEncState)->cod_amr_state->common_amr_tbls));
+            }
+            else
+            {
+                ets_to_ietf(*p3gpp_frame_type, ets_output_bfr, pEncOutput, &(((Speech_Encode_FrameState*)pEncState)->cod_amr_state->common_amr_tbls));
+            }
 
             /* Set up the number of encoded WMF bytes */
             num_enc_bytes = WmfEncBytesPerFrame[(Word16) *p3gpp_frame_type];
@@ -730,7 +1024,14 @@ Word16 AMREncode(
         else if (output_format == AMR_TX_WMF)
         {
             /* Change output data format to WMF */
-            ets_to_wmf(*p3gpp_frame_type, ets_output_bfr, pEncOutput, &(((Speech_Encode_FrameState*)pEncState)->cod_amr_state->common_amr_tbls));
+            if (prm_ptr != NULL)
+            {
+                prm_to_wmf(*p3gpp_frame_type, prm_ptr, pEncOutput, &(((Speech_Encode_FrameState*)pEncState)->cod_amr_state->common_amr_tbls));
+            }
+            else
+            {
+                ets_to_wmf(*p3gpp_frame_type, ets_output_bfr, pEncOutput, &(((Speech_Encode_FrameState*)pEncState)->cod_amr_state->common_amr_tbls));
+            }
 
             /* Set up the number of encoded WMF bytes */
             num_enc_bytes = WmfEncBytesPerFrame[(Word16) *p3gpp_frame_type];
@@ -739,7 +1040,14 @@ Word16 AMREncode(
         else if (output_format == AMR_TX_IF2)
         {
             /* Change output data format to IF2 */
-            ets_to_if2(*p3gpp_frame_type, ets_output_bfr, pEncOutput, &(((Speech_Encode_FrameState*)pEncState)->cod_amr_state->common_amr_tbls));
+            if (prm_ptr != NULL)
+            {
+                prm_to_if2(*p3gpp_frame_type, prm_ptr, pEncOutput, &(((Speech_Encode_FrameState*)pEncState)->cod_amr_state->common_amr_tbls));
+            }
+            else
+            {
+                ets_to_if2(*p3gpp_frame_type, ets_output_bfr, pEncOutput, &(((Speech_Encode_FrameState*)pEncState)->cod_amr_state->common_amr_tbls));
+            }
 
             /* Set up the number of encoded IF2 bytes */
             num_enc_bytes = If2EncBytesPerFrame[(Word16) *p3gpp_frame_type];
@@ -106,10 +106,28 @@ extern "C"
         void **pSidSyncStructure,
         Flag dtx_enable);
 
+    Word32 AMREncodeStateSize(void);
+
+    Word16 AMREncodeInitInPlace(
+        void *pMem,
+        void **pEncStructure,
+        void **pSidSyncStructure,
+        Flag dtx_enable);
+
     Word16 AMREncodeReset(
         void *pEncStructure,
         void *pSidSyncStructure);
 
+    Word16 AMREncodeSetComplexity(
+        void *pEncStructure,
+        Word16 complexity);
+
+    Word16 AMREncodeSetHints(
+        void *pEncStructure,
+        Word16 lsp_mid[],
+        Word16 lsp_new[],
+        Word16 T_op[]);
+
     void AMREncodeExit(
         void **pEncStructure,
         void **pSidSyncStructure);
@@ -0,0 +1,126 @@
+/* ------------------------------------------------------------------
+ * Copyright (C) 1998-2009 PacketVideo
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied.
+ * See the License for the specific language governing permissions
+ * and limitations under the License.
+ * -------------------------------------------------------------------
+ */
+/*
+
+ Filename: amrnb_enc_cpu.cpp
+
+------------------------------------------------------------------------------
+ MODULE DESCRIPTION
+
+ Kernel table of the encoder library (see amrnb_cpu.h).
+
+------------------------------------------------------------------------------
+*/
+
+/*----------------------------------------------------------------------------
+; INCLUDES
+----------------------------------------------------------------------------*/
+#include    "amrnb_enc_cpu.h"
+#include    "amrnb_cpu.h"
+#include    "cnst.h"
+#include    "autocorr.h"
+#include    "calc_cor.h"
+#include    "convolve.h"
+#include    "cor_h.h"
+#include    "cor_h_x.h"
+#include    "cor_h_x2.h"
+#include    "inter_36.h"
+#include    "pitch_fr.h"
+#include    "qgain475.h"
+#include    "qgain795.h"
+#include    "qua_gain.h"
+#include    "s10_8pf.h"
+#include    "score_trk.h"
+#include    "set_sign.h"
+#include    "vad1.h"
+
+/*----------------------------------------------------------------------------
+; LOCAL VARIABLE DEFINITIONS
+; Variable declaration - defined here and used outside this module
+----------------------------------------------------------------------------*/
+
+/* The modules of this library with SIMD kernels */
+static const amrnb_cpu_select_fn amrnb_enc_kernels[] =
+{
+    autocorr_cpu_select,
+    calc_cor_cpu_select,
+    convolve_cpu_select,
+    cor_h_cpu_select,
+    cor_h_x_cpu_select,
+    cor_h_x2_cpu_select,
+    inter_36_cpu_select,
+    pitch_fr_cpu_select,
+    qgain475_cpu_select,
+    qgain795_cpu_select,
+    qua_gain_cpu_select,
+    s10_8pf_cpu_select,
+    score_trk_cpu_select,
+    set_sign_cpu_select,
+    vad1_cpu_select
+};
+
+/*
+------------------------------------------------------------------------------
+ FUNCTION NAME: amrnb_enc_cpu_select
+------------------------------------------------------------------------------
+ INPUT AND OUTPUT DEFINITIONS
+
+ Inputs:
+    features = AMRNB_CPU_* features the kernels may use (Word32)
+
+ Outputs:
+    the kernels of the encoder library point at the implementations for
+    features
+
+ Returns:
+    None
+
+------------------------------------------------------------------------------
+*/
+static void amrnb_enc_cpu_select(Word32 features)
+{
+    Word16 i;
+
+    for (i = 0; i < (Word16)(sizeof(amrnb_enc_kernels) / sizeof(amrnb_enc_kernels[0])); i++)
+    {
+        amrnb_enc_kernels[i](features);
+    }
+}
+
+/*
+------------------------------------------------------------------------------
+ FUNCTION NAME: amrnb_enc_cpu_init
+------------------------------------------------------------------------------
+ INPUT AND OUTPUT DEFINITIONS
+
+ Inputs:
+    None
+
+ Outputs:
+    the kernels of the encoder library point at the implementations for
+    the features in use, and follow amrnb_cpu_set_features() from now on
+
+ Returns:
+    None
+
+------------------------------------------------------------------------------
+*/
+void amrnb_enc_cpu_init(void)
+{
+    amrnb_cpu_register(AMRNB_CPU_TABLE_ENC, amrnb_enc_cpu_select);
+}
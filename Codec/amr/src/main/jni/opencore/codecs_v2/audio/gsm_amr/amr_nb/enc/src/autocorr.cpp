@@ -43,6 +43,8 @@ terms listed above has been obtained from the copyright holder.
 #include "basic_op.h"
 #include "oper_32b.h"
 #include "cnst.h"
+#include "basic_op_vec.h"
+#include "amrnb_cpu.h"
 
 /*----------------------------------------------------------------------------
 ; MACROS
@@ -80,7 +82,7 @@ terms listed above has been obtained from the copyright holder.
 
 /*
 ------------------------------------------------------------------------------
- FUNCTION NAME: Autocorr
+ FUNCTION NAME: Autocorr_c
 ----------------------------------------------------------------------------
  INPUT AND OUTPUT DEFINITIONS
 
@@ -215,7 +217,7 @@ Word16 Autocorr (
 ------------------------------------------------------------------------------
 */
 
-Word16 Autocorr(
+Word16 Autocorr_c(
     Word16 x[],            /* (i)    : Input signal (L_WINDOW)            */
     Word16 m,              /* (i)    : LPC order                          */
     Word16 r_h[],          /* (o)    : Autocorrelations  (msb)            */
@@ -374,4 +376,509 @@ Word16 Autocorr(
 
     return (norm);
 
-} /* Autocorr */
+} /* Autocorr_c */
+
+#if defined(AMRNB_SIMD_SSE2)
+/*
+------------------------------------------------------------------------------
+ FUNCTION NAME: Autocorr_sse2
+------------------------------------------------------------------------------
+ INPUT AND OUTPUT DEFINITIONS
+
+ Same as Autocorr_c.
+
+------------------------------------------------------------------------------
+ FUNCTION DESCRIPTION
+
+ Windows the signal eight samples at a time, with the 0x4000 rounding term
+ carried as an extra {x, 1} x {wind, 0x4000} pair of the multiply-add.
+ The running energy of Autocorr_c turns negative exactly when the exact
+ energy reaches 2^31, so the overflow test is made once on the 64-bit sum.
+ r[1] to r[m] are then computed four lags at a time over a zero-padded
+ copy of the windowed signal, with the same 32-bit wrap-around as the
+ scalar sums. Orders above 12 are left to Autocorr_c.
+
+------------------------------------------------------------------------------
+*/
+
+Word16 Autocorr_sse2(
+    Word16 x[],            /* (i)    : Input signal (L_WINDOW)            */
+    Word16 m,              /* (i)    : LPC order                          */
+    Word16 r_h[],          /* (o)    : Autocorrelations  (msb)            */
+    Word16 r_l[],          /* (o)    : Autocorrelations  (lsb)            */
+    const Word16 wind[],   /* (i)    : window for LPC analysis (L_WINDOW) */
+    Flag  *pOverflow       /* (o)    : indicates overflow                 */
+)
+{
+    register Word16 i;
+    register Word16 j;
+    register Word16 norm;
+
+    Word16 y[L_WINDOW + 16];
+    Word32 r[12 + 1];
+    Word32 sum;
+    int64 energy;
+    Word16 overfl_shft;
+    __m128i one = _mm_set1_epi16(1);
+    __m128i round = _mm_set1_epi16(0x4000);
+
+    if (m > 12)
+    {
+        return (Autocorr_c(x, m, r_h, r_l, wind, pOverflow));
+    }
+
+    OSCL_UNUSED_ARG(pOverflow);
+
+    /*
+     *  Windowing of the signal
+     */
+
+    for (i = 0; i < L_WINDOW; i += 8)
+    {
+        __m128i vx = _mm_loadu_si128((const __m128i *) &x[i]);
+        __m128i vw = _mm_loadu_si128((const __m128i *) &wind[i]);
+        __m128i lo = _mm_madd_epi16(_mm_unpacklo_epi16(vx, one), _mm_unpacklo_epi16(vw, round));
+        __m128i hi = _mm_madd_epi16(_mm_unpackhi_epi16(vx, one), _mm_unpackhi_epi16(vw, round));
+
+        _mm_storeu_si128((__m128i *) &y[i],
+                         amrnb_pack_trunc_epi32(_mm_srai_epi32(lo, 15), _mm_srai_epi32(hi, 15)));
+    }
+    _mm_storeu_si128((__m128i *) &y[L_WINDOW], _mm_setzero_si128());
+    _mm_storeu_si128((__m128i *) &y[L_WINDOW + 8], _mm_setzero_si128());
+
+    /*
+     *  Compute r[0] and test for overflow
+     */
+
+    overfl_shft = 0;
+    energy = amrnb_energy_16(y, L_WINDOW);
+
+    if (energy >= (int64) 0x40000000L)
+    {
+        /* divide y[] by 4 until the wrapped 32-bit energy is positive */
+        do
+        {
+            overfl_shft += 4;
+            for (i = 0; i < L_WINDOW; i += 8)
+            {
+                _mm_storeu_si128((__m128i *) &y[i],
+                                 _mm_srai_epi16(_mm_loadu_si128((__m128i *) &y[i]), 2));
+            }
+            sum = (Word32)(UWord32)((uint64) amrnb_energy_16(y, L_WINDOW) << 1);
+        }
+        while (sum <= 0);
+    }
+    else
+    {
+        sum = (Word32)(energy << 1);
+    }
+
+    sum += 1L;              /* Avoid the case of all zeros */
+
+    /* Normalization of r[0] */
+
+    norm = norm_l(sum);
+
+    sum <<= norm;
+
+    /* Put in DPF format (see oper_32b) */
+    r_h[0] = (Word16)(sum >> 16);
+    r_l[0] = (Word16)((sum >> 1) - ((Word32)(r_h[0]) << 15));
+
+    /* r[1] to r[m], four lags per pass */
+
+    for (j = 1; j <= m; j += 4)
+    {
+        __m128i t1 = _mm_setzero_si128();
+        __m128i t2 = _mm_setzero_si128();
+        __m128i t3 = _mm_setzero_si128();
+        __m128i t4 = _mm_setzero_si128();
+
+        for (i = 0; i < L_WINDOW; i += 8)
+        {
+            __m128i s = _mm_loadu_si128((__m128i *) &y[i]);
+            t1 = _mm_add_epi32(t1, _mm_madd_epi16(s, _mm_loadu_si128((__m128i *) &y[i + j])));
+            t2 = _mm_add_epi32(t2, _mm_madd_epi16(s, _mm_loadu_si128((__m128i *) &y[i + j + 1])));
+            t3 = _mm_add_epi32(t3, _mm_madd_epi16(s, _mm_loadu_si128((__m128i *) &y[i + j + 2])));
+            t4 = _mm_add_epi32(t4, _mm_madd_epi16(s, _mm_loadu_si128((__m128i *) &y[i + j + 3])));
+        }
+        _mm_storeu_si128((__m128i *) &r[j], amrnb_hsum4_epi32(t1, t2, t3, t4));
+    }
+
+    for (i = 1; i <= m; i++)
+    {
+        sum = r[i] << (norm + 1);
+
+        r_h[i] = (Word16)(sum >> 16);
+        r_l[i] = (Word16)((sum >> 1) - ((Word32) r_h[i] << 15));
+    }
+
+    norm -= overfl_shft;
+
+    return (norm);
+
+} /* Autocorr_sse2 */
+#endif
+
+#if defined(AMRNB_SIMD_AVX2)
+/*
+------------------------------------------------------------------------------
+ FUNCTION NAME: Autocorr_avx2
+------------------------------------------------------------------------------
+ INPUT AND OUTPUT DEFINITIONS
+
+ Same as Autocorr_c.
+
+------------------------------------------------------------------------------
+ FUNCTION DESCRIPTION
+
+ Autocorr_sse2 with the windowing and the lag sums sixteen samples at a
+ time. Orders above 12 are left to Autocorr_c.
+
+------------------------------------------------------------------------------
+*/
+
+AMRNB_TARGET_AVX2 Word16 Autocorr_avx2(
+    Word16 x[],            /* (i)    : Input signal (L_WINDOW)            */
+    Word16 m,              /* (i)    : LPC order                          */
+    Word16 r_h[],          /* (o)    : Autocorrelations  (msb)            */
+    Word16 r_l[],          /* (o)    : Autocorrelations  (lsb)            */
+    const Word16 wind[],   /* (i)    : window for LPC analysis (L_WINDOW) */
+    Flag  *pOverflow       /* (o)    : indicates overflow                 */
+)
+{
+    register Word16 i;
+    register Word16 j;
+    register Word16 norm;
+
+    Word16 y[L_WINDOW + 16];
+    Word32 r[12 + 1];
+    Word32 sum;
+    int64 energy;
+    Word16 overfl_shft;
+    __m256i one = _mm256_set1_epi16(1);
+    __m256i round = _mm256_set1_epi16(0x4000);
+
+    if (m > 12)
+    {
+        return (Autocorr_c(x, m, r_h, r_l, wind, pOverflow));
+    }
+
+    OSCL_UNUSED_ARG(pOverflow);
+
+    /*
+     *  Windowing of the signal
+     */
+
+    for (i = 0; i < L_WINDOW; i += 16)
+    {
+        __m256i vx = _mm256_loadu_si256((const __m256i *) &x[i]);
+        __m256i vw = _mm256_loadu_si256((const __m256i *) &wind[i]);
+        __m256i lo = _mm256_madd_epi16(_mm256_unpacklo_epi16(vx, one),
+                                       _mm256_unpacklo_epi16(vw, round));
+        __m256i hi = _mm256_madd_epi16(_mm256_unpackhi_epi16(vx, one),
+                                       _mm256_unpackhi_epi16(vw, round));
+
+        _mm256_storeu_si256((__m256i *) &y[i],
+                            amrnb_pack_trunc_epi32_256(_mm256_srai_epi32(lo, 15),
+                                                       _mm256_srai_epi32(hi, 15)));
+    }
+    _mm256_storeu_si256((__m256i *) &y[L_WINDOW], _mm256_setzero_si256());
+
+    /*
+     *  Compute r[0] and test for overflow
+     */
+
+    overfl_shft = 0;
+    energy = amrnb_energy_16(y, L_WINDOW);
+
+    if (energy >= (int64) 0x40000000L)
+    {
+        /* divide y[] by 4 until the wrapped 32-bit energy is positive */
+        do
+        {
+            overfl_shft += 4;
+            for (i = 0; i < L_WINDOW; i += 16)
+            {
+                _mm256_storeu_si256((__m256i *) &y[i],
+                                    _mm256_srai_epi16(_mm256_loadu_si256((__m256i *) &y[i]), 2));
+            }
+            sum = (Word32)(UWord32)((uint64) amrnb_energy_16(y, L_WINDOW) << 1);
+        }
+        while (sum <= 0);
+    }
+    else
+    {
+        sum = (Word32)(energy << 1);
+    }
+
+    sum += 1L;              /* Avoid the case of all zeros */
+
+    /* Normalization of r[0] */
+
+    norm = norm_l(sum);
+
+    sum <<= norm;
+
+    /* Put in DPF format (see oper_32b) */
+    r_h[0] = (Word16)(sum >> 16);
+    r_l[0] = (Word16)((sum >> 1) - ((Word32)(r_h[0]) << 15));
+
+    /* r[1] to r[m], four lags per pass */
+
+    for (j = 1; j <= m; j += 4)
+    {
+        __m256i t1 = _mm256_setzero_si256();
+        __m256i t2 = _mm256_setzero_si256();
+        __m256i t3 = _mm256_setzero_si256();
+        __m256i t4 = _mm256_setzero_si256();
+
+        for (i = 0; i < L_WINDOW; i += 16)
+        {
+            __m256i s = _mm256_loadu_si256((__m256i *) &y[i]);
+            t1 = _mm256_add_epi32(t1, _mm256_madd_epi16(s, _mm256_loadu_si256((__m256i *) &y[i + j])));
+            t2 = _mm256_add_epi32(t2, _mm256_madd_epi16(s, _mm256_loadu_si256((__m256i *) &y[i + j + 1])));
+            t3 = _mm256_add_epi32(t3, _mm256_madd_epi16(s, _mm256_loadu_si256((__m256i *) &y[i + j + 2])));
+            t4 = _mm256_add_epi32(t4, _mm256_madd_epi16(s, _mm256_loadu_si256((__m256i *) &y[i + j + 3])));
+        }
+        _mm_storeu_si128((__m128i *) &r[j],
+                         amrnb_hsum4_epi32(amrnb_fold_epi32_256(t1), amrnb_fold_epi32_256(t2),
+                                           amrnb_fold_epi32_256(t3), amrnb_fold_epi32_256(t4)));
+    }
+
+    for (i = 1; i <= m; i++)
+    {
+        sum = r[i] << (norm + 1);
+
+        r_h[i] = (Word16)(sum >> 16);
+        r_l[i] = (Word16)((sum >> 1) - ((Word32) r_h[i] << 15));
+    }
+
+    norm -= overfl_shft;
+
+    return (norm);
+
+} /* Autocorr_avx2 */
+#endif
+
+#if defined(AMRNB_SIMD_NEON)
+/*
+------------------------------------------------------------------------------
+ FUNCTION NAME: Autocorr_neon
+------------------------------------------------------------------------------
+ INPUT AND OUTPUT DEFINITIONS
+
+ Same as Autocorr_c.
+
+------------------------------------------------------------------------------
+ FUNCTION DESCRIPTION
+
+ Autocorr_sse2 for NEON: the windowing is a widening multiply followed by a
+ rounding narrowing shift, the overflow test is made once on the 64-bit
+ energy, and r[1] to r[m] are computed four lags at a time over a
+ zero-padded copy of the windowed signal. Orders above 12 are left to
+ Autocorr_c.
+
+------------------------------------------------------------------------------
+*/
+
+Word16 Autocorr_neon(
+    Word16 x[],            /* (i)    : Input signal (L_WINDOW)            */
+    Word16 m,              /* (i)    : LPC order                          */
+    Word16 r_h[],          /* (o)    : Autocorrelations  (msb)            */
+    Word16 r_l[],          /* (o)    : Autocorrelations  (lsb)            */
+    const Word16 wind[],   /* (i)    : window for LPC analysis (L_WINDOW) */
+    Flag  *pOverflow       /* (o)    : indicates overflow                 */
+)
+{
+    register Word16 i;
+    register Word16 j;
+    register Word16 k;
+    register Word16 norm;
+
+    Word16 y[L_WINDOW + 16];
+    Word32 r[12 + 1];
+    Word32 sum;
+    int64 energy;
+    Word16 overfl_shft;
+
+    if (m > 12)
+    {
+        return (Autocorr_c(x, m, r_h, r_l, wind, pOverflow));
+    }
+
+    OSCL_UNUSED_ARG(pOverflow);
+
+    /*
+     *  Windowing of the signal
+     */
+
+    for (i = 0; i < L_WINDOW; i += 8)
+    {
+        int16x8_t vx = vld1q_s16(&x[i]);
+        int16x8_t vw = vld1q_s16(&wind[i]);
+
+        vst1q_s16(&y[i], vcombine_s16(vrshrn_n_s32(vmull_s16(vget_low_s16(vx), vget_low_s16(vw)), 15),
+                                      vrshrn_n_s32(vmull_high_s16(vx, vw), 15)));
+    }
+    vst1q_s16(&y[L_WINDOW], vdupq_n_s16(0));
+    vst1q_s16(&y[L_WINDOW + 8], vdupq_n_s16(0));
+
+    /*
+     *  Compute r[0] and test for overflow
+     */
+
+    overfl_shft = 0;
+    energy = amrnb_energy_16(y, L_WINDOW);
+
+    if (energy >= (int64) 0x40000000L)
+    {
+        /* divide y[] by 4 until the wrapped 32-bit energy is positive */
+        do
+        {
+            overfl_shft += 4;
+            for (i = 0; i < L_WINDOW; i += 8)
+            {
+                vst1q_s16(&y[i], vshrq_n_s16(vld1q_s16(&y[i]), 2));
+            }
+            sum = (Word32)(UWord32)((uint64) amrnb_energy_16(y, L_WINDOW) << 1);
+        }
+        while (sum <= 0);
+    }
+    else
+    {
+        sum = (Word32)(energy << 1);
+    }
+
+    sum += 1L;              /* Avoid the case of all zeros */
+
+    /* Normalization of r[0] */
+
+    norm = norm_l(sum);
+
+    sum <<= norm;
+
+    /* Put in DPF format (see oper_32b) */
+    r_h[0] = (Word16)(sum >> 16);
+    r_l[0] = (Word16)((sum >> 1) - ((Word32)(r_h[0]) << 15));
+
+    /* r[1] to r[m], four lags per pass */
+
+    for (j = 1; j <= m; j += 4)
+    {
+        int32x4_t t[4];
+
+        for (k = 0; k < 4; k++)
+        {
+            t[k] = vdupq_n_s32(0);
+        }
+
+        for (i = 0; i < L_WINDOW; i += 8)
+        {
+            int16x8_t s = vld1q_s16(&y[i]);
+
+            for (k = 0; k < 4; k++)
+            {
+                int16x8_t w = vld1q_s16(&y[i + j + k]);
+
+                t[k] = vmlal_s16(t[k], vget_low_s16(s), vget_low_s16(w));
+                t[k] = vmlal_high_s16(t[k], s, w);
+            }
+        }
+        vst1q_s32(&r[j], amrnb_hsum4_s32(t[0], t[1], t[2], t[3]));
+    }
+
+    for (i = 1; i <= m; i++)
+    {
+        sum = r[i] << (norm + 1);
+
+        r_h[i] = (Word16)(sum >> 16);
+        r_l[i] = (Word16)((sum >> 1) - ((Word32) r_h[i] << 15));
+    }
+
+    norm -= overfl_shft;
+
+    return (norm);
+
+} /* Autocorr_neon */
+#endif
+
+/* Implementation of Autocorr that autocorr_cpu_select() selected */
+static Word16 (*Autocorr_impl)(Word16 x[], Word16 m, Word16 r_h[],
+                               Word16 r_l[], const Word16 wind[],
+                               Flag *pOverflow) = Autocorr_c;
+
+/*
+------------------------------------------------------------------------------
+ FUNCTION NAME: Autocorr
+------------------------------------------------------------------------------
+ INPUT AND OUTPUT DEFINITIONS
+
+ Same as Autocorr_c.
+
+------------------------------------------------------------------------------
+ FUNCTION DESCRIPTION
+
+ Runs the implementation of Autocorr that autocorr_cpu_select() selected
+ (see amrnb_cpu.h).
+
+------------------------------------------------------------------------------
+*/
+
+Word16 Autocorr(
+    Word16 x[],            /* (i)    : Input signal (L_WINDOW)            */
+    Word16 m,              /* (i)    : LPC order                          */
+    Word16 r_h[],          /* (o)    : Autocorrelations  (msb)            */
+    Word16 r_l[],          /* (o)    : Autocorrelations  (lsb)            */
+    const Word16 wind[],   /* (i)    : window for LPC analysis (L_WINDOW) */
+    Flag  *pOverflow       /* (o)    : indicates overflow                 */
+)
+{
+    return (Autocorr_impl(x, m, r_h, r_l, wind, pOverflow));
+}
+
+/*
+------------------------------------------------------------------------------
+ FUNCTION NAME: autocorr_cpu_select
+------------------------------------------------------------------------------
+ INPUT AND OUTPUT DEFINITIONS
+
+ Inputs:
+    features = AMRNB_CPU_* features the kernels may use (Word32)
+
+ Outputs:
+    Autocorr_impl = the Autocorr implementation for features
+
+ Returns:
+    None
+
+------------------------------------------------------------------------------
+ FUNCTION DESCRIPTION
+
+ Part of the kernel table of the encoder library, run when the features in
+ use are set (see amrnb_cpu.h).
+
+------------------------------------------------------------------------------
+*/
+void autocorr_cpu_select(Word32 features)
+{
+    Autocorr_impl = Autocorr_c;
+#if defined(AMRNB_SIMD_NEON)
+    if (features & AMRNB_CPU_NEON)
+    {
+        Autocorr_impl = Autocorr_neon;
+    }
+#endif
+#if defined(AMRNB_SIMD_SSE2)
+    if (features & AMRNB_CPU_SSE2)
+    {
+        Autocorr_impl = Autocorr_sse2;
+    }
+#endif
+#if defined(AMRNB_SIMD_AVX2)
+    if (features & AMRNB_CPU_AVX2)
+    {
+        Autocorr_impl = Autocorr_avx2;
+    }
+#endif
+}
@@ -52,6 +52,7 @@ terms listed above has been obtained from the copyright holder.
 ; INCLUDES
 ----------------------------------------------------------------------------*/
 #include "typedef.h"
+#include "amrnb_simd.h"
 
 /*--------------------------------------------------------------------------*/
 #ifdef __cplusplus
@@ -99,6 +100,26 @@ extern "C"
         Flag  *pOverflow       /* (o)    : indicates overflow                 */
     );
 
+    /* Implementations selected by Autocorr() */
+    Word16 Autocorr_c(Word16 x[], Word16 m, Word16 r_h[], Word16 r_l[],
+                      const Word16 wind[], Flag *pOverflow);
+#if defined(AMRNB_SIMD_SSE2)
+    Word16 Autocorr_sse2(Word16 x[], Word16 m, Word16 r_h[], Word16 r_l[],
+                         const Word16 wind[], Flag *pOverflow);
+#endif
+#if defined(AMRNB_SIMD_AVX2)
+    AMRNB_TARGET_AVX2 Word16 Autocorr_avx2(Word16 x[], Word16 m, Word16 r_h[], Word16 r_l[],
+                                           const Word16 wind[], Flag *pOverflow);
+#endif
+#if defined(AMRNB_SIMD_NEON)
+    Word16 Autocorr_neon(Word16 x[], Word16 m, Word16 r_h[], Word16 r_l[],
+                         const Word16 wind[], Flag *pOverflow);
+#endif
+
+    /* Selects the implementation of Autocorr for the AMRNB_CPU_* features
+       (see amrnb_cpu.h) */
+    void autocorr_cpu_select(Word32 features);
+
     /*----------------------------------------------------------------------------
     ; END
     ----------------------------------------------------------------------------*/
@@ -480,6 +480,7 @@ static void build_code(
     param_size_table = table holding paameter sizes (Word16)
     param[] = array to hold CN generated paramters (Word16)
     pOverflow = pointer to overflow flag (Flag)
+    complexity = search effort, 0..COMPLEXITY_MAX (Word16)
 
  Outputs:
     param[] = CN generated parameters (Word16)
@@ -518,6 +519,9 @@ static void build_code(
  The function determines the optimal pulse signs and positions, builds
  the codevector, and computes the filtered codevector.
 
+ Below COMPLEXITY_MAX the pulse pairs are searched from fewer starting
+ tracks (see COMPLEXITY_SCALE).
+
 ------------------------------------------------------------------------------
  REQUIREMENTS
 
@@ -578,18 +582,23 @@ void code_10i40_35bits(
     Word16 y[],     /* (o)   : filtered fixed codebook excitation           */
     Word16 indx[],  /* (o)   : index of 10 pulses (sign + position)         */
     const Word16* gray_ptr, /* (i) : ptr to read-only table                 */
+    Word16 complexity, /* (i): search effort, 0..COMPLEXITY_MAX             */
     Flag *pOverflow /* (i/o) : overflow Flag                                */
 )
 {
     Word16 ipos[NB_PULSE], pos_max[NB_TRACK], codvec[NB_PULSE];
     Word16 dn[L_CODE], sign[L_CODE];
     Word16 rr[L_CODE][L_CODE], i;
+    Word16 nbTracks;
+
+    /* search_10and8i40 starts from nbTracks - 1 tracks, all at full effort */
+    nbTracks = 1 + COMPLEXITY_SCALE(NB_TRACK - 1, complexity);
 
     cor_h_x(h, x, dn, 2, pOverflow);
     set_sign12k2(dn, cn, sign, pos_max, NB_TRACK, ipos, STEP, pOverflow);
     cor_h(h, sign, rr, pOverflow);
 
-    search_10and8i40(NB_PULSE, STEP, NB_TRACK,
+    search_10and8i40(NB_PULSE, STEP, nbTracks,
                      dn, rr, ipos, pos_max, codvec, pOverflow);
 
     build_code(codvec, sign, cod, h, y, indx, pOverflow);
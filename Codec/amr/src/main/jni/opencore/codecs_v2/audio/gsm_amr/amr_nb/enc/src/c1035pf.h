@@ -99,6 +99,7 @@ extern "C"
         Word16 y[],     /* (o)   : filtered fixed codebook excitation           */
         Word16 indx[],  /* (o)   : index of 10 pulses (sign + position)         */
         const Word16* gray_ptr, /* (i) : ptr to read-only table                 */
+        Word16 complexity, /* (i): search effort, 0..COMPLEXITY_MAX             */
         Flag *pOverflow /* (i/o) : overflow Flag                                */
     );
 
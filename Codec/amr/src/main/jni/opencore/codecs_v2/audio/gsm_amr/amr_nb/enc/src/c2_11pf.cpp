@@ -74,6 +74,7 @@ terms listed above has been obtained from the copyright holder.
 #include "cnst.h"
 #include "cor_h.h"
 #include "set_sign.h"
+#include "score_trk.h"
 
 /*----------------------------------------------------------------------------
 ; MACROS
@@ -98,6 +99,7 @@ terms listed above has been obtained from the copyright holder.
 ----------------------------------------------------------------------------*/
 static void search_2i40(
     Word16 dn[],        /* i : correlation between target and h[]            */
+    Word16 dn2[],       /* i : maximum of corr. in each track.               */
     Word16 rr[][L_CODE],/* i : matrix of autocorrelation                     */
     Word16 codvec[],    /* o : algebraic codebook vector                     */
     Flag   * pOverflow
@@ -132,6 +134,7 @@ const Word16 startPos2[4] = {0, 1, 2, 4};
     h,  impulse response of weighted synthesis filter, array of type Word16
     T0, Pitch lag, variable of type Word16
     pitch_sharp, Last quantized pitch gain, variable of type Word16
+    complexity, search effort, 0..COMPLEXITY_MAX, variable of type Word16
 
  Outputs:
     code[], Innovative codebook, array of type Word16
@@ -166,6 +169,9 @@ const Word16 startPos2[4] = {0, 1, 2, 4};
               2, 7, 12, 17, 22, 27, 32, 37.
               4, 9, 14, 19, 24, 29, 34, 39.
 
+     Below COMPLEXITY_MAX, i0 only tries the positions with the largest
+     correlation of its track (see COMPLEXITY_SCALE).
+
 ------------------------------------------------------------------------------
  REQUIREMENTS
 
@@ -195,6 +201,7 @@ Word16 code_2i40_11bits(
     Word16 code[],      /* o : Innovative codebook                           */
     Word16 y[],         /* o : filtered fixed codebook excitation            */
     Word16 * sign,      /* o : Signs of 2 pulses                             */
+    Word16 complexity,  /* i : search effort, 0..COMPLEXITY_MAX              */
     Flag   * pOverflow  /* o : Flag set when overflow occurs                 */
 )
 {
@@ -242,7 +249,7 @@ Word16 code_2i40_11bits(
         dn,
         dn_sign,
         dn2,
-        8); /* dn2[] not used in this codebook search */
+        COMPLEXITY_SCALE(8, complexity)); /* positions i0 starts on */
 
     cor_h(
         h,
@@ -252,6 +259,7 @@ Word16 code_2i40_11bits(
 
     search_2i40(
         dn,
+        dn2,
         rr,
         codvec,
         pOverflow);
@@ -305,6 +313,8 @@ Word16 code_2i40_11bits(
 
  Inputs:
     dn, correlation between target and h[], array of type Word16
+    dn2, positions of each track i0 starts on, the others are negative,
+         array of type Word16
     rr, matrix of autocorrelation, double-array of type Word16
 
  Outputs:
@@ -349,6 +359,7 @@ Word16 code_2i40_11bits(
 
 static void search_2i40(
     Word16 dn[],         /* i : correlation between target and h[] */
+    Word16 dn2[],        /* i : maximum of corr. in each track.    */
     Word16 rr[][L_CODE], /* i : matrix of autocorrelation          */
     Word16 codvec[],     /* o : algebraic codebook vector          */
     Flag   * pOverflow   /* o : Flag set when overflow occurs      */
@@ -363,17 +374,18 @@ static void search_2i40(
 
     Word16 psk;
     Word16 ps0;
-    Word16 ps1;
+    Word16 ps1[NB_TRACK_POS];
     Word16 sq;
-    Word16 sq1;
+    Word16 sq1[NB_TRACK_POS];
 
     Word16 alpk;
     Word16 alp;
-    Word16 alp_16;
+    Word16 alp_16[NB_TRACK_POS];
 
     Word32 s;
     Word32 alp0;
-    Word32 alp1;
+    Word16 m;
+    Word16 placed[1];
 
     Word16 i;
     Word16 *p_codvec = &codvec[0];
@@ -403,6 +415,11 @@ static void search_2i40(
             *----------------------------------------------------------------*/
             for (i0 = ipos[0]; i0 < L_CODE; i0 += STEP)
             {
+                if (dn2[i0] < 0)
+                {
+                    continue;
+                }
+
                 ps0 = dn[i0];
 
                 /* alp0 = L_mult(rr[i0][i0], _1_4, pOverflow); */
@@ -423,37 +440,22 @@ static void search_2i40(
                 * and incremented by "STEP".                                    *
                 *---------------------------------------------------------------*/
 
-                for (i1 = ipos[1]; i1 < L_CODE; i1 += STEP)
-                {
-                    /* idx increment = STEP */
-                    ps1 = add_16(ps0, dn[i1], pOverflow);
-
-                    /* alp1 = alp0 + rr[i0][i1] + 1/2*rr[i1][i1]; */
-
-                    /* idx incr = STEP */
-                    /* alp1 = L_mac(alp0, rr[i1][i1], _1_4, pOverflow); */
-                    alp1 = alp0 + ((Word32) rr[i1][i1] << 14);
-
-                    /* idx incr = STEP */
-                    /* alp1 = L_mac(alp1, rr[i0][i1], _1_2, pOverflow); */
-                    alp1 += (Word32) rr[i0][i1] << 15;
-
-                    /* sq1 = mult(ps1, ps1, pOverflow); */
-                    sq1 = (Word16)(((Word32) ps1 * ps1) >> 15);
-
-                    /* alp_16 = pv_round(alp1, pOverflow); */
-                    alp_16 = (Word16)((alp1 + (Word32) 0x00008000L) >> 16);
+                placed[0] = i0;
+                score_track(ps0, alp0, dn, rr, ipos[1], placed, 1, 14, 15,
+                            ps1, sq1, alp_16, pOverflow);
 
+                for (m = 0, i1 = ipos[1]; i1 < L_CODE; m++, i1 += STEP)
+                {
                     /* s = L_mult(alp, sq1, pOverflow); */
-                    s = ((Word32) alp * sq1) << 1;
+                    s = ((Word32) alp * sq1[m]) << 1;
 
                     /* s =L_msu(s, sq, alp_16, pOverflow); */
-                    s -= (((Word32) sq * alp_16) << 1);
+                    s -= (((Word32) sq * alp_16[m]) << 1);
 
                     if (s > 0)
                     {
-                        sq = sq1;
-                        alp = alp_16;
+                        sq = sq1[m];
+                        alp = alp_16[m];
                         ix = i1;
                     }
 
@@ -768,4 +770,3 @@ static Word16 build_code(
     return indx;
 }
 
-
@@ -58,6 +58,7 @@ terms listed above has been obtained from the copyright holder.
 #include "cor_h.h"
 #include "cor_h_x.h"
 #include "set_sign.h"
+#include "score_trk.h"
 
 /*--------------------------------------------------------------------------*/
 #ifdef __cplusplus
@@ -84,6 +85,7 @@ extern "C"
     static void search_2i40(
         Word16 subNr,       /* i : subframe number                               */
         Word16 dn[],        /* i : correlation between target and h[]            */
+        Word16 dn2[],       /* i : maximum of corr. in each track.               */
         Word16 rr[][L_CODE],/* i : matrix of autocorrelation                     */
         const Word16* startPos_ptr, /* i: ptr to read only table                 */
         Word16 codvec[],    /* o : algebraic codebook vector                     */
@@ -139,6 +141,7 @@ extern "C"
         code = buffer containing the innovative codebook (Word16)
         y = buffer containing the filtered fixed codebook excitation (Word16)
         sign = pointer to the signs of 2 pulses (Word16)
+        complexity = search effort, 0..COMPLEXITY_MAX (Word16)
 
      Outputs:
         code buffer contains the new innovation vector gains
@@ -187,6 +190,9 @@ extern "C"
         second  i0 :  1, 6, 11, 16, 21, 26, 31, 36.
                     i1 :  4, 9, 14, 19, 24, 29, 34, 39.
 
+     Below COMPLEXITY_MAX, i0 only tries the positions with the largest
+     correlation of its track (see COMPLEXITY_SCALE).
+
     ------------------------------------------------------------------------------
      REQUIREMENTS
 
@@ -258,6 +264,7 @@ extern "C"
         Word16 y[],         /* o : filtered fixed codebook excitation       */
         Word16 * sign,      /* o : Signs of 2 pulses                        */
         const Word16* startPos_ptr, /* ptr to read-only table              */
+        Word16 complexity,  /* i : search effort, 0..COMPLEXITY_MAX         */
         Flag   * pOverflow  /* o : Flag set when overflow occurs            */
     )
     {
@@ -312,13 +319,13 @@ extern "C"
             1,
             pOverflow);
 
-        /* dn2[] not used in this codebook search */
+        /* dn2[] marks the positions i0 starts on, all of them at full effort */
 
         set_sign(
             dn,
             dn_sign,
             dn2,
-            8);
+            COMPLEXITY_SCALE(8, complexity));
 
         cor_h(
             h,
@@ -329,6 +336,7 @@ extern "C"
         search_2i40(
             subNr,
             dn,
+            dn2,
             rr,
             startPos_ptr,
             codvec,
@@ -384,6 +392,8 @@ extern "C"
         subNr = subframe number (Word16)
         dn = vector containing the correlation between target and the impulse
              response of the weighted synthesis filter (Word16)
+        dn2 = positions of each track i0 starts on, the others are
+              negative (Word16)
         rr = autocorrelation matrix (Word16)
         codvec = algebraic codebook vector (Word16)
 
@@ -521,6 +531,7 @@ extern "C"
     static void search_2i40(
         Word16 subNr,        /* i : subframe number                    */
         Word16 dn[],         /* i : correlation between target and h[] */
+        Word16 dn2[],        /* i : maximum of corr. in each track.    */
         Word16 rr[][L_CODE], /* i : matrix of autocorrelation          */
         const Word16* startPos_ptr, /* i: ptr to read only table       */
         Word16 codvec[],     /* o : algebraic codebook vector          */
@@ -534,18 +545,19 @@ extern "C"
         Word16 ipos[NB_PULSE];
         Word16 psk;
         Word16 ps0;
-        Word16 ps1;
+        Word16 ps1[NB_TRACK_POS];
         Word16 sq;
-        Word16 sq1;
+        Word16 sq1[NB_TRACK_POS];
         Word16 alpk;
         Word16 alp;
-        Word16 alp_16;
+        Word16 alp_16[NB_TRACK_POS];
         Word32 s;
         Word32 alp0;
-        Word32 alp1;
         register Word16 i;
         Word32 L_temp;
         Word16 *p_codvec = &codvec[0];
+        Word16 m;
+        Word16 placed[1];
 
         OSCL_UNUSED_ARG(pOverflow);
 
@@ -576,6 +588,11 @@ extern "C"
 
             for (i0 = *ipos; i0 < L_CODE; i0 += STEP)
             {
+                if (dn2[i0] < 0)
+                {
+                    continue;
+                }
+
                 ps0 = *(dn + i0);
 
                 /* Left shift by 1 converts integer product to */
@@ -598,42 +615,22 @@ extern "C"
                 *  and incremented by "STEP".                       *
                 *---------------------------------------------------*/
 
-                for (i1 = *(ipos + 1); i1 < L_CODE; i1 += STEP)
-                {
-                    /* idx increment = STEP */
-                    /* ps1 = add(ps0, *(dn + i1), pOverflow); */
-                    ps1 = ps0 + dn[i1];
-
-                    /* alp1 = alp0+rr[i0][i1]+1/2*rr[i1][i1]; */
-
-                    /* idx incr = STEP */
-                    /* Extra left shift by 1 converts integer  */
-                    /* product to fractional product     */
-                    /* alp1 = L_add(alp0, s, pOverflow); */
-                    alp1 = alp0 + ((Word32) rr[i1][i1] << 14);
-
-                    /* idx incr = STEP */
-                    /* Extra left shift by 1 converts integer  */
-                    /* product to fractional product     */
-                    /* alp1 = L_add(alp1, s, pOverflow); */
-                    alp1 += (Word32) rr[i0][i1] << 15;
-
-                    /* sq1 = mult(ps1, ps1, pOverflow); */
-                    sq1 = (Word16)(((Word32) ps1 * ps1) >> 15);
-
-                    /* alp_16 = pv_round(alp1, pOverflow); */
-                    alp_16 = (Word16)((alp1 + (Word32) 0x00008000L) >> 16);
+                placed[0] = i0;
+                score_track(ps0, alp0, dn, rr, *(ipos + 1), placed, 1, 14, 15,
+                            ps1, sq1, alp_16, NULL);
 
+                for (m = 0, i1 = *(ipos + 1); i1 < L_CODE; m++, i1 += STEP)
+                {
                     /* L_temp = L_mult(alp, sq1, pOverflow); */
-                    L_temp = ((Word32) alp * sq1) << 1;
+                    L_temp = ((Word32) alp * sq1[m]) << 1;
 
                     /* s = L_msu(L_temp, sq, alp_16, pOverflow); */
-                    s = L_temp - (((Word32) sq * alp_16) << 1);
+                    s = L_temp - (((Word32) sq * alp_16[m]) << 1);
 
                     if (s > 0)
                     {
-                        sq = sq1;
-                        alp = alp_16;
+                        sq = sq1[m];
+                        alp = alp_16[m];
                         ix = i1;
                     }
                 }
@@ -737,9 +734,11 @@ extern "C"
            MODIFYING(nothing)
            RETURNING(nothing)
         ----------------------------------------------------------------------------*/
+        /* all positions kept: dn[] is non-negative after set_sign */
         search_2i40(
             subNr,
             dn,
+            dn,
             rr,
             startPos_ptr,
             codvec,
@@ -101,6 +101,7 @@ extern "C"
         Word16 y[],         /* o : filtered fixed codebook excitation            */
         Word16 * sign,      /* o : Signs of 2 pulses                             */
         const Word16* startPos_ptr, /* ptr to read-only table                    */
+        Word16 complexity,  /* i : search effort, 0..COMPLEXITY_MAX              */
         Flag   * pOverflow  /* o : Flag set when overflow occurs                 */
     );
 
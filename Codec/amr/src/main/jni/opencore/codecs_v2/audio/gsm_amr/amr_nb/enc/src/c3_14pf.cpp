@@ -48,6 +48,7 @@ terms listed above has been obtained from the copyright holder.
 #include "cnst.h"
 #include "cor_h.h"
 #include "set_sign.h"
+#include "score_trk.h"
 #include "basic_op.h"
 
 /*----------------------------------------------------------------------------
@@ -71,6 +72,7 @@ static void search_3i40(
     Word16 dn[],        /* i : correlation between target and h[]            */
     Word16 dn2[],       /* i : maximum of corr. in each track.               */
     Word16 rr[][L_CODE],/* i : matrix of autocorrelation                     */
+    Word16 rotations,   /* i : number of track rotations tried               */
     Word16 codvec[],    /* o : algebraic codebook vector                     */
     Flag   * pOverflow  /* o : Flag set when overflow occurs                 */
 );
@@ -108,6 +110,7 @@ static Word16 build_code(
 
     T0           Array of type Word16 -- Pitch lag
     pitch_sharp, Array of type Word16 --  Last quantized pitch gain
+    complexity   Word16 -- search effort, 0..COMPLEXITY_MAX
 
  Outputs:
     code[]  Array of type Word16 -- Innovative codebook
@@ -142,6 +145,10 @@ static Word16 build_code(
         i2 :  2, 7, 12, 17, 22, 27, 32, 37.
               4, 9, 14, 19, 24, 29, 34, 39.
 
+    Below COMPLEXITY_MAX the search is pruned: i0 only starts on the
+    positions with the largest correlation of its track, and fewer cyclic
+    rotations of the tracks are tried (see COMPLEXITY_SCALE).
+
 ------------------------------------------------------------------------------
  REQUIREMENTS
 
@@ -171,6 +178,7 @@ Word16 code_3i40_14bits(
     Word16 code[],      /* o : Innovative codebook                           */
     Word16 y[],         /* o : filtered fixed codebook excitation            */
     Word16 * sign,      /* o : Signs of 3 pulses                             */
+    Word16 complexity,  /* i : search effort, 0..COMPLEXITY_MAX              */
     Flag   * pOverflow  /* o : Flag set when overflow occurs                 */
 )
 {
@@ -216,7 +224,7 @@ Word16 code_3i40_14bits(
         dn,
         dn_sign,
         dn2,
-        6);
+        COMPLEXITY_SCALE(6, complexity));
 
     cor_h(
         h,
@@ -228,6 +236,7 @@ Word16 code_3i40_14bits(
         dn,
         dn2,
         rr,
+        COMPLEXITY_SCALE(NB_PULSE, complexity),
         codvec,
         pOverflow);
 
@@ -279,6 +288,7 @@ Word16 code_3i40_14bits(
     dn[]         Array of type Word16 -- correlation between target and h[]
     dn2[]        Array of type Word16 -- maximum of corr. in each track.
     rr[][L_CODE] Double Array of type Word16 -- autocorrelation matrix
+    rotations    Word16 -- number of cyclic rotations of the tracks tried
 
  Outputs:
     codvec[]     Array of type Word16 -- algebraic codebook vector
@@ -321,6 +331,7 @@ static void search_3i40(
     Word16 dn[],         /* i : correlation between target and h[] */
     Word16 dn2[],        /* i : maximum of corr. in each track.    */
     Word16 rr[][L_CODE], /* i : matrix of autocorrelation          */
+    Word16 rotations,    /* i : number of track rotations tried    */
     Word16 codvec[],     /* o : algebraic codebook vector          */
     Flag   * pOverflow   /* o : Flag set when overflow occurs      */
 )
@@ -340,18 +351,19 @@ static void search_3i40(
 
     Word16 psk;
     Word16 ps0;
-    Word16 ps1;
+    Word16 ps1[NB_TRACK_POS];
     Word16 sq;
-    Word16 sq1;
+    Word16 sq1[NB_TRACK_POS];
     Word16 alpk;
     Word16 alp;
-    Word16 alp_16;
+    Word16 alp_16[NB_TRACK_POS];
 
     Word16 *p_codvec = &codvec[0];
 
     Word32 s;
     Word32 alp0;
-    Word32 alp1;
+    Word16 m;
+    Word16 placed[NB_PULSE-1];
 
     psk = -1;
     alpk = 1;
@@ -375,7 +387,7 @@ static void search_3i40(
              * main loop: try 3 tracks.                                         *
              *------------------------------------------------------------------*/
 
-            for (i = 0; i < NB_PULSE; i++)
+            for (i = 0; i < rotations; i++)
             {
                 /*----------------------------------------------------------------*
                  * i0 loop: try 8 positions.                                      *
@@ -408,39 +420,23 @@ static void search_3i40(
                          *  and incremented by "STEP".                                       *
                          *-------------------------------------------------------------------*/
 
-                        for (i1 = ipos[1]; i1 < L_CODE; i1 += STEP)
-                        {
-                            /* idx increment = STEP */
-                            /* ps1 = add(ps0, dn[i1], pOverflow); */
-                            ps1 = ps0 + dn[i1];
-
-                            /* alp1 = alp0 + rr[i0][i1] + 1/2*rr[i1][i1]; */
-
-                            /* idx incr = STEP */
-                            /* alp1 = L_mac(alp0, rr[i1][i1], _1_4, pOverflow); */
-                            alp1 = alp0 + ((Word32) rr[i1][i1] << 14);
-
-                            /* idx incr = STEP */
-                            /* alp1 = L_mac(alp1, rr[i0][i1], _1_2, pOverflow); */
-                            alp1 += (Word32) rr[i0][i1] << 15;
-
-                            /* sq1 = mult(ps1, ps1, pOverflow); */
-                            sq1 = (Word16)(((Word32) ps1 * ps1) >> 15);
-
-                            /* alp_16 = pv_round(alp1, pOverflow); */
-                            alp_16 = (Word16)((alp1 + (Word32) 0x00008000L) >> 16);
+                        placed[0] = i0;
+                        score_track(ps0, alp0, dn, rr, ipos[1], placed, 1, 14, 15,
+                                    ps1, sq1, alp_16, NULL);
 
+                        for (m = 0, i1 = ipos[1]; i1 < L_CODE; m++, i1 += STEP)
+                        {
                             /* s = L_mult(alp, sq1, pOverflow); */
-                            s = ((Word32) alp * sq1) << 1;
+                            s = ((Word32) alp * sq1[m]) << 1;
 
                             /* s = L_msu(s, sq, alp_16, pOverflow); */
-                            s -= (((Word32) sq * alp_16) << 1);
+                            s -= (((Word32) sq * alp_16[m]) << 1);
 
                             if (s > 0)
                             {
-                                sq = sq1;
-                                ps = ps1;
-                                alp = alp_16;
+                                sq = sq1[m];
+                                ps = ps1[m];
+                                alp = alp_16[m];
                                 ix = i1;
                             }
                         }
@@ -462,43 +458,24 @@ static void search_3i40(
 
                         /* initialize 4 index for next loop (see i1 loop) */
 
-                        for (i2 = ipos[2]; i2 < L_CODE; i2 += STEP)
-                        {
-                            /* index increment = STEP */
-                            /* ps1 = add(ps0, dn[i2], pOverflow); */
-                            ps1 = ps0 + dn[i2];
-
-                            /* alp1 = alp0 + rr[i0][i2] + rr[i1][i2] + 1/2*rr[i2][i2]; */
-
-                            /* idx incr = STEP */
-                            /* alp1 = L_mac(alp0, rr[i2][i2], _1_16, pOverflow); */
-                            alp1 = alp0 + ((Word32) rr[i2][i2] << 12);
-
-                            /* idx incr = STEP */
-                            /* alp1 = L_mac(alp1, rr[i1][i2], _1_8, pOverflow); */
-                            alp1 += (Word32) rr[i1][i2] << 13;
-
-                            /* idx incr = STEP */
-                            /* alp1 = L_mac(alp1,rr[i0][i2], _1_8, pOverflow); */
-                            alp1 += (Word32) rr[i0][i2] << 13;
-
-                            /* sq1 = mult(ps1, ps1, pOverflow); */
-                            sq1 = (Word16)(((Word32) ps1 * ps1) >> 15);
-
-                            /* alp_16 = pv_round(alp1, pOverflow); */
-                            alp_16 = (Word16)((alp1 + (Word32) 0x00008000L) >> 16);
+                        placed[0] = i0;
+                        placed[1] = i1;
+                        score_track(ps0, alp0, dn, rr, ipos[2], placed, 2, 12, 13,
+                                    ps1, sq1, alp_16, NULL);
 
+                        for (m = 0, i2 = ipos[2]; i2 < L_CODE; m++, i2 += STEP)
+                        {
                             /* s = L_mult(alp, sq1, pOverflow); */
-                            s = ((Word32) alp * sq1) << 1;
+                            s = ((Word32) alp * sq1[m]) << 1;
 
                             /* s = L_msu(s, sq, alp_16, pOverflow); */
-                            s -= (((Word32) sq * alp_16) << 1);
+                            s -= (((Word32) sq * alp_16[m]) << 1);
 
                             if (s > 0)
                             {
-                                sq = sq1;
-                                ps = ps1;
-                                alp = alp_16;
+                                sq = sq1[m];
+                                ps = ps1[m];
+                                alp = alp_16[m];
                                 ix = i2;
                             }
                         }
@@ -740,9 +717,3 @@ build_code(
     return indx;
 }
 
-
-
-
-
-
-
@@ -100,6 +100,7 @@ extern "C"
         Word16 code[],      /* (o)   : Innovative codebook                   */
         Word16 y[],         /* (o)   : filtered fixed codebook excitation    */
         Word16 * sign,      /* (o)   : Signs of 3 pulses                     */
+        Word16 complexity,  /* (i)   : search effort, 0..COMPLEXITY_MAX      */
         Flag   *pOverflow
     );
 
@@ -100,6 +100,7 @@ extern "C"
         Word16 y[],         /* (o)   : filtered fixed codebook excitation    */
         Word16 * sign,      /* (o)   : Signs of 4 pulses                     */
         const Word16* gray_ptr,   /* i : ptr to read-only table                  */
+        Word16 complexity,  /* (i)   : search effort, 0..COMPLEXITY_MAX      */
         Flag   * pOverflow  /* (o)   : Flag set when overflow occurs         */
     );
 
@@ -598,6 +598,7 @@ static void compress_code(
     x   Array of type Word16 -- target vector
     cn  Array of type Word16 -- residual after long term prediction
     h   Array of type Word16 -- impulse response of weighted synthesis filter
+    complexity Word16 -- search effort, 0..COMPLEXITY_MAX
 
 
  Outputs:
@@ -642,6 +643,9 @@ static void compress_code(
    The function determines the optimal pulse signs and positions, builds
    the codevector, and computes the filtered codevector.
 
+   Below COMPLEXITY_MAX the pulse pairs are searched from fewer starting
+   tracks (see COMPLEXITY_SCALE).
+
 ------------------------------------------------------------------------------
  REQUIREMENTS
 
@@ -669,6 +673,7 @@ void code_8i40_31bits(
     Word16 cod[],      /* o : algebraic (fixed) codebook excitation          */
     Word16 y[],        /* o : filtered fixed codebook excitation             */
     Word16 indx[],     /* o : 7 Word16, index of 8 pulses (signs+positions)  */
+    Word16 complexity, /* i : search effort, 0..COMPLEXITY_MAX               */
     Flag  *pOverflow   /* o : Flag set when overflow occurs                  */
 )
 {
@@ -682,6 +687,10 @@ void code_8i40_31bits(
     Word16 rr[L_CODE][L_CODE];
     Word16 linear_signs[NB_TRACK_MR102];
     Word16 linear_codewords[NB_PULSE];
+    Word16 nbTracks;
+
+    /* search_10and8i40 starts from nbTracks - 1 tracks, all at full effort */
+    nbTracks = 1 + COMPLEXITY_SCALE(NB_TRACK_MR102 - 1, complexity);
 
     cor_h_x2(
         h,
@@ -715,7 +724,7 @@ void code_8i40_31bits(
     search_10and8i40(
         NB_PULSE,
         STEP_MR102,
-        NB_TRACK_MR102,
+        nbTracks,
         dn,
         rr,
         ipos,
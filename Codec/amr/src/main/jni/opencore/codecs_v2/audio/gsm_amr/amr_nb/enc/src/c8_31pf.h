@@ -99,6 +99,7 @@ extern "C"
         Word16 cod[],      /* o : algebraic (fixed) codebook excitation          */
         Word16 y[],        /* o : filtered fixed codebook excitation             */
         Word16 indx[],     /* o : 7 Word16, index of 8 pulses (signs+positions)  */
+        Word16 complexity, /* i : search effort, 0..COMPLEXITY_MAX               */
         Flag   * pOverflow /* o : Flag set when overflow occurs                  */
     );
 
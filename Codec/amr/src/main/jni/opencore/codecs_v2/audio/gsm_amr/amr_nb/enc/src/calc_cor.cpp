@@ -40,7 +40,10 @@ terms listed above has been obtained from the copyright holder.
 ; INCLUDES
 ----------------------------------------------------------------------------*/
 #include "calc_cor.h"
+#include "cnst.h"
 #include "basic_op.h"
+#include "basic_op_vec.h"
+#include "amrnb_cpu.h"
 /*----------------------------------------------------------------------------
 ; MACROS
 ; Define module specific macros here
@@ -66,7 +69,7 @@ terms listed above has been obtained from the copyright holder.
 
 /*
 ------------------------------------------------------------------------------
- FUNCTION NAME: comp_corr
+ FUNCTION NAME: comp_corr_c
 ------------------------------------------------------------------------------
  INPUT AND OUTPUT DEFINITIONS
 
@@ -150,7 +153,7 @@ void comp_corr (
 ------------------------------------------------------------------------------
 */
 
-void comp_corr(
+void comp_corr_c(
     Word16 scal_sig[],  /* i   : scaled signal.                     */
     Word16 L_frame,     /* i   : length of frame to compute pitch   */
     Word16 lag_max,     /* i   : maximum lag                        */
@@ -218,3 +221,437 @@ void comp_corr(
 
     return;
 }
+
+#if defined(AMRNB_SIMD_SSE2)
+/*
+------------------------------------------------------------------------------
+ FUNCTION NAME: comp_corr_sse2
+------------------------------------------------------------------------------
+ INPUT AND OUTPUT DEFINITIONS
+
+ Same as comp_corr_c.
+
+------------------------------------------------------------------------------
+ FUNCTION DESCRIPTION
+
+ Computes the correlations four lags at a time: each block of eight samples
+ of scal_sig[] is loaded once and multiplied against the four shifted
+ windows with 8-lane multiply-adds. The same lags as comp_corr_c are
+ written, and the sums wrap around the same way as the scalar accumulation.
+ Frame lengths that are not a multiple of 8 are left to comp_corr_c.
+
+------------------------------------------------------------------------------
+*/
+
+void comp_corr_sse2(
+    Word16 scal_sig[],  /* i   : scaled signal.                     */
+    Word16 L_frame,     /* i   : length of frame to compute pitch   */
+    Word16 lag_max,     /* i   : maximum lag                        */
+    Word16 lag_min,     /* i   : minimum lag                        */
+    Word32 corr[])      /* o   : correlation of selected lag        */
+{
+    Word16 i;
+    Word16 j;
+    Word16 *p1;
+    __m128i s;
+    __m128i t1;
+    __m128i t2;
+    __m128i t3;
+    __m128i t4;
+
+    if (L_frame & 7)
+    {
+        comp_corr_c(scal_sig, L_frame, lag_max, lag_min, corr);
+        return;
+    }
+
+    corr = corr - lag_max;
+    p1 = &scal_sig[-lag_max];
+
+    for (i = ((lag_max - lag_min) >> 2) + 1; i > 0; i--)
+    {
+        t1 = _mm_setzero_si128();
+        t2 = _mm_setzero_si128();
+        t3 = _mm_setzero_si128();
+        t4 = _mm_setzero_si128();
+
+        for (j = 0; j < L_frame; j += 8)
+        {
+            s = _mm_loadu_si128((__m128i *) &scal_sig[j]);
+            t1 = _mm_add_epi32(t1, _mm_madd_epi16(s, _mm_loadu_si128((__m128i *)(p1 + j))));
+            t2 = _mm_add_epi32(t2, _mm_madd_epi16(s, _mm_loadu_si128((__m128i *)(p1 + j + 1))));
+            t3 = _mm_add_epi32(t3, _mm_madd_epi16(s, _mm_loadu_si128((__m128i *)(p1 + j + 2))));
+            t4 = _mm_add_epi32(t4, _mm_madd_epi16(s, _mm_loadu_si128((__m128i *)(p1 + j + 3))));
+        }
+
+        _mm_storeu_si128((__m128i *) corr,
+                         _mm_slli_epi32(amrnb_hsum4_epi32(t1, t2, t3, t4), 1));
+        corr += 4;
+        p1 += 4;
+    }
+
+    return;
+}
+#endif
+
+#if defined(AMRNB_SIMD_AVX2)
+/*
+------------------------------------------------------------------------------
+ FUNCTION NAME: comp_corr_avx2
+------------------------------------------------------------------------------
+ INPUT AND OUTPUT DEFINITIONS
+
+ Same as comp_corr_c.
+
+------------------------------------------------------------------------------
+ FUNCTION DESCRIPTION
+
+ comp_corr_sse2 with blocks of sixteen samples. Frame lengths that are not
+ a multiple of 16 are left to comp_corr_sse2.
+
+------------------------------------------------------------------------------
+*/
+
+AMRNB_TARGET_AVX2 void comp_corr_avx2(
+    Word16 scal_sig[],  /* i   : scaled signal.                     */
+    Word16 L_frame,     /* i   : length of frame to compute pitch   */
+    Word16 lag_max,     /* i   : maximum lag                        */
+    Word16 lag_min,     /* i   : minimum lag                        */
+    Word32 corr[])      /* o   : correlation of selected lag        */
+{
+    Word16 i;
+    Word16 j;
+    Word16 *p1;
+    __m256i s;
+    __m256i t1;
+    __m256i t2;
+    __m256i t3;
+    __m256i t4;
+
+    if (L_frame & 15)
+    {
+        comp_corr_sse2(scal_sig, L_frame, lag_max, lag_min, corr);
+        return;
+    }
+
+    corr = corr - lag_max;
+    p1 = &scal_sig[-lag_max];
+
+    for (i = ((lag_max - lag_min) >> 2) + 1; i > 0; i--)
+    {
+        t1 = _mm256_setzero_si256();
+        t2 = _mm256_setzero_si256();
+        t3 = _mm256_setzero_si256();
+        t4 = _mm256_setzero_si256();
+
+        for (j = 0; j < L_frame; j += 16)
+        {
+            s = _mm256_loadu_si256((__m256i *) &scal_sig[j]);
+            t1 = _mm256_add_epi32(t1, _mm256_madd_epi16(s, _mm256_loadu_si256((__m256i *)(p1 + j))));
+            t2 = _mm256_add_epi32(t2, _mm256_madd_epi16(s, _mm256_loadu_si256((__m256i *)(p1 + j + 1))));
+            t3 = _mm256_add_epi32(t3, _mm256_madd_epi16(s, _mm256_loadu_si256((__m256i *)(p1 + j + 2))));
+            t4 = _mm256_add_epi32(t4, _mm256_madd_epi16(s, _mm256_loadu_si256((__m256i *)(p1 + j + 3))));
+        }
+
+        _mm_storeu_si128((__m128i *) corr,
+                         _mm_slli_epi32(amrnb_hsum4_epi32(amrnb_fold_epi32_256(t1),
+                                                          amrnb_fold_epi32_256(t2),
+                                                          amrnb_fold_epi32_256(t3),
+                                                          amrnb_fold_epi32_256(t4)), 1));
+        corr += 4;
+        p1 += 4;
+    }
+
+    return;
+}
+#endif
+
+/* Implementation of comp_corr that calc_cor_cpu_select() selected */
+static void (*comp_corr_impl)(Word16 scal_sig[], Word16 L_frame,
+                              Word16 lag_max, Word16 lag_min,
+                              Word32 corr[]) = comp_corr_c;
+
+/*
+------------------------------------------------------------------------------
+ FUNCTION NAME: comp_corr
+------------------------------------------------------------------------------
+ INPUT AND OUTPUT DEFINITIONS
+
+ Same as comp_corr_c.
+
+------------------------------------------------------------------------------
+ FUNCTION DESCRIPTION
+
+ Runs the implementation of comp_corr that calc_cor_cpu_select() selected
+ (see amrnb_cpu.h).
+
+------------------------------------------------------------------------------
+*/
+
+void comp_corr(
+    Word16 scal_sig[],  /* i   : scaled signal.                     */
+    Word16 L_frame,     /* i   : length of frame to compute pitch   */
+    Word16 lag_max,     /* i   : maximum lag                        */
+    Word16 lag_min,     /* i   : minimum lag                        */
+    Word32 corr[])      /* o   : correlation of selected lag        */
+{
+    comp_corr_impl(scal_sig, L_frame, lag_max, lag_min, corr);
+}
+
+
+/*
+------------------------------------------------------------------------------
+ FUNCTION NAME: cross_corr4_c
+------------------------------------------------------------------------------
+ INPUT AND OUTPUT DEFINITIONS
+
+ Inputs:
+    x = first vector, L elements (Word16)
+    y = second vector, L + n - 1 elements (Word16)
+    L = length of the correlations (Word16)
+    n = number of correlations, a multiple of 4 (Word16)
+
+ Outputs:
+    r = r[k] = <x[j],y[j+k]>, k=0,...,n-1, with 32-bit wrap-around (Word32)
+
+------------------------------------------------------------------------------
+ FUNCTION DESCRIPTION
+
+ Four correlations per pass over x[], as in comp_corr_c.
+
+------------------------------------------------------------------------------
+*/
+
+static void cross_corr4_c(const Word16 x[], const Word16 y[], Word16 L,
+                          Word16 n, Word32 r[])
+{
+    Word16 i;
+    Word16 j;
+    Word32 t1;
+    Word32 t2;
+    Word32 t3;
+    Word32 t4;
+
+    for (i = 0; i < n; i += 4)
+    {
+        t1 = 0;
+        t2 = 0;
+        t3 = 0;
+        t4 = 0;
+        for (j = 0; j < L; j++)
+        {
+            t1 = amrnb_fxp_mac_16_by_16bb((Word32) x[j], (Word32) y[i + j], t1);
+            t2 = amrnb_fxp_mac_16_by_16bb((Word32) x[j], (Word32) y[i + j + 1], t2);
+            t3 = amrnb_fxp_mac_16_by_16bb((Word32) x[j], (Word32) y[i + j + 2], t3);
+            t4 = amrnb_fxp_mac_16_by_16bb((Word32) x[j], (Word32) y[i + j + 3], t4);
+        }
+        r[i] = t1;
+        r[i + 1] = t2;
+        r[i + 2] = t3;
+        r[i + 3] = t4;
+    }
+
+    return;
+}
+
+#if defined(AMRNB_SIMD_SSE2)
+/*
+------------------------------------------------------------------------------
+ FUNCTION NAME: cross_corr4_sse2
+------------------------------------------------------------------------------
+ INPUT AND OUTPUT DEFINITIONS
+
+ Same as cross_corr4_c.
+
+------------------------------------------------------------------------------
+ FUNCTION DESCRIPTION
+
+ The loop of comp_corr_sse2 on two vectors. Lengths that are not a
+ multiple of 8 are left to cross_corr4_c.
+
+------------------------------------------------------------------------------
+*/
+
+static void cross_corr4_sse2(const Word16 x[], const Word16 y[], Word16 L,
+                             Word16 n, Word32 r[])
+{
+    Word16 i;
+    Word16 j;
+    __m128i s;
+    __m128i t1;
+    __m128i t2;
+    __m128i t3;
+    __m128i t4;
+
+    if (L & 7)
+    {
+        cross_corr4_c(x, y, L, n, r);
+        return;
+    }
+
+    for (i = 0; i < n; i += 4)
+    {
+        t1 = _mm_setzero_si128();
+        t2 = _mm_setzero_si128();
+        t3 = _mm_setzero_si128();
+        t4 = _mm_setzero_si128();
+
+        for (j = 0; j < L; j += 8)
+        {
+            s = _mm_loadu_si128((const __m128i *) &x[j]);
+            t1 = _mm_add_epi32(t1, _mm_madd_epi16(s, _mm_loadu_si128((const __m128i *) &y[i + j])));
+            t2 = _mm_add_epi32(t2, _mm_madd_epi16(s, _mm_loadu_si128((const __m128i *) &y[i + j + 1])));
+            t3 = _mm_add_epi32(t3, _mm_madd_epi16(s, _mm_loadu_si128((const __m128i *) &y[i + j + 2])));
+            t4 = _mm_add_epi32(t4, _mm_madd_epi16(s, _mm_loadu_si128((const __m128i *) &y[i + j + 3])));
+        }
+
+        _mm_storeu_si128((__m128i *) &r[i], amrnb_hsum4_epi32(t1, t2, t3, t4));
+    }
+
+    return;
+}
+#endif
+
+/* Implementation of cross_corr4 that calc_cor_cpu_select() selected */
+static void (*cross_corr4_impl)(const Word16 x[], const Word16 y[], Word16 L,
+                                Word16 n, Word32 r[]) = cross_corr4_c;
+
+/*
+------------------------------------------------------------------------------
+ FUNCTION NAME: comp_corr_dec
+------------------------------------------------------------------------------
+ INPUT AND OUTPUT DEFINITIONS
+
+ Same as comp_corr_c.
+
+------------------------------------------------------------------------------
+ FUNCTION DESCRIPTION
+
+ Reduced effort form of comp_corr for the encoder complexity levels below
+ COMPLEXITY_MAX: each correlation is taken over the even samples of the
+ frame only and doubled, at half the cost of the full sums,
+
+         cor[t] = 2 * <scal_sig[2n],scal_sig[2n-t]>,  t=lag_min,...,lag_max
+
+ The signal is split into its even and odd samples first, so that the even
+ lags are the correlations of the even samples with themselves and the odd
+ lags those of the even samples with the odd ones; both sets are computed
+ four lags at a time like comp_corr. Results are saturated to 32 bits.
+
+------------------------------------------------------------------------------
+*/
+
+void comp_corr_dec(
+    Word16 scal_sig[],  /* i   : scaled signal.                     */
+    Word16 L_frame,     /* i   : length of frame to compute pitch   */
+    Word16 lag_max,     /* i   : maximum lag                        */
+    Word16 lag_min,     /* i   : minimum lag                        */
+    Word32 corr[])      /* o   : correlation of selected lag        */
+{
+    Word16 i;
+    Word16 half;
+    Word16 L_half;
+    Word16 hi_even;
+    Word16 hi_odd;
+    Word16 n;
+    Word32 t;
+    Word16 even[(PIT_MAX + 1) / 2 + L_FRAME / 2];
+    Word16 odd[(PIT_MAX + 1) / 2 + L_FRAME / 2];
+    Word32 r_even[(PIT_MAX + 1) / 2 + 4];
+    Word32 r_odd[(PIT_MAX + 1) / 2 + 4];
+    Word16 *p_even;
+    Word16 *p_odd;
+
+    half = (lag_max + 1) >> 1;
+    L_half = L_frame >> 1;
+
+    /* even[k] = scal_sig[2k], odd[k] = scal_sig[2k + 1], k = -half.. */
+    p_even = &even[half];
+    p_odd = &odd[half];
+
+    for (i = -half; i < L_half; i++)
+    {
+        p_even[i] = ((i << 1) >= -lag_max) ? scal_sig[i << 1] : 0;
+        p_odd[i] = scal_sig[(i << 1) + 1];
+    }
+
+    /* lag 2m pairs p_even[j] with p_even[j - m], lag 2m - 1 pairs it with
+       p_odd[j - m]; r_even[k] and r_odd[k] hold m = hi_even - k, hi_odd - k */
+    hi_even = lag_max >> 1;
+    hi_odd = (lag_max + 1) >> 1;
+    n = (hi_even - ((lag_min + 1) >> 1) + 4) & ~3;
+    cross_corr4_impl(p_even, &p_even[-hi_even], L_half, n, r_even);
+    n = (hi_odd - ((lag_min + 1) >> 1) + 4) & ~3;
+    cross_corr4_impl(p_even, &p_odd[-hi_odd], L_half, n, r_odd);
+
+    for (i = lag_min; i <= lag_max; i++)
+    {
+        if (i & 1)
+        {
+            t = r_odd[hi_odd - ((i + 1) >> 1)];
+        }
+        else
+        {
+            t = r_even[hi_even - (i >> 1)];
+        }
+
+        /* doubled for the skipped samples, and << 1 as in comp_corr */
+        if (t > (Word32) 0x1fffffffL)
+        {
+            corr[-i] = MAX_32;
+        }
+        else if (t < (Word32) - 0x20000000L)
+        {
+            corr[-i] = MIN_32;
+        }
+        else
+        {
+            corr[-i] = t << 2;
+        }
+    }
+
+    return;
+}
+
+/*
+------------------------------------------------------------------------------
+ FUNCTION NAME: calc_cor_cpu_select
+------------------------------------------------------------------------------
+ INPUT AND OUTPUT DEFINITIONS
+
+ Inputs:
+    features = AMRNB_CPU_* features the kernels may use (Word32)
+
+ Outputs:
+    comp_corr_impl = the comp_corr implementation for features
+    cross_corr4_impl = the cross_corr4 implementation for features
+
+ Returns:
+    None
+
+------------------------------------------------------------------------------
+ FUNCTION DESCRIPTION
+
+ Part of the kernel table of the encoder library, run when the features in
+ use are set (see amrnb_cpu.h).
+
+------------------------------------------------------------------------------
+*/
+void calc_cor_cpu_select(Word32 features)
+{
+    comp_corr_impl = comp_corr_c;
+    cross_corr4_impl = cross_corr4_c;
+#if defined(AMRNB_SIMD_SSE2)
+    if (features & AMRNB_CPU_SSE2)
+    {
+        comp_corr_impl = comp_corr_sse2;
+        cross_corr4_impl = cross_corr4_sse2;
+    }
+#endif
+#if defined(AMRNB_SIMD_AVX2)
+    if (features & AMRNB_CPU_AVX2)
+    {
+        comp_corr_impl = comp_corr_avx2;
+    }
+#endif
+}
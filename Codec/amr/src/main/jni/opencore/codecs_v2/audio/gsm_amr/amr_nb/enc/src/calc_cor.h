@@ -49,6 +49,7 @@ terms listed above has been obtained from the copyright holder.
 ********************************************************************************
 */
 #include "typedef.h"
+#include "amrnb_simd.h"
 
 #ifdef __cplusplus
 extern "C"
@@ -80,6 +81,27 @@ extern "C"
     Word32 corr[]       /* o   : correlation of selected lag        */
                   );
 
+    /* Implementations selected by comp_corr() */
+    void comp_corr_c(Word16 scal_sig[], Word16 L_frame, Word16 lag_max,
+                     Word16 lag_min, Word32 corr[]);
+#if defined(AMRNB_SIMD_SSE2)
+    void comp_corr_sse2(Word16 scal_sig[], Word16 L_frame, Word16 lag_max,
+                        Word16 lag_min, Word32 corr[]);
+#endif
+#if defined(AMRNB_SIMD_AVX2)
+    AMRNB_TARGET_AVX2 void comp_corr_avx2(Word16 scal_sig[], Word16 L_frame, Word16 lag_max,
+                                          Word16 lag_min, Word32 corr[]);
+#endif
+
+    /* Same correlations taken over the even samples only and doubled,
+       at half the cost (encoder complexity levels below COMPLEXITY_MAX) */
+    void comp_corr_dec(Word16 scal_sig[], Word16 L_frame, Word16 lag_max,
+                       Word16 lag_min, Word32 corr[]);
+
+    /* Selects the implementation of comp_corr and comp_corr_dec for the
+       AMRNB_CPU_* features (see amrnb_cpu.h) */
+    void calc_cor_cpu_select(Word32 features);
+
 #ifdef __cplusplus
 }
 #endif
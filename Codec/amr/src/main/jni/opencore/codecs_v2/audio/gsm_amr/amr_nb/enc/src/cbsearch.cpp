@@ -48,6 +48,7 @@ terms listed above has been obtained from the copyright holder.
     res2[] -- array of type Word16 -- Long term prediction residual, Q0
     mode -- enum Mode --  coder mode
     subNr -- Word16 -- subframe number
+    complexity -- Word16 -- search effort, 0..COMPLEXITY_MAX
 
  Outputs:
     code[] -- array of type Word16 -- Innovative codebook, Q13
@@ -160,6 +161,7 @@ void cbsearch(Word16 x[],        /* i : target vector, Q0                     */
               enum Mode mode,    /* i : coder mode                            */
               Word16 subNr,      /* i : subframe number                       */
               CommonAmrTbls* common_amr_tbls, /* ptr to struct of tables    */
+              Word16 complexity, /* i : search effort, 0..COMPLEXITY_MAX     */
               Flag  *pOverflow)  /* o : Flag set when overflow occurs         */
 {
     Word16 index;
@@ -185,6 +187,7 @@ void cbsearch(Word16 x[],        /* i : target vector, Q0                     */
                 y,
                 &index,
                 common_amr_tbls->startPos_ptr,
+                complexity,
                 pOverflow);
 
         *(*anap)++ = index;    /* sign index */
@@ -200,6 +203,7 @@ void cbsearch(Word16 x[],        /* i : target vector, Q0                     */
                 code,
                 y,
                 &index,
+                complexity,
                 pOverflow);
 
         *(*anap)++ = index;    /* sign index */
@@ -215,6 +219,7 @@ void cbsearch(Word16 x[],        /* i : target vector, Q0                     */
                 code,
                 y,
                 &index,
+                complexity,
                 pOverflow);
 
         *(*anap)++ = index;    /* sign index */
@@ -231,6 +236,7 @@ void cbsearch(Word16 x[],        /* i : target vector, Q0                     */
                 y,
                 &index,
                 common_amr_tbls->gray_ptr,
+                complexity,
                 pOverflow);
 
         *(*anap)++ = index;    /* sign index */
@@ -274,6 +280,7 @@ void cbsearch(Word16 x[],        /* i : target vector, Q0                     */
             code,
             y,
             *anap,
+            complexity,
             pOverflow);
 
         *anap += 7;
@@ -334,6 +341,7 @@ void cbsearch(Word16 x[],        /* i : target vector, Q0                     */
             y,
             *anap,
             common_amr_tbls->gray_ptr,
+            complexity,
             pOverflow);
 
         *anap += 10;
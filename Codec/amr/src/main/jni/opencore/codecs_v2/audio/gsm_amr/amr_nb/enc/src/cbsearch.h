@@ -108,6 +108,7 @@ extern "C"
     enum Mode mode, /* i : coder mode                             */
     Word16 subNr,   /* i : subframe number                        */
     CommonAmrTbls* common_amr_tbls, /* ptr to struct of tables    */
+    Word16 complexity, /* i : search effort, 0..COMPLEXITY_MAX    */
     Flag  *pOverflow  /* o : Flag set when overflow occurs        */
                  );
 
@@ -369,6 +369,7 @@ void cl_ltp_exit(clLtpState **state)
     res2 = pointer to long term prediction residual (Word16)
     xn = pointer to target vector for pitch search (Word16)
     lsp_flag = LSP resonance flag (Word16)
+    complexity = search effort, 0..COMPLEXITY_MAX (Word16)
 
  Outputs:
     clSt = pointer to the clLtpState struct
@@ -542,6 +543,7 @@ void cl_ltp(
     Word16 **anap,       /* o   : Analysis parameters                       */
     Word16 *gp_limit,    /* o   : pitch gain limit                          */
     const Word16* qua_gain_pitch_ptr, /* i : ptr to read-only table         */
+    Word16 complexity,   /* i   : search effort, 0..COMPLEXITY_MAX          */
     Flag   *pOverflow    /* o   : overflow indicator                        */
 )
 {
@@ -573,6 +575,7 @@ void cl_ltp(
             T0_frac,
             &resu3,
             &index,
+            complexity,
             pOverflow);
 
     *(*anap)++ = index;
@@ -136,6 +136,7 @@ extern "C"
         Word16 **anap,       /* o   : Analysis parameters                       */
         Word16 *gp_limit,    /* o   : pitch gain limit                          */
         const Word16* qua_gain_pitch_ptr, /* i : ptr to read-only table         */
+        Word16 complexity,   /* i   : search effort, 0..COMPLEXITY_MAX          */
         Flag   *pOverflow    /* o   : overflow indicator                        */
     );
 
@@ -248,6 +248,7 @@ Word16 cod_amr_init(cod_amrState **state, Flag dtx)
     s->vadSt = NULL;
     s->dtx_encSt = NULL;
     s->dtx = dtx;
+    s->complexity = COMPLEXITY_MAX;
 
     /* Initialize overflow Flag */
 
@@ -452,6 +453,11 @@ Word16 cod_amr_reset(cod_amrState *st)
         st->old_lags[i] = 40;
     }
 
+    st->hint = 0;
+
+    /* full search again, as after cod_amr_init */
+    st->complexity = COMPLEXITY_MAX;
+
     /* Reset lpc states */
     lpc_reset(st->lpcSt);
 
@@ -1196,11 +1202,16 @@ Word16 cod_amr(
     *         subframes (both quantized and unquantized)                     *
     *------------------------------------------------------------------------*/
 
-    /* LP analysis */
-    lpc(st->lpcSt, mode, st->p_window, st->p_window_12k2, A_t, &(st->common_amr_tbls), pOverflow);
+    /* LP analysis, unless the LSPs come from the frame being transcoded */
+    if (!st->hint)
+    {
+        lpc(st->lpcSt, mode, st->p_window, st->p_window_12k2, A_t, &(st->common_amr_tbls),
+            pOverflow);
+    }
 
     /* From A(z) to lsp. LSP quantization and interpolation */
-    lsp(st->lspSt, mode, *usedMode, A_t, Aq_t, lsp_new, &ana, pOverflow);
+    lsp(st->lspSt, mode, *usedMode, A_t, Aq_t, lsp_new, &ana,
+        st->hint ? st->hint_lsp : NULL, pOverflow);
 
     /* Buffer lsp's and energy */
     dtx_buffer(st->dtx_encSt,
@@ -1262,22 +1273,28 @@ Word16 cod_amr(
                 st->mem_w, st->wsp, pOverflow);
 
 
-        if ((mode != MR475) && (mode != MR515))
+        /* The VAD needs the open-loop search even with hinted lags */
+        if (st->hint && !st->dtx)
+        {
+            T_op[subfrNr] = st->hint_T_op[subfrNr];
+            st->ol_gain_flg[subfrNr] = 0;
+        }
+        else if ((mode != MR475) && (mode != MR515))
         {
             /* Find open loop pitch lag for two subframes */
             ol_ltp(st->pitchOLWghtSt, st->vadSt, mode, &st->wsp[i_subfr],
                    &T_op[subfrNr], st->old_lags, st->ol_gain_flg, subfrNr,
-                   st->dtx, pOverflow);
+                   st->dtx, st->complexity, pOverflow);
         }
     }
 
-    if ((mode == MR475) || (mode == MR515))
+    if (((mode == MR475) || (mode == MR515)) && !(st->hint && !st->dtx))
     {
         /* Find open loop pitch lag for ONE FRAME ONLY */
         /* search on 160 samples */
 
         ol_ltp(st->pitchOLWghtSt, st->vadSt, mode, &st->wsp[0], &T_op[0],
-               st->old_lags, st->ol_gain_flg, 1, st->dtx, pOverflow);
+               st->old_lags, st->ol_gain_flg, 1, st->dtx, st->complexity, pOverflow);
         T_op[1] = T_op[0];
     }
 
@@ -1380,7 +1397,8 @@ Word16 cod_amr(
         cl_ltp(st->clLtpSt, st->tonStabSt, *usedMode, i_subfr, T_op, st->h1,
                &st->exc[i_subfr], res2, xn, lsp_flag, xn2, y1,
                &T0, &T0_frac, &gain_pit, gCoeff, &ana,
-               &gp_limit, st->common_amr_tbls.qua_gain_pitch_ptr, pOverflow);
+               &gp_limit, st->common_amr_tbls.qua_gain_pitch_ptr,
+               st->complexity, pOverflow);
 
         /* update LTP lag history */
 
@@ -1399,7 +1417,8 @@ Word16 cod_amr(
         * - Inovative codebook search (find index and gain)               *
         *-----------------------------------------------------------------*/
         cbsearch(xn2, st->h1, T0, st->sharp, gain_pit, res2,
-                 code, y2, &ana, *usedMode, subfrNr, &(st->common_amr_tbls), pOverflow);
+                 code, y2, &ana, *usedMode, subfrNr, &(st->common_amr_tbls),
+                 st->complexity, pOverflow);
 
         /*------------------------------------------------------*
         * - Quantization of gains.                             *
@@ -1496,6 +1515,9 @@ the_end:
     oscl_memcpy(&st->old_wsp[0], &st->old_wsp[L_FRAME], PIT_MAX*sizeof(Word16));
     oscl_memcpy(&st->old_speech[0], &st->old_speech[L_FRAME], (L_TOTAL - L_FRAME)*sizeof(Word16));
 
+    /* hints only hold for the frame they were given for */
+    st->hint = 0;
+
     return(0);
 }
 
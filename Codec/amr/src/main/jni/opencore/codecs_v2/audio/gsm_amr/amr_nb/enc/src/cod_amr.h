@@ -147,6 +147,15 @@ extern "C"
         Flag dtx;
         dtx_encState *dtx_encSt;
 
+        /* Search effort, 0..COMPLEXITY_MAX */
+        Word16 complexity;
+
+        /* Transcoder hints for the next frame (see AMREncodeSetHints): */
+        /* LSPs at the 2nd and 4th subframe, open-loop lags             */
+        Flag hint;
+        Word16 hint_lsp[2 * M];
+        Word16 hint_T_op[2];
+
         /* Filter's memory */
         Word16 mem_syn[M], mem_w0[M], mem_w[M];
         Word16 mem_err[M + L_SUBFR], *error;
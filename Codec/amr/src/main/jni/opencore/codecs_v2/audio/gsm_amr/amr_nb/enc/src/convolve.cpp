@@ -42,6 +42,10 @@ terms listed above has been obtained from the copyright holder.
 #include "typedef.h"
 #include "convolve.h"
 #include "basic_op.h"
+#include "basic_op_vec.h"
+#include "cnst.h"
+#include "oscl_mem.h"
+#include "amrnb_cpu.h"
 
 /*----------------------------------------------------------------------------
 ; MACROS
@@ -148,7 +152,7 @@ void Convolve (
 ------------------------------------------------------------------------------
 */
 
-void Convolve(
+void Convolve_c(
     Word16 x[],        /* (i)     : input vector                           */
     Word16 h[],        /* (i)     : impulse response                       */
     Word16 y[],        /* (o)     : output vector                          */
@@ -186,3 +190,319 @@ void Convolve(
 
     return;
 }
+
+#if defined(AMRNB_SIMD_SSE2)
+/*
+------------------------------------------------------------------------------
+ FUNCTION NAME: Convolve_sse2
+------------------------------------------------------------------------------
+ INPUT AND OUTPUT DEFINITIONS
+
+ Same as Convolve_c.
+
+------------------------------------------------------------------------------
+ FUNCTION DESCRIPTION
+
+ Computes eight outputs y[n..n+7] at a time. Each step applies the input
+ pair {x[i], x[i+1]} to the interleaved {h[n-i], h[n-i-1]} of all eight
+ outputs with one multiply-add; h[] is copied behind eight zeros so that
+ the terms with n < i vanish instead of needing a triangular loop.
+
+------------------------------------------------------------------------------
+*/
+
+void Convolve_sse2(
+    Word16 x[],        /* (i)     : input vector                           */
+    Word16 h[],        /* (i)     : impulse response                       */
+    Word16 y[],        /* (o)     : output vector                          */
+    Word16 L           /* (i)     : vector size                            */
+)
+{
+    Word16 i, n;
+    Word16 h_pad[8 + L_SUBFR];
+    Word32 s;
+
+    if (L > L_SUBFR)
+    {
+        Convolve_c(x, h, y, L);
+        return;
+    }
+
+    oscl_memset(h_pad, 0, 8*sizeof(Word16));
+    oscl_memcpy(&h_pad[8], h, L*sizeof(Word16));
+
+    for (n = 0; n + 8 <= L; n += 8)
+    {
+        __m128i s_lo = _mm_setzero_si128();
+        __m128i s_hi = _mm_setzero_si128();
+
+        for (i = 0; i < n + 8; i += 2)
+        {
+            __m128i c = amrnb_pair_epi16(x[i], x[i + 1]);
+            __m128i w0 = _mm_loadu_si128((__m128i *) &h_pad[8 + n - i]);
+            __m128i w1 = _mm_loadu_si128((__m128i *) &h_pad[8 + n - i - 1]);
+
+            s_lo = _mm_add_epi32(s_lo, _mm_madd_epi16(_mm_unpacklo_epi16(w0, w1), c));
+            s_hi = _mm_add_epi32(s_hi, _mm_madd_epi16(_mm_unpackhi_epi16(w0, w1), c));
+        }
+
+        _mm_storeu_si128((__m128i *) &y[n],
+                         amrnb_pack_trunc_epi32(_mm_srai_epi32(s_lo, 12),
+                                                _mm_srai_epi32(s_hi, 12)));
+    }
+
+    /* Convolve_c computes the outputs in pairs */
+    for (; n < (L & ~1); n++)
+    {
+        s = 0;
+        for (i = 0; i <= n; i++)
+        {
+            s = amrnb_fxp_mac_16_by_16bb((Word32) x[i], (Word32) h[n - i], s);
+        }
+        y[n] = (Word16)(s >> 12);
+    }
+
+    return;
+}
+#endif
+
+#if defined(AMRNB_SIMD_AVX2)
+/*
+------------------------------------------------------------------------------
+ FUNCTION NAME: Convolve_avx2
+------------------------------------------------------------------------------
+ INPUT AND OUTPUT DEFINITIONS
+
+ Same as Convolve_c.
+
+------------------------------------------------------------------------------
+ FUNCTION DESCRIPTION
+
+ Convolve_sse2 with blocks of sixteen outputs; a last block of eight, if
+ any, is computed as in Convolve_sse2.
+
+------------------------------------------------------------------------------
+*/
+
+AMRNB_TARGET_AVX2 void Convolve_avx2(
+    Word16 x[],        /* (i)     : input vector                           */
+    Word16 h[],        /* (i)     : impulse response                       */
+    Word16 y[],        /* (o)     : output vector                          */
+    Word16 L           /* (i)     : vector size                            */
+)
+{
+    Word16 i, n;
+    Word16 h_pad[16 + L_SUBFR];
+    Word32 s;
+
+    if (L > L_SUBFR)
+    {
+        Convolve_c(x, h, y, L);
+        return;
+    }
+
+    oscl_memset(h_pad, 0, 16*sizeof(Word16));
+    oscl_memcpy(&h_pad[16], h, L*sizeof(Word16));
+
+    for (n = 0; n + 16 <= L; n += 16)
+    {
+        __m256i s_lo = _mm256_setzero_si256();
+        __m256i s_hi = _mm256_setzero_si256();
+
+        for (i = 0; i < n + 16; i += 2)
+        {
+            __m256i c = amrnb_pair_epi16_256(x[i], x[i + 1]);
+            __m256i w0 = _mm256_loadu_si256((__m256i *) &h_pad[16 + n - i]);
+            __m256i w1 = _mm256_loadu_si256((__m256i *) &h_pad[16 + n - i - 1]);
+
+            s_lo = _mm256_add_epi32(s_lo, _mm256_madd_epi16(_mm256_unpacklo_epi16(w0, w1), c));
+            s_hi = _mm256_add_epi32(s_hi, _mm256_madd_epi16(_mm256_unpackhi_epi16(w0, w1), c));
+        }
+
+        _mm256_storeu_si256((__m256i *) &y[n],
+                            amrnb_pack_trunc_epi32_256(_mm256_srai_epi32(s_lo, 12),
+                                                       _mm256_srai_epi32(s_hi, 12)));
+    }
+
+    if (n + 8 <= L)
+    {
+        __m128i s_lo = _mm_setzero_si128();
+        __m128i s_hi = _mm_setzero_si128();
+
+        for (i = 0; i < n + 8; i += 2)
+        {
+            __m128i c = amrnb_pair_epi16(x[i], x[i + 1]);
+            __m128i w0 = _mm_loadu_si128((__m128i *) &h_pad[16 + n - i]);
+            __m128i w1 = _mm_loadu_si128((__m128i *) &h_pad[16 + n - i - 1]);
+
+            s_lo = _mm_add_epi32(s_lo, _mm_madd_epi16(_mm_unpacklo_epi16(w0, w1), c));
+            s_hi = _mm_add_epi32(s_hi, _mm_madd_epi16(_mm_unpackhi_epi16(w0, w1), c));
+        }
+
+        _mm_storeu_si128((__m128i *) &y[n],
+                         amrnb_pack_trunc_epi32(_mm_srai_epi32(s_lo, 12),
+                                                _mm_srai_epi32(s_hi, 12)));
+        n += 8;
+    }
+
+    /* Convolve_c computes the outputs in pairs */
+    for (; n < (L & ~1); n++)
+    {
+        s = 0;
+        for (i = 0; i <= n; i++)
+        {
+            s = amrnb_fxp_mac_16_by_16bb((Word32) x[i], (Word32) h[n - i], s);
+        }
+        y[n] = (Word16)(s >> 12);
+    }
+
+    return;
+}
+#endif
+
+#if defined(AMRNB_SIMD_NEON)
+/*
+------------------------------------------------------------------------------
+ FUNCTION NAME: Convolve_neon
+------------------------------------------------------------------------------
+ INPUT AND OUTPUT DEFINITIONS
+
+ Same as Convolve_c.
+
+------------------------------------------------------------------------------
+ FUNCTION DESCRIPTION
+
+ Computes eight outputs y[n..n+7] at a time, accumulating x[i] times
+ h[n-i..n-i+7] with widening multiply-accumulates; h[] is copied behind
+ eight zeros so that the terms with n < i vanish.
+
+------------------------------------------------------------------------------
+*/
+
+void Convolve_neon(
+    Word16 x[],        /* (i)     : input vector                           */
+    Word16 h[],        /* (i)     : impulse response                       */
+    Word16 y[],        /* (o)     : output vector                          */
+    Word16 L           /* (i)     : vector size                            */
+)
+{
+    Word16 i, n;
+    Word16 h_pad[8 + L_SUBFR];
+    Word32 s;
+
+    if (L > L_SUBFR)
+    {
+        Convolve_c(x, h, y, L);
+        return;
+    }
+
+    oscl_memset(h_pad, 0, 8*sizeof(Word16));
+    oscl_memcpy(&h_pad[8], h, L*sizeof(Word16));
+
+    for (n = 0; n + 8 <= L; n += 8)
+    {
+        int32x4_t s_lo = vdupq_n_s32(0);
+        int32x4_t s_hi = vdupq_n_s32(0);
+
+        for (i = 0; i < n + 8; i++)
+        {
+            int16x8_t w = vld1q_s16(&h_pad[8 + n - i]);
+
+            s_lo = vmlal_n_s16(s_lo, vget_low_s16(w), x[i]);
+            s_hi = vmlal_n_s16(s_hi, vget_high_s16(w), x[i]);
+        }
+
+        vst1q_s16(&y[n], vcombine_s16(vshrn_n_s32(s_lo, 12), vshrn_n_s32(s_hi, 12)));
+    }
+
+    /* Convolve_c computes the outputs in pairs */
+    for (; n < (L & ~1); n++)
+    {
+        s = 0;
+        for (i = 0; i <= n; i++)
+        {
+            s = amrnb_fxp_mac_16_by_16bb((Word32) x[i], (Word32) h[n - i], s);
+        }
+        y[n] = (Word16)(s >> 12);
+    }
+
+    return;
+}
+#endif
+
+/* Implementation of Convolve that convolve_cpu_select() selected */
+static void (*Convolve_impl)(Word16 x[], Word16 h[], Word16 y[],
+                             Word16 L) = Convolve_c;
+
+/*
+------------------------------------------------------------------------------
+ FUNCTION NAME: Convolve
+------------------------------------------------------------------------------
+ INPUT AND OUTPUT DEFINITIONS
+
+ Same as Convolve_c.
+
+------------------------------------------------------------------------------
+ FUNCTION DESCRIPTION
+
+ Runs the implementation of Convolve that convolve_cpu_select() selected
+ (see amrnb_cpu.h).
+
+------------------------------------------------------------------------------
+*/
+
+void Convolve(
+    Word16 x[],        /* (i)     : input vector                           */
+    Word16 h[],        /* (i)     : impulse response                       */
+    Word16 y[],        /* (o)     : output vector                          */
+    Word16 L           /* (i)     : vector size                            */
+)
+{
+    Convolve_impl(x, h, y, L);
+}
+
+/*
+------------------------------------------------------------------------------
+ FUNCTION NAME: convolve_cpu_select
+------------------------------------------------------------------------------
+ INPUT AND OUTPUT DEFINITIONS
+
+ Inputs:
+    features = AMRNB_CPU_* features the kernels may use (Word32)
+
+ Outputs:
+    Convolve_impl = the Convolve implementation for features
+
+ Returns:
+    None
+
+------------------------------------------------------------------------------
+ FUNCTION DESCRIPTION
+
+ Part of the kernel table of the encoder library, run when the features in
+ use are set (see amrnb_cpu.h).
+
+------------------------------------------------------------------------------
+*/
+void convolve_cpu_select(Word32 features)
+{
+    Convolve_impl = Convolve_c;
+#if defined(AMRNB_SIMD_NEON)
+    if (features & AMRNB_CPU_NEON)
+    {
+        Convolve_impl = Convolve_neon;
+    }
+#endif
+#if defined(AMRNB_SIMD_SSE2)
+    if (features & AMRNB_CPU_SSE2)
+    {
+        Convolve_impl = Convolve_sse2;
+    }
+#endif
+#if defined(AMRNB_SIMD_AVX2)
+    if (features & AMRNB_CPU_AVX2)
+    {
+        Convolve_impl = Convolve_avx2;
+    }
+#endif
+}
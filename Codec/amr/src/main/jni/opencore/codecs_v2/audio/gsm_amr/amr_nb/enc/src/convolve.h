@@ -52,6 +52,7 @@ terms listed above has been obtained from the copyright holder.
 ********************************************************************************
 */
 #include "typedef.h"
+#include "amrnb_simd.h"
 
 #ifdef __cplusplus
 extern "C"
@@ -76,6 +77,22 @@ extern "C"
         Word16 L           /* (i)  : vector size                                */
     );
 
+    /* Implementations selected by Convolve() */
+    void Convolve_c(Word16 x[], Word16 h[], Word16 y[], Word16 L);
+#if defined(AMRNB_SIMD_SSE2)
+    void Convolve_sse2(Word16 x[], Word16 h[], Word16 y[], Word16 L);
+#endif
+#if defined(AMRNB_SIMD_AVX2)
+    AMRNB_TARGET_AVX2 void Convolve_avx2(Word16 x[], Word16 h[], Word16 y[], Word16 L);
+#endif
+#if defined(AMRNB_SIMD_NEON)
+    void Convolve_neon(Word16 x[], Word16 h[], Word16 y[], Word16 L);
+#endif
+
+    /* Selects the implementation of Convolve for the AMRNB_CPU_* features
+       (see amrnb_cpu.h) */
+    void convolve_cpu_select(Word32 features);
+
 #ifdef __cplusplus
 }
 #endif
@@ -44,6 +44,8 @@ terms listed above has been obtained from the copyright holder.
 #include "basicop_malloc.h"
 #include "inv_sqrt.h"
 #include "basic_op.h"
+#include "basic_op_vec.h"
+#include "amrnb_cpu.h"
 
 /*----------------------------------------------------------------------------
 ; MACROS
@@ -185,7 +187,7 @@ void cor_h (
 ------------------------------------------------------------------------------
 */
 
-void cor_h(
+void cor_h_c(
     Word16 h[],          /* (i) : impulse response of weighted synthesis
                                   filter                                  */
     Word16 sign[],       /* (i) : sign of d[n]                            */
@@ -348,3 +350,246 @@ void cor_h(
 
 }
 
+#if defined(AMRNB_SIMD_SSE2)
+/*
+------------------------------------------------------------------------------
+ FUNCTION NAME: cor_h_sse2
+------------------------------------------------------------------------------
+ INPUT AND OUTPUT DEFINITIONS
+
+ Same as cor_h_c.
+
+------------------------------------------------------------------------------
+ FUNCTION DESCRIPTION
+
+ Computes the same matrix as cor_h_c, one row at a time instead of one
+ diagonal at a time. Walking the rows from i = L_CODE-1 down to 0 adds the
+ product h2[j] * h2[j+d] (j = L_CODE-1-i) to the running sum of every
+ diagonal d at once, so that after the step the sums for d = 0..i are
+ exactly the ones cor_h_c has reached for rr[i][i-d]. h2 and the reversed
+ sign vector are zero-padded so that the lanes past the end of a diagonal
+ add nothing. The rounding and sign products use the same truncating
+ arithmetic as cor_h_c.
+
+ Each row of the lower triangle is stored eight columns at a time; the
+ lanes left of column 0 land in the upper triangle of the row above, which
+ is written afterwards by mirroring the lower triangle in 8x8 blocks.
+
+------------------------------------------------------------------------------
+*/
+
+void cor_h_sse2(
+    Word16 h[],          /* (i) : impulse response of weighted synthesis
+                                  filter                                  */
+    Word16 sign[],       /* (i) : sign of d[n]                            */
+    Word16 rr[][L_CODE], /* (o) : matrix of autocorrelation               */
+    Flag  *pOverflow
+)
+{
+    Word16 i;
+    Word16 q;
+    Word16 dec;
+    Word16 h2[2 * L_CODE];      /* h2[] followed by zeros   */
+    Word16 sign_r[2 * L_CODE];  /* sign[L_CODE-1-n], zeros  */
+    Word32 s;
+
+    __m128i sum_lo[L_CODE / 8];
+    __m128i sum_hi[L_CODE / 8];
+    __m128i zero = _mm_setzero_si128();
+    __m128i round = _mm_set1_epi32(0x00004000L);
+    __m128i diag = _mm_setr_epi16(-1, 0, 0, 0, 0, 0, 0, 0);
+
+    /* Scaling for maximum precision, as in cor_h_c */
+    s = (Word32)((UWord32) amrnb_dot_16x16(h, h, L_CODE) + 1);
+    s = (Word32)((UWord32) s << 1);
+
+    if (s & MIN_32)
+    {
+        for (q = 0; q < L_CODE; q += 8)
+        {
+            _mm_storeu_si128((__m128i *)(h2 + q),
+                             _mm_srai_epi16(_mm_loadu_si128((__m128i *)(h + q)), 1));
+        }
+    }
+    else
+    {
+        __m128i vdec;
+
+        s >>= 1;
+
+        s = Inv_sqrt(s, pOverflow);
+
+        if (s < (Word32) 0x00ffffffL)
+        {
+            /* k = 0.99*k */
+            dec = (Word16)(((s >> 9) * 32440) >> 15);
+        }
+        else
+        {
+            dec = 32440;  /* 0.99 */
+        }
+
+        vdec = _mm_set1_epi16(dec);
+        for (q = 0; q < L_CODE; q += 8)
+        {
+            __m128i vh = _mm_loadu_si128((__m128i *)(h + q));
+            __m128i lo = _mm_mullo_epi16(vh, vdec);
+            __m128i hi = _mm_mulhi_epi16(vh, vdec);
+            __m128i p0 = _mm_add_epi32(_mm_unpacklo_epi16(lo, hi), _mm_set1_epi32(0x020L));
+            __m128i p1 = _mm_add_epi32(_mm_unpackhi_epi16(lo, hi), _mm_set1_epi32(0x020L));
+
+            _mm_storeu_si128((__m128i *)(h2 + q),
+                             amrnb_pack_trunc_epi32(_mm_srai_epi32(p0, 6),
+                                                    _mm_srai_epi32(p1, 6)));
+        }
+    }
+
+    for (q = 0; q < L_CODE; q += 8)
+    {
+        _mm_storeu_si128((__m128i *)(h2 + L_CODE + q), zero);
+        _mm_storeu_si128((__m128i *)(sign_r + L_CODE + q), zero);
+        _mm_storeu_si128((__m128i *)(sign_r + q),
+                         amrnb_reverse_epi16(_mm_loadu_si128((__m128i *)(sign + L_CODE - 8 - q))));
+        sum_lo[q >> 3] = zero;
+        sum_hi[q >> 3] = zero;
+    }
+
+    /* build the lower triangle of rr[] */
+
+    for (i = L_CODE - 1; i > 0; i--)
+    {
+        Word16 j = L_CODE - 1 - i;
+        __m128i vh = _mm_set1_epi16(h2[j]);
+        __m128i vsign = _mm_set1_epi16(sign[i]);
+
+        /* diagonals d = 8q .. 8q+7; only those with d <= i reach row i */
+        for (q = 0; q <= (i >> 3); q++)
+        {
+            __m128i v = _mm_loadu_si128((__m128i *)(h2 + j + 8 * q));
+            __m128i lo = _mm_mullo_epi16(vh, v);
+            __m128i hi = _mm_mulhi_epi16(vh, v);
+            __m128i t;
+            __m128i sg;
+
+            sum_lo[q] = _mm_add_epi32(sum_lo[q], _mm_unpacklo_epi16(lo, hi));
+            sum_hi[q] = _mm_add_epi32(sum_hi[q], _mm_unpackhi_epi16(lo, hi));
+
+            t = amrnb_pack_trunc_epi32(_mm_srai_epi32(_mm_add_epi32(sum_lo[q], round), 15),
+                                       _mm_srai_epi32(_mm_add_epi32(sum_hi[q], round), 15));
+            sg = amrnb_mul_shr15_epi16(vsign,
+                                       _mm_loadu_si128((__m128i *)(sign_r + j + 8 * q)));
+            sg = amrnb_mul_shr15_epi16(t, sg);
+
+            if (q == 0)
+            {
+                /* the diagonal carries no sign */
+                sg = _mm_or_si128(_mm_andnot_si128(diag, sg), _mm_and_si128(diag, t));
+            }
+
+            /* columns i-8q-7 .. i-8q */
+            _mm_storeu_si128((__m128i *)(&rr[i][i - 8 * q - 7]), amrnb_reverse_epi16(sg));
+        }
+    }
+    rr[0][0] = (Word16)((amrnb_dot_16x16(h2, h2, L_CODE) + 0x00004000L) >> 15);
+
+    /* mirror the lower triangle */
+
+    for (i = 0; i < L_CODE; i += 8)
+    {
+        for (q = 0; q <= i; q += 8)
+        {
+            __m128i blk[8];
+            Word16 r;
+
+            for (r = 0; r < 8; r++)
+            {
+                blk[r] = _mm_loadu_si128((__m128i *) &rr[i + r][q]);
+            }
+            amrnb_transpose8x8_epi16(blk);
+
+            for (r = 0; r < 8; r++)
+            {
+                if (q == i)
+                {
+                    /* keep columns 0..r of the diagonal block */
+                    __m128i upper = _mm_cmpgt_epi16(_mm_setr_epi16(0, 1, 2, 3, 4, 5, 6, 7),
+                                                    _mm_set1_epi16(r));
+                    __m128i lower = _mm_loadu_si128((__m128i *) &rr[i + r][i]);
+
+                    blk[r] = _mm_or_si128(_mm_andnot_si128(upper, lower),
+                                          _mm_and_si128(upper, blk[r]));
+                }
+                _mm_storeu_si128((__m128i *) &rr[q + r][i], blk[r]);
+            }
+        }
+    }
+
+    return;
+}
+#endif
+
+/* Implementation of cor_h that cor_h_cpu_select() selected */
+static void (*cor_h_impl)(Word16 h[], Word16 sign[], Word16 rr[][L_CODE],
+                          Flag *pOverflow) = cor_h_c;
+
+/*
+------------------------------------------------------------------------------
+ FUNCTION NAME: cor_h
+------------------------------------------------------------------------------
+ INPUT AND OUTPUT DEFINITIONS
+
+ Same as cor_h_c.
+
+------------------------------------------------------------------------------
+ FUNCTION DESCRIPTION
+
+ Runs the implementation of cor_h that cor_h_cpu_select() selected
+ (see amrnb_cpu.h).
+
+------------------------------------------------------------------------------
+*/
+
+void cor_h(
+    Word16 h[],          /* (i) : impulse response of weighted synthesis
+                                  filter                                  */
+    Word16 sign[],       /* (i) : sign of d[n]                            */
+    Word16 rr[][L_CODE], /* (o) : matrix of autocorrelation               */
+    Flag  *pOverflow
+)
+{
+    cor_h_impl(h, sign, rr, pOverflow);
+}
+
+/*
+------------------------------------------------------------------------------
+ FUNCTION NAME: cor_h_cpu_select
+------------------------------------------------------------------------------
+ INPUT AND OUTPUT DEFINITIONS
+
+ Inputs:
+    features = AMRNB_CPU_* features the kernels may use (Word32)
+
+ Outputs:
+    cor_h_impl = the cor_h implementation for features
+
+ Returns:
+    None
+
+------------------------------------------------------------------------------
+ FUNCTION DESCRIPTION
+
+ Part of the kernel table of the encoder library, run when the features in
+ use are set (see amrnb_cpu.h).
+
+------------------------------------------------------------------------------
+*/
+void cor_h_cpu_select(Word32 features)
+{
+    cor_h_impl = cor_h_c;
+#if defined(AMRNB_SIMD_SSE2)
+    if (features & AMRNB_CPU_SSE2)
+    {
+        cor_h_impl = cor_h_sse2;
+    }
+#endif
+}
@@ -36,6 +36,7 @@ terms listed above has been obtained from the copyright holder.
 ; INCLUDES
 ----------------------------------------------------------------------------*/
 #include "typedef.h"
+#include "amrnb_simd.h"
 
 #include "cor_h_x.h"                /* Used by legacy files */
 #include "cor_h_x2.h"               /* Used by legacy files */
@@ -85,6 +86,16 @@ extern "C"
         Flag  *pOverflow
     );
 
+    /* Implementations selected by cor_h() */
+    void cor_h_c(Word16 h[], Word16 sign[], Word16 rr[][L_CODE], Flag *pOverflow);
+#if defined(AMRNB_SIMD_SSE2)
+    void cor_h_sse2(Word16 h[], Word16 sign[], Word16 rr[][L_CODE], Flag *pOverflow);
+#endif
+
+    /* Selects the implementation of cor_h for the AMRNB_CPU_* features (see
+       amrnb_cpu.h) */
+    void cor_h_cpu_select(Word32 features);
+
     /*----------------------------------------------------------------------------
     ; END
     ----------------------------------------------------------------------------*/
@@ -43,6 +43,8 @@ terms listed above has been obtained from the copyright holder.
 #include "cnst.h"
 #include "cor_h_x.h"
 #include "basic_op.h"
+#include "basic_op_vec.h"
+#include "amrnb_cpu.h"
 
 /*----------------------------------------------------------------------------
 ; MACROS
@@ -194,7 +196,7 @@ void cor_h_x2 (
 ------------------------------------------------------------------------------
 */
 
-void cor_h_x(
+void cor_h_x_c(
     Word16 h[],       /* (i): impulse response of weighted synthesis filter */
     Word16 x[],       /* (i): target                                        */
     Word16 dn[],      /* (o): correlation between target and h[]            */
@@ -271,3 +273,165 @@ void cor_h_x(
 
     return;
 }
+
+#if defined(AMRNB_SIMD_SSE2)
+/*
+------------------------------------------------------------------------------
+ FUNCTION NAME: cor_h_x_sse2
+------------------------------------------------------------------------------
+ INPUT AND OUTPUT DEFINITIONS
+
+ Same as cor_h_x_c.
+
+------------------------------------------------------------------------------
+ FUNCTION DESCRIPTION
+
+ Computes the 40 correlations four at a time with 8-lane multiply-adds over
+ a zero-padded copy of x[], then normalizes them exactly as cor_h_x_c does.
+ The sums wrap around the same way as the scalar accumulation.
+
+------------------------------------------------------------------------------
+*/
+
+void cor_h_x_sse2(
+    Word16 h[],       /* (i): impulse response of weighted synthesis filter */
+    Word16 x[],       /* (i): target                                        */
+    Word16 dn[],      /* (o): correlation between target and h[]            */
+    Word16 sf,        /* (i): scaling factor: 2 for 12.2, 1 for others      */
+    Flag   *pOverflow /* (o): pointer to overflow flag                      */
+)
+{
+    register Word16 i;
+    register Word16 j;
+    register Word16 k;
+
+    Word32 s;
+    Word32 y32[L_CODE];
+    Word32 max;
+    Word32 tot;
+    Word16 x_pad[2 * L_CODE];
+
+    /* x[] followed by zeros, so that every correlation runs over L_CODE taps */
+    for (i = 0; i < L_CODE; i += 8)
+    {
+        _mm_storeu_si128((__m128i *)(x_pad + i), _mm_loadu_si128((__m128i *) &x[i]));
+        _mm_storeu_si128((__m128i *)(x_pad + L_CODE + i), _mm_setzero_si128());
+    }
+
+    for (i = 0; i < L_CODE; i += 4)
+    {
+        __m128i acc[4];
+
+        for (k = 0; k < 4; k++)
+        {
+            acc[k] = _mm_setzero_si128();
+            for (j = 0; j < L_CODE; j += 8)
+            {
+                acc[k] = _mm_add_epi32(acc[k],
+                                       _mm_madd_epi16(_mm_loadu_si128((__m128i *)(x_pad + i + k + j)),
+                                                      _mm_loadu_si128((__m128i *) &h[j])));
+            }
+        }
+        _mm_storeu_si128((__m128i *) &y32[i],
+                         _mm_slli_epi32(amrnb_hsum4_epi32(acc[0], acc[1], acc[2], acc[3]), 1));
+    }
+
+    tot = 5;
+    for (k = 0; k < NB_TRACK; k++)              /* NB_TRACK = 5 */
+    {
+        max = 0;
+        for (i = k; i < L_CODE; i += STEP)      /* L_CODE = 40; STEP = 5 */
+        {
+            s = y32[i];
+
+            if (s < 0)
+            {
+                s = -s;
+            }
+
+            if (s > max)
+            {
+                max = s;
+            }
+        }
+
+        tot += (max >> 1);
+    }
+
+    j = norm_l(tot) - sf;
+
+    for (i = 0; i < L_CODE; i++)
+    {
+        s = L_shl(y32[i], j, pOverflow);
+        dn[i] = (s + 0x00008000) >> 16;
+    }
+
+    return;
+}
+#endif
+
+/* Implementation of cor_h_x that cor_h_x_cpu_select() selected */
+static void (*cor_h_x_impl)(Word16 h[], Word16 x[], Word16 dn[], Word16 sf,
+                            Flag *pOverflow) = cor_h_x_c;
+
+/*
+------------------------------------------------------------------------------
+ FUNCTION NAME: cor_h_x
+------------------------------------------------------------------------------
+ INPUT AND OUTPUT DEFINITIONS
+
+ Same as cor_h_x_c.
+
+------------------------------------------------------------------------------
+ FUNCTION DESCRIPTION
+
+ Runs the implementation of cor_h_x that cor_h_x_cpu_select() selected
+ (see amrnb_cpu.h).
+
+------------------------------------------------------------------------------
+*/
+
+void cor_h_x(
+    Word16 h[],       /* (i): impulse response of weighted synthesis filter */
+    Word16 x[],       /* (i): target                                        */
+    Word16 dn[],      /* (o): correlation between target and h[]            */
+    Word16 sf,        /* (i): scaling factor: 2 for 12.2, 1 for others      */
+    Flag   *pOverflow /* (o): pointer to overflow flag                      */
+)
+{
+    cor_h_x_impl(h, x, dn, sf, pOverflow);
+}
+
+/*
+------------------------------------------------------------------------------
+ FUNCTION NAME: cor_h_x_cpu_select
+------------------------------------------------------------------------------
+ INPUT AND OUTPUT DEFINITIONS
+
+ Inputs:
+    features = AMRNB_CPU_* features the kernels may use (Word32)
+
+ Outputs:
+    cor_h_x_impl = the cor_h_x implementation for features
+
+ Returns:
+    None
+
+------------------------------------------------------------------------------
+ FUNCTION DESCRIPTION
+
+ Part of the kernel table of the encoder library, run when the features in
+ use are set (see amrnb_cpu.h).
+
+------------------------------------------------------------------------------
+*/
+void cor_h_x_cpu_select(Word32 features)
+{
+    cor_h_x_impl = cor_h_x_c;
+#if defined(AMRNB_SIMD_SSE2)
+    if (features & AMRNB_CPU_SSE2)
+    {
+        cor_h_x_impl = cor_h_x_sse2;
+    }
+#endif
+}
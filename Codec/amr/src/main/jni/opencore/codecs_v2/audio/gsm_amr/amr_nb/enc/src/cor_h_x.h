@@ -45,6 +45,7 @@ terms listed above has been obtained from the copyright holder.
 ; INCLUDES
 ----------------------------------------------------------------------------*/
 #include    "typedef.h"
+#include    "amrnb_simd.h"
 
 /*--------------------------------------------------------------------------*/
 #ifdef __cplusplus
@@ -91,6 +92,16 @@ extern "C"
         Flag   *pOverflow /* (o): pointer to overflow flag                      */
     );
 
+    /* Implementations selected by cor_h_x() */
+    void cor_h_x_c(Word16 h[], Word16 x[], Word16 dn[], Word16 sf, Flag *pOverflow);
+#if defined(AMRNB_SIMD_SSE2)
+    void cor_h_x_sse2(Word16 h[], Word16 x[], Word16 dn[], Word16 sf, Flag *pOverflow);
+#endif
+
+    /* Selects the implementation of cor_h_x for the AMRNB_CPU_* features
+       (see amrnb_cpu.h) */
+    void cor_h_x_cpu_select(Word32 features);
+
     /*----------------------------------------------------------------------------
     ; END
     ----------------------------------------------------------------------------*/
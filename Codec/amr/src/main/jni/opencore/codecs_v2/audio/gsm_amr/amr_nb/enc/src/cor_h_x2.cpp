@@ -45,6 +45,8 @@ terms listed above has been obtained from the copyright holder.
 #include "cor_h_x2.h" // BX
 #include "basic_op.h"
 #include "l_abs.h"
+#include "basic_op_vec.h"
+#include "amrnb_cpu.h"
 
 /*----------------------------------------------------------------------------
 ; MACROS
@@ -183,7 +185,7 @@ void cor_h_x2 (
 ------------------------------------------------------------------------------
 */
 
-void cor_h_x2(
+void cor_h_x2_c(
     Word16 h[],    /* (i): impulse response of weighted synthesis filter */
     Word16 x[],    /* (i): target                                        */
     Word16 dn[],   /* (o): correlation between target and h[]            */
@@ -238,3 +240,262 @@ void cor_h_x2(
 
     return;
 }
+
+#if defined(AMRNB_SIMD_SSE2)
+/*
+------------------------------------------------------------------------------
+ FUNCTION NAME: cor_h_x2_sse2
+------------------------------------------------------------------------------
+ INPUT AND OUTPUT DEFINITIONS
+
+ Same as cor_h_x2_c.
+
+------------------------------------------------------------------------------
+ FUNCTION DESCRIPTION
+
+ Computes all 40 correlations four at a time with 8-lane multiply-adds over
+ a zero-padded copy of x[], then runs the track maximum search and the
+ normalization of cor_h_x2_c on them.
+
+------------------------------------------------------------------------------
+*/
+
+void cor_h_x2_sse2(
+    Word16 h[],    /* (i): impulse response of weighted synthesis filter */
+    Word16 x[],    /* (i): target                                        */
+    Word16 dn[],   /* (o): correlation between target and h[]            */
+    Word16 sf,     /* (i): scaling factor: 2 for 12.2, 1 for others      */
+    Word16 nb_track,/* (i): the number of ACB tracks                     */
+    Word16 step,   /* (i): step size from one pulse position to the next
+                           in one track                                  */
+    Flag *pOverflow
+)
+{
+    register Word16 i;
+    register Word16 j;
+    register Word16 k;
+    Word32 s;
+    Word32 y32[L_CODE];
+    Word32 max;
+    Word32 tot;
+    Word16 x_pad[2 * L_CODE];
+
+    /* x[] followed by zeros, so that every correlation runs over L_CODE taps */
+    for (i = 0; i < L_CODE; i += 8)
+    {
+        _mm_storeu_si128((__m128i *)(x_pad + i), _mm_loadu_si128((__m128i *) &x[i]));
+        _mm_storeu_si128((__m128i *)(x_pad + L_CODE + i), _mm_setzero_si128());
+    }
+
+    for (i = 0; i < L_CODE; i += 4)
+    {
+        __m128i acc[4];
+
+        for (k = 0; k < 4; k++)
+        {
+            acc[k] = _mm_setzero_si128();
+            for (j = 0; j < L_CODE; j += 8)
+            {
+                acc[k] = _mm_add_epi32(acc[k],
+                                       _mm_madd_epi16(_mm_loadu_si128((__m128i *)(x_pad + i + k + j)),
+                                                      _mm_loadu_si128((__m128i *) &h[j])));
+            }
+        }
+        _mm_storeu_si128((__m128i *) &y32[i],
+                         _mm_slli_epi32(amrnb_hsum4_epi32(acc[0], acc[1], acc[2], acc[3]), 1));
+    }
+
+    tot = LOG2_OF_32;
+    for (k = 0; k < nb_track; k++)
+    {
+        max = 0;
+        for (i = k; i < L_CODE; i += step)
+        {
+            s = L_abs(y32[i]);
+
+            if (s > max)
+            {
+                max = s;
+            }
+        }
+        tot = (tot + (max >> 1));
+    }
+
+    j = norm_l(tot) - sf;
+
+    for (i = 0; i < L_CODE; i++)
+    {
+        dn[i] = pv_round(L_shl(y32[i], j, pOverflow), pOverflow);
+    }
+
+    return;
+}
+#endif
+
+#if defined(AMRNB_SIMD_NEON)
+/*
+------------------------------------------------------------------------------
+ FUNCTION NAME: cor_h_x2_neon
+------------------------------------------------------------------------------
+ INPUT AND OUTPUT DEFINITIONS
+
+ Same as cor_h_x2_c.
+
+------------------------------------------------------------------------------
+ FUNCTION DESCRIPTION
+
+ Computes all 40 correlations four at a time with widening
+ multiply-accumulates over a zero-padded copy of x[], then runs the track
+ maximum search and the normalization of cor_h_x2_c on them.
+
+------------------------------------------------------------------------------
+*/
+
+void cor_h_x2_neon(
+    Word16 h[],    /* (i): impulse response of weighted synthesis filter */
+    Word16 x[],    /* (i): target                                        */
+    Word16 dn[],   /* (o): correlation between target and h[]            */
+    Word16 sf,     /* (i): scaling factor: 2 for 12.2, 1 for others      */
+    Word16 nb_track,/* (i): the number of ACB tracks                     */
+    Word16 step,   /* (i): step size from one pulse position to the next
+                           in one track                                  */
+    Flag *pOverflow
+)
+{
+    register Word16 i;
+    register Word16 j;
+    register Word16 k;
+    Word32 s;
+    Word32 y32[L_CODE];
+    Word32 max;
+    Word32 tot;
+    Word16 x_pad[2 * L_CODE];
+
+    /* x[] followed by zeros, so that every correlation runs over L_CODE taps */
+    for (i = 0; i < L_CODE; i += 8)
+    {
+        vst1q_s16(x_pad + i, vld1q_s16(&x[i]));
+        vst1q_s16(x_pad + L_CODE + i, vdupq_n_s16(0));
+    }
+
+    for (i = 0; i < L_CODE; i += 4)
+    {
+        int32x4_t acc[4];
+
+        for (k = 0; k < 4; k++)
+        {
+            acc[k] = vdupq_n_s32(0);
+            for (j = 0; j < L_CODE; j += 8)
+            {
+                int16x8_t vx = vld1q_s16(x_pad + i + k + j);
+                int16x8_t vh = vld1q_s16(&h[j]);
+
+                acc[k] = vmlal_s16(acc[k], vget_low_s16(vx), vget_low_s16(vh));
+                acc[k] = vmlal_high_s16(acc[k], vx, vh);
+            }
+        }
+        vst1q_s32(&y32[i], vshlq_n_s32(amrnb_hsum4_s32(acc[0], acc[1], acc[2], acc[3]), 1));
+    }
+
+    tot = LOG2_OF_32;
+    for (k = 0; k < nb_track; k++)
+    {
+        max = 0;
+        for (i = k; i < L_CODE; i += step)
+        {
+            s = L_abs(y32[i]);
+
+            if (s > max)
+            {
+                max = s;
+            }
+        }
+        tot = (tot + (max >> 1));
+    }
+
+    j = norm_l(tot) - sf;
+
+    for (i = 0; i < L_CODE; i++)
+    {
+        dn[i] = pv_round(L_shl(y32[i], j, pOverflow), pOverflow);
+    }
+
+    return;
+}
+#endif
+
+/* Implementation of cor_h_x2 that cor_h_x2_cpu_select() selected */
+static void (*cor_h_x2_impl)(Word16 h[], Word16 x[], Word16 dn[], Word16 sf,
+                             Word16 nb_track, Word16 step,
+                             Flag *pOverflow) = cor_h_x2_c;
+
+/*
+------------------------------------------------------------------------------
+ FUNCTION NAME: cor_h_x2
+------------------------------------------------------------------------------
+ INPUT AND OUTPUT DEFINITIONS
+
+ Same as cor_h_x2_c.
+
+------------------------------------------------------------------------------
+ FUNCTION DESCRIPTION
+
+ Runs the implementation of cor_h_x2 that cor_h_x2_cpu_select() selected
+ (see amrnb_cpu.h).
+
+------------------------------------------------------------------------------
+*/
+
+void cor_h_x2(
+    Word16 h[],    /* (i): impulse response of weighted synthesis filter */
+    Word16 x[],    /* (i): target                                        */
+    Word16 dn[],   /* (o): correlation between target and h[]            */
+    Word16 sf,     /* (i): scaling factor: 2 for 12.2, 1 for others      */
+    Word16 nb_track,/* (i): the number of ACB tracks                     */
+    Word16 step,   /* (i): step size from one pulse position to the next
+                           in one track                                  */
+    Flag *pOverflow
+)
+{
+    cor_h_x2_impl(h, x, dn, sf, nb_track, step, pOverflow);
+}
+
+/*
+------------------------------------------------------------------------------
+ FUNCTION NAME: cor_h_x2_cpu_select
+------------------------------------------------------------------------------
+ INPUT AND OUTPUT DEFINITIONS
+
+ Inputs:
+    features = AMRNB_CPU_* features the kernels may use (Word32)
+
+ Outputs:
+    cor_h_x2_impl = the cor_h_x2 implementation for features
+
+ Returns:
+    None
+
+------------------------------------------------------------------------------
+ FUNCTION DESCRIPTION
+
+ Part of the kernel table of the encoder library, run when the features in
+ use are set (see amrnb_cpu.h).
+
+------------------------------------------------------------------------------
+*/
+void cor_h_x2_cpu_select(Word32 features)
+{
+    cor_h_x2_impl = cor_h_x2_c;
+#if defined(AMRNB_SIMD_NEON)
+    if (features & AMRNB_CPU_NEON)
+    {
+        cor_h_x2_impl = cor_h_x2_neon;
+    }
+#endif
+#if defined(AMRNB_SIMD_SSE2)
+    if (features & AMRNB_CPU_SSE2)
+    {
+        cor_h_x2_impl = cor_h_x2_sse2;
+    }
+#endif
+}
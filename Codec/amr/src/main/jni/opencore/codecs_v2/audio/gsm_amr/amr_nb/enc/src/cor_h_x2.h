@@ -51,6 +51,7 @@ terms listed above has been obtained from the copyright holder.
 ; INCLUDES
 ----------------------------------------------------------------------------*/
 #include    "typedef.h"
+#include    "amrnb_simd.h"
 
 /*--------------------------------------------------------------------------*/
 #ifdef __cplusplus
@@ -100,6 +101,22 @@ extern "C"
         Flag *pOverflow
     );
 
+    /* Implementations selected by cor_h_x2() */
+    void cor_h_x2_c(Word16 h[], Word16 x[], Word16 dn[], Word16 sf,
+                    Word16 nb_track, Word16 step, Flag *pOverflow);
+#if defined(AMRNB_SIMD_SSE2)
+    void cor_h_x2_sse2(Word16 h[], Word16 x[], Word16 dn[], Word16 sf,
+                       Word16 nb_track, Word16 step, Flag *pOverflow);
+#endif
+#if defined(AMRNB_SIMD_NEON)
+    void cor_h_x2_neon(Word16 h[], Word16 x[], Word16 dn[], Word16 sf,
+                       Word16 nb_track, Word16 step, Flag *pOverflow);
+#endif
+
+    /* Selects the implementation of cor_h_x2 for the AMRNB_CPU_* features
+       (see amrnb_cpu.h) */
+    void cor_h_x2_cpu_select(Word32 features);
+
 #ifdef __cplusplus
 }
 #endif
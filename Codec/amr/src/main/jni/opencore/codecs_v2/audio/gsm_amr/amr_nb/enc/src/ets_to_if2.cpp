@@ -30,7 +30,7 @@ terms listed above has been obtained from the copyright holder.
 ------------------------------------------------------------------------------
 
  Filename: ets_to_if2.cpp
- Funtions: ets_to_if2
+ Funtions: ets_to_if2, prm_to_if2
 
 */
 
@@ -226,3 +226,67 @@ void ets_to_if2(
 
     return;
 }
+
+/*
+------------------------------------------------------------------------------
+ FUNCTION NAME: prm_to_if2
+------------------------------------------------------------------------------
+ INPUT AND OUTPUT DEFINITIONS
+
+ Inputs:
+    frame_type_3gpp = speech bit rate, AMR_475 .. AMR_122 (enum Frame_Type_3GPP)
+    prm             = pointer to the codec parameters of the frame (Word16)
+    if2_output_ptr  = pointer to output encoded speech bits in IF2 format (UWord8)
+
+ Outputs:
+    if2_output_ptr  = pointer to encoded speech bits in the IF2 format (UWord8)
+
+ Returns:
+    None
+
+ Global Variables Used:
+    numOfBits, packBits (see bitreorder_tab.cpp)
+
+------------------------------------------------------------------------------
+ FUNCTION DESCRIPTION
+
+ Produces the same frame as Prm2bits() followed by ets_to_if2() for a speech
+ frame. Each packBits entry names the parameter and bit that goes into the
+ next position of the frame, so the parameters are shifted straight into the
+ IF2 bytes (first bit in the LSB) without the one-bit-per-word ETS form.
+
+------------------------------------------------------------------------------
+*/
+void prm_to_if2(
+    enum Frame_Type_3GPP frame_type_3gpp,
+    Word16 *prm,
+    UWord8 *if2_output_ptr,
+    CommonAmrTbls* common_amr_tbls)
+{
+    Word16  i;
+    Word16  e;
+    Word16  pos = 4;
+    UWord32 accum = (UWord32) frame_type_3gpp;
+    const Word16 *pack_tbl = common_amr_tbls->packBits_ptr[frame_type_3gpp];
+    Word16  n = common_amr_tbls->numOfBits_ptr[frame_type_3gpp];
+
+    for (i = 0; i < n; i++)
+    {
+        e = pack_tbl[i];
+        accum |= (UWord32)((prm[e >> 4] >> (e & 15)) & 1) << pos;
+
+        if (++pos == 8)
+        {
+            *(if2_output_ptr++) = (UWord8) accum;
+            accum = 0;
+            pos = 0;
+        }
+    }
+
+    if (pos != 0)
+    {
+        *if2_output_ptr = (UWord8) accum;
+    }
+
+    return;
+}
@@ -99,6 +99,12 @@ extern "C"
     UWord8   *if2_output_ptr,
     CommonAmrTbls* common_amr_tbls);
 
+    /* Speech frames only: same output as Prm2bits() + ets_to_if2() */
+    void prm_to_if2(enum Frame_Type_3GPP frame_type_3gpp,
+                    Word16 *prm,
+                    UWord8 *if2_output_ptr,
+                    CommonAmrTbls* common_amr_tbls);
+
 
 
     /*----------------------------------------------------------------------------
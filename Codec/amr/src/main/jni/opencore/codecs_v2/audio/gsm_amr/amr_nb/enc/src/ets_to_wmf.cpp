@@ -32,7 +32,7 @@ terms listed above has been obtained from the copyright holder.
 
 
  Filename: ets_to_wmf.cpp
- Functions: ets_to_wmf
+ Functions: ets_to_wmf, ets_to_ietf, prm_to_wmf, prm_to_ietf
 
 ------------------------------------------------------------------------------
 */
@@ -298,3 +298,148 @@ void ets_to_ietf(
 
     return;
 }
+
+/*
+------------------------------------------------------------------------------
+ FUNCTION NAME: pack_prm_msb
+------------------------------------------------------------------------------
+ INPUT AND OUTPUT DEFINITIONS
+
+ Inputs:
+    prm      = pointer to the codec parameters of the frame (Word16)
+    pack_tbl = pointer to the packBits table of the mode (const Word16)
+    n        = number of bits in the frame (Word16)
+    out_ptr  = pointer to the first byte of speech bits (UWord8)
+
+ Outputs:
+    out_ptr  = (n + 7) / 8 bytes of speech bits, first bit in the MSB
+
+ Returns:
+    None
+
+------------------------------------------------------------------------------
+ FUNCTION DESCRIPTION
+
+ This function packs the parameters of a speech frame directly into the
+ byte-aligned WMF/IETF layout. Each packBits entry names the parameter and
+ bit that goes into the next position of the frame, so the bits are shifted
+ into an accumulator and stored a byte at a time, without going through the
+ one-bit-per-word ETS serial form. The final byte is zero padded.
+
+------------------------------------------------------------------------------
+*/
+static void pack_prm_msb(
+    const Word16 *prm,
+    const Word16 *pack_tbl,
+    Word16 n,
+    UWord8 *out_ptr)
+{
+    Word16 i;
+    Word16 e;
+    UWord32 accum = 0;
+
+    for (i = 0; i < n; i++)
+    {
+        e = pack_tbl[i];
+        accum = (accum << 1) | ((prm[e >> 4] >> (e & 15)) & 1);
+
+        if ((i & 7) == 7)
+        {
+            *(out_ptr++) = (UWord8) accum;
+            accum = 0;
+        }
+    }
+
+    *out_ptr = (UWord8)(accum << (8 - (n & 7)));
+
+    return;
+}
+
+/*
+------------------------------------------------------------------------------
+ FUNCTION NAME: prm_to_wmf
+------------------------------------------------------------------------------
+ INPUT AND OUTPUT DEFINITIONS
+
+ Inputs:
+    frame_type_3gpp = speech bit rate, AMR_475 .. AMR_122 (enum Frame_Type_3GPP)
+    prm             = pointer to the codec parameters of the frame (Word16)
+    wmf_output_ptr  = pointer to output encoded speech bits in WMF format(UWord8)
+
+ Outputs:
+    wmf_output_ptr  = pointer to encoded speech bits in the WMF format (UWord8)
+
+ Returns:
+    None
+
+ Global Variables Used:
+    numOfBits, packBits (see bitreorder_tab.cpp)
+
+------------------------------------------------------------------------------
+ FUNCTION DESCRIPTION
+
+ Produces the same frame as Prm2bits() followed by ets_to_wmf() for a speech
+ frame, packing the parameters straight into the WMF bytes.
+
+------------------------------------------------------------------------------
+*/
+void prm_to_wmf(
+    enum Frame_Type_3GPP frame_type_3gpp,
+    Word16 *prm,
+    UWord8 *wmf_output_ptr,
+    CommonAmrTbls* common_amr_tbls)
+{
+    wmf_output_ptr[0] = (UWord8)(frame_type_3gpp) & 0x0f;
+
+    pack_prm_msb(prm,
+                 common_amr_tbls->packBits_ptr[frame_type_3gpp],
+                 common_amr_tbls->numOfBits_ptr[frame_type_3gpp],
+                 &wmf_output_ptr[1]);
+
+    return;
+}
+
+/*
+------------------------------------------------------------------------------
+ FUNCTION NAME: prm_to_ietf
+------------------------------------------------------------------------------
+ INPUT AND OUTPUT DEFINITIONS
+
+ Inputs:
+    frame_type_3gpp = speech bit rate, AMR_475 .. AMR_122 (enum Frame_Type_3GPP)
+    prm             = pointer to the codec parameters of the frame (Word16)
+    ietf_output_ptr = pointer to output encoded speech bits in IETF format
+                      (UWord8)
+
+ Outputs:
+    ietf_output_ptr = pointer to encoded speech bits in the IETF format (UWord8)
+
+ Returns:
+    None
+
+ Global Variables Used:
+    numOfBits, packBits (see bitreorder_tab.cpp)
+
+------------------------------------------------------------------------------
+ FUNCTION DESCRIPTION
+
+ Produces the same frame as Prm2bits() followed by ets_to_ietf() for a speech
+ frame, packing the parameters straight into the IETF bytes.
+
+------------------------------------------------------------------------------
+*/
+void prm_to_ietf(
+    enum Frame_Type_3GPP frame_type_3gpp,
+    Word16 *prm,
+    UWord8 *ietf_output_ptr,
+    CommonAmrTbls* common_amr_tbls)
+{
+    ietf_output_ptr[0] = (UWord8)(frame_type_3gpp << 3);
+
+    pack_prm_msb(prm,
+                 common_amr_tbls->packBits_ptr[frame_type_3gpp],
+                 common_amr_tbls->numOfBits_ptr[frame_type_3gpp],
+                 &ietf_output_ptr[1]);
+
+    return;
+}
@@ -104,6 +104,17 @@ extern "C"
                      UWord8 *ietf_output_ptr,
                      CommonAmrTbls* common_amr_tbls);
 
+    /* Speech frames only: same output as Prm2bits() + ets_to_wmf/ietf() */
+    void prm_to_wmf(enum Frame_Type_3GPP frame_type_3gpp,
+                    Word16 *prm,
+                    UWord8 *wmf_output_ptr,
+                    CommonAmrTbls* common_amr_tbls);
+
+    void prm_to_ietf(enum Frame_Type_3GPP frame_type_3gpp,
+                     Word16 *prm,
+                     UWord8 *ietf_output_ptr,
+                     CommonAmrTbls* common_amr_tbls);
+
 
     /*----------------------------------------------------------------------------
     ; END
@@ -43,6 +43,8 @@ terms listed above has been obtained from the copyright holder.
 #include "cnst.h"
 #include "inter_36_tab.h"
 #include "basic_op.h"
+#include "basic_op_vec.h"
+#include "amrnb_cpu.h"
 
 /*----------------------------------------------------------------------------
 ; MACROS
@@ -68,6 +70,21 @@ terms listed above has been obtained from the copyright holder.
 ; Variable declaration - defined here and used outside this module
 ----------------------------------------------------------------------------*/
 
+#if defined(AMRNB_SIMD_SSE2)
+/* inter_6 rearranged per fraction (0..5) into the taps applied to
+ * x[-3..4], i.e. inter_6[frac+18], [frac+12], [frac+6], [frac] followed by
+ * inter_6[6-frac], [12-frac], [18-frac], [24-frac] */
+static const Word16 inter_6_rows[UP_SAMP_MAX][8] =
+{
+    {   516,  -1561,   2755,  29519,   2755,  -1561,    516,      0},
+    {   220,   -336,  -1127,  28316,   7945,  -2899,    823,   -215},
+    {     0,    534,  -3459,  24906,  13896,  -3969,   1023,   -194},
+    {  -131,    970,  -4304,  19838,  19838,  -4304,    970,   -131},
+    {  -194,   1023,  -3969,  13896,  24906,  -3459,    534,      0},
+    {  -215,    823,  -2899,   7945,  28316,  -1127,   -336,    220}
+};
+#endif
+
 
 /*
 ------------------------------------------------------------------------------
@@ -149,7 +166,7 @@ terms listed above has been obtained from the copyright holder.
 
 ------------------------------------------------------------------------------
 */
-Word16 Interpol_3or6(   /* o : interpolated value                        */
+Word16 Interpol_3or6_c( /* o : interpolated value                        */
     Word16 *pX,         /* i : input vector                              */
     Word16 frac,        /* i : fraction  (-2..2 for 3*, -3..3 for 6*)    */
     Word16 flag3,       /* i : if set, upsampling rate = 3 (6 otherwise) */
@@ -201,8 +218,115 @@ Word16 Interpol_3or6(   /* o : interpolated value                        */
     return((Word16)(s >> 15));
 }
 
+#if defined(AMRNB_SIMD_SSE2)
+/*
+------------------------------------------------------------------------------
+ FUNCTION NAME: Interpol_3or6_sse2
+------------------------------------------------------------------------------
+ INPUT AND OUTPUT DEFINITIONS
+
+ Same as Interpol_3or6_c.
+
+------------------------------------------------------------------------------
+ FUNCTION DESCRIPTION
+
+ Applies the eight taps for the fraction, taken from inter_6_rows, to
+ x[-3..4] with a single multiply-add.
+
+------------------------------------------------------------------------------
+*/
+
+Word16 Interpol_3or6_sse2(  /* o : interpolated value                      */
+    Word16 *pX,         /* i : input vector                              */
+    Word16 frac,        /* i : fraction  (-2..2 for 3*, -3..3 for 6*)    */
+    Word16 flag3,       /* i : if set, upsampling rate = 3 (6 otherwise) */
+    Flag   *pOverflow
+)
+{
+    __m128i s;
+
+    OSCL_UNUSED_ARG(pOverflow);
+
+    if (flag3 != 0)
+    {
+        frac <<= 1;
+        /* inter_3[k] = inter_6[2*k] -> k' = 2*k */
+    }
+
+    if (frac < 0)
+    {
+        frac += UP_SAMP_MAX;
+        pX--;
+    }
+
+    s = _mm_madd_epi16(_mm_loadu_si128((__m128i *) &pX[-3]),
+                       _mm_loadu_si128((__m128i *) inter_6_rows[frac]));
+
+    return((Word16)((amrnb_hsum_epi32(s) + 0x04000) >> 15));
+}
+#endif
+
+/* Implementation of Interpol_3or6 that inter_36_cpu_select() selected */
+static Word16 (*Interpol_3or6_impl)(Word16 *pX, Word16 frac, Word16 flag3,
+                                    Flag *pOverflow) = Interpol_3or6_c;
 
+/*
+------------------------------------------------------------------------------
+ FUNCTION NAME: Interpol_3or6
+------------------------------------------------------------------------------
+ INPUT AND OUTPUT DEFINITIONS
+
+ Same as Interpol_3or6_c.
+
+------------------------------------------------------------------------------
+ FUNCTION DESCRIPTION
+
+ Runs the implementation of Interpol_3or6 that inter_36_cpu_select() selected
+ (see amrnb_cpu.h).
+
+------------------------------------------------------------------------------
+*/
+
+Word16 Interpol_3or6(   /* o : interpolated value                        */
+    Word16 *pX,         /* i : input vector                              */
+    Word16 frac,        /* i : fraction  (-2..2 for 3*, -3..3 for 6*)    */
+    Word16 flag3,       /* i : if set, upsampling rate = 3 (6 otherwise) */
+    Flag   *pOverflow
+)
+{
+    return Interpol_3or6_impl(pX, frac, flag3, pOverflow);
+}
+
+/*
+------------------------------------------------------------------------------
+ FUNCTION NAME: inter_36_cpu_select
+------------------------------------------------------------------------------
+ INPUT AND OUTPUT DEFINITIONS
+
+ Inputs:
+    features = AMRNB_CPU_* features the kernels may use (Word32)
+
+ Outputs:
+    Interpol_3or6_impl = the Interpol_3or6 implementation for features
 
+ Returns:
+    None
 
+------------------------------------------------------------------------------
+ FUNCTION DESCRIPTION
 
+ Part of the kernel table of the encoder library, run when the features in
+ use are set (see amrnb_cpu.h).
 
+------------------------------------------------------------------------------
+*/
+void inter_36_cpu_select(Word32 features)
+{
+    Interpol_3or6_impl = Interpol_3or6_c;
+#if defined(AMRNB_SIMD_SSE2)
+    if (features & AMRNB_CPU_SSE2)
+    {
+        Interpol_3or6_impl = Interpol_3or6_sse2;
+    }
+#endif
+}
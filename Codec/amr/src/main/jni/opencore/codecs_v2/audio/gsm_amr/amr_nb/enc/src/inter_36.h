@@ -51,6 +51,7 @@ terms listed above has been obtained from the copyright holder.
 ; INCLUDES
 ----------------------------------------------------------------------------*/
 #include "typedef.h"
+#include "amrnb_simd.h"
 
 /*--------------------------------------------------------------------------*/
 #ifdef __cplusplus
@@ -97,7 +98,17 @@ extern "C"
         Flag   *pOverflow
     );
 
+    /* Implementations selected by Interpol_3or6() */
+    Word16 Interpol_3or6_c(Word16 *x, Word16 frac, Word16 flag3, Flag *pOverflow);
+#if defined(AMRNB_SIMD_SSE2)
+    Word16 Interpol_3or6_sse2(Word16 *x, Word16 frac, Word16 flag3, Flag *pOverflow);
+#endif
+
+
 
+    /* Selects the implementation of Interpol_3or6 for the AMRNB_CPU_*
+       features (see amrnb_cpu.h) */
+    void inter_36_cpu_select(Word32 features);
 
 #ifdef __cplusplus
 }
@@ -81,6 +81,7 @@ terms listed above has been obtained from the copyright holder.
     ol_gain_flg = pointer to OL gain flag (Word16)
     idx = 16 bit value specifies the frame index
     dtx = Data of type 'Flag' used for dtx. Use dtx=1, do not use dtx=0
+    complexity = search effort, 0..COMPLEXITY_MAX (Word16)
     pOverflow = pointer to Overflow indicator (Flag)
 
  Outputs:
@@ -179,6 +180,7 @@ void ol_ltp(
     Word16 ol_gain_flg[], /* i   : OL gain flag                            */
     Word16 idx,           /* i   : index                                   */
     Flag dtx,             /* i   : dtx flag; use dtx=1, do not use dtx=0   */
+    Word16 complexity,    /* i   : search effort, 0..COMPLEXITY_MAX        */
     Flag *pOverflow       /* i/o : overflow indicator                      */
 )
 {
@@ -191,14 +193,14 @@ void ol_ltp(
     if ((mode == MR475) || (mode == MR515))
     {
         *T_op = Pitch_ol(vadSt, mode, wsp, PIT_MIN, PIT_MAX, L_FRAME, idx, dtx,
-                         pOverflow);
+                         complexity, pOverflow);
     }
     else
     {
         if (mode <= MR795)
         {
             *T_op = Pitch_ol(vadSt, mode, wsp, PIT_MIN, PIT_MAX, L_FRAME_BY2,
-                             idx, dtx, pOverflow);
+                             idx, dtx, complexity, pOverflow);
         }
         else if (mode == MR102)
         {
@@ -208,7 +210,7 @@ void ol_ltp(
         else
         {
             *T_op = Pitch_ol(vadSt, mode, wsp, PIT_MIN_MR122, PIT_MAX,
-                             L_FRAME_BY2, idx, dtx, pOverflow);
+                             L_FRAME_BY2, idx, dtx, complexity, pOverflow);
         }
     }
 
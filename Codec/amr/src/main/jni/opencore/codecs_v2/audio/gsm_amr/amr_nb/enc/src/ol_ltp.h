@@ -101,6 +101,7 @@ extern "C"
         Word16 ol_gain_flg[], /* i   : OL gain flag                            */
         Word16 idx,           /* i   : index                                   */
         Flag dtx,             /* i   : dtx flag; use dtx=1, do not use dtx=0   */
+        Word16 complexity,    /* i   : search effort, 0..COMPLEXITY_MAX        */
         Flag *pOverflow       /* i/o : overflow Flag                           */
     );
 
@@ -53,6 +53,7 @@ terms listed above has been obtained from the copyright holder.
 #include "typedef.h"
 #include "cnst.h"
 #include "basic_op.h"
+#include "basic_op_vec.h"
 #include "gmed_n.h"
 #include "inv_sqrt.h"
 #include "vad1.h"
@@ -503,7 +504,6 @@ static Word16 Lag_max(  /* o : lag found                               */
 )
 {
     Word16 i;
-    Word16 j;
     Word16 *p;
     Word16 *p1;
     Word32 max;
@@ -547,14 +547,8 @@ static Word16 Lag_max(  /* o : lag found                               */
     }
     p  = &scal_sig[0];
     p1 = &scal_sig[-p_max];
-    t0 = 0;
-    t1 = 0;
-
-    for (j = 0; j < L_frame; j++, p++, p1++)
-    {
-        t0 = L_mac(t0, *p, *p1, pOverflow);
-        t1 = L_mac(t1, *p1, *p1, pOverflow);
-    }
+    t0 = amrnb_L_mac_n(0, p, p1, L_frame, pOverflow);
+    t1 = amrnb_L_mac_n(0, p1, p1, L_frame, pOverflow);
 
     if (dtx)
     {  /* no test() call since this if is only in simulation env */
@@ -790,11 +784,8 @@ Word16 Pitch_ol_wgh(      /* o   : open loop pitch lag
 
     scal_sig = &scaled_signal[pit_max];
 
-    t0 = 0L;
-    for (i = -pit_max; i < L_frame; i++)
-    {
-        t0 = L_mac(t0, signal[i], signal[i], pOverflow);
-    }
+    t0 = amrnb_L_mac_n(0L, &signal[-pit_max], &signal[-pit_max],
+                       pit_max + L_frame, pOverflow);
     /*--------------------------------------------------------*
      * Scaling of input signal.                               *
      *                                                        *
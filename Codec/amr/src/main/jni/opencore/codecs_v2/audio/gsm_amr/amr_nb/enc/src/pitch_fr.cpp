@@ -56,7 +56,9 @@ terms listed above has been obtained from the copyright holder.
 #include "convolve.h"
 
 #include "basic_op.h"
+#include "basic_op_vec.h"
 #include "oscl_mem.h"
+#include "amrnb_cpu.h"
 
 
 /*----------------------------------------------------------------------------
@@ -109,7 +111,7 @@ static const struct
 
 /*
 ------------------------------------------------------------------------------
- FUNCTION NAME: Norm_Corr
+ FUNCTION NAME: Norm_Corr_c
 ------------------------------------------------------------------------------
  INPUT AND OUTPUT DEFINITIONS
 
@@ -254,14 +256,14 @@ static void Norm_Corr (Word16 exc[], Word16 xn[], Word16 h[], Word16 L_subfr,
 ------------------------------------------------------------------------------
 */
 
-static void Norm_Corr(Word16 exc[],
-                      Word16 xn[],
-                      Word16 h[],
-                      Word16 L_subfr,
-                      Word16 t_min,
-                      Word16 t_max,
-                      Word16 corr_norm[],
-                      Flag *pOverflow)
+static void Norm_Corr_c(Word16 exc[],
+                        Word16 xn[],
+                        Word16 h[],
+                        Word16 L_subfr,
+                        Word16 t_min,
+                        Word16 t_max,
+                        Word16 corr_norm[],
+                        Flag *pOverflow)
 {
     Word16 i;
     Word16 j;
@@ -380,6 +382,186 @@ static void Norm_Corr(Word16 exc[],
     return;
 }
 
+#if defined(AMRNB_SIMD_SSE2)
+/*
+------------------------------------------------------------------------------
+ FUNCTION NAME: Norm_Corr_sse2
+------------------------------------------------------------------------------
+ INPUT AND OUTPUT DEFINITIONS
+
+ Same as Norm_Corr_c.
+
+------------------------------------------------------------------------------
+ FUNCTION DESCRIPTION
+
+ Computes the correlation and the energy of each lag eight samples at a
+ time with multiply-adds, wrapping around like the 32-bit sums of
+ Norm_Corr_c. The filtered excitation is kept behind eight words of
+ padding so that its update for the next lag, s_excf[j] =
+ (Word16)((exc[k] * h[j]) >> h_fac) + s_excf[j - 1], can also run on whole
+ blocks, from the end of the buffer back; the shifted product is rebuilt
+ from the high and low halves of the 16x16 multiply. Subframes that are
+ not a multiple of eight are left to Norm_Corr_c.
+
+------------------------------------------------------------------------------
+*/
+
+static void Norm_Corr_sse2(Word16 exc[],
+                           Word16 xn[],
+                           Word16 h[],
+                           Word16 L_subfr,
+                           Word16 t_min,
+                           Word16 t_max,
+                           Word16 corr_norm[],
+                           Flag *pOverflow)
+{
+    Word16 i;
+    Word16 j;
+    Word16 k;
+    Word16 corr_h;
+    Word16 corr_l;
+    Word16 norm_h;
+    Word16 norm_l;
+    Word32 s;
+    Word32 s2;
+    Word16 excf[L_SUBFR];
+    Word16 buf[8 + L_SUBFR];
+    Word16 *s_excf = &buf[8];
+    Word16 scaling;
+    Word16 h_fac;
+    __m128i lo_shift;
+    __m128i hi_shift;
+
+    if ((L_subfr & 7) != 0 || L_subfr > L_SUBFR)
+    {
+        Norm_Corr_c(exc, xn, h, L_subfr, t_min, t_max, corr_norm, pOverflow);
+        return;
+    }
+
+    k = -t_min;
+
+    /* compute the filtered excitation for the first delay t_min */
+
+    Convolve(&exc[k], h, excf, L_subfr);
+
+    /* scale "excf[]" to avoid overflow */
+    s = amrnb_dot_16x16(excf, excf, L_subfr);
+
+    if (s <= (67108864L >> 1))
+    {
+        h_fac = 12;
+        scaling = 0;
+    }
+    else
+    {
+        /* "excf[]" is divided by 2 */
+        h_fac = 14;
+        scaling = 2;
+    }
+
+    for (j = 0; j < L_subfr; j += 8)
+    {
+        _mm_storeu_si128((__m128i *) &s_excf[j],
+                         _mm_srai_epi16(_mm_loadu_si128((__m128i *) &excf[j]), scaling));
+    }
+    _mm_storeu_si128((__m128i *) buf, _mm_setzero_si128());
+
+    lo_shift = _mm_cvtsi32_si128(h_fac);
+    hi_shift = _mm_cvtsi32_si128(16 - h_fac);
+
+    /* loop for every possible period */
+
+    for (i = t_min; i <= t_max; i++)
+    {
+        __m128i acc = _mm_setzero_si128();
+        __m128i acc2 = _mm_setzero_si128();
+
+        /* Compute 1/sqrt(energy of excf[]) */
+
+        for (j = 0; j < L_subfr; j += 8)
+        {
+            __m128i e = _mm_loadu_si128((__m128i *) &s_excf[j]);
+
+            acc = _mm_add_epi32(acc, _mm_madd_epi16(_mm_loadu_si128((__m128i *) &xn[j]), e));
+            acc2 = _mm_add_epi32(acc2, _mm_madd_epi16(e, e));
+        }
+        s = amrnb_hsum_epi32(acc);
+        s2 = amrnb_hsum_epi32(acc2);
+
+        s2     = s2 << 1;
+        s2     = Inv_sqrt(s2, pOverflow);
+        norm_h = (Word16)(s2 >> 16);
+        norm_l = (Word16)((s2 >> 1) - (norm_h << 15));
+        corr_h = (Word16)(s >> 15);
+        corr_l = (Word16)((s) - (corr_h << 15));
+
+        /* Normalize correlation = correlation * (1/sqrt(energy)) */
+
+        s = Mpy_32(corr_h, corr_l, norm_h, norm_l, pOverflow);
+
+        corr_norm[i] = (Word16) s ;
+
+        /* modify the filtered excitation excf[] for the next iteration */
+        if (i != t_max)
+        {
+            __m128i temp;
+
+            k--;
+            temp = _mm_set1_epi16(exc[k]);
+
+            for (j = L_subfr - 8; j >= 0; j -= 8)
+            {
+                __m128i hv = _mm_loadu_si128((__m128i *) &h[j]);
+                __m128i prev = _mm_loadu_si128((__m128i *) &s_excf[j - 1]);
+                __m128i prod = _mm_or_si128(_mm_sll_epi16(_mm_mulhi_epi16(temp, hv), hi_shift),
+                                            _mm_srl_epi16(_mm_mullo_epi16(temp, hv), lo_shift));
+
+                _mm_storeu_si128((__m128i *) &s_excf[j], _mm_add_epi16(prod, prev));
+            }
+
+            s_excf[0] = exc[k] >> scaling;
+        }
+
+    }
+    return;
+}
+#endif
+
+/* Implementation of Norm_Corr that pitch_fr_cpu_select() selected */
+static void (*Norm_Corr_impl)(Word16 exc[], Word16 xn[], Word16 h[],
+                              Word16 L_subfr, Word16 t_min, Word16 t_max,
+                              Word16 corr_norm[],
+                              Flag *pOverflow) = Norm_Corr_c;
+
+/*
+------------------------------------------------------------------------------
+ FUNCTION NAME: Norm_Corr
+------------------------------------------------------------------------------
+ INPUT AND OUTPUT DEFINITIONS
+
+ Same as Norm_Corr_c.
+
+------------------------------------------------------------------------------
+ FUNCTION DESCRIPTION
+
+ Runs the implementation of Norm_Corr that pitch_fr_cpu_select() selected
+ (see amrnb_cpu.h).
+
+------------------------------------------------------------------------------
+*/
+
+static void Norm_Corr(Word16 exc[],
+                      Word16 xn[],
+                      Word16 h[],
+                      Word16 L_subfr,
+                      Word16 t_min,
+                      Word16 t_max,
+                      Word16 corr_norm[],
+                      Flag *pOverflow)
+{
+    Norm_Corr_impl(exc, xn, h, L_subfr, t_min, t_max, corr_norm, pOverflow);
+}
+
 /****************************************************************************/
 
 
@@ -665,6 +847,112 @@ static void getRange(
 /****************************************************************************/
 
 
+/*
+------------------------------------------------------------------------------
+ FUNCTION NAME: limitRange
+------------------------------------------------------------------------------
+ INPUT AND OUTPUT DEFINITIONS
+
+ Inputs:
+    T0 = integer pitch the search is centred on of type Word16
+    t0_min = search range minimum (from getRange) of type Word16
+    t0_max = search range maximum (from getRange) of type Word16
+    flag3 = subsample resolution 1/3 (=1) or 1/6 (=0) of type Word16
+    complexity = search effort, 0..COMPLEXITY_MAX of type Word16
+    frac = first fractional to check of type Word16
+    last_frac = last fractional to check of type Word16
+
+ Outputs:
+    s_min = first integer lag to search of type Word16
+    s_max = last integer lag to search of type Word16
+    frac, last_frac = fractionals to check at this effort (left as they
+        are when the fractional search is skipped)
+
+ Returns:
+    Number of lags the normalized correlation is needed beyond
+    s_min..s_max (L_INTER_SRCH, or 0 with no fractional search).
+
+ Global Variables Used:
+    None
+
+ Local Variables Needed:
+    None
+
+------------------------------------------------------------------------------
+ FUNCTION DESCRIPTION
+
+ Narrows the closed-loop search below COMPLEXITY_MAX. Under 8 only the
+ integer lags within 1 + complexity / 3 of T0 are tried, under 7 the
+ fractions are limited to one step either side of the integer lag (two at
+ 1/6 resolution), and under 3 the fractional search is skipped. The range
+ the lag is encoded against (t0_min..t0_max) is not changed, so the index
+ is the one the full search would have produced for the same lag.
+
+------------------------------------------------------------------------------
+*/
+static Word16 limitRange(
+    Word16 T0,           /* i   : integer pitch to centre on           */
+    Word16 t0_min,       /* i   : search range minimum                 */
+    Word16 t0_max,       /* i   : search range maximum                 */
+    Word16 flag3,        /* i   : subsample resolution (3: =1 / 6: =0) */
+    Word16 complexity,   /* i   : search effort, 0..COMPLEXITY_MAX     */
+    Word16 *s_min,       /* o   : first integer lag to search          */
+    Word16 *s_max,       /* o   : last integer lag to search           */
+    Word16 *frac,        /* i/o : first fractional to check            */
+    Word16 *last_frac)   /* i/o : last fractional to check             */
+{
+    Word16 width;
+    Word16 step;
+
+    *s_min = t0_min;
+    *s_max = t0_max;
+
+    if (complexity < 8)
+    {
+        if (T0 < t0_min)
+        {
+            T0 = t0_min;
+        }
+        if (T0 > t0_max)
+        {
+            T0 = t0_max;
+        }
+        width = 1 + complexity / 3;
+
+        if ((T0 - width) > t0_min)
+        {
+            *s_min = T0 - width;
+        }
+        if ((T0 + width) < t0_max)
+        {
+            *s_max = T0 + width;
+        }
+    }
+
+    if (complexity < 3)
+    {
+        return (0);
+    }
+
+    if (complexity < 7)
+    {
+        step = (flag3 != 0) ? 1 : 2;
+        if (*frac < -step)
+        {
+            *frac = -step;
+        }
+        if (*last_frac > step)
+        {
+            *last_frac = step;
+        }
+    }
+    return (L_INTER_SRCH);
+}
+
+
+/****************************************************************************/
+
+
 /*
 ------------------------------------------------------------------------------
  FUNCTION NAME: Pitch_fr_init
@@ -927,6 +1215,7 @@ void Pitch_fr_exit(Pitch_frState **state)
           of type Word16
     L_subfr = length of subframe of type Word16
     i_subfr = subframe offset of type Word16
+    complexity = search effort, 0..COMPLEXITY_MAX of type Word16
 
  Outputs:
     pit_frac = pointer to pitch period (fractional) of type Word16
@@ -957,6 +1246,8 @@ void Pitch_fr_exit(Pitch_frState **state)
          - interpolate the normalized correlation at fractions -3/6 to 3/6
            with step 1/6 around the chosen delay.
          - The fraction which gives the maximum interpolated value is chosen.
+         - below COMPLEXITY_MAX fewer delays and fractions are tried
+           (see limitRange).
 
 ------------------------------------------------------------------------------
  REQUIREMENTS
@@ -1222,6 +1513,7 @@ Word16 Pitch_fr(         /* o   : pitch period (integer)                    */
     Word16 *pit_frac,    /* o   : pitch period (fractional)                 */
     Word16 *resu3,       /* o   : subsample resolution 1/3 (=1) or 1/6 (=0) */
     Word16 *ana_index,   /* o   : index of encoding                         */
+    Word16 complexity,   /* i   : search effort, 0..COMPLEXITY_MAX          */
     Flag   *pOverflow
 )
 {
@@ -1230,6 +1522,9 @@ Word16 Pitch_fr(         /* o   : pitch period (integer)                    */
     Word16 t_max;
     Word16 t0_min = 0;
     Word16 t0_max;
+    Word16 s_min;
+    Word16 s_max;
+    Word16 ext;
     Word16 max;
     Word16 lag;
     Word16 frac;
@@ -1318,8 +1613,12 @@ Word16 Pitch_fr(         /* o   : pitch period (integer)                    */
      *           Find interval to compute normalized correlation             *
      *-----------------------------------------------------------------------*/
 
-    t_min = t0_min - L_INTER_SRCH;
-    t_max = t0_max + L_INTER_SRCH;
+    ext = limitRange((delta_search == 0) ? T_op[frame_offset] : st->T0_prev_subframe,
+                     t0_min, t0_max, flag3, complexity,
+                     &s_min, &s_max, &frac, &last_frac);
+
+    t_min = s_min - ext;
+    t_max = s_max + ext;
 
     corr = &corr_v[-t_min];
 
@@ -1333,10 +1632,10 @@ Word16 Pitch_fr(         /* o   : pitch period (integer)                    */
      *                           Find integer pitch                          *
      *-----------------------------------------------------------------------*/
 
-    max = corr[t0_min];
-    lag = t0_min;
+    max = corr[s_min];
+    lag = s_min;
 
-    for (i = t0_min + 1; i <= t0_max; i++)
+    for (i = s_min + 1; i <= s_max; i++)
     {
         if (corr[i] >= max)
         {
@@ -1348,11 +1647,11 @@ Word16 Pitch_fr(         /* o   : pitch period (integer)                    */
     /*-----------------------------------------------------------------------*
      *                        Find fractional pitch                          *
      *-----------------------------------------------------------------------*/
-    if ((delta_search == 0) && (lag > max_frac_lag))
+    if (((delta_search == 0) && (lag > max_frac_lag)) || (ext == 0))
     {
 
-        /* full search and integer pitch greater than max_frac_lag */
-        /* fractional search is not needed, set fractional to zero */
+        /* full search and integer pitch greater than max_frac_lag, */
+        /* or no fractional search at this effort: set fractional to zero */
 
         frac = 0;
     }
@@ -1460,3 +1759,36 @@ Word16 Pitch_fr(         /* o   : pitch period (integer)                    */
     return (lag);
 }
 
+/*
+------------------------------------------------------------------------------
+ FUNCTION NAME: pitch_fr_cpu_select
+------------------------------------------------------------------------------
+ INPUT AND OUTPUT DEFINITIONS
+
+ Inputs:
+    features = AMRNB_CPU_* features the kernels may use (Word32)
+
+ Outputs:
+    Norm_Corr_impl = the Norm_Corr implementation for features
+
+ Returns:
+    None
+
+------------------------------------------------------------------------------
+ FUNCTION DESCRIPTION
+
+ Part of the kernel table of the encoder library, run when the features in
+ use are set (see amrnb_cpu.h).
+
+------------------------------------------------------------------------------
+*/
+void pitch_fr_cpu_select(Word32 features)
+{
+    Norm_Corr_impl = Norm_Corr_c;
+#if defined(AMRNB_SIMD_SSE2)
+    if (features & AMRNB_CPU_SSE2)
+    {
+        Norm_Corr_impl = Norm_Corr_sse2;
+    }
+#endif
+}
@@ -125,9 +125,14 @@ extern "C"
         Word16 *pit_frac,    /* o   : pitch period (fractional)                 */
         Word16 *resu3,       /* o   : subsample resolution 1/3 (=1) or 1/6 (=0) */
         Word16 *ana_index,   /* o   : index of encoding                         */
+        Word16 complexity,   /* i   : search effort, 0..COMPLEXITY_MAX          */
         Flag   *pOverflow
     );
 
+    /* Selects the implementation of the correlations of Pitch_fr for the
+       AMRNB_CPU_* features (see amrnb_cpu.h) */
+    void pitch_fr_cpu_select(Word32 features);
+
 #ifdef __cplusplus
 }
 #endif
@@ -56,6 +56,7 @@ terms listed above has been obtained from the copyright holder.
 #include "hp_max.h"
 #include "oscl_mem.h"
 #include "basic_op.h"
+#include "basic_op_vec.h"
 
 /*----------------------------------------------------------------------------
 ; MACROS
@@ -69,6 +70,7 @@ terms listed above has been obtained from the copyright holder.
 ; compile variables also.
 ----------------------------------------------------------------------------*/
 #define THRESHOLD 27853
+#define DEC_COMPLEXITY 6   /* below this effort, correlate even samples only */
 
 /*----------------------------------------------------------------------------
 ; LOCAL FUNCTION DEFINITIONS
@@ -334,22 +336,10 @@ static Word16 Lag_max(  /* o   : lag found                               */
 
     /* compute energy */
 
-    t0 = 0;
-
     /* The negative array index is equivalent to a negative          */
     /* address offset, i.e., scal_sig[-p_max] == *(scal_sig - p_max) */
     p = &scal_sig[-p_max];
-    for (i = (L_frame >> 2); i != 0; i--)
-    {
-        t0 = amrnb_fxp_mac_16_by_16bb((Word32) * (p), (Word32) * (p), t0);
-        p++;
-        t0 = amrnb_fxp_mac_16_by_16bb((Word32) * (p), (Word32) * (p), t0);
-        p++;
-        t0 = amrnb_fxp_mac_16_by_16bb((Word32) * (p), (Word32) * (p), t0);
-        p++;
-        t0 = amrnb_fxp_mac_16_by_16bb((Word32) * (p), (Word32) * (p), t0);
-        p++;
-    }
+    t0 = amrnb_dot_16x16(p, p, L_frame);
 
     t0 <<= 1;
     /* 1/sqrt(energy) */
@@ -642,6 +632,7 @@ Word16 Lag_max_wrapper(  /* o   : lag found                          */
     L_frame = 16 bit value specifies the length of frame to compute pitch
     idx = 16 bit value specifies the frame index
     dtx = Data of type 'Flag' used for dtx. Use dtx=1, do not use dtx=0
+    complexity = search effort, 0..COMPLEXITY_MAX (Word16)
     pOverflow = pointer to overflow indicator (Flag)
 
  Outputs
@@ -671,6 +662,8 @@ Word16 Lag_max_wrapper(  /* o   : lag found                          */
          that maximum correlation.
        - select the delay of maximum normalized correlation (among the
          three candidates) while favoring the lower delay ranges.
+ Below DEC_COMPLEXITY the correlations are taken over the even samples of
+ the frame only (see comp_corr_dec).
 
 
 ------------------------------------------------------------------------------
@@ -897,6 +890,7 @@ Word16 Pitch_ol(       /* o   : open loop pitch lag                         */
     Word16 L_frame,    /* i   : length of frame to compute pitch            */
     Word16 idx,        /* i   : frame index                                 */
     Flag dtx,          /* i   : dtx flag; use dtx=1, do not use dtx=0       */
+    Word16 complexity, /* i   : search effort, 0..COMPLEXITY_MAX            */
     Flag *pOverflow    /* i/o : overflow Flag                               */
 )
 {
@@ -910,6 +904,7 @@ Word16 Pitch_ol(       /* o   : open loop pitch lag                         */
     Word16 p_max3;
     Word16 scal_flag = 0;
     Word32 t0;
+    int64 energy;
 
 #ifdef VAD2
     Word32 r01;
@@ -948,19 +943,16 @@ Word16 Pitch_ol(       /* o   : open loop pitch lag                         */
 #endif
 
 
-    t0 = 0L;
-    p_signal = &signal[-pit_max];
-
-    for (i = -pit_max; i < L_frame; i++)
+    /* Every term is in [0, 2^31], so a running 32-bit sum of the terms
+       turns negative exactly when the energy reaches 2^31 */
+    energy = amrnb_energy_16(&signal[-pit_max], pit_max + L_frame);
+    if (energy >= (int64) 0x40000000L)
     {
-        t0 += (((Word32) * (p_signal)) * *(p_signal)) << 1;
-        p_signal++;
-        if (t0 < 0)
-        {
-            t0 = MAX_32;
-            break;
-        }
-
+        t0 = MAX_32;
+    }
+    else
+    {
+        t0 = (Word32)(energy << 1);
     }
 
     /*--------------------------------------------------------*
@@ -1021,7 +1013,14 @@ Word16 Pitch_ol(       /* o   : open loop pitch lag                         */
 
     scal_sig = &scaled_signal[pit_max];
 
-    comp_corr(scal_sig, L_frame, pit_max, pit_min, corr_ptr);
+    if (complexity < DEC_COMPLEXITY)
+    {
+        comp_corr_dec(scal_sig, L_frame, pit_max, pit_min, corr_ptr);
+    }
+    else
+    {
+        comp_corr(scal_sig, L_frame, pit_max, pit_min, corr_ptr);
+    }
 
     /*--------------------------------------------------------------------*
      *  The pitch lag search is divided in three sections.                *
@@ -1163,3 +1162,4 @@ Word16 Pitch_ol(       /* o   : open loop pitch lag                         */
 
     return (p_max1);
 }
+
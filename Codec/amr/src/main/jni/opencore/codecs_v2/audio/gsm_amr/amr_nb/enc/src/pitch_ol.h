@@ -100,6 +100,7 @@ extern "C"
         Word16 L_frame,    /* i   : length of frame to compute pitch            */
         Word16 idx,        /* i   : frame index                                 */
         Flag dtx,          /* i   : dtx flag; use dtx=1, do not use dtx=0       */
+        Word16 complexity, /* i   : search effort, 0..COMPLEXITY_MAX            */
         Flag *pOverflow    /* i/o : overflow Flag                               */
     );
 
@@ -55,6 +55,8 @@ terms listed above has been obtained from the copyright holder.
 #include "cnst.h"
 #include "pow2.h"
 #include "log2.h"
+#include "basic_op_vec.h"
+#include "amrnb_cpu.h"
 
 /*----------------------------------------------------------------------------
 ; MACROS
@@ -754,6 +756,249 @@ void MR475_update_unq_pred(
 /****************************************************************************/
 
 
+/*
+------------------------------------------------------------------------------
+ FUNCTION NAME: MR475_gain_search_c
+------------------------------------------------------------------------------
+ INPUT AND OUTPUT DEFINITIONS
+
+ Inputs:
+    gp_limit -- Word16 -- pitch gain limit
+    sf0_gcode0 -- Word16 -- predicted CB gain of subframe 0 (or 2),  Q14
+    sf1_gcode0 -- Word16 -- predicted CB gain of subframe 1 (or 3),  Q14
+    coeff -- array of type Word16 -- scaled energy coeff. (10), high part
+    coeff_lo -- array of type Word16 -- scaled energy coeff. (10), low part
+    pOverflow -- pointer to type Flag -- overflow indicator
+
+ Returns:
+    Word16 -- index of the table_gain_MR475 entry with the lowest MSE
+
+------------------------------------------------------------------------------
+ FUNCTION DESCRIPTION
+
+ Codebook search of MR475_gain_quant: for each entry of table_gain_MR475
+ the terms t[0..4] of both subframes are summed up, and the index of the
+ minimum MSE among the entries with both pitch gains under gp_limit is
+ returned.
+
+------------------------------------------------------------------------------
+*/
+
+static Word16 MR475_gain_search_c(
+    Word16 gp_limit,
+    Word16 sf0_gcode0,
+    Word16 sf1_gcode0,
+    Word16 coeff[],
+    Word16 coeff_lo[],
+    Flag   *pOverflow)
+{
+    const Word16 *p;
+    Word16 i;
+    Word16 index = 0;
+    Word16 tmp;
+    Word16 g_pitch;
+    Word16 g2_pitch;
+    Word16 g_code;
+    Word16 g2_code;
+    Word16 g_pit_cod;
+    Word32 L_tmp;
+    Word32 dist_min;
+
+    /* start with "infinite" MSE */
+    dist_min = MAX_32;
+
+    p = &table_gain_MR475[0];
+
+    for (i = 0; i < MR475_VQ_SIZE; i++)
+    {
+        /* subframe 0 (and 2) calculations */
+        g_pitch = *p++;
+        g_code = *p++;
+
+        /* Need to be there OKA */
+        g_code    = (Word16)(((Word32) g_code * sf0_gcode0) >> 15);
+        g2_pitch  = (Word16)(((Word32) g_pitch * g_pitch) >> 15);
+        g2_code   = (Word16)(((Word32) g_code * g_code) >> 15);
+        g_pit_cod = (Word16)(((Word32) g_code * g_pitch) >> 15);
+
+
+        L_tmp = Mpy_32_16(coeff[0], coeff_lo[0], g2_pitch, pOverflow) +
+                Mpy_32_16(coeff[1], coeff_lo[1], g_pitch, pOverflow) +
+                Mpy_32_16(coeff[2], coeff_lo[2], g2_code, pOverflow) +
+                Mpy_32_16(coeff[3], coeff_lo[3], g_code, pOverflow) +
+                Mpy_32_16(coeff[4], coeff_lo[4], g_pit_cod, pOverflow);
+
+        tmp = (g_pitch - gp_limit);
+
+        /* subframe 1 (and 3) calculations */
+        g_pitch = *p++;
+        g_code = *p++;
+
+        if ((tmp <= 0) && (g_pitch <= gp_limit))
+        {
+            g_code = (Word16)(((Word32) g_code * sf1_gcode0) >> 15);
+            g2_pitch  = (Word16)(((Word32) g_pitch * g_pitch) >> 15);
+            g2_code   = (Word16)(((Word32) g_code * g_code) >> 15);
+            g_pit_cod = (Word16)(((Word32) g_code * g_pitch) >> 15);
+
+            L_tmp += (Mpy_32_16(coeff[5], coeff_lo[5], g2_pitch, pOverflow) +
+                      Mpy_32_16(coeff[6], coeff_lo[6], g_pitch, pOverflow) +
+                      Mpy_32_16(coeff[7], coeff_lo[7], g2_code, pOverflow) +
+                      Mpy_32_16(coeff[8], coeff_lo[8], g_code, pOverflow) +
+                      Mpy_32_16(coeff[9], coeff_lo[9], g_pit_cod, pOverflow));
+
+            /* store table index if MSE for this index is lower
+               than the minimum MSE seen so far */
+            if (L_tmp < dist_min)
+            {
+                dist_min = L_tmp;
+                index = i;
+            }
+        }
+    }
+
+    return index;
+}
+
+#if defined(AMRNB_SIMD_SSE2)
+/*
+------------------------------------------------------------------------------
+ FUNCTION NAME: MR475_gain_search_sse2
+------------------------------------------------------------------------------
+ INPUT AND OUTPUT DEFINITIONS
+
+ Same as MR475_gain_search_c.
+
+------------------------------------------------------------------------------
+ FUNCTION DESCRIPTION
+
+ Evaluates eight table entries at a time. The gains are non-negative, so
+ no Mpy_32_16 saturates and each term is twice the exact value given by
+ amrnb_mpy_32_16_half; the terms are summed with plain wrapping adds, as
+ in MR475_gain_search_c, so twice the wrapped sum of halves is the same
+ distance. Entries with a pitch gain above gp_limit get the distance
+ MAX_32, which never replaces the initial one.
+
+------------------------------------------------------------------------------
+*/
+
+static Word16 MR475_gain_search_sse2(
+    Word16 gp_limit,
+    Word16 sf0_gcode0,
+    Word16 sf1_gcode0,
+    Word16 coeff[],
+    Word16 coeff_lo[],
+    Flag   *pOverflow)
+{
+    Word16 i;
+    Word16 k;
+    __m128i c[10];
+    __m128i c_lo[10];
+    __m128i v_gcode0[2];
+    __m128i v_limit = _mm_set1_epi16(gp_limit);
+    __m128i v_max = _mm_set1_epi32(MAX_32);
+    __m128i dist_min = v_max;
+    __m128i index_min = _mm_setzero_si128();
+    __m128i entry_lo = _mm_setr_epi32(0, 1, 2, 3);
+    __m128i entry_hi = _mm_setr_epi32(4, 5, 6, 7);
+
+    OSCL_UNUSED_ARG(pOverflow);
+
+    for (k = 0; k < 10; k++)
+    {
+        c[k] = amrnb_pair_epi16(coeff[k], 1);
+        c_lo[k] = _mm_set1_epi16(coeff_lo[k]);
+    }
+    v_gcode0[0] = _mm_set1_epi16(sf0_gcode0);
+    v_gcode0[1] = _mm_set1_epi16(sf1_gcode0);
+
+    for (i = 0; i < MR475_VQ_SIZE; i += 8)
+    {
+        __m128i t[4];
+        __m128i n[5];
+        __m128i h_lo;
+        __m128i h_hi;
+        __m128i s_lo = _mm_setzero_si128();
+        __m128i s_hi = _mm_setzero_si128();
+        __m128i skip;
+        __m128i skip_lo;
+        __m128i skip_hi;
+        Word16 sf;
+
+        amrnb_deinterleave4_epi16(&table_gain_MR475[i << 2], t);
+
+        for (sf = 0; sf < 2; sf++)
+        {
+            n[1] = t[2 * sf];
+            n[3] = amrnb_mul_shr15_epi16(t[2 * sf + 1], v_gcode0[sf]);
+            n[0] = amrnb_mul_shr15_epi16(n[1], n[1]);
+            n[2] = amrnb_mul_shr15_epi16(n[3], n[3]);
+            n[4] = amrnb_mul_shr15_epi16(n[3], n[1]);
+
+            for (k = 0; k < 5; k++)
+            {
+                amrnb_mpy_32_16_half(c[5 * sf + k], c_lo[5 * sf + k], n[k], &h_lo, &h_hi);
+                s_lo = _mm_add_epi32(s_lo, h_lo);
+                s_hi = _mm_add_epi32(s_hi, h_hi);
+            }
+        }
+
+        skip = _mm_or_si128(_mm_cmpgt_epi16(t[0], v_limit),
+                            _mm_cmpgt_epi16(t[2], v_limit));
+        skip_lo = _mm_unpacklo_epi16(skip, skip);
+        skip_hi = _mm_unpackhi_epi16(skip, skip);
+
+        s_lo = _mm_or_si128(_mm_and_si128(skip_lo, v_max),
+                            _mm_andnot_si128(skip_lo, _mm_slli_epi32(s_lo, 1)));
+        s_hi = _mm_or_si128(_mm_and_si128(skip_hi, v_max),
+                            _mm_andnot_si128(skip_hi, _mm_slli_epi32(s_hi, 1)));
+
+        amrnb_min_index_epi32(&dist_min, &index_min, s_lo, entry_lo);
+        amrnb_min_index_epi32(&dist_min, &index_min, s_hi, entry_hi);
+
+        entry_lo = _mm_add_epi32(entry_lo, _mm_set1_epi32(8));
+        entry_hi = _mm_add_epi32(entry_hi, _mm_set1_epi32(8));
+    }
+
+    return amrnb_min_index_reduce(dist_min, index_min);
+}
+#endif
+
+/* Implementation of MR475_gain_search that qgain475_cpu_select() selected */
+static Word16 (*MR475_gain_search_impl)(Word16 gp_limit, Word16 sf0_gcode0,
+                                        Word16 sf1_gcode0, Word16 coeff[],
+                                        Word16 coeff_lo[],
+                                        Flag *pOverflow) = MR475_gain_search_c;
+
+/*
+------------------------------------------------------------------------------
+ FUNCTION NAME: MR475_gain_search
+------------------------------------------------------------------------------
+ INPUT AND OUTPUT DEFINITIONS
+
+ Same as MR475_gain_search_c.
+
+------------------------------------------------------------------------------
+ FUNCTION DESCRIPTION
+
+ Runs the implementation of MR475_gain_search that qgain475_cpu_select() selected
+ (see amrnb_cpu.h).
+
+------------------------------------------------------------------------------
+*/
+
+static Word16 MR475_gain_search(
+    Word16 gp_limit,
+    Word16 sf0_gcode0,
+    Word16 sf1_gcode0,
+    Word16 coeff[],
+    Word16 coeff_lo[],
+    Flag   *pOverflow)
+{
+    return MR475_gain_search_impl(gp_limit, sf0_gcode0, sf1_gcode0,
+                               coeff, coeff_lo, pOverflow);
+}
+
 /*
 ------------------------------------------------------------------------------
  FUNCTION NAME: MR475_gain_quant
@@ -1132,21 +1377,15 @@ Word16 MR475_gain_quant(       /* o  : index of quantization.                 */
 {
     const Word16 *p;
     Word16 i;
-    Word16 index = 0;
+    Word16 index;
     Word16 tmp;
     Word16 exp;
     Word16 sf0_gcode0;
     Word16 sf1_gcode0;
-    Word16 g_pitch;
-    Word16 g2_pitch;
-    Word16 g_code;
-    Word16 g2_code;
-    Word16 g_pit_cod;
     Word16 coeff[10];
     Word16 coeff_lo[10];
     Word16 exp_max[10];  /* 0..4: sf0; 5..9: sf1 */
     Word32 L_tmp;
-    Word32 dist_min;
 
     /*-------------------------------------------------------------------*
      *  predicted codebook gain                                          *
@@ -1305,58 +1544,8 @@ Word16 MR475_gain_quant(       /* o  : index of quantization.                 */
      *  gains                                                            *
      *-------------------------------------------------------------------*/
 
-    /* start with "infinite" MSE */
-    dist_min = MAX_32;
-
-    p = &table_gain_MR475[0];
-
-    for (i = 0; i < MR475_VQ_SIZE; i++)
-    {
-        /* subframe 0 (and 2) calculations */
-        g_pitch = *p++;
-        g_code = *p++;
-
-        /* Need to be there OKA */
-        g_code    = (Word16)(((Word32) g_code * sf0_gcode0) >> 15);
-        g2_pitch  = (Word16)(((Word32) g_pitch * g_pitch) >> 15);
-        g2_code   = (Word16)(((Word32) g_code * g_code) >> 15);
-        g_pit_cod = (Word16)(((Word32) g_code * g_pitch) >> 15);
-
-
-        L_tmp = Mpy_32_16(coeff[0], coeff_lo[0], g2_pitch, pOverflow) +
-                Mpy_32_16(coeff[1], coeff_lo[1], g_pitch, pOverflow) +
-                Mpy_32_16(coeff[2], coeff_lo[2], g2_code, pOverflow) +
-                Mpy_32_16(coeff[3], coeff_lo[3], g_code, pOverflow) +
-                Mpy_32_16(coeff[4], coeff_lo[4], g_pit_cod, pOverflow);
-
-        tmp = (g_pitch - gp_limit);
-
-        /* subframe 1 (and 3) calculations */
-        g_pitch = *p++;
-        g_code = *p++;
-
-        if ((tmp <= 0) && (g_pitch <= gp_limit))
-        {
-            g_code = (Word16)(((Word32) g_code * sf1_gcode0) >> 15);
-            g2_pitch  = (Word16)(((Word32) g_pitch * g_pitch) >> 15);
-            g2_code   = (Word16)(((Word32) g_code * g_code) >> 15);
-            g_pit_cod = (Word16)(((Word32) g_code * g_pitch) >> 15);
-
-            L_tmp += (Mpy_32_16(coeff[5], coeff_lo[5], g2_pitch, pOverflow) +
-                      Mpy_32_16(coeff[6], coeff_lo[6], g_pitch, pOverflow) +
-                      Mpy_32_16(coeff[7], coeff_lo[7], g2_code, pOverflow) +
-                      Mpy_32_16(coeff[8], coeff_lo[8], g_code, pOverflow) +
-                      Mpy_32_16(coeff[9], coeff_lo[9], g_pit_cod, pOverflow));
-
-            /* store table index if MSE for this index is lower
-               than the minimum MSE seen so far */
-            if (L_tmp < dist_min)
-            {
-                dist_min = L_tmp;
-                index = i;
-            }
-        }
-    }
+    index = MR475_gain_search(gp_limit, sf0_gcode0, sf1_gcode0,
+                              coeff, coeff_lo, pOverflow);
 
     /*------------------------------------------------------------------*
      *  read quantized gains and update MA predictor memories           *
@@ -1395,3 +1584,37 @@ Word16 MR475_gain_quant(       /* o  : index of quantization.                 */
 
     return(index);
 }
+
+/*
+------------------------------------------------------------------------------
+ FUNCTION NAME: qgain475_cpu_select
+------------------------------------------------------------------------------
+ INPUT AND OUTPUT DEFINITIONS
+
+ Inputs:
+    features = AMRNB_CPU_* features the kernels may use (Word32)
+
+ Outputs:
+    MR475_gain_search_impl = the MR475_gain_search implementation for features
+
+ Returns:
+    None
+
+------------------------------------------------------------------------------
+ FUNCTION DESCRIPTION
+
+ Part of the kernel table of the encoder library, run when the features in
+ use are set (see amrnb_cpu.h).
+
+------------------------------------------------------------------------------
+*/
+void qgain475_cpu_select(Word32 features)
+{
+    MR475_gain_search_impl = MR475_gain_search_c;
+#if defined(AMRNB_SIMD_SSE2)
+    if (features & AMRNB_CPU_SSE2)
+    {
+        MR475_gain_search_impl = MR475_gain_search_sse2;
+    }
+#endif
+}
@@ -159,6 +159,10 @@ extern "C"
         Word16 *sf1_gain_cod,      /* o  : Code gain,                         Q1  */
         Flag   *pOverflow          /* o  : overflow indicator                     */
     );
+    /* Selects the implementation of the codebook search of MR475_gain_quant
+       for the AMRNB_CPU_* features (see amrnb_cpu.h) */
+    void qgain475_cpu_select(Word32 features);
+
 #ifdef __cplusplus
 }
 #endif
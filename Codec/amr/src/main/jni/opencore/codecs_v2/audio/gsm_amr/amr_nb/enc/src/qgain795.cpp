@@ -56,6 +56,8 @@ terms listed above has been obtained from the copyright holder.
 #include "g_adapt.h"
 #include "calc_en.h"
 #include "q_gain_p.h"
+#include "basic_op_vec.h"
+#include "amrnb_cpu.h"
 
 
 /*--------------------------------------------------------------------------*/
@@ -96,6 +98,281 @@ extern "C"
 }
 #endif
 
+/*
+------------------------------------------------------------------------------
+ FUNCTION NAME: MR795_gain_code_search_c
+------------------------------------------------------------------------------
+ INPUT AND OUTPUT DEFINITIONS
+
+ Inputs:
+    gcode0         -- Word16       -- predicted CB gain (norm.),    Q14
+    g_pitch_cand[] -- Word16 array -- Pitch gain candidates (3),    Q14
+    coeff[]        -- Word16 array -- scaled coefficients (5), high part
+    coeff_lo[]     -- Word16 array -- scaled coefficients (5), low part
+    qua_gain_code_ptr -- pointer to const Word16 -- code gain table
+
+ Outputs:
+    cod_ind   -- Pointer to Word16 -- index of the best code gain
+    pit_ind   -- Pointer to Word16 -- index of the best pitch gain candidate
+    pOverflow -- Pointer to Flag --  overflow indicator
+
+ Returns:
+    None
+
+------------------------------------------------------------------------------
+ FUNCTION DESCRIPTION
+
+ Codebook search of MR795_gain_code_quant3: for each of the candidate LTP
+ gains and each code gain in the table, the terms t[0..4] are summed up,
+ and the indices of the pair with the minimum MSE are returned.
+
+------------------------------------------------------------------------------
+*/
+
+static void MR795_gain_code_search_c(
+    Word16 gcode0,
+    Word16 g_pitch_cand[],
+    Word16 coeff[],
+    Word16 coeff_lo[],
+    const Word16* qua_gain_code_ptr,
+    Word16 *cod_ind,
+    Word16 *pit_ind,
+    Flag   *pOverflow)
+{
+    const Word16 *p;
+    Word16 i;
+    Word16 j;
+    Word16 g_pitch;
+    Word16 g2_pitch;
+    Word16 g_code;
+    Word16 g2_code_h;
+    Word16 g2_code_l;
+    Word16 g_pit_cod_h;
+    Word16 g_pit_cod_l;
+    Word32 L_tmp;
+    Word32 L_tmp0;
+    Word32 dist_min;
+
+    /* start with "infinite" MSE */
+    dist_min = MAX_32;
+    *cod_ind = 0;
+    *pit_ind = 0;
+
+    /* loop through LTP gain candidates */
+    for (j = 0; j < 3; j++)
+    {
+        /* pre-calculate terms only dependent on pitch gain */
+        g_pitch = g_pitch_cand[j];
+        g2_pitch = mult(g_pitch, g_pitch, pOverflow);
+        L_tmp0 = Mpy_32_16(coeff[0], coeff_lo[0], g2_pitch, pOverflow);
+        L_tmp0 = Mac_32_16(L_tmp0, coeff[1], coeff_lo[1], g_pitch, pOverflow);
+
+        p = &qua_gain_code_ptr[0];
+        for (i = 0; i < NB_QUA_CODE; i++)
+        {
+            g_code = *p++;                   /* this is g_fac        Q11 */
+            p++;                             /* skip log2(g_fac)         */
+            p++;                             /* skip 20*log10(g_fac)     */
+
+            g_code = mult(g_code, gcode0, pOverflow);
+
+            L_tmp = L_mult(g_code, g_code, pOverflow);
+            L_Extract(L_tmp, &g2_code_h, &g2_code_l, pOverflow);
+
+            L_tmp = L_mult(g_code, g_pitch, pOverflow);
+            L_Extract(L_tmp, &g_pit_cod_h, &g_pit_cod_l, pOverflow);
+
+            L_tmp = Mac_32(L_tmp0, coeff[2], coeff_lo[2],
+                           g2_code_h, g2_code_l, pOverflow);
+            L_tmp = Mac_32_16(L_tmp, coeff[3], coeff_lo[3],
+                              g_code, pOverflow);
+            L_tmp = Mac_32(L_tmp, coeff[4], coeff_lo[4],
+                           g_pit_cod_h, g_pit_cod_l, pOverflow);
+
+            /* store table index if MSE for this index is lower
+               than the minimum MSE seen so far; also store the
+               pitch gain for this (so far) lowest MSE          */
+            if (L_tmp < dist_min)
+            {
+                dist_min = L_tmp;
+                *cod_ind = i;
+                *pit_ind = j;
+            }
+        }
+    }
+}
+
+#if defined(AMRNB_SIMD_SSE2)
+/*
+------------------------------------------------------------------------------
+ FUNCTION NAME: MR795_gain_code_search_sse2
+------------------------------------------------------------------------------
+ INPUT AND OUTPUT DEFINITIONS
+
+ Same as MR795_gain_code_search_c.
+
+------------------------------------------------------------------------------
+ FUNCTION DESCRIPTION
+
+ Evaluates eight code gains at a time for each pitch gain candidate. The
+ L_mac steps of Mac_32 and Mac_32_16 are kept as separate wrapping adds
+ from the scalar L_tmp0, and a search in which any of them overflows,
+ which covers every case where L_mac saturates, is left to
+ MR795_gain_code_search_c.
+
+------------------------------------------------------------------------------
+*/
+
+static void MR795_gain_code_search_sse2(
+    Word16 gcode0,
+    Word16 g_pitch_cand[],
+    Word16 coeff[],
+    Word16 coeff_lo[],
+    const Word16* qua_gain_code_ptr,
+    Word16 *cod_ind,
+    Word16 *pit_ind,
+    Flag   *pOverflow)
+{
+    Word16 i;
+    Word16 j;
+    Word16 k;
+    Word16 index;
+    Word16 g_pitch;
+    Word16 g2_pitch;
+    Word16 g_code[NB_QUA_CODE];
+    Word32 L_tmp0;
+    __m128i zero = _mm_setzero_si128();
+    __m128i one = _mm_set1_epi16(1);
+    __m128i mask_lo = _mm_set1_epi16(0x7fff);
+    __m128i c2 = _mm_set1_epi16(coeff[2]);
+    __m128i c2_lo = _mm_set1_epi16(coeff_lo[2]);
+    __m128i c3 = _mm_set1_epi16(coeff[3]);
+    __m128i c3_lo = _mm_set1_epi16(coeff_lo[3]);
+    __m128i c4 = _mm_set1_epi16(coeff[4]);
+    __m128i c4_lo = _mm_set1_epi16(coeff_lo[4]);
+    __m128i ovf = _mm_setzero_si128();
+    __m128i dist_min = _mm_set1_epi32(MAX_32);
+    __m128i index_min = _mm_setzero_si128();
+
+    for (i = 0; i < NB_QUA_CODE; i++)
+    {
+        g_code[i] = mult(qua_gain_code_ptr[3 * i], gcode0, pOverflow);
+    }
+
+    for (j = 0; j < 3; j++)
+    {
+        __m128i acc0;
+        __m128i gp;
+
+        g_pitch = g_pitch_cand[j];
+        g2_pitch = mult(g_pitch, g_pitch, pOverflow);
+        L_tmp0 = Mpy_32_16(coeff[0], coeff_lo[0], g2_pitch, pOverflow);
+        L_tmp0 = Mac_32_16(L_tmp0, coeff[1], coeff_lo[1], g_pitch, pOverflow);
+
+        acc0 = _mm_set1_epi32(L_tmp0);
+        gp = _mm_set1_epi16(g_pitch);
+
+        for (i = 0; i < NB_QUA_CODE; i += 8)
+        {
+            __m128i gc = _mm_loadu_si128((const __m128i *) &g_code[i]);
+            __m128i g2_h = amrnb_mul_shr15_epi16(gc, gc);
+            __m128i g2_l = _mm_and_si128(_mm_mullo_epi16(gc, gc), mask_lo);
+            __m128i gpc_h = amrnb_mul_shr15_epi16(gc, gp);
+            __m128i gpc_l = _mm_and_si128(_mm_mullo_epi16(gc, gp), mask_lo);
+            __m128i acc_lo = acc0;
+            __m128i acc_hi = acc0;
+            __m128i a[8];
+            __m128i b[8];
+            __m128i entry = _mm_set1_epi32(j * NB_QUA_CODE + i);
+
+            /* the L_mac operands of Mac_32, Mac_32_16 and Mac_32, in order */
+            a[0] = c2;
+            b[0] = g2_h;
+            a[1] = amrnb_mul_shr15_epi16(c2, g2_l);
+            b[1] = one;
+            a[2] = amrnb_mul_shr15_epi16(c2_lo, g2_h);
+            b[2] = one;
+            a[3] = c3;
+            b[3] = gc;
+            a[4] = amrnb_mul_shr15_epi16(c3_lo, gc);
+            b[4] = one;
+            a[5] = c4;
+            b[5] = gpc_h;
+            a[6] = amrnb_mul_shr15_epi16(c4, gpc_l);
+            b[6] = one;
+            a[7] = amrnb_mul_shr15_epi16(c4_lo, gpc_h);
+            b[7] = one;
+
+            for (k = 0; k < 8; k++)
+            {
+                __m128i p_lo = _mm_madd_epi16(_mm_unpacklo_epi16(a[k], zero),
+                                              _mm_unpacklo_epi16(b[k], zero));
+                __m128i p_hi = _mm_madd_epi16(_mm_unpackhi_epi16(a[k], zero),
+                                              _mm_unpackhi_epi16(b[k], zero));
+
+                acc_lo = amrnb_add_ovf_epi32(acc_lo, _mm_slli_epi32(p_lo, 1), &ovf);
+                acc_hi = amrnb_add_ovf_epi32(acc_hi, _mm_slli_epi32(p_hi, 1), &ovf);
+            }
+
+            amrnb_min_index_epi32(&dist_min, &index_min, acc_lo,
+                                  _mm_add_epi32(entry, _mm_setr_epi32(0, 1, 2, 3)));
+            amrnb_min_index_epi32(&dist_min, &index_min, acc_hi,
+                                  _mm_add_epi32(entry, _mm_setr_epi32(4, 5, 6, 7)));
+        }
+    }
+
+    if (_mm_movemask_ps(_mm_castsi128_ps(ovf)) != 0)
+    {
+        MR795_gain_code_search_c(gcode0, g_pitch_cand, coeff, coeff_lo,
+                                 qua_gain_code_ptr, cod_ind, pit_ind, pOverflow);
+        return;
+    }
+
+    index = amrnb_min_index_reduce(dist_min, index_min);
+    *pit_ind = index / NB_QUA_CODE;
+    *cod_ind = index - *pit_ind * NB_QUA_CODE;
+}
+#endif
+
+/* Implementation of MR795_gain_code_search that qgain795_cpu_select() selected */
+static void (*MR795_gain_code_search_impl)(Word16 gcode0,
+                                           Word16 g_pitch_cand[],
+                                           Word16 coeff[], Word16 coeff_lo[],
+                                           const Word16* qua_gain_code_ptr,
+                                           Word16 *cod_ind, Word16 *pit_ind,
+                                           Flag *pOverflow) = MR795_gain_code_search_c;
+
+/*
+------------------------------------------------------------------------------
+ FUNCTION NAME: MR795_gain_code_search
+------------------------------------------------------------------------------
+ INPUT AND OUTPUT DEFINITIONS
+
+ Same as MR795_gain_code_search_c.
+
+------------------------------------------------------------------------------
+ FUNCTION DESCRIPTION
+
+ Runs the fastest implementation of MR795_gain_code_search that the CPU
+ supports (see amrnb_cpu.h).
+
+------------------------------------------------------------------------------
+*/
+
+static void MR795_gain_code_search(
+    Word16 gcode0,
+    Word16 g_pitch_cand[],
+    Word16 coeff[],
+    Word16 coeff_lo[],
+    const Word16* qua_gain_code_ptr,
+    Word16 *cod_ind,
+    Word16 *pit_ind,
+    Flag   *pOverflow)
+{
+    MR795_gain_code_search_impl(gcode0, g_pitch_cand, coeff, coeff_lo,
+                             qua_gain_code_ptr, cod_ind, pit_ind, pOverflow);
+}
+
 /*
 ------------------------------------------------------------------------------
  FUNCTION NAME: MR795_gain_code_quant3
@@ -187,19 +464,11 @@ MR795_gain_code_quant3(
     Word16 pit_ind;
     Word16 e_max;
     Word16 exp_code;
-    Word16 g_pitch;
-    Word16 g2_pitch;
     Word16 g_code;
-    Word16 g2_code_h;
-    Word16 g2_code_l;
-    Word16 g_pit_cod_h;
-    Word16 g_pit_cod_l;
     Word16 coeff[5];
     Word16 coeff_lo[5];
     Word16 exp_max[5];
     Word32 L_tmp;
-    Word32 L_tmp0;
-    Word32 dist_min;
 
     /*
      * The error energy (sum) to be minimized consists of five terms, t[0..4].
@@ -269,53 +538,8 @@ MR795_gain_code_quant3(
      *  gain                                                             *
      *-------------------------------------------------------------------*/
 
-    /* start with "infinite" MSE */
-    dist_min = MAX_32;
-    cod_ind = 0;
-    pit_ind = 0;
-
-    /* loop through LTP gain candidates */
-    for (j = 0; j < 3; j++)
-    {
-        /* pre-calculate terms only dependent on pitch gain */
-        g_pitch = g_pitch_cand[j];
-        g2_pitch = mult(g_pitch, g_pitch, pOverflow);
-        L_tmp0 = Mpy_32_16(coeff[0], coeff_lo[0], g2_pitch, pOverflow);
-        L_tmp0 = Mac_32_16(L_tmp0, coeff[1], coeff_lo[1], g_pitch, pOverflow);
-
-        p = &qua_gain_code_ptr[0];
-        for (i = 0; i < NB_QUA_CODE; i++)
-        {
-            g_code = *p++;                   /* this is g_fac        Q11 */
-            p++;                             /* skip log2(g_fac)         */
-            p++;                             /* skip 20*log10(g_fac)     */
-
-            g_code = mult(g_code, gcode0, pOverflow);
-
-            L_tmp = L_mult(g_code, g_code, pOverflow);
-            L_Extract(L_tmp, &g2_code_h, &g2_code_l, pOverflow);
-
-            L_tmp = L_mult(g_code, g_pitch, pOverflow);
-            L_Extract(L_tmp, &g_pit_cod_h, &g_pit_cod_l, pOverflow);
-
-            L_tmp = Mac_32(L_tmp0, coeff[2], coeff_lo[2],
-                           g2_code_h, g2_code_l, pOverflow);
-            L_tmp = Mac_32_16(L_tmp, coeff[3], coeff_lo[3],
-                              g_code, pOverflow);
-            L_tmp = Mac_32(L_tmp, coeff[4], coeff_lo[4],
-                           g_pit_cod_h, g_pit_cod_l, pOverflow);
-
-            /* store table index if MSE for this index is lower
-               than the minimum MSE seen so far; also store the
-               pitch gain for this (so far) lowest MSE          */
-            if (L_tmp < dist_min)
-            {
-                dist_min = L_tmp;
-                cod_ind = i;
-                pit_ind = j;
-            }
-        }
-    }
+    MR795_gain_code_search(gcode0, g_pitch_cand, coeff, coeff_lo,
+                           qua_gain_code_ptr, &cod_ind, &pit_ind, pOverflow);
 
     /*------------------------------------------------------------------*
      *  read quantized gains and new values for MA predictor memories   *
@@ -830,3 +1054,37 @@ MR795_gain_quant(
     *(*anap)++ = gain_pit_index;
     *(*anap)++ = gain_cod_index;
 }
+
+/*
+------------------------------------------------------------------------------
+ FUNCTION NAME: qgain795_cpu_select
+------------------------------------------------------------------------------
+ INPUT AND OUTPUT DEFINITIONS
+
+ Inputs:
+    features = AMRNB_CPU_* features the kernels may use (Word32)
+
+ Outputs:
+    MR795_gain_code_search_impl = the MR795_gain_code_search implementation for features
+
+ Returns:
+    None
+
+------------------------------------------------------------------------------
+ FUNCTION DESCRIPTION
+
+ Part of the kernel table of the encoder library, run when the features in
+ use are set (see amrnb_cpu.h).
+
+------------------------------------------------------------------------------
+*/
+void qgain795_cpu_select(Word32 features)
+{
+    MR795_gain_code_search_impl = MR795_gain_code_search_c;
+#if defined(AMRNB_SIMD_SSE2)
+    if (features & AMRNB_CPU_SSE2)
+    {
+        MR795_gain_code_search_impl = MR795_gain_code_search_sse2;
+    }
+#endif
+}
@@ -121,6 +121,10 @@ extern "C"
         Flag   *pOverflow         /* o  : overflow indicator                 */
     );
 
+    /* Selects the implementation of the codebook search of MR795_gain_quant
+       for the AMRNB_CPU_* features (see amrnb_cpu.h) */
+    void qgain795_cpu_select(Word32 features);
+
     /*----------------------------------------------------------------------------
     ; END
     ----------------------------------------------------------------------------*/
@@ -51,6 +51,8 @@ terms listed above has been obtained from the copyright holder.
 #include "cnst.h"
 #include "pow2.h"
 #include "gc_pred.h"
+#include "basic_op_vec.h"
+#include "amrnb_cpu.h"
 
 /*--------------------------------------------------------------------------*/
 #ifdef __cplusplus
@@ -89,6 +91,259 @@ extern "C"
 }
 #endif
 
+/*
+------------------------------------------------------------------------------
+ FUNCTION NAME: Qua_gain_search_c
+------------------------------------------------------------------------------
+ INPUT AND OUTPUT DEFINITIONS
+
+ Inputs:
+    table_gain -- array of type Word16 -- gain table, 4 words per entry
+    table_len -- Word16 -- number of entries in table_gain
+    gp_limit -- Word16 -- pitch gain limit
+    gcode0 -- Word16 -- predicted CB gain,                           Q14
+    coeff -- array of type Word16 -- scaled energy coeff. (5), high part
+    coeff_lo -- array of type Word16 -- scaled energy coeff. (5), low part
+    pOverflow -- pointer to type Flag -- overflow indicator
+
+ Returns:
+    Word16 -- index of the table entry with the lowest MSE
+
+------------------------------------------------------------------------------
+ FUNCTION DESCRIPTION
+
+ Codebook search of Qua_gain: for each pair (g_pitch, g_fac) in the table
+ calculate the terms t[0..4] and sum them up; the result is the mean
+ squared error for the quantized gains from the table. The index for the
+ minimum MSE is returned.
+
+------------------------------------------------------------------------------
+*/
+
+static Word16 Qua_gain_search_c(
+    const Word16 *table_gain,
+    Word16 table_len,
+    Word16 gp_limit,
+    Word16 gcode0,
+    Word16 coeff[],
+    Word16 coeff_lo[],
+    Flag   *pOverflow)
+{
+    const Word16 *p;
+    Word16 i;
+    Word16 index = 0;
+    Word16 g_pitch;
+    Word16 g2_pitch;
+    Word16 g_code;
+    Word16 g2_code;
+    Word16 g_pit_cod;
+    Word32 L_tmp;
+    Word32 L_tmp2;
+    Word32 dist_min;
+
+    /* start with "infinite" MSE */
+    dist_min = MAX_32;
+
+    p = &table_gain[0];
+
+    for (i = 0; i < table_len; i++)
+    {
+        g_pitch = *p++;
+        g_code = *p++;                   /* this is g_fac        */
+        p++;                             /* skip log2(g_fac)     */
+        p++;                             /* skip 20*log10(g_fac) */
+
+        if (g_pitch <= gp_limit)
+        {
+            g_code = mult(g_code, gcode0, pOverflow);
+            g2_pitch = mult(g_pitch, g_pitch, pOverflow);
+            g2_code = mult(g_code, g_code, pOverflow);
+            g_pit_cod = mult(g_code, g_pitch, pOverflow);
+
+            L_tmp = Mpy_32_16(coeff[0], coeff_lo[0], g2_pitch, pOverflow);
+            L_tmp2 = Mpy_32_16(coeff[1], coeff_lo[1], g_pitch, pOverflow);
+            L_tmp = L_add(L_tmp, L_tmp2, pOverflow);
+
+            L_tmp2 = Mpy_32_16(coeff[2], coeff_lo[2], g2_code, pOverflow);
+            L_tmp = L_add(L_tmp, L_tmp2, pOverflow);
+
+            L_tmp2 =  Mpy_32_16(coeff[3], coeff_lo[3], g_code, pOverflow);
+            L_tmp = L_add(L_tmp, L_tmp2, pOverflow);
+
+            L_tmp2 = Mpy_32_16(coeff[4], coeff_lo[4], g_pit_cod, pOverflow);
+            L_tmp = L_add(L_tmp, L_tmp2, pOverflow);
+
+            /* store table index if MSE for this index is lower
+               than the minimum MSE seen so far */
+            if (L_tmp < dist_min)
+            {
+                dist_min = L_tmp;
+                index = i;
+            }
+        }
+    }
+
+    return index;
+}
+
+#if defined(AMRNB_SIMD_SSE2)
+/*
+------------------------------------------------------------------------------
+ FUNCTION NAME: Qua_gain_search_sse2
+------------------------------------------------------------------------------
+ INPUT AND OUTPUT DEFINITIONS
+
+ Same as Qua_gain_search_c.
+
+------------------------------------------------------------------------------
+ FUNCTION DESCRIPTION
+
+ Evaluates eight table entries at a time. Mpy_32_16 cannot saturate for
+ the non-negative gains of the table, so each term t[k] is 2 * h[k] with
+ |h[k]| < 2^30, and the L_add chain saturates exactly when one of the
+ partial sums of h leaves [-2^30, 2^30). Those partial sums are formed
+ without wrapping, and a search in which one of them leaves the range for
+ an entry under gp_limit is left to Qua_gain_search_c. Entries above
+ gp_limit get the distance MAX_32, which never replaces the initial one.
+
+------------------------------------------------------------------------------
+*/
+
+static Word16 Qua_gain_search_sse2(
+    const Word16 *table_gain,
+    Word16 table_len,
+    Word16 gp_limit,
+    Word16 gcode0,
+    Word16 coeff[],
+    Word16 coeff_lo[],
+    Flag   *pOverflow)
+{
+    Word16 i;
+    Word16 k;
+    __m128i c[5];
+    __m128i c_lo[5];
+    __m128i v_gcode0 = _mm_set1_epi16(gcode0);
+    __m128i v_limit = _mm_set1_epi16(gp_limit);
+    __m128i v_max = _mm_set1_epi32(MAX_32);
+    __m128i sat = _mm_setzero_si128();
+    __m128i dist_min = v_max;
+    __m128i index_min = _mm_setzero_si128();
+    __m128i entry_lo = _mm_setr_epi32(0, 1, 2, 3);
+    __m128i entry_hi = _mm_setr_epi32(4, 5, 6, 7);
+
+    if ((table_len & 7) != 0)
+    {
+        return Qua_gain_search_c(table_gain, table_len, gp_limit, gcode0,
+                                 coeff, coeff_lo, pOverflow);
+    }
+
+    for (k = 0; k < 5; k++)
+    {
+        c[k] = amrnb_pair_epi16(coeff[k], 1);
+        c_lo[k] = _mm_set1_epi16(coeff_lo[k]);
+    }
+
+    for (i = 0; i < table_len; i += 8)
+    {
+        __m128i t[4];
+        __m128i n[5];
+        __m128i h_lo;
+        __m128i h_hi;
+        __m128i s_lo;
+        __m128i s_hi;
+        __m128i skip;
+        __m128i skip_lo;
+        __m128i skip_hi;
+        __m128i outside;
+
+        amrnb_deinterleave4_epi16(&table_gain[i << 2], t);
+
+        /* g_pitch, g_code and the products, all non-negative */
+        n[1] = t[0];
+        n[3] = amrnb_mul_shr15_epi16(t[1], v_gcode0);
+        n[0] = amrnb_mul_shr15_epi16(n[1], n[1]);
+        n[2] = amrnb_mul_shr15_epi16(n[3], n[3]);
+        n[4] = amrnb_mul_shr15_epi16(n[3], n[1]);
+
+        skip = _mm_cmpgt_epi16(t[0], v_limit);
+        skip_lo = _mm_unpacklo_epi16(skip, skip);
+        skip_hi = _mm_unpackhi_epi16(skip, skip);
+
+        amrnb_mpy_32_16_half(c[0], c_lo[0], n[0], &s_lo, &s_hi);
+        outside = _mm_setzero_si128();
+        for (k = 1; k < 5; k++)
+        {
+            amrnb_mpy_32_16_half(c[k], c_lo[k], n[k], &h_lo, &h_hi);
+            s_lo = _mm_add_epi32(s_lo, h_lo);
+            s_hi = _mm_add_epi32(s_hi, h_hi);
+
+            /* bit 31 of s ^ (s << 1) is set when s is outside [-2^30, 2^30) */
+            outside = _mm_or_si128(outside, _mm_andnot_si128(skip_lo,
+                                    _mm_xor_si128(s_lo, _mm_slli_epi32(s_lo, 1))));
+            outside = _mm_or_si128(outside, _mm_andnot_si128(skip_hi,
+                                    _mm_xor_si128(s_hi, _mm_slli_epi32(s_hi, 1))));
+        }
+        sat = _mm_or_si128(sat, outside);
+
+        s_lo = _mm_or_si128(_mm_and_si128(skip_lo, v_max),
+                            _mm_andnot_si128(skip_lo, _mm_slli_epi32(s_lo, 1)));
+        s_hi = _mm_or_si128(_mm_and_si128(skip_hi, v_max),
+                            _mm_andnot_si128(skip_hi, _mm_slli_epi32(s_hi, 1)));
+
+        amrnb_min_index_epi32(&dist_min, &index_min, s_lo, entry_lo);
+        amrnb_min_index_epi32(&dist_min, &index_min, s_hi, entry_hi);
+
+        entry_lo = _mm_add_epi32(entry_lo, _mm_set1_epi32(8));
+        entry_hi = _mm_add_epi32(entry_hi, _mm_set1_epi32(8));
+    }
+
+    if (_mm_movemask_ps(_mm_castsi128_ps(sat)) != 0)
+    {
+        return Qua_gain_search_c(table_gain, table_len, gp_limit, gcode0,
+                                 coeff, coeff_lo, pOverflow);
+    }
+
+    return amrnb_min_index_reduce(dist_min, index_min);
+}
+#endif
+
+/* Implementation of Qua_gain_search that qua_gain_cpu_select() selected */
+static Word16 (*Qua_gain_search_impl)(const Word16 *table_gain,
+                                      Word16 table_len, Word16 gp_limit,
+                                      Word16 gcode0, Word16 coeff[],
+                                      Word16 coeff_lo[],
+                                      Flag *pOverflow) = Qua_gain_search_c;
+
+/*
+------------------------------------------------------------------------------
+ FUNCTION NAME: Qua_gain_search
+------------------------------------------------------------------------------
+ INPUT AND OUTPUT DEFINITIONS
+
+ Same as Qua_gain_search_c.
+
+------------------------------------------------------------------------------
+ FUNCTION DESCRIPTION
+
+ Runs the implementation of Qua_gain_search that qua_gain_cpu_select() selected
+ (see amrnb_cpu.h).
+
+------------------------------------------------------------------------------
+*/
+
+static Word16 Qua_gain_search(
+    const Word16 *table_gain,
+    Word16 table_len,
+    Word16 gp_limit,
+    Word16 gcode0,
+    Word16 coeff[],
+    Word16 coeff_lo[],
+    Flag   *pOverflow)
+{
+    return Qua_gain_search_impl(table_gain, table_len, gp_limit, gcode0,
+                             coeff, coeff_lo, pOverflow);
+}
+
 /*
 ------------------------------------------------------------------------------
  FUNCTION NAME:
@@ -174,22 +429,16 @@ Qua_gain(                   /* o  : index of quantization.                 */
     const Word16 *p;
     Word16 i;
     Word16 j;
-    Word16 index = 0;
+    Word16 index;
     Word16 gcode0;
     Word16 e_max;
     Word16 temp;
     Word16 exp_code;
-    Word16 g_pitch;
-    Word16 g2_pitch;
     Word16 g_code;
-    Word16 g2_code;
-    Word16 g_pit_cod;
     Word16 coeff[5];
     Word16 coeff_lo[5];
     Word16 exp_max[5];
     Word32 L_tmp;
-    Word32 L_tmp2;
-    Word32 dist_min;
     const Word16 *table_gain;
     Word16 table_len;
 
@@ -292,47 +541,8 @@ Qua_gain(                   /* o  : index of quantization.                 */
      *  gains                                                            *
      *-------------------------------------------------------------------*/
 
-    /* start with "infinite" MSE */
-    dist_min = MAX_32;
-
-    p = &table_gain[0];
-
-    for (i = 0; i < table_len; i++)
-    {
-        g_pitch = *p++;
-        g_code = *p++;                   /* this is g_fac        */
-        p++;                             /* skip log2(g_fac)     */
-        p++;                             /* skip 20*log10(g_fac) */
-
-        if (g_pitch <= gp_limit)
-        {
-            g_code = mult(g_code, gcode0, pOverflow);
-            g2_pitch = mult(g_pitch, g_pitch, pOverflow);
-            g2_code = mult(g_code, g_code, pOverflow);
-            g_pit_cod = mult(g_code, g_pitch, pOverflow);
-
-            L_tmp = Mpy_32_16(coeff[0], coeff_lo[0], g2_pitch, pOverflow);
-            L_tmp2 = Mpy_32_16(coeff[1], coeff_lo[1], g_pitch, pOverflow);
-            L_tmp = L_add(L_tmp, L_tmp2, pOverflow);
-
-            L_tmp2 = Mpy_32_16(coeff[2], coeff_lo[2], g2_code, pOverflow);
-            L_tmp = L_add(L_tmp, L_tmp2, pOverflow);
-
-            L_tmp2 =  Mpy_32_16(coeff[3], coeff_lo[3], g_code, pOverflow);
-            L_tmp = L_add(L_tmp, L_tmp2, pOverflow);
-
-            L_tmp2 = Mpy_32_16(coeff[4], coeff_lo[4], g_pit_cod, pOverflow);
-            L_tmp = L_add(L_tmp, L_tmp2, pOverflow);
-
-            /* store table index if MSE for this index is lower
-               than the minimum MSE seen so far */
-            if (L_tmp < dist_min)
-            {
-                dist_min = L_tmp;
-                index = i;
-            }
-        }
-    }
+    index = Qua_gain_search(table_gain, table_len, gp_limit, gcode0,
+                            coeff, coeff_lo, pOverflow);
 
     /*------------------------------------------------------------------*
      *  read quantized gains and new values for MA predictor memories   *
@@ -361,3 +571,37 @@ Qua_gain(                   /* o  : index of quantization.                 */
 
     return index;
 }
+
+/*
+------------------------------------------------------------------------------
+ FUNCTION NAME: qua_gain_cpu_select
+------------------------------------------------------------------------------
+ INPUT AND OUTPUT DEFINITIONS
+
+ Inputs:
+    features = AMRNB_CPU_* features the kernels may use (Word32)
+
+ Outputs:
+    Qua_gain_search_impl = the Qua_gain_search implementation for features
+
+ Returns:
+    None
+
+------------------------------------------------------------------------------
+ FUNCTION DESCRIPTION
+
+ Part of the kernel table of the encoder library, run when the features in
+ use are set (see amrnb_cpu.h).
+
+------------------------------------------------------------------------------
+*/
+void qua_gain_cpu_select(Word32 features)
+{
+    Qua_gain_search_impl = Qua_gain_search_c;
+#if defined(AMRNB_SIMD_SSE2)
+    if (features & AMRNB_CPU_SSE2)
+    {
+        Qua_gain_search_impl = Qua_gain_search_sse2;
+    }
+#endif
+}
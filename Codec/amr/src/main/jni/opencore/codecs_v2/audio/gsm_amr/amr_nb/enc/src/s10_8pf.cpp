@@ -43,6 +43,8 @@ terms listed above has been obtained from the copyright holder.
 #include "s10_8pf.h"
 #include "cnst.h"
 #include "oscl_mem.h"
+#include "basic_op_vec.h"
+#include "amrnb_cpu.h"
 
 /*----------------------------------------------------------------------------
 ; MACROS
@@ -67,7 +69,7 @@ terms listed above has been obtained from the copyright holder.
 
 /*
 ------------------------------------------------------------------------------
- FUNCTION NAME: search_10and8i40
+ FUNCTION NAME: search_10and8i40_c
 ------------------------------------------------------------------------------
  INPUT AND OUTPUT DEFINITIONS
 
@@ -479,7 +481,7 @@ void search_10and8i40 (
 /*----------------------------------------------------------------------------
 ; FUNCTION CODE
 ----------------------------------------------------------------------------*/
-void search_10and8i40(
+static void search_10and8i40_c(
     Word16 nbPulse,      /* i : nbpulses to find                       */
     Word16 step,         /* i : stepsize                               */
     Word16 nbTracks,     /* i : nbTracks                               */
@@ -914,3 +916,526 @@ void search_10and8i40(
     } /* end 1..nbTracks  loop*/
 }
 
+#if defined(AMRNB_SIMD_SSE2)
+/* one vector of the pair search: the pairs (ia, ib) for eight ib */
+static inline void search_pair_lanes(
+    __m128i r,            /* rr[ia][ib]                                  */
+    __m128i v_rrv,        /* rrv[ib]                                     */
+    __m128i coef,         /* {1 << shift_rr, 1 << shift_rrv}             */
+    __m128i v_alp1,       /* alp1[ia] in every 32-bit lane               */
+    __m128i v_ps,         /* ps_b[ib]                                    */
+    __m128i v_dn,         /* dn[ia] in every lane                        */
+    __m128i v_a,          /* index of ia in every lane                   */
+    __m128i sh_alp,       /* shift_alp                                   */
+    __m128i *v_sq,        /* sq kept per lane                            */
+    __m128i *v_alp,       /* alp kept per lane                           */
+    __m128i *v_best_a,    /* index of ia kept per lane                   */
+    __m128i *v_alp_min)   /* smallest alp seen                           */
+{
+    __m128i lo = _mm_add_epi32(v_alp1, _mm_madd_epi16(_mm_unpacklo_epi16(r, v_rrv), coef));
+    __m128i hi = _mm_add_epi32(v_alp1, _mm_madd_epi16(_mm_unpackhi_epi16(r, v_rrv), coef));
+    __m128i alp2 = _mm_packs_epi32(_mm_sra_epi32(lo, sh_alp), _mm_sra_epi32(hi, sh_alp));
+    __m128i ps2 = _mm_add_epi16(v_dn, v_ps);
+    __m128i gt;
+
+    *v_alp_min = _mm_min_epi16(*v_alp_min, alp2);
+    gt = amrnb_max_ratio_epi16(v_sq, v_alp, amrnb_mul_shr15_epi16(ps2, ps2), alp2);
+    *v_best_a = _mm_or_si128(_mm_and_si128(gt, v_a), _mm_andnot_si128(gt, *v_best_a));
+}
+
+/*
+------------------------------------------------------------------------------
+ FUNCTION NAME: search_pair_sse2
+------------------------------------------------------------------------------
+ INPUT AND OUTPUT DEFINITIONS
+
+ Inputs:
+    dn[] = correlation between target and h[] (Word16)
+    rr[][] = matrix of autocorrelation (Word16)
+    step = step size (Word16)
+    ja = first position of the first pulse of the pair (Word16)
+    jb = first position of the second pulse of the pair (Word16)
+    alp1[] = energy with the first pulse, per position of its track (Word32)
+    ps_b[] = ps + dn[], per position of the second track (Word16)
+    rrv[] = scaled rrv, per position of the second track (Word16)
+    shift_rr = left shift of rr[ia][ib] (Word16)
+    shift_rrv = left shift of rrv[] (Word16)
+    shift_alp = right shift of the energy giving alp (Word16)
+
+ Outputs:
+    p_sq, p_ps, p_alp = sq, ps and alp of the selected pair (Word16)
+    p_ia, p_ib = positions of the selected pair (Word16)
+
+ Returns:
+    1, or 0 if an energy alp of the pair search is not positive; the outputs
+    are then left unset.
+
+------------------------------------------------------------------------------
+ FUNCTION DESCRIPTION
+
+ One pair search of search_10and8i40_c, with the positions ib of the second
+ track in 16-bit lanes:
+
+    alp = (alp1[ia] + (rr[ia][ib] << shift_rr) + (rrv[ib] << shift_rrv))
+              >> shift_alp
+    sq  = mult(ps_b[ib] + dn[ia], ps_b[ib] + dn[ia])
+
+ With a shift_alp of 16 alp fits in 16 bits; the i2/i3 stage keeps its
+ energy in 32 bits, but its terms bound it to 16 bits as well. The lanes
+ therefore compare the same values as the scalar search.
+
+ With every alp positive, the sequential search keeps the first pair of
+ highest ratio sq / alp. Each lane keeps the first of highest ratio among
+ its own pairs, and the lanes are then reduced to the highest ratio,
+ taking the lowest ia and then the lowest ib on ties, which is the same
+ pair.
+
+------------------------------------------------------------------------------
+*/
+
+static Word16 search_pair_sse2(
+    Word16 dn[],          /* i : correlation between target and h[]      */
+    Word16 rr[][L_CODE],  /* i : matrix of autocorrelation               */
+    Word16 step,          /* i : stepsize                                */
+    Word16 ja,            /* i : first position of the first pulse       */
+    Word16 jb,            /* i : first position of the second pulse      */
+    Word32 alp1[],        /* i : energy with the first pulse             */
+    Word16 ps_b[],        /* i : ps + dn[] for the second pulse          */
+    Word16 rrv[],         /* i : scaled rrv for the second pulse         */
+    Word16 shift_rr,      /* i : left shift of rr[ia][ib]                */
+    Word16 shift_rrv,     /* i : left shift of rrv[]                     */
+    Word16 shift_alp,     /* i : right shift giving alp                  */
+    Word16 *p_sq,         /* o : sq of the selected pair                 */
+    Word16 *p_ps,         /* o : ps of the selected pair                 */
+    Word16 *p_alp,        /* o : alp of the selected pair                */
+    Word16 *p_ia,         /* o : position of the first pulse             */
+    Word16 *p_ib          /* o : position of the second pulse            */
+)
+{
+    /* 8 positions per track for STEP, 10 for STEP_MR102 */
+    Word16 n_b = (L_CODE - 1 - jb) / step + 1;
+    Word16 a;
+    Word16 b;
+    Word16 j;
+    Word16 lane_sq[16];
+    Word16 lane_alp[16];
+    Word16 lane_a[16];
+    Word16 best_a;
+    Word16 best_b = 0;
+    Word32 d;
+    Word16 *p;
+    __m128i coef = amrnb_pair_epi16((Word16)(1 << shift_rr), (Word16)(1 << shift_rrv));
+    __m128i sh_alp = _mm_cvtsi32_si128(shift_alp);
+    __m128i v_alp_min = _mm_set1_epi16(MAX_16);
+    __m128i v_ps0 = _mm_loadu_si128((__m128i *) ps_b);
+    __m128i v_rrv0 = _mm_loadu_si128((__m128i *) rrv);
+    __m128i v_ps1 = _mm_setzero_si128();
+    __m128i v_rrv1 = _mm_setzero_si128();
+    __m128i v_sq0 = _mm_set1_epi16(-1);
+    __m128i v_sq1 = v_sq0;
+    __m128i v_alp0 = _mm_set1_epi16(1);
+    __m128i v_alp1 = v_alp0;
+    __m128i v_best_a0 = v_sq0;
+    __m128i v_best_a1 = v_sq0;
+
+    if (n_b > 8)
+    {
+        /* positions 8 and 9 of a STEP_MR102 track */
+        v_ps1 = _mm_setr_epi16(ps_b[8], ps_b[9], 0, 0, 0, 0, 0, 0);
+        v_rrv1 = _mm_setr_epi16(rrv[8], rrv[9], 0, 0, 0, 0, 0, 0);
+    }
+
+    for (a = 0, j = ja; j < L_CODE; a++, j += step)
+    {
+        __m128i v_alp1j = _mm_set1_epi32(alp1[a]);
+        __m128i v_dn = _mm_set1_epi16(dn[j]);
+        __m128i v_a = _mm_set1_epi16(a);
+        __m128i r;
+
+        p = &rr[j][jb];
+        r = _mm_setr_epi16(p[0], p[step], p[2*step], p[3*step],
+                           p[4*step], p[5*step], p[6*step], p[7*step]);
+        search_pair_lanes(r, v_rrv0, coef, v_alp1j, v_ps0, v_dn, v_a, sh_alp,
+                          &v_sq0, &v_alp0, &v_best_a0, &v_alp_min);
+
+        if (n_b > 8)
+        {
+            r = _mm_setr_epi16(p[8*step], p[9*step], 0, 0, 0, 0, 0, 0);
+            search_pair_lanes(r, v_rrv1, coef, v_alp1j, v_ps1, v_dn, v_a, sh_alp,
+                              &v_sq1, &v_alp1, &v_best_a1, &v_alp_min);
+        }
+    }
+
+    /* the unused lanes of the second vector may also fail the test, which
+       only sends the search to the scalar code */
+    if (_mm_movemask_epi8(_mm_cmplt_epi16(v_alp_min, _mm_set1_epi16(1))) != 0)
+    {
+        return 0;
+    }
+
+    _mm_storeu_si128((__m128i *) &lane_sq[0], v_sq0);
+    _mm_storeu_si128((__m128i *) &lane_alp[0], v_alp0);
+    _mm_storeu_si128((__m128i *) &lane_a[0], v_best_a0);
+    _mm_storeu_si128((__m128i *) &lane_sq[8], v_sq1);
+    _mm_storeu_si128((__m128i *) &lane_alp[8], v_alp1);
+    _mm_storeu_si128((__m128i *) &lane_a[8], v_best_a1);
+
+    /* Default value */
+    *p_sq = -1;
+    *p_alp = 1;
+    *p_ps = 0;
+    *p_ia = ja;
+    *p_ib = jb;
+    best_a = -1;
+
+    for (b = 0; b < n_b; b++)
+    {
+        if (lane_a[b] < 0)
+        {
+            continue;
+        }
+        d = (Word32) lane_sq[b] * *p_alp - (Word32) * p_sq * lane_alp[b];
+        if (d > 0 || (d == 0 && lane_a[b] < best_a))
+        {
+            *p_sq = lane_sq[b];
+            *p_alp = lane_alp[b];
+            best_a = lane_a[b];
+            best_b = b;
+        }
+    }
+
+    if (best_a >= 0)
+    {
+        *p_ia = ja + best_a * step;
+        *p_ib = jb + best_b * step;
+        *p_ps = dn[*p_ia] + ps_b[best_b];
+    }
+
+    return 1;
+}
+
+/*
+------------------------------------------------------------------------------
+ FUNCTION NAME: search_10and8i40_sse2
+------------------------------------------------------------------------------
+ INPUT AND OUTPUT DEFINITIONS
+
+ Same as search_10and8i40_c.
+
+------------------------------------------------------------------------------
+ FUNCTION DESCRIPTION
+
+ The pair searches of search_10and8i40_c run through search_pair_sse2. If
+ one of them meets an energy that is not positive, the search stops and is
+ redone by search_10and8i40_c from the original starting positions.
+
+------------------------------------------------------------------------------
+*/
+
+static void search_10and8i40_sse2(
+    Word16 nbPulse,      /* i : nbpulses to find                       */
+    Word16 step,         /* i : stepsize                               */
+    Word16 nbTracks,     /* i : nbTracks                               */
+    Word16 dn[],         /* i : correlation between target and h[]     */
+    Word16 rr[][L_CODE], /* i : matrix of autocorrelation              */
+    Word16 ipos[],       /* i : starting position for each pulse       */
+    Word16 pos_max[],    /* i : position of maximum of dn[]            */
+    Word16 codvec[],     /* o : algebraic codebook vector              */
+    Flag   *pOverflow    /* i/o : overflow flag                        */
+)
+{
+    Word16 i0, i1, i2, i3, i4, i5, i7, i9;
+    Word16 i, j, k, n;
+    Word16 pos, ia, ib;
+    Word16 psk;
+    Word16 sq;
+    Word16 alpk, alp;
+    Word32 s;
+    Word32 alp0;
+    Word16 gsmefrFlag;
+    Word16 fast = 1;
+    Word16 *p_codvec = codvec;
+    Word16 *p_temp2;
+
+    Word32 alp1[16];
+    Word16 ps_b[16];
+    Word16 rrv[16];
+    Word16 ps;
+    Word16 ps0;
+
+    Word16 index[10];
+    Word16 ipos_in[10];
+
+    oscl_memcpy(ipos_in, ipos, nbPulse*sizeof(*ipos));
+
+    if (nbPulse == 10)
+    {
+        gsmefrFlag = 1;
+    }
+    else
+    {
+        gsmefrFlag = 0;
+    }
+
+    /* fix i0 on maximum of correlation position */
+    i0 = pos_max[ipos[0]];
+    index[0] = i0;
+
+    /* Default value */
+    psk = -1;
+    alpk = 1;
+    for (i = 0; i < nbPulse; i++)
+    {
+        *(p_codvec++) = i;
+    }
+
+    for (i = 1; i < nbTracks; i++)
+    {
+        i1 = pos_max[ipos[1]];
+        index[1] = i1;
+
+        ps0 = (Word16)((Word32) dn[i0] + dn[i1]);
+
+        alp0 = (Word32) rr[i0][i0] << 12;
+        alp0 += (Word32) rr[i1][i1] << 12;
+        alp0 += (Word32) rr[i0][i1] << 13;
+        alp0 += 0x00008000L;
+
+        /* i2 and i3: alp = (alp1 + rr[i2][i3] + (rrv << 2)) >> 3 */
+
+        for (n = 0, i3 = ipos[3]; i3 < L_CODE; n++, i3 += step)
+        {
+            p_temp2 = &rr[i3][0];
+            s  = (Word32) p_temp2[i3] >> 1;
+            s += (Word32) p_temp2[i0];
+            s += (Word32) p_temp2[i1];
+            ps_b[n] = ps0 + dn[i3];
+            rrv[n] = (Word16)((s + 2) >> 2);
+        }
+
+        s = (alp0 >> 12);
+
+        for (n = 0, j = ipos[2]; j < L_CODE; n++, j += step)
+        {
+            p_temp2 = &rr[j][0];
+            alp1[n] = ((s + (Word32) p_temp2[j]) >> 1) + p_temp2[i0] + p_temp2[i1];
+        }
+
+        fast = search_pair_sse2(dn, rr, step, ipos[2], ipos[3], alp1, ps_b, rrv,
+                                 0, 2, 3, &sq, &ps, &alp, &ia, &ib);
+        if (!fast)
+        {
+            break;
+        }
+        i2 = ia;
+        i3 = ib;
+        index[2] = ia;
+        index[3] = ib;
+
+        /* i4 and i5 */
+
+        alp0 = ((Word32) alp << 15) + 0x00008000L;
+
+        for (n = 0, i5 = ipos[5]; i5 < L_CODE; n++, i5 += step)
+        {
+            p_temp2 = &rr[i5][0];
+            s = (Word32) p_temp2[i5] >> 1;
+            s += (Word32) p_temp2[i0];
+            s += (Word32) p_temp2[i1];
+            s += (Word32) p_temp2[i2];
+            s += (Word32) p_temp2[i3];
+            ps_b[n] = ps + dn[i5];
+            rrv[n] = (Word16)((s + 2) >> 2);
+        }
+
+        for (n = 0, j = ipos[4]; j < L_CODE; n++, j += step)
+        {
+            p_temp2 = &rr[j][0];
+            alp1[n] = alp0 + ((Word32) p_temp2[j] << 11)
+                      + ((Word32) p_temp2[i0] << 12) + ((Word32) p_temp2[i1] << 12)
+                      + ((Word32) p_temp2[i2] << 12) + ((Word32) p_temp2[i3] << 12);
+        }
+
+        fast = search_pair_sse2(dn, rr, step, ipos[4], ipos[5], alp1, ps_b, rrv,
+                                 12, 14, 16, &sq, &ps, &alp, &ia, &ib);
+        if (!fast)
+        {
+            break;
+        }
+        i4 = ia;
+        i5 = ib;
+        index[4] = ia;
+        index[5] = ib;
+
+        /* i6 and i7 */
+
+        alp0 = ((Word32) alp << 15) + 0x00008000L;
+
+        for (n = 0, i7 = ipos[7]; i7 < L_CODE; n++, i7 += step)
+        {
+            s = (Word32) rr[i7][i7] >> 1;
+            s += (Word32) rr[i0][i7];
+            s += (Word32) rr[i1][i7];
+            s += (Word32) rr[i2][i7];
+            s += (Word32) rr[i3][i7];
+            s += (Word32) rr[i4][i7];
+            s += (Word32) rr[i5][i7];
+            ps_b[n] = ps + dn[i7];
+            rrv[n] = (Word16)((s + 4) >> 3);
+        }
+
+        for (n = 0, j = ipos[6]; j < L_CODE; n++, j += step)
+        {
+            p_temp2 = &rr[j][0];
+            alp1[n] = alp0 + ((Word32) p_temp2[j] << 10)
+                      + ((Word32) p_temp2[i0] << 11) + ((Word32) p_temp2[i1] << 11)
+                      + ((Word32) p_temp2[i2] << 11) + ((Word32) p_temp2[i3] << 11)
+                      + ((Word32) p_temp2[i4] << 11) + ((Word32) p_temp2[i5] << 11);
+        }
+
+        fast = search_pair_sse2(dn, rr, step, ipos[6], ipos[7], alp1, ps_b, rrv,
+                                 11, 14, 16, &sq, &ps, &alp, &ia, &ib);
+        if (!fast)
+        {
+            break;
+        }
+        index[6] = ia;
+        index[7] = ib;
+
+        if (gsmefrFlag != 0)
+        {
+            /* i8 and i9 */
+
+            alp0 = ((Word32) alp << 15) + 0x00008000L;
+
+            for (n = 0, i9 = ipos[9]; i9 < L_CODE; n++, i9 += step)
+            {
+                s = (Word32) rr[i9][i9] >> 1;
+                for (k = 0; k < 8; k++)
+                {
+                    s += (Word32) rr[index[k]][i9];
+                }
+                ps_b[n] = ps + dn[i9];
+                rrv[n] = (Word16)((s + 4) >> 3);
+            }
+
+            for (n = 0, j = ipos[8]; j < L_CODE; n++, j += step)
+            {
+                alp1[n] = alp0 + ((Word32) rr[j][j] << 9);
+                for (k = 0; k < 8; k++)
+                {
+                    alp1[n] += (Word32) rr[index[k]][j] << 10;
+                }
+            }
+
+            fast = search_pair_sse2(dn, rr, step, ipos[8], ipos[9], alp1, ps_b, rrv,
+                                     10, 13, 16, &sq, &ps, &alp, &ia, &ib);
+            if (!fast)
+            {
+                break;
+            }
+            index[8] = ia;
+            index[9] = ib;
+        }
+
+        /* test and memorise if this combination is better than the last one */
+
+        if (((Word32) alpk * sq) > ((Word32) psk * alp))
+        {
+            psk = sq;
+            alpk = alp;
+            oscl_memcpy(codvec, index, nbPulse*sizeof(*index));
+        }
+
+        /* Cyclic permutation of i1,i2,i3,i4,i5,i6,i7,(i8 and i9) */
+
+        pos = ipos[1];
+        for (j = 1, k = 2; k < nbPulse; j++, k++)
+        {
+            ipos[j] = ipos[k];
+        }
+        ipos[nbPulse-1] = pos;
+    }
+
+    if (!fast)
+    {
+        oscl_memcpy(ipos, ipos_in, nbPulse*sizeof(*ipos));
+        search_10and8i40_c(nbPulse, step, nbTracks, dn, rr, ipos, pos_max,
+                           codvec, pOverflow);
+    }
+}
+#endif
+
+/* Implementation of search_10and8i40 that s10_8pf_cpu_select() selected */
+static void (*search_10and8i40_impl)(Word16 nbPulse, Word16 step,
+                                     Word16 nbTracks, Word16 dn[],
+                                     Word16 rr[][L_CODE], Word16 ipos[],
+                                     Word16 pos_max[], Word16 codvec[],
+                                     Flag *pOverflow) = search_10and8i40_c;
+
+/*
+------------------------------------------------------------------------------
+ FUNCTION NAME: search_10and8i40
+------------------------------------------------------------------------------
+ INPUT AND OUTPUT DEFINITIONS
+
+ Same as search_10and8i40_c.
+
+------------------------------------------------------------------------------
+ FUNCTION DESCRIPTION
+
+ Runs the implementation of search_10and8i40 that s10_8pf_cpu_select() selected
+ (see amrnb_cpu.h).
+
+------------------------------------------------------------------------------
+*/
+
+void search_10and8i40(
+    Word16 nbPulse,      /* i : nbpulses to find                       */
+    Word16 step,         /* i : stepsize                               */
+    Word16 nbTracks,     /* i : nbTracks                               */
+    Word16 dn[],         /* i : correlation between target and h[]     */
+    Word16 rr[][L_CODE], /* i : matrix of autocorrelation              */
+    Word16 ipos[],       /* i : starting position for each pulse       */
+    Word16 pos_max[],    /* i : position of maximum of dn[]            */
+    Word16 codvec[],     /* o : algebraic codebook vector              */
+    Flag   *pOverflow    /* i/o : overflow flag                        */
+)
+{
+    search_10and8i40_impl(nbPulse, step, nbTracks, dn, rr, ipos, pos_max,
+                       codvec, pOverflow);
+}
+
+/*
+------------------------------------------------------------------------------
+ FUNCTION NAME: s10_8pf_cpu_select
+------------------------------------------------------------------------------
+ INPUT AND OUTPUT DEFINITIONS
+
+ Inputs:
+    features = AMRNB_CPU_* features the kernels may use (Word32)
+
+ Outputs:
+    search_10and8i40_impl = the search_10and8i40 implementation for features
+
+ Returns:
+    None
+
+------------------------------------------------------------------------------
+ FUNCTION DESCRIPTION
+
+ Part of the kernel table of the encoder library, run when the features in
+ use are set (see amrnb_cpu.h).
+
+------------------------------------------------------------------------------
+*/
+void s10_8pf_cpu_select(Word32 features)
+{
+    search_10and8i40_impl = search_10and8i40_c;
+#if defined(AMRNB_SIMD_SSE2)
+    if (features & AMRNB_CPU_SSE2)
+    {
+        search_10and8i40_impl = search_10and8i40_sse2;
+    }
+#endif
+}
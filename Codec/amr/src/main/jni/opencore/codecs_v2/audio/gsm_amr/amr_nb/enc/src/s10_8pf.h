@@ -99,6 +99,10 @@ extern "C"
         Word16 codvec[],      /* o : algebraic codebook vector              */
         Flag   *pOverflow     /* i/o : Overflow flag                        */
     );
+    /* Selects the implementation of search_10and8i40 for the AMRNB_CPU_*
+       features (see amrnb_cpu.h) */
+    void s10_8pf_cpu_select(Word32 features);
+
     /*----------------------------------------------------------------------------
     ; END
     ----------------------------------------------------------------------------*/
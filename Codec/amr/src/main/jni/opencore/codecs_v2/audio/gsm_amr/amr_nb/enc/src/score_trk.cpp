@@ -0,0 +1,364 @@
+/* ------------------------------------------------------------------
+ * Copyright (C) 1998-2009 PacketVideo
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied.
+ * See the License for the specific language governing permissions
+ * and limitations under the License.
+ * -------------------------------------------------------------------
+ */
+/****************************************************************************************
+Portions of this file are derived from the following 3GPP standard:
+
+    3GPP TS 26.073
+    ANSI-C code for the Adaptive Multi-Rate (AMR) speech codec
+    Available from http://www.3gpp.org
+
+(C) 2004, 3GPP Organizational Partners (ARIB, ATIS, CCSA, ETSI, TTA, TTC)
+Permission to distribute, modify and use this file under the standard license
+terms listed above has been obtained from the copyright holder.
+****************************************************************************************/
+/*
+------------------------------------------------------------------------------
+
+
+
+ Filename: score_trk.cpp
+ Funtions: score_track
+
+------------------------------------------------------------------------------
+ MODULE DESCRIPTION
+
+ This module contains the function score_track, which evaluates every
+ position of one track as the next pulse of the algebraic codebook
+ searches of c2_9pf, c2_11pf, c3_14pf and c4_17pf. The searches keep
+ their own comparison of the candidates, so the pulses they select are
+ unchanged.
+
+------------------------------------------------------------------------------
+*/
+
+/*----------------------------------------------------------------------------
+; INCLUDES
+----------------------------------------------------------------------------*/
+#include "score_trk.h"
+#include "basic_op.h"
+#include "basic_op_vec.h"
+#include "amrnb_cpu.h"
+
+/*----------------------------------------------------------------------------
+; MACROS
+; Define module specific macros here
+----------------------------------------------------------------------------*/
+
+/*----------------------------------------------------------------------------
+; DEFINES
+; Include all pre-processor statements here. Include conditional
+; compile variables also.
+----------------------------------------------------------------------------*/
+
+/*----------------------------------------------------------------------------
+; LOCAL FUNCTION DEFINITIONS
+; Function Prototype declaration
+----------------------------------------------------------------------------*/
+
+/*----------------------------------------------------------------------------
+; LOCAL VARIABLE DEFINITIONS
+; Variable declaration - defined here and used outside this module
+----------------------------------------------------------------------------*/
+
+/*
+------------------------------------------------------------------------------
+ FUNCTION NAME: score_track_c
+------------------------------------------------------------------------------
+ INPUT AND OUTPUT DEFINITIONS
+
+ Inputs:
+    ps0 = correlation of the pulses already placed (Word16)
+    alp0 = energy of the pulses already placed (Word32)
+    dn[] = correlation between target and h[] (Word16)
+    rr[][] = matrix of autocorrelation (Word16)
+    start = first position of the track (Word16)
+    ix[] = positions of the pulses already placed (Word16)
+    n_ix = number of positions in ix[] (Word16)
+    shift_rr = left shift applied to rr[i][i] (Word16)
+    shift_ix = left shift applied to rr[ix[k]][i] (Word16)
+    pOverflow = pointer to overflow flag, or NULL (Flag)
+
+ Outputs:
+    ps1[] = ps0 + dn[i] for the NB_TRACK_POS positions i (Word16)
+    sq1[] = mult(ps1, ps1) for the same positions (Word16)
+    alp_16[] = pv_round(alp1) for the same positions (Word16)
+    pOverflow -> 1 if one of the ps1 saturates
+
+ Returns:
+    None
+
+ Global Variables Used:
+    None
+
+ Local Variables Needed:
+    None
+
+------------------------------------------------------------------------------
+ FUNCTION DESCRIPTION
+
+ For the positions i = start, start + STEP, ... of a track, computes the
+ terms with which the codebook searches compare the candidate pulse i:
+
+    ps1    = ps0 + dn[i]
+    sq1    = mult(ps1, ps1)
+    alp1   = alp0 + (rr[i][i] << shift_rr) + sum_k (rr[ix[k]][i] << shift_ix)
+    alp_16 = pv_round(alp1)
+
+ The 32-bit sums wrap as in the inline searches they replace. With
+ pOverflow NULL, ps1 wraps as well; otherwise it is add_16().
+
+------------------------------------------------------------------------------
+ REQUIREMENTS
+
+ None
+
+------------------------------------------------------------------------------
+ REFERENCES
+
+ c4_17pf.c, UMTS GSM AMR speech codec, R99 - Version 3.2.0, March 2, 2001
+
+------------------------------------------------------------------------------
+ PSEUDO-CODE
+
+------------------------------------------------------------------------------
+ CAUTION [optional]
+ [State any special notes, constraints or cautions for users of this function]
+
+------------------------------------------------------------------------------
+*/
+
+void score_track_c(
+    Word16 ps0,          /* i : correlation of the pulses already placed  */
+    Word32 alp0,         /* i : energy of the pulses already placed       */
+    Word16 dn[],         /* i : correlation between target and h[]        */
+    Word16 rr[][L_CODE], /* i : matrix of autocorrelation                 */
+    Word16 start,        /* i : first position of the track               */
+    Word16 ix[],         /* i : positions of the pulses already placed    */
+    Word16 n_ix,         /* i : number of them                            */
+    Word16 shift_rr,     /* i : left shift of rr[i][i]                    */
+    Word16 shift_ix,     /* i : left shift of rr[ix[k]][i]                */
+    Word16 ps1[],        /* o : correlation per position                  */
+    Word16 sq1[],        /* o : squared correlation per position          */
+    Word16 alp_16[],     /* o : rounded energy per position               */
+    Flag   *pOverflow    /* i/o : if not NULL, ps1 saturates and sets it  */
+)
+{
+    Word16 i;
+    Word16 k;
+    Word16 m;
+    Word32 alp1;
+
+    for (m = 0, i = start; i < L_CODE; m++, i += STEP)
+    {
+        if (pOverflow != NULL)
+        {
+            ps1[m] = add_16(ps0, dn[i], pOverflow);
+        }
+        else
+        {
+            ps1[m] = ps0 + dn[i];
+        }
+
+        alp1 = alp0 + ((Word32) rr[i][i] << shift_rr);
+
+        for (k = 0; k < n_ix; k++)
+        {
+            alp1 += (Word32) rr[ix[k]][i] << shift_ix;
+        }
+
+        sq1[m] = (Word16)(((Word32) ps1[m] * ps1[m]) >> 15);
+
+        alp_16[m] = (Word16)((alp1 + (Word32) 0x00008000L) >> 16);
+    }
+
+    return;
+}
+
+#if defined(AMRNB_SIMD_SSE2)
+/* p[start], p[start + STEP], ..., one track of the row p */
+static inline __m128i track_load(const Word16 *p, Word16 start)
+{
+    p += start;
+    return _mm_setr_epi16(p[0], p[STEP], p[2*STEP], p[3*STEP],
+                          p[4*STEP], p[5*STEP], p[6*STEP], p[7*STEP]);
+}
+
+/*
+------------------------------------------------------------------------------
+ FUNCTION NAME: score_track_sse2
+------------------------------------------------------------------------------
+ INPUT AND OUTPUT DEFINITIONS
+
+ Same as score_track_c.
+
+------------------------------------------------------------------------------
+ FUNCTION DESCRIPTION
+
+ Evaluates the eight positions of the track at once. The rows rr[ix[k]]
+ are summed before the shift, which gives the same wrapped 32-bit energy.
+ A saturating ps1 sets pOverflow as add_16 would.
+
+------------------------------------------------------------------------------
+*/
+
+void score_track_sse2(
+    Word16 ps0,          /* i : correlation of the pulses already placed  */
+    Word32 alp0,         /* i : energy of the pulses already placed       */
+    Word16 dn[],         /* i : correlation between target and h[]        */
+    Word16 rr[][L_CODE], /* i : matrix of autocorrelation                 */
+    Word16 start,        /* i : first position of the track               */
+    Word16 ix[],         /* i : positions of the pulses already placed    */
+    Word16 n_ix,         /* i : number of them                            */
+    Word16 shift_rr,     /* i : left shift of rr[i][i]                    */
+    Word16 shift_ix,     /* i : left shift of rr[ix[k]][i]                */
+    Word16 ps1[],        /* o : correlation per position                  */
+    Word16 sq1[],        /* o : squared correlation per position          */
+    Word16 alp_16[],     /* o : rounded energy per position               */
+    Flag   *pOverflow    /* i/o : if not NULL, ps1 saturates and sets it  */
+)
+{
+    Word16 k;
+    const Word16 *p = &rr[start][start];
+    __m128i v_ps0 = _mm_set1_epi16(ps0);
+    __m128i v_dn = track_load(dn, start);
+    __m128i v_rr = _mm_setr_epi16(p[0], p[STEP*(L_CODE + 1)], p[2*STEP*(L_CODE + 1)],
+                                  p[3*STEP*(L_CODE + 1)], p[4*STEP*(L_CODE + 1)],
+                                  p[5*STEP*(L_CODE + 1)], p[6*STEP*(L_CODE + 1)],
+                                  p[7*STEP*(L_CODE + 1)]);
+    __m128i v_alp0 = _mm_set1_epi32(alp0 + (Word32) 0x00008000L);
+    __m128i ix_lo = _mm_setzero_si128();
+    __m128i ix_hi = _mm_setzero_si128();
+    __m128i lo;
+    __m128i hi;
+    __m128i v_ps1;
+    __m128i v_wrap;
+
+    for (k = 0; k < n_ix; k++)
+    {
+        __m128i r = track_load(rr[ix[k]], start);
+
+        ix_lo = _mm_add_epi32(ix_lo, _mm_srai_epi32(_mm_unpacklo_epi16(r, r), 16));
+        ix_hi = _mm_add_epi32(ix_hi, _mm_srai_epi32(_mm_unpackhi_epi16(r, r), 16));
+    }
+
+    lo = _mm_add_epi32(v_alp0, _mm_sll_epi32(_mm_srai_epi32(_mm_unpacklo_epi16(v_rr, v_rr), 16),
+                       _mm_cvtsi32_si128(shift_rr)));
+    hi = _mm_add_epi32(v_alp0, _mm_sll_epi32(_mm_srai_epi32(_mm_unpackhi_epi16(v_rr, v_rr), 16),
+                       _mm_cvtsi32_si128(shift_rr)));
+    lo = _mm_add_epi32(lo, _mm_sll_epi32(ix_lo, _mm_cvtsi32_si128(shift_ix)));
+    hi = _mm_add_epi32(hi, _mm_sll_epi32(ix_hi, _mm_cvtsi32_si128(shift_ix)));
+    _mm_storeu_si128((__m128i *) alp_16,
+                     amrnb_pack_trunc_epi32(_mm_srai_epi32(lo, 16), _mm_srai_epi32(hi, 16)));
+
+    v_wrap = _mm_add_epi16(v_ps0, v_dn);
+    if (pOverflow != NULL)
+    {
+        v_ps1 = _mm_adds_epi16(v_ps0, v_dn);
+        if (_mm_movemask_epi8(_mm_cmpeq_epi16(v_ps1, v_wrap)) != 0xffff)
+        {
+            *pOverflow = 1;
+        }
+    }
+    else
+    {
+        v_ps1 = v_wrap;
+    }
+    _mm_storeu_si128((__m128i *) ps1, v_ps1);
+    _mm_storeu_si128((__m128i *) sq1, amrnb_mul_shr15_epi16(v_ps1, v_ps1));
+
+    return;
+}
+#endif
+
+/* Implementation of score_track that score_trk_cpu_select() selected */
+static void (*score_track_impl)(Word16 ps0, Word32 alp0, Word16 dn[],
+                                Word16 rr[][L_CODE], Word16 start, Word16 ix[],
+                                Word16 n_ix, Word16 shift_rr, Word16 shift_ix,
+                                Word16 ps1[], Word16 sq1[], Word16 alp_16[],
+                                Flag *pOverflow) = score_track_c;
+
+/*
+------------------------------------------------------------------------------
+ FUNCTION NAME: score_track
+------------------------------------------------------------------------------
+ INPUT AND OUTPUT DEFINITIONS
+
+ Same as score_track_c.
+
+------------------------------------------------------------------------------
+ FUNCTION DESCRIPTION
+
+ Runs the implementation of score_track that score_trk_cpu_select() selected
+ (see amrnb_cpu.h).
+
+------------------------------------------------------------------------------
+*/
+
+void score_track(
+    Word16 ps0,          /* i : correlation of the pulses already placed  */
+    Word32 alp0,         /* i : energy of the pulses already placed       */
+    Word16 dn[],         /* i : correlation between target and h[]        */
+    Word16 rr[][L_CODE], /* i : matrix of autocorrelation                 */
+    Word16 start,        /* i : first position of the track               */
+    Word16 ix[],         /* i : positions of the pulses already placed    */
+    Word16 n_ix,         /* i : number of them                            */
+    Word16 shift_rr,     /* i : left shift of rr[i][i]                    */
+    Word16 shift_ix,     /* i : left shift of rr[ix[k]][i]                */
+    Word16 ps1[],        /* o : correlation per position                  */
+    Word16 sq1[],        /* o : squared correlation per position          */
+    Word16 alp_16[],     /* o : rounded energy per position               */
+    Flag   *pOverflow    /* i/o : if not NULL, ps1 saturates and sets it  */
+)
+{
+    score_track_impl(ps0, alp0, dn, rr, start, ix, n_ix, shift_rr, shift_ix,
+                  ps1, sq1, alp_16, pOverflow);
+}
+
+/*
+------------------------------------------------------------------------------
+ FUNCTION NAME: score_trk_cpu_select
+------------------------------------------------------------------------------
+ INPUT AND OUTPUT DEFINITIONS
+
+ Inputs:
+    features = AMRNB_CPU_* features the kernels may use (Word32)
+
+ Outputs:
+    score_track_impl = the score_track implementation for features
+
+ Returns:
+    None
+
+------------------------------------------------------------------------------
+ FUNCTION DESCRIPTION
+
+ Part of the kernel table of the encoder library, run when the features in
+ use are set (see amrnb_cpu.h).
+
+------------------------------------------------------------------------------
+*/
+void score_trk_cpu_select(Word32 features)
+{
+    score_track_impl = score_track_c;
+#if defined(AMRNB_SIMD_SSE2)
+    if (features & AMRNB_CPU_SSE2)
+    {
+        score_track_impl = score_track_sse2;
+    }
+#endif
+}
@@ -0,0 +1,131 @@
+/* ------------------------------------------------------------------
+ * Copyright (C) 1998-2009 PacketVideo
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied.
+ * See the License for the specific language governing permissions
+ * and limitations under the License.
+ * -------------------------------------------------------------------
+ */
+/****************************************************************************************
+Portions of this file are derived from the following 3GPP standard:
+
+    3GPP TS 26.073
+    ANSI-C code for the Adaptive Multi-Rate (AMR) speech codec
+    Available from http://www.3gpp.org
+
+(C) 2004, 3GPP Organizational Partners (ARIB, ATIS, CCSA, ETSI, TTA, TTC)
+Permission to distribute, modify and use this file under the standard license
+terms listed above has been obtained from the copyright holder.
+****************************************************************************************/
+/*
+------------------------------------------------------------------------------
+
+
+
+ Filename: score_trk.h
+
+------------------------------------------------------------------------------
+ INCLUDE DESCRIPTION
+
+ This file contains all the constant definitions and prototype definitions
+ needed by the score_track() function.
+
+------------------------------------------------------------------------------
+*/
+
+#ifndef SCORE_TRK_H
+#define SCORE_TRK_H "@(#)$Id $"
+
+/*----------------------------------------------------------------------------
+; INCLUDES
+----------------------------------------------------------------------------*/
+#include    "typedef.h"
+#include    "cnst.h"
+#include    "amrnb_simd.h"
+
+/*--------------------------------------------------------------------------*/
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+    /*----------------------------------------------------------------------------
+    ; MACROS
+    ; Define module specific macros here
+    ----------------------------------------------------------------------------*/
+
+    /*----------------------------------------------------------------------------
+    ; DEFINES
+    ; Include all pre-processor statements here.
+    ----------------------------------------------------------------------------*/
+#define NB_TRACK_POS  (L_CODE / STEP)  /* positions in one track           */
+
+    /*----------------------------------------------------------------------------
+    ; EXTERNAL VARIABLES REFERENCES
+    ; Declare variables used in this module but defined elsewhere
+    ----------------------------------------------------------------------------*/
+
+    /*----------------------------------------------------------------------------
+    ; SIMPLE TYPEDEF'S
+    ----------------------------------------------------------------------------*/
+
+    /*----------------------------------------------------------------------------
+    ; ENUMERATED TYPEDEF'S
+    ----------------------------------------------------------------------------*/
+
+    /*----------------------------------------------------------------------------
+    ; STRUCTURES TYPEDEF'S
+    ----------------------------------------------------------------------------*/
+
+    /*----------------------------------------------------------------------------
+    ; GLOBAL FUNCTION DEFINITIONS
+    ; Function Prototype declaration
+    ----------------------------------------------------------------------------*/
+    void score_track(
+        Word16 ps0,          /* i : correlation of the pulses already placed  */
+        Word32 alp0,         /* i : energy of the pulses already placed       */
+        Word16 dn[],         /* i : correlation between target and h[]        */
+        Word16 rr[][L_CODE], /* i : matrix of autocorrelation                 */
+        Word16 start,        /* i : first position of the track               */
+        Word16 ix[],         /* i : positions of the pulses already placed    */
+        Word16 n_ix,         /* i : number of them                            */
+        Word16 shift_rr,     /* i : left shift of rr[i][i]                    */
+        Word16 shift_ix,     /* i : left shift of rr[ix[k]][i]                */
+        Word16 ps1[],        /* o : correlation per position                  */
+        Word16 sq1[],        /* o : squared correlation per position          */
+        Word16 alp_16[],     /* o : rounded energy per position               */
+        Flag   *pOverflow    /* i/o : if not NULL, ps1 saturates and sets it  */
+    );
+
+    /* Implementations selected by score_track() */
+    void score_track_c(Word16 ps0, Word32 alp0, Word16 dn[], Word16 rr[][L_CODE],
+                       Word16 start, Word16 ix[], Word16 n_ix, Word16 shift_rr,
+                       Word16 shift_ix, Word16 ps1[], Word16 sq1[], Word16 alp_16[],
+                       Flag *pOverflow);
+#if defined(AMRNB_SIMD_SSE2)
+    void score_track_sse2(Word16 ps0, Word32 alp0, Word16 dn[], Word16 rr[][L_CODE],
+                          Word16 start, Word16 ix[], Word16 n_ix, Word16 shift_rr,
+                          Word16 shift_ix, Word16 ps1[], Word16 sq1[], Word16 alp_16[],
+                          Flag *pOverflow);
+#endif
+    /* Selects the implementation of score_track for the AMRNB_CPU_* features
+       (see amrnb_cpu.h) */
+    void score_trk_cpu_select(Word32 features);
+
+    /*----------------------------------------------------------------------------
+    ; END
+    ----------------------------------------------------------------------------*/
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SCORE_TRK_H */
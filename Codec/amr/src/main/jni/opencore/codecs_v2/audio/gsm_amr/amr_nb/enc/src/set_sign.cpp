@@ -53,8 +53,10 @@ terms listed above has been obtained from the copyright holder.
 ----------------------------------------------------------------------------*/
 #include "set_sign.h"
 #include "basic_op.h"
+#include "basic_op_vec.h"
 #include "inv_sqrt.h"
 #include "cnst.h"
+#include "amrnb_cpu.h"
 
 
 /*----------------------------------------------------------------------------
@@ -73,6 +75,9 @@ terms listed above has been obtained from the copyright holder.
 ; LOCAL FUNCTION DEFINITIONS
 ; Function Prototype declaration
 ----------------------------------------------------------------------------*/
+static void set_sign_tracks(Word16 dn2[], Word16 n);
+static void set_sign12k2_tracks(Word16 en[], Word16 pos_max[], Word16 nb_track,
+                                Word16 ipos[], Word16 step);
 
 /*----------------------------------------------------------------------------
 ; LOCAL VARIABLE DEFINITIONS
@@ -188,15 +193,14 @@ void set_sign(Word16 dn[],    i/o : correlation between target and h[]
 ------------------------------------------------------------------------------
 */
 
-void set_sign(Word16 dn[],   /* i/o : correlation between target and h[]    */
-              Word16 sign[], /* o   : sign of dn[]                          */
-              Word16 dn2[],  /* o   : maximum of correlation in each track. */
-              Word16 n       /* i   : # of maximum correlations in dn2[]    */
-             )
+void set_sign_c(Word16 dn[],   /* i/o : correlation between target and h[]    */
+                Word16 sign[], /* o   : sign of dn[]                          */
+                Word16 dn2[],  /* o   : maximum of correlation in each track. */
+                Word16 n       /* i   : # of maximum correlations in dn2[]    */
+               )
 {
-    register Word16 i, j, k;
-    Word16 val, min;
-    Word16 pos = 0; /* initialization only needed to keep gcc silent */
+    register Word16 i;
+    Word16 val;
 
     /* set sign according to dn[] */
     for (i = L_CODE - 1; i >= 0; i--)
@@ -217,7 +221,50 @@ void set_sign(Word16 dn[],   /* i/o : correlation between target and h[]    */
         dn2[i] = val;
     }
 
-    /* keep 8-n maximum positions/8 of each track and store it in dn2[] */
+    set_sign_tracks(dn2, n);
+
+    return;
+}
+
+/* keep 8-n maximum positions/8 of each track and store it in dn2[] */
+static void set_sign_tracks(Word16 dn2[], Word16 n)
+{
+    register Word16 i, j, k;
+    Word16 min;
+    Word16 max;
+    Word16 pos = 0; /* initialization only needed to keep gcc silent */
+    Word16 keep[L_CODE / STEP];
+
+    if (n < 8 - n)
+    {
+        /* Fewer scans to pick the n survivors than to drop the 8-n others.
+         * Ties go to the higher position, which is the one the removal
+         * below would leave. dn2[] is never negative on entry.
+         */
+        for (i = 0; i < NB_TRACK; i++)
+        {
+            for (j = i, k = 0; j < L_CODE; j += STEP, k++)
+            {
+                keep[k] = dn2[j];
+                dn2[j] = -1;
+            }
+            for (k = 0; k < n; k++)
+            {
+                max = -1;
+                for (j = 0; j < L_CODE / STEP; j++)
+                {
+                    if (keep[j] >= max)
+                    {
+                        max = keep[j];
+                        pos = j;
+                    }
+                }
+                dn2[i + pos * STEP] = max;
+                keep[pos] = -2;
+            }
+        }
+        return;
+    }
 
     for (i = 0; i < NB_TRACK; i++)
     {
@@ -413,7 +460,7 @@ void set_sign12k2 (
 ------------------------------------------------------------------------------
 */
 
-void set_sign12k2(
+void set_sign12k2_c(
     Word16 dn[],        /* i/o : correlation between target and h[]         */
     Word16 cn[],        /* i   : residual after long term prediction        */
     Word16 sign[],      /* o   : sign of d[n]                               */
@@ -424,14 +471,11 @@ void set_sign12k2(
     Flag   *pOverflow   /* i/o: overflow flag                               */
 )
 {
-    Word16 i, j;
+    Word16 i;
     Word16 val;
     Word16 cor;
     Word16 k_cn;
     Word16 k_dn;
-    Word16 max;
-    Word16 max_of_all;
-    Word16 pos = 0; /* initialization only needed to keep gcc silent */
     Word16 en[L_CODE];                  /* correlation vector */
     Word32 s;
     Word32 t;
@@ -491,6 +535,22 @@ void set_sign12k2(
         *(p_en--) = cor;
     }
 
+    set_sign12k2_tracks(en, pos_max, nb_track, ipos, step);
+
+    return;
+}
+
+/* position of the maximum of en[] in each track, and the starting position
+   of each pulse */
+static void set_sign12k2_tracks(Word16 en[], Word16 pos_max[], Word16 nb_track,
+                                Word16 ipos[], Word16 step)
+{
+    Word16 i, j;
+    Word16 cor;
+    Word16 max;
+    Word16 max_of_all;
+    Word16 pos = 0; /* initialization only needed to keep gcc silent */
+
     max_of_all = -1;
     for (i = 0; i < nb_track; i++)
     {
@@ -537,3 +597,280 @@ void set_sign12k2(
     return;
 }
 
+#if defined(AMRNB_SIMD_SSE2)
+/*
+------------------------------------------------------------------------------
+ FUNCTION NAME: set_sign_sse2
+------------------------------------------------------------------------------
+ INPUT AND OUTPUT DEFINITIONS
+
+ Same as set_sign_c.
+
+------------------------------------------------------------------------------
+ FUNCTION DESCRIPTION
+
+ Sets the signs and absolute values eight at a time; negate() is the
+ saturating 0 - val. The track search is shared with set_sign_c.
+
+------------------------------------------------------------------------------
+*/
+
+void set_sign_sse2(Word16 dn[],   /* i/o : correlation between target and h[]    */
+                   Word16 sign[], /* o   : sign of dn[]                          */
+                   Word16 dn2[],  /* o   : maximum of correlation in each track. */
+                   Word16 n       /* i   : # of maximum correlations in dn2[]    */
+                  )
+{
+    Word16 i;
+
+    for (i = 0; i < L_CODE; i += 8)
+    {
+        __m128i val = _mm_loadu_si128((__m128i *) &dn[i]);
+        __m128i neg = _mm_cmplt_epi16(val, _mm_setzero_si128());
+
+        /* 32767 + 2 wraps to -32767 */
+        _mm_storeu_si128((__m128i *) &sign[i],
+                         _mm_add_epi16(_mm_set1_epi16(32767),
+                                       _mm_and_si128(neg, _mm_set1_epi16(2))));
+        val = amrnb_abs_sat_epi16(val);
+        _mm_storeu_si128((__m128i *) &dn[i], val);
+        _mm_storeu_si128((__m128i *) &dn2[i], val);
+    }
+
+    set_sign_tracks(dn2, n);
+
+    return;
+}
+
+/*
+------------------------------------------------------------------------------
+ FUNCTION NAME: set_sign12k2_sse2
+------------------------------------------------------------------------------
+ INPUT AND OUTPUT DEFINITIONS
+
+ Same as set_sign12k2_c.
+
+------------------------------------------------------------------------------
+ FUNCTION DESCRIPTION
+
+ The energies are vector dot products (the cn[] one through amrnb_L_mac_n,
+ which keeps the L_mac saturation). The combined correlation
+ pv_round(L_shl(L_mac(k_cn * cn * 2, k_dn, dn), 10)) is evaluated four
+ lanes at a time with the saturation rules of L_mac (including its
+ overflow test against the unshifted product), L_shl and pv_round, and the
+ signs are then applied eight lanes at a time.
+
+------------------------------------------------------------------------------
+*/
+
+void set_sign12k2_sse2(
+    Word16 dn[],        /* i/o : correlation between target and h[]         */
+    Word16 cn[],        /* i   : residual after long term prediction        */
+    Word16 sign[],      /* o   : sign of d[n]                               */
+    Word16 pos_max[],   /* o   : position of maximum correlation            */
+    Word16 nb_track,    /* i   : number of tracks tracks                    */
+    Word16 ipos[],      /* o   : starting position for each pulse           */
+    Word16 step,        /* i   : the step size in the tracks                */
+    Flag   *pOverflow   /* i/o: overflow flag                               */
+)
+{
+    Word16 i;
+    Word16 k_cn;
+    Word16 k_dn;
+    Word16 en[L_CODE];                  /* correlation vector */
+    Word32 s;
+    Word32 t;
+    __m128i vk;
+    __m128i ovf = _mm_setzero_si128();
+
+    /* calculate energy for normalization of cn[] and dn[] */
+
+    s = amrnb_L_mac_n(256, cn, cn, L_CODE, pOverflow);
+    t = (Word32)(256 + ((UWord32) amrnb_dot_16x16(dn, dn, L_CODE) << 1));
+
+    s = Inv_sqrt(s, pOverflow);
+    k_cn = (Word16)((L_shl(s, 5, pOverflow)) >> 16);
+
+    t = Inv_sqrt(t, pOverflow);
+    k_dn = (Word16)(t >> 11);
+
+    /* {k_cn, k_dn} pairs against interleaved {cn[i], dn[i]} */
+    vk = _mm_set1_epi32((Word32)((UWord16) k_cn) | ((Word32) k_dn << 16));
+
+    for (i = 0; i < L_CODE; i += 8)
+    {
+        __m128i vcn = _mm_loadu_si128((__m128i *) &cn[i]);
+        __m128i vdn = _mm_loadu_si128((__m128i *) &dn[i]);
+        __m128i cor[2];
+        __m128i neg;
+        Word16 h;
+
+        for (h = 0; h < 2; h++)
+        {
+            __m128i c = h ? _mm_unpackhi_epi16(vcn, _mm_setzero_si128())
+                        : _mm_unpacklo_epi16(vcn, _mm_setzero_si128());
+            __m128i d = h ? _mm_unpackhi_epi16(_mm_setzero_si128(), vdn)
+                        : _mm_unpacklo_epi16(_mm_setzero_si128(), vdn);
+            __m128i L_temp;
+            __m128i p;
+            __m128i sum;
+            __m128i sat;
+            __m128i o;
+            __m128i sh;
+
+            /* L_temp = k_cn * cn[i] * 2, p = k_dn * dn[i] */
+            L_temp = _mm_slli_epi32(_mm_madd_epi16(vk, c), 1);
+            p = _mm_madd_epi16(vk, d);
+
+            /* s = L_mac(L_temp, k_dn, dn[i]) */
+            sum = _mm_add_epi32(L_temp, _mm_slli_epi32(p, 1));
+            sat = _mm_xor_si128(_mm_srai_epi32(L_temp, 31), _mm_set1_epi32(MAX_32));
+            o = _mm_and_si128(_mm_cmpgt_epi32(_mm_xor_si128(L_temp, p), _mm_setzero_si128()),
+                              _mm_srai_epi32(_mm_xor_si128(sum, L_temp), 31));
+            sum = _mm_or_si128(_mm_andnot_si128(o, sum), _mm_and_si128(o, sat));
+            ovf = _mm_or_si128(ovf, o);
+
+            o = _mm_cmpeq_epi32(p, _mm_set1_epi32(0x40000000L));
+            sum = _mm_or_si128(_mm_andnot_si128(o, sum), _mm_and_si128(o, _mm_set1_epi32(MAX_32)));
+            ovf = _mm_or_si128(ovf, o);
+
+            /* L_shl(s, 10) */
+            sh = _mm_slli_epi32(sum, 10);
+            o = _mm_xor_si128(_mm_cmpeq_epi32(_mm_srai_epi32(sh, 10), sum), _mm_set1_epi32(-1));
+            sat = _mm_xor_si128(_mm_srai_epi32(sum, 31), _mm_set1_epi32(MAX_32));
+            sh = _mm_or_si128(_mm_andnot_si128(o, sh), _mm_and_si128(o, sat));
+
+            /* pv_round() */
+            o = _mm_cmpgt_epi32(sh, _mm_set1_epi32(MAX_32 - 0x00008000L));
+            sh = _mm_add_epi32(sh, _mm_set1_epi32(0x00008000L));
+            sh = _mm_or_si128(_mm_andnot_si128(o, sh), _mm_and_si128(o, _mm_set1_epi32(MAX_32)));
+            ovf = _mm_or_si128(ovf, o);
+
+            cor[h] = _mm_srai_epi32(sh, 16);
+        }
+        cor[0] = _mm_packs_epi32(cor[0], cor[1]);
+
+        neg = _mm_cmplt_epi16(cor[0], _mm_setzero_si128());
+        _mm_storeu_si128((__m128i *) &sign[i],
+                         _mm_add_epi16(_mm_set1_epi16(32767),
+                                       _mm_and_si128(neg, _mm_set1_epi16(2))));
+        _mm_storeu_si128((__m128i *) &en[i], amrnb_abs_sat_epi16(cor[0]));
+        vdn = _mm_or_si128(_mm_andnot_si128(neg, vdn),
+                           _mm_and_si128(neg, _mm_subs_epi16(_mm_setzero_si128(), vdn)));
+        _mm_storeu_si128((__m128i *) &dn[i], vdn);
+    }
+
+    if (_mm_movemask_epi8(ovf))
+    {
+        *pOverflow = 1;
+    }
+
+    set_sign12k2_tracks(en, pos_max, nb_track, ipos, step);
+
+    return;
+}
+#endif
+
+/* Implementation of set_sign that set_sign_cpu_select() selected */
+static void (*set_sign_impl)(Word16 dn[], Word16 sign[], Word16 dn2[],
+                             Word16 n) = set_sign_c;
+
+/*
+------------------------------------------------------------------------------
+ FUNCTION NAME: set_sign
+------------------------------------------------------------------------------
+ INPUT AND OUTPUT DEFINITIONS
+
+ Same as set_sign_c.
+
+------------------------------------------------------------------------------
+ FUNCTION DESCRIPTION
+
+ Runs the implementation of set_sign that set_sign_cpu_select() selected
+ (see amrnb_cpu.h).
+
+------------------------------------------------------------------------------
+*/
+
+void set_sign(Word16 dn[],   /* i/o : correlation between target and h[]    */
+              Word16 sign[], /* o   : sign of dn[]                          */
+              Word16 dn2[],  /* o   : maximum of correlation in each track. */
+              Word16 n       /* i   : # of maximum correlations in dn2[]    */
+             )
+{
+    set_sign_impl(dn, sign, dn2, n);
+}
+
+/* Implementation of set_sign12k2 that set_sign_cpu_select() selected */
+static void (*set_sign12k2_impl)(Word16 dn[], Word16 cn[], Word16 sign[],
+                                 Word16 pos_max[], Word16 nb_track,
+                                 Word16 ipos[], Word16 step,
+                                 Flag *pOverflow) = set_sign12k2_c;
+
+/*
+------------------------------------------------------------------------------
+ FUNCTION NAME: set_sign12k2
+------------------------------------------------------------------------------
+ INPUT AND OUTPUT DEFINITIONS
+
+ Same as set_sign12k2_c.
+
+------------------------------------------------------------------------------
+ FUNCTION DESCRIPTION
+
+ Runs the implementation of set_sign12k2 that set_sign_cpu_select() selected
+ (see amrnb_cpu.h).
+
+------------------------------------------------------------------------------
+*/
+
+void set_sign12k2(
+    Word16 dn[],        /* i/o : correlation between target and h[]         */
+    Word16 cn[],        /* i   : residual after long term prediction        */
+    Word16 sign[],      /* o   : sign of d[n]                               */
+    Word16 pos_max[],   /* o   : position of maximum correlation            */
+    Word16 nb_track,    /* i   : number of tracks tracks                    */
+    Word16 ipos[],      /* o   : starting position for each pulse           */
+    Word16 step,        /* i   : the step size in the tracks                */
+    Flag   *pOverflow   /* i/o: overflow flag                               */
+)
+{
+    set_sign12k2_impl(dn, cn, sign, pos_max, nb_track, ipos, step, pOverflow);
+}
+
+/*
+------------------------------------------------------------------------------
+ FUNCTION NAME: set_sign_cpu_select
+------------------------------------------------------------------------------
+ INPUT AND OUTPUT DEFINITIONS
+
+ Inputs:
+    features = AMRNB_CPU_* features the kernels may use (Word32)
+
+ Outputs:
+    set_sign_impl = the set_sign implementation for features
+    set_sign12k2_impl = the set_sign12k2 implementation for features
+
+ Returns:
+    None
+
+------------------------------------------------------------------------------
+ FUNCTION DESCRIPTION
+
+ Part of the kernel table of the encoder library, run when the features in
+ use are set (see amrnb_cpu.h).
+
+------------------------------------------------------------------------------
+*/
+void set_sign_cpu_select(Word32 features)
+{
+    set_sign_impl = set_sign_c;
+    set_sign12k2_impl = set_sign12k2_c;
+#if defined(AMRNB_SIMD_SSE2)
+    if (features & AMRNB_CPU_SSE2)
+    {
+        set_sign_impl = set_sign_sse2;
+        set_sign12k2_impl = set_sign12k2_sse2;
+    }
+#endif
+}
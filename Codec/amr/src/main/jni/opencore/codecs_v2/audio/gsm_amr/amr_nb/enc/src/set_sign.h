@@ -49,6 +49,7 @@ terms listed above has been obtained from the copyright holder.
 ; INCLUDES
 ----------------------------------------------------------------------------*/
 #include    "basicop_malloc.h"
+#include    "amrnb_simd.h"
 
 /*--------------------------------------------------------------------------*/
 #ifdef __cplusplus
@@ -103,6 +104,20 @@ extern "C"
         Word16 step,        /* i   : the step size in the tracks                */
         Flag   *pOverflow   /* i/o : overflow flag                              */
     );
+
+    /* Implementations selected by set_sign() and set_sign12k2() */
+    void set_sign_c(Word16 dn[], Word16 sign[], Word16 dn2[], Word16 n);
+    void set_sign12k2_c(Word16 dn[], Word16 cn[], Word16 sign[], Word16 pos_max[],
+                        Word16 nb_track, Word16 ipos[], Word16 step, Flag *pOverflow);
+#if defined(AMRNB_SIMD_SSE2)
+    void set_sign_sse2(Word16 dn[], Word16 sign[], Word16 dn2[], Word16 n);
+    void set_sign12k2_sse2(Word16 dn[], Word16 cn[], Word16 sign[], Word16 pos_max[],
+                           Word16 nb_track, Word16 ipos[], Word16 step, Flag *pOverflow);
+#endif
+    /* Selects the implementation of set_sign and set_sign12k2 for the
+       AMRNB_CPU_* features (see amrnb_cpu.h) */
+    void set_sign_cpu_select(Word32 features);
+
     /*----------------------------------------------------------------------------
     ; END
     ----------------------------------------------------------------------------*/
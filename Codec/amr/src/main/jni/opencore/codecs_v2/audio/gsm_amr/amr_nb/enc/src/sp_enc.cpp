@@ -58,6 +58,7 @@ terms listed above has been obtained from the copyright holder.
 #include "prm2bits.h"
 #include "mode.h"
 #include "cod_amr.h"
+#include "amrnb_enc_cpu.h"
 #include "oscl_mem.h"
 
 /*----------------------------------------------------------------------------
@@ -185,6 +186,8 @@ Word16 GSMInitEncode(void **state_data,
 
     OSCL_UNUSED_ARG(id);
 
+    amrnb_enc_cpu_init();
+
     if (state_data == NULL)
     {
         /*  fprintf(stderr, "Speech_Encode_Frame_init: invalid parameter\n");  */
@@ -626,7 +629,6 @@ void GSMEncodeFrame(
         (Speech_Encode_FrameState *) state_data;
 
     Word16 prm[MAX_PRM_SIZE];   /* Analysis parameters.                 */
-    Word16 syn[L_FRAME];        /* Buffer for synthesis speech          */
     Word16 i;
 
     /* initialize the serial output frame to zero */
@@ -634,7 +636,68 @@ void GSMEncodeFrame(
     {
         serial[i] = 0;
     }
+
+    GSMEncodeFramePrm(state_data, mode, new_speech, prm, usedMode);
+
+    /* Parameters to serial bits */
+    Prm2bits(*usedMode, prm, &serial[0], &(st->cod_amr_state->common_amr_tbls));
+
+    return;
+}
+
+/*
+------------------------------------------------------------------------------
+ FUNCTION NAME: GSMEncodeFramePrm
+------------------------------------------------------------------------------
+ INPUT AND OUTPUT DEFINITIONS
+
+ Inputs:
+    state_data = a void pointer to the post filter states
+    mode = AMR mode of type enum Mode
+    new_speech = pointer to buffer of length L_FRAME that contains
+                 the speech input of type Word16
+    prm = pointer to the analysis parameters of type Word16
+    usedMode = pointer to the used mode of type enum Mode
+
+ Outputs:
+    prm contains the MAX_PRM_SIZE analysis parameters of the frame
+    usedMode contains the mode the frame was coded in
+
+ Returns:
+    None
+
+ Global Variables Used:
+    None.
+
+ Local Variables Needed:
+    None.
+
+------------------------------------------------------------------------------
+ FUNCTION DESCRIPTION
+
+ This function is GSMEncodeFrame() without the Prm2bits() conversion. It lets
+ callers that pack the parameters straight into a frame (see prm_to_ietf(),
+ prm_to_wmf() and prm_to_if2()) skip the serial bit stream.
+
+------------------------------------------------------------------------------
+*/
+
+void GSMEncodeFramePrm(
+    void *state_data,             /* i/o : post filter states          */
+    enum Mode mode,               /* i   : speech coder mode           */
+    Word16 *new_speech,           /* i   : speech input                */
+    Word16 *prm,                  /* o   : analysis parameters         */
+    enum Mode *usedMode           /* o   : used speech coder mode      */
+)
+{
+
+    Speech_Encode_FrameState *st =
+        (Speech_Encode_FrameState *) state_data;
+
+    Word16 syn[L_FRAME];        /* Buffer for synthesis speech          */
 #if !defined(NO13BIT)
+    Word16 i;
+
     /* Delete the 3 LSBs (13-bit input) */
     for (i = 0; i < L_FRAME; i++)
     {
@@ -648,8 +711,5 @@ void GSMEncodeFrame(
     /* Call the speech encoder */
     cod_amr(st->cod_amr_state, mode, new_speech, prm, usedMode, syn);
 
-    /* Parameters to serial bits */
-    Prm2bits(*usedMode, prm, &serial[0], &(st->cod_amr_state->common_amr_tbls));
-
     return;
 }
@@ -127,6 +127,15 @@ extern "C"
         enum Mode *usedMode           /* o   : used speech coder mode */
     );
 
+    /* GSMEncodeFrame() without the parameters to serial bits conversion */
+    void GSMEncodeFramePrm(
+        void *state_data,             /* i/o : encoder states         */
+        enum Mode mode,               /* i   : speech coder mode      */
+        Word16 *new_speech,           /* i   : input speech           */
+        Word16 *prm,                  /* o   : analysis parameters    */
+        enum Mode *usedMode           /* o   : used speech coder mode */
+    );
+
 #ifdef __cplusplus
 }
 #endif
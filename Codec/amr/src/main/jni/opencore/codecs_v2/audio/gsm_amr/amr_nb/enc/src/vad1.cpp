@@ -46,6 +46,8 @@ terms listed above has been obtained from the copyright holder.
 #include "basic_op.h"
 #include "cnst_vad.h"
 #include "oscl_mem.h"
+#include "basic_op_vec.h"
+#include "amrnb_cpu.h"
 
 /*----------------------------------------------------------------------------
 ; MACROS
@@ -466,6 +468,247 @@ static Word16 level_calculation(
 
 
 
+/*
+------------------------------------------------------------------------------
+ FUNCTION NAME: band_split_c
+------------------------------------------------------------------------------
+ INPUT AND OUTPUT DEFINITIONS
+
+ Inputs:
+    st -- pointer to type vadState1 --  State struct
+    in -- array of type Word16 -- input frame
+
+ Outputs:
+    out -- array of type Word16 -- band-split frame, as used by filter_bank
+    st -- pointer to type vadState1 --  State struct
+    pOverflow -- pointer to type Flag -- overflow indicator
+
+ Returns:
+    None
+
+------------------------------------------------------------------------------
+ FUNCTION DESCRIPTION
+
+ Purpose      : Runs the filter cascade of filter_bank, leaving the samples
+                of the 9 bands interleaved in out[].
+
+------------------------------------------------------------------------------
+*/
+
+static void band_split_c(
+    vadState1 *st,    /* i/o : State struct                    */
+    Word16 in[],      /* i   : input frame                     */
+    Word16 out[],     /* o   : band-split frame                */
+    Flag  *pOverflow  /* o   : Flag set when overflow occurs   */
+)
+{
+    Word16 i;
+
+    first_filter_stage(in, out, st->a_data5[0], pOverflow);
+
+    for (i = 0; i < FRAME_LEN / 4; i++)
+    {
+        filter5(&out[4*i], &out[4*i+2], st->a_data5[1], pOverflow);
+        filter5(&out[4*i+1], &out[4*i+3], st->a_data5[2], pOverflow);
+    }
+    for (i = 0; i < FRAME_LEN / 8; i++)
+    {
+        filter3(&out[8*i+0], &out[8*i+4], &st->a_data3[0], pOverflow);
+        filter3(&out[8*i+2], &out[8*i+6], &st->a_data3[1], pOverflow);
+        filter3(&out[8*i+3], &out[8*i+7], &st->a_data3[4], pOverflow);
+    }
+
+    for (i = 0; i < FRAME_LEN / 16; i++)
+    {
+        filter3(&out[16*i+0], &out[16*i+8], &st->a_data3[2], pOverflow);
+        filter3(&out[16*i+4], &out[16*i+12], &st->a_data3[3], pOverflow);
+    }
+}
+
+#if defined(AMRNB_SIMD_SSE2)
+/* one step of the all-pass sections held in the lanes of d:
+   t = sub(x, mult(c, d)); y = add_16(d, mult(c, t)); d = t */
+static inline __m128i allpass_sse2(__m128i x, __m128i *d, __m128i c, __m128i *ovf)
+{
+    __m128i t = amrnb_subs_ovf_epi16(x, amrnb_mul_shr15_epi16(c, *d), ovf);
+    __m128i y = amrnb_adds_ovf_epi16(*d, amrnb_mul_shr15_epi16(c, t), ovf);
+
+    *d = t;
+    return y;
+}
+
+/* a + b in the lanes where m is clear, a - b where it is set (saturated) */
+static inline __m128i addsub_sse2(__m128i a, __m128i b, __m128i m, __m128i *ovf)
+{
+    __m128i sat = _mm_or_si128(_mm_andnot_si128(m, _mm_adds_epi16(a, b)),
+                               _mm_and_si128(m, _mm_subs_epi16(a, b)));
+    __m128i wrap = _mm_or_si128(_mm_andnot_si128(m, _mm_add_epi16(a, b)),
+                                _mm_and_si128(m, _mm_sub_epi16(a, b)));
+
+    *ovf = _mm_or_si128(*ovf, _mm_xor_si128(sat, wrap));
+    return sat;
+}
+
+/*
+------------------------------------------------------------------------------
+ FUNCTION NAME: band_split_sse2
+------------------------------------------------------------------------------
+ INPUT AND OUTPUT DEFINITIONS
+
+ Same as band_split_c.
+
+------------------------------------------------------------------------------
+ FUNCTION DESCRIPTION
+
+ The all-pass sections that band_split_c runs one by one are recursive, so
+ the lanes hold the sections of one stage instead of successive samples:
+ 2 for the first stage, 4 for the filter5 stage, 3 and 2 for the filter3
+ stages. The stages are run together block by block of 16 samples, which
+ lets the four recursions overlap. Unused lanes have zero input and memory
+ and stay zero, so only the sections of the scalar code can set the
+ overflow flag.
+
+------------------------------------------------------------------------------
+*/
+
+static void band_split_sse2(
+    vadState1 *st,    /* i/o : State struct                    */
+    Word16 in[],      /* i   : input frame                     */
+    Word16 out[],     /* o   : band-split frame                */
+    Flag  *pOverflow  /* o   : Flag set when overflow occurs   */
+)
+{
+    Word16 i;
+    Word16 j;
+    Word16 *p;
+    __m128i ovf = _mm_setzero_si128();
+    __m128i x;
+    __m128i y;
+    __m128i y1;
+    __m128i t;
+    __m128i in0;
+    __m128i in1;
+
+    /* first_filter_stage: a_data5[0][0..1] */
+    __m128i c1 = _mm_setr_epi16(COEFF5_1, COEFF5_2, 0, 0, 0, 0, 0, 0);
+    __m128i d1 = _mm_setr_epi16(st->a_data5[0][0], st->a_data5[0][1], 0, 0, 0, 0, 0, 0);
+    __m128i m1 = _mm_setr_epi16(0, -1, 0, -1, 0, 0, 0, 0);
+    __m128i lo1 = _mm_setr_epi32(-1, 0, 0, 0);
+
+    /* filter5 on a_data5[1] and a_data5[2] */
+    __m128i c2 = _mm_setr_epi16(COEFF5_1, COEFF5_1, COEFF5_2, COEFF5_2, 0, 0, 0, 0);
+    __m128i d2 = _mm_setr_epi16(st->a_data5[1][0], st->a_data5[2][0],
+                                st->a_data5[1][1], st->a_data5[2][1], 0, 0, 0, 0);
+    __m128i m2 = _mm_setr_epi16(0, 0, -1, -1, 0, 0, 0, 0);
+
+    /* filter3 on a_data3[0], a_data3[1], a_data3[4]; lane 1 is unused */
+    __m128i c3 = _mm_setr_epi16(COEFF3, 0, COEFF3, COEFF3, 0, 0, 0, 0);
+    __m128i d3 = _mm_setr_epi16(st->a_data3[0], 0, st->a_data3[1], st->a_data3[4],
+                                0, 0, 0, 0);
+    __m128i k3 = _mm_setr_epi16(-1, 0, -1, -1, -1, 0, -1, -1);
+
+    /* filter3 on a_data3[2], a_data3[3] */
+    __m128i c4 = _mm_setr_epi16(COEFF3, COEFF3, 0, 0, 0, 0, 0, 0);
+    __m128i d4 = _mm_setr_epi16(st->a_data3[2], st->a_data3[3], 0, 0, 0, 0, 0, 0);
+
+    for (i = 0; i < FRAME_LEN; i += 16)
+    {
+        for (j = i; j < i + 16; j += 4)
+        {
+            /* first_filter_stage: two samples of each section */
+            x = _mm_srai_epi16(_mm_loadl_epi64((__m128i *) &in[j]), 2);
+            y = allpass_sse2(_mm_and_si128(x, lo1), &d1, c1, &ovf);
+            y1 = allpass_sse2(_mm_srli_si128(x, 4), &d1, c1, &ovf);
+            y = _mm_unpacklo_epi32(y, y1);
+            x = addsub_sse2(_mm_shufflelo_epi16(y, _MM_SHUFFLE(2, 2, 0, 0)),
+                            _mm_shufflelo_epi16(y, _MM_SHUFFLE(3, 3, 1, 1)), m1, &ovf);
+
+            /* filter5 */
+            y = allpass_sse2(x, &d2, c2, &ovf);
+            x = addsub_sse2(_mm_shuffle_epi32(y, _MM_SHUFFLE(3, 3, 0, 0)),
+                            _mm_shuffle_epi32(y, _MM_SHUFFLE(3, 3, 1, 1)), m2, &ovf);
+            _mm_storel_epi64((__m128i *) &out[j], _mm_srai_epi16(x, 1));
+        }
+
+        /* filter3 on out[8*k + {0, 2, 3}] and out[8*k + {4, 6, 7}] */
+        for (j = i; j < i + 16; j += 8)
+        {
+            x = _mm_loadu_si128((__m128i *) &out[j]);
+            t = _mm_and_si128(x, k3);
+            in0 = t;
+            in1 = _mm_srli_si128(t, 8);
+            y = allpass_sse2(in1, &d3, c3, &ovf);
+            in0 = _mm_srai_epi16(amrnb_adds_ovf_epi16(t, y, &ovf), 1);
+            in1 = _mm_srai_epi16(amrnb_subs_ovf_epi16(t, y, &ovf), 1);
+            y = _mm_unpacklo_epi64(in0, in1);
+            _mm_storeu_si128((__m128i *) &out[j],
+                             _mm_or_si128(_mm_and_si128(k3, y), _mm_andnot_si128(k3, x)));
+        }
+
+        /* filter3 on out[16*k + {0, 4}] and out[16*k + {8, 12}] */
+        p = &out[i];
+        in0 = _mm_setr_epi16(p[0], p[4], 0, 0, 0, 0, 0, 0);
+        in1 = _mm_setr_epi16(p[8], p[12], 0, 0, 0, 0, 0, 0);
+        y = allpass_sse2(in1, &d4, c4, &ovf);
+        in1 = _mm_srai_epi16(amrnb_subs_ovf_epi16(in0, y, &ovf), 1);
+        in0 = _mm_srai_epi16(amrnb_adds_ovf_epi16(in0, y, &ovf), 1);
+        p[0] = (Word16) _mm_extract_epi16(in0, 0);
+        p[4] = (Word16) _mm_extract_epi16(in0, 1);
+        p[8] = (Word16) _mm_extract_epi16(in1, 0);
+        p[12] = (Word16) _mm_extract_epi16(in1, 1);
+    }
+
+    st->a_data5[0][0] = (Word16) _mm_extract_epi16(d1, 0);
+    st->a_data5[0][1] = (Word16) _mm_extract_epi16(d1, 1);
+    st->a_data5[1][0] = (Word16) _mm_extract_epi16(d2, 0);
+    st->a_data5[2][0] = (Word16) _mm_extract_epi16(d2, 1);
+    st->a_data5[1][1] = (Word16) _mm_extract_epi16(d2, 2);
+    st->a_data5[2][1] = (Word16) _mm_extract_epi16(d2, 3);
+    st->a_data3[0] = (Word16) _mm_extract_epi16(d3, 0);
+    st->a_data3[1] = (Word16) _mm_extract_epi16(d3, 2);
+    st->a_data3[4] = (Word16) _mm_extract_epi16(d3, 3);
+    st->a_data3[2] = (Word16) _mm_extract_epi16(d4, 0);
+    st->a_data3[3] = (Word16) _mm_extract_epi16(d4, 1);
+
+    if (_mm_movemask_epi8(ovf) != 0)
+    {
+        *pOverflow = 1;
+    }
+}
+#endif
+
+/* Implementation of band_split that vad1_cpu_select() selected */
+static void (*band_split_impl)(vadState1 *st, Word16 in[], Word16 out[],
+                               Flag *pOverflow) = band_split_c;
+
+/*
+------------------------------------------------------------------------------
+ FUNCTION NAME: band_split
+------------------------------------------------------------------------------
+ INPUT AND OUTPUT DEFINITIONS
+
+ Same as band_split_c.
+
+------------------------------------------------------------------------------
+ FUNCTION DESCRIPTION
+
+ Runs the implementation of band_split that vad1_cpu_select() selected
+ (see amrnb_cpu.h).
+
+------------------------------------------------------------------------------
+*/
+
+static void band_split(
+    vadState1 *st,    /* i/o : State struct                    */
+    Word16 in[],      /* i   : input frame                     */
+    Word16 out[],     /* o   : band-split frame                */
+    Flag  *pOverflow  /* o   : Flag set when overflow occurs   */
+)
+{
+    band_split_impl(st, in, out, pOverflow);
+}
+
+
 /*
 ------------------------------------------------------------------------------
  FUNCTION NAME: filter_bank
@@ -524,30 +767,11 @@ static void filter_bank(
     Flag  *pOverflow  /* o   : Flag set when overflow occurs   */
 )
 {
-    Word16 i;
     Word16 tmp_buf[FRAME_LEN];
 
     /* calculate the filter bank */
 
-    first_filter_stage(in, tmp_buf, st->a_data5[0], pOverflow);
-
-    for (i = 0; i < FRAME_LEN / 4; i++)
-    {
-        filter5(&tmp_buf[4*i], &tmp_buf[4*i+2], st->a_data5[1], pOverflow);
-        filter5(&tmp_buf[4*i+1], &tmp_buf[4*i+3], st->a_data5[2], pOverflow);
-    }
-    for (i = 0; i < FRAME_LEN / 8; i++)
-    {
-        filter3(&tmp_buf[8*i+0], &tmp_buf[8*i+4], &st->a_data3[0], pOverflow);
-        filter3(&tmp_buf[8*i+2], &tmp_buf[8*i+6], &st->a_data3[1], pOverflow);
-        filter3(&tmp_buf[8*i+3], &tmp_buf[8*i+7], &st->a_data3[4], pOverflow);
-    }
-
-    for (i = 0; i < FRAME_LEN / 16; i++)
-    {
-        filter3(&tmp_buf[16*i+0], &tmp_buf[16*i+8], &st->a_data3[2], pOverflow);
-        filter3(&tmp_buf[16*i+4], &tmp_buf[16*i+12], &st->a_data3[3], pOverflow);
-    }
+    band_split(st, in, tmp_buf, pOverflow);
 
     /* calculate levels in each frequency band */
 
@@ -2010,4 +2234,36 @@ Word16 vad1(
     return (vad_decision(st, level, pow_sum, pOverflow));
 }
 
+/*
+------------------------------------------------------------------------------
+ FUNCTION NAME: vad1_cpu_select
+------------------------------------------------------------------------------
+ INPUT AND OUTPUT DEFINITIONS
+
+ Inputs:
+    features = AMRNB_CPU_* features the kernels may use (Word32)
 
+ Outputs:
+    band_split_impl = the band_split implementation for features
+
+ Returns:
+    None
+
+------------------------------------------------------------------------------
+ FUNCTION DESCRIPTION
+
+ Part of the kernel table of the encoder library, run when the features in
+ use are set (see amrnb_cpu.h).
+
+------------------------------------------------------------------------------
+*/
+void vad1_cpu_select(Word32 features)
+{
+    band_split_impl = band_split_c;
+#if defined(AMRNB_SIMD_SSE2)
+    if (features & AMRNB_CPU_SSE2)
+    {
+        band_split_impl = band_split_sse2;
+    }
+#endif
+}
@@ -173,6 +173,10 @@ extern "C"
                 Flag *pOverflow
                );
 
+    /* Selects the implementation of the filter bank of vad1 for the
+       AMRNB_CPU_* features (see amrnb_cpu.h) */
+    void vad1_cpu_select(Word32 features);
+
     /*----------------------------------------------------------------------------
     ; END
     ----------------------------------------------------------------------------*/
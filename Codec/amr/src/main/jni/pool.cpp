@@ -0,0 +1,235 @@
+/* ------------------------------------------------------------------
+ * Copyright (C) 2009 Martin Storsjo
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied.
+ * See the License for the specific language governing permissions
+ * and limitations under the License.
+ * -------------------------------------------------------------------
+ */
+
+#include "interf_dec.h"
+#include "interf_enc.h"
+#include "interf_pool.h"
+#include <stdlib.h>
+#include <string.h>
+
+/*
+ * Fixed-chunk slab in the spirit of OsclMemPoolFixedChunkAllocator: one
+ * aligned allocation of num_chunks states, and a stack of free chunk
+ * indices so that the most recently released (cache-warm) state is handed
+ * out first.
+ */
+struct state_pool {
+	char* chunks;
+	void* mem;
+	size_t chunk_size;
+	int num_chunks;
+	int* free_list;
+	int num_free;
+	unsigned char* dirty;
+	int dtx;
+
+	void* (*init_mem)(struct state_pool* pool, void* mem);
+	void* (*init_heap)(struct state_pool* pool);
+	void (*reset)(void* state);
+	void (*exit)(void* state);
+
+	struct amrnb_pool_stats stats;
+};
+
+static struct state_pool* pool_create(int count, size_t state_size) {
+	struct state_pool* pool;
+
+	if (count < 0)
+		return NULL;
+	pool = (struct state_pool*) calloc(1, sizeof(*pool));
+	if (!pool)
+		return NULL;
+	pool->chunk_size = (state_size + AMRNB_STATE_ALIGN - 1) & ~((size_t) AMRNB_STATE_ALIGN - 1);
+	pool->num_chunks = count;
+	pool->mem = malloc(count * pool->chunk_size + AMRNB_STATE_ALIGN - 1);
+	pool->free_list = (int*) malloc((count + 1) * sizeof(int));
+	pool->dirty = (unsigned char*) calloc(count + 1, 1);
+	if (!pool->mem || !pool->free_list || !pool->dirty) {
+		free(pool->mem);
+		free(pool->free_list);
+		free(pool->dirty);
+		free(pool);
+		return NULL;
+	}
+	pool->chunks = (char*) (((size_t) pool->mem + AMRNB_STATE_ALIGN - 1) &
+	                        ~((size_t) AMRNB_STATE_ALIGN - 1));
+	pool->stats.size = count;
+	return pool;
+}
+
+static struct state_pool* pool_fill(struct state_pool* pool) {
+	int i;
+	if (!pool)
+		return NULL;
+	/* push in reverse so that chunk 0 is handed out first */
+	for (i = pool->num_chunks - 1; i >= 0; i--) {
+		if (!pool->init_mem(pool, pool->chunks + i * pool->chunk_size)) {
+			free(pool->mem);
+			free(pool->free_list);
+			free(pool->dirty);
+			free(pool);
+			return NULL;
+		}
+		pool->free_list[pool->num_free++] = i;
+	}
+	return pool;
+}
+
+static void* pool_acquire(struct state_pool* pool) {
+	void* state;
+	int i;
+
+	pool->stats.acquires++;
+	if (pool->num_free > 0) {
+		i = pool->free_list[--pool->num_free];
+		state = pool->chunks + i * pool->chunk_size;
+		if (pool->dirty[i]) {
+			pool->reset(state);
+			pool->dirty[i] = 0;
+		}
+		pool->stats.hits++;
+	} else {
+		state = pool->init_heap(pool);
+		if (!state)
+			return NULL;
+	}
+	if (++pool->stats.in_use > pool->stats.high_water)
+		pool->stats.high_water = pool->stats.in_use;
+	return state;
+}
+
+static void pool_release(struct state_pool* pool, void* state) {
+	size_t offset = (char*) state - pool->chunks;
+
+	if (!state)
+		return;
+	pool->stats.in_use--;
+	if ((char*) state < pool->chunks || offset >= pool->num_chunks * pool->chunk_size) {
+		/* overflow instance from init_heap */
+		pool->exit(state);
+		return;
+	}
+	pool->dirty[offset / pool->chunk_size] = 1;
+	pool->free_list[pool->num_free++] = (int) (offset / pool->chunk_size);
+}
+
+static void pool_reset_idle(struct state_pool* pool) {
+	int n;
+	for (n = 0; n < pool->num_free; n++) {
+		int i = pool->free_list[n];
+		if (pool->dirty[i]) {
+			pool->reset(pool->chunks + i * pool->chunk_size);
+			pool->dirty[i] = 0;
+		}
+	}
+}
+
+static void pool_destroy(struct state_pool* pool) {
+	int i;
+	if (!pool)
+		return;
+	for (i = 0; i < pool->num_chunks; i++)
+		pool->exit(pool->chunks + i * pool->chunk_size);
+	free(pool->mem);
+	free(pool->free_list);
+	free(pool->dirty);
+	free(pool);
+}
+
+#ifndef DISABLE_AMRNB_ENCODER
+static void* encoder_init_mem(struct state_pool* pool, void* mem) {
+	return Encoder_Interface_init_mem(mem, pool->dtx);
+}
+
+static void* encoder_init_heap(struct state_pool* pool) {
+	return Encoder_Interface_init(pool->dtx);
+}
+
+void* Encoder_Pool_create(int count, int dtx) {
+	struct state_pool* pool = pool_create(count, Encoder_Interface_state_size());
+	if (!pool)
+		return NULL;
+	pool->dtx = dtx;
+	pool->init_mem = encoder_init_mem;
+	pool->init_heap = encoder_init_heap;
+	pool->reset = Encoder_Interface_reset;
+	pool->exit = Encoder_Interface_exit;
+	return pool_fill(pool);
+}
+
+void* Encoder_Pool_acquire(void* pool) {
+	return pool_acquire((struct state_pool*) pool);
+}
+
+void Encoder_Pool_release(void* pool, void* state) {
+	pool_release((struct state_pool*) pool, state);
+}
+
+void Encoder_Pool_reset_idle(void* pool) {
+	pool_reset_idle((struct state_pool*) pool);
+}
+
+void Encoder_Pool_stats(void* pool, struct amrnb_pool_stats* stats) {
+	*stats = ((struct state_pool*) pool)->stats;
+}
+
+void Encoder_Pool_destroy(void* pool) {
+	pool_destroy((struct state_pool*) pool);
+}
+#endif
+
+#ifndef DISABLE_AMRNB_DECODER
+static void* decoder_init_mem(struct state_pool* /* pool */, void* mem) {
+	return Decoder_Interface_init_mem(mem);
+}
+
+static void* decoder_init_heap(struct state_pool* /* pool */) {
+	return Decoder_Interface_init();
+}
+
+void* Decoder_Pool_create(int count) {
+	struct state_pool* pool = pool_create(count, Decoder_Interface_state_size());
+	if (!pool)
+		return NULL;
+	pool->init_mem = decoder_init_mem;
+	pool->init_heap = decoder_init_heap;
+	pool->reset = Decoder_Interface_reset;
+	pool->exit = Decoder_Interface_exit;
+	return pool_fill(pool);
+}
+
+void* Decoder_Pool_acquire(void* pool) {
+	return pool_acquire((struct state_pool*) pool);
+}
+
+void Decoder_Pool_release(void* pool, void* state) {
+	pool_release((struct state_pool*) pool, state);
+}
+
+void Decoder_Pool_reset_idle(void* pool) {
+	pool_reset_idle((struct state_pool*) pool);
+}
+
+void Decoder_Pool_stats(void* pool, struct amrnb_pool_stats* stats) {
+	*stats = ((struct state_pool*) pool)->stats;
+}
+
+void Decoder_Pool_destroy(void* pool) {
+	pool_destroy((struct state_pool*) pool);
+}
+#endif
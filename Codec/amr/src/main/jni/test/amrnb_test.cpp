@@ -0,0 +1,154 @@
+/*
+ * amrnb_test: regression checks of the Encoder_Interface_* / Decoder_Interface_*
+ * entry points that the checksums of amrnb_bench do not cover. Every check
+ * prints one line; the exit status is non-zero if any of them fails.
+ */
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "interf_dec.h"
+#include "interf_enc.h"
+#include "interf_pool.h"
+
+#define FRAME_SAMPLES   160
+#define MAX_FRAME_BYTES 32
+#define TEST_FRAMES     50
+
+static unsigned int rnd_state = 1;
+
+static int rnd(void) {
+	rnd_state = rnd_state * 1103515245u + 12345u;
+	return (rnd_state >> 16) & 0x7fff;
+}
+
+/* Voiced-like test signal: a pulse train through a resonance, plus noise */
+static void make_speech(short* pcm, int n) {
+	int y1 = 0, y2 = 0, phase = 0, i;
+
+	rnd_state = 1;
+	for (i = 0; i < n; i++) {
+		int x = (phase == 0 ? 4000 : 0) + (rnd() & 0xff) - 128;
+		int y = x + ((27400 * y1 - 14800 * y2) >> 14);
+
+		if (++phase >= 57)
+			phase = 0;
+		y2 = y1;
+		y1 = y;
+		pcm[i] = (short) (y > 32767 ? 32767 : (y < -32768 ? -32768 : y));
+	}
+}
+
+/*
+ * Encodes pcm in MR475 and returns the number of bytes written to bits.
+ * The encoder pre-processes its input in place, so every frame is copied.
+ */
+static int encode_all(void* enc, const short* pcm, unsigned char* bits) {
+	short frame[FRAME_SAMPLES];
+	int bytes = 0, i;
+
+	for (i = 0; i < TEST_FRAMES; i++) {
+		memcpy(frame, pcm + i * FRAME_SAMPLES, sizeof(frame));
+		bytes += Encoder_Interface_Encode(enc, MR475, frame, bits + bytes);
+	}
+	return bytes;
+}
+
+static int check(const char* name, int ok) {
+	printf("%-48s %s\n", name, ok ? "ok" : "FAIL");
+	return ok ? 0 : 1;
+}
+
+/*
+ * An encoder handed out again by a pool must encode like a fresh one, even
+ * if its previous user lowered the complexity.
+ */
+static int test_pool_resets_complexity(void) {
+	static short pcm[TEST_FRAMES * FRAME_SAMPLES];
+	static unsigned char fresh[TEST_FRAMES * MAX_FRAME_BYTES];
+	static unsigned char recycled[TEST_FRAMES * MAX_FRAME_BYTES];
+	void* enc;
+	void* pool;
+	int fresh_bytes, recycled_bytes;
+
+	make_speech(pcm, TEST_FRAMES * FRAME_SAMPLES);
+
+	enc = Encoder_Interface_init(0);
+	fresh_bytes = encode_all(enc, pcm, fresh);
+	Encoder_Interface_exit(enc);
+
+	pool = Encoder_Pool_create(1, 0);
+	enc = Encoder_Pool_acquire(pool);
+	Encoder_Interface_SetComplexity(enc, 0);
+	encode_all(enc, pcm, recycled);
+	Encoder_Pool_release(pool, enc);
+
+	enc = Encoder_Pool_acquire(pool);
+	recycled_bytes = encode_all(enc, pcm, recycled);
+	Encoder_Pool_release(pool, enc);
+	Encoder_Pool_destroy(pool);
+
+	return check("pool recycle after SetComplexity(0)",
+		fresh_bytes == recycled_bytes && !memcmp(fresh, recycled, fresh_bytes));
+}
+
+/*
+ * Mean DecodeParams energy over the second half of TEST_FRAMES MR122 frames
+ * of a 500 Hz sine of the given amplitude.
+ */
+static int sine_energy(int amplitude) {
+	static short pcm[TEST_FRAMES * FRAME_SAMPLES];
+	static unsigned char bits[TEST_FRAMES * MAX_FRAME_BYTES];
+	struct amrnb_frame_params params;
+	void* enc;
+	void* dec;
+	int sum = 0, pos = 0, i;
+
+	for (i = 0; i < TEST_FRAMES * FRAME_SAMPLES; i++)
+		pcm[i] = (short) floor(amplitude * sin(2 * M_PI * 500 * i / 8000.0) + 0.5);
+
+	enc = Encoder_Interface_init(0);
+	for (i = 0; i < TEST_FRAMES; i++)
+		pos += Encoder_Interface_Encode(enc, MR122, pcm + i * FRAME_SAMPLES, bits + pos);
+	Encoder_Interface_exit(enc);
+
+	dec = Decoder_Interface_init();
+	pos = 0;
+	for (i = 0; i < TEST_FRAMES; i++) {
+		pos += Decoder_Interface_DecodeParams(dec, bits + pos, &params);
+		if (i >= TEST_FRAMES / 2)
+			sum += params.energy;
+	}
+	Decoder_Interface_exit(dec);
+	return sum / (TEST_FRAMES - TEST_FRAMES / 2);
+}
+
+/*
+ * The energy of loud frames must follow the level instead of saturating:
+ * a sine of amplitude a has a mean square of a^2 / 2, and doubling a adds
+ * 2048 (log2(4) in Q10).
+ */
+static int test_params_energy_full_scale(void) {
+	int half = sine_energy(12000);
+	int loud = sine_energy(24000);
+	int full = sine_energy(32767);
+	int expect = (int) floor(1024 * log2(24000.0 * 24000.0 / 2) + 0.5);
+	int ok = abs(loud - expect) < 256 && abs(loud - half - 2048) < 256 && full > loud;
+
+	if (!ok)
+		printf("energy 12000: %d, 24000: %d (expected %d), 32767: %d\n", half, loud, expect, full);
+	return check("DecodeParams energy of full-scale frames", ok);
+}
+
+int main(void) {
+	int failed = 0;
+
+	failed += test_pool_resets_complexity();
+	failed += test_params_energy_full_scale();
+
+	if (failed)
+		printf("%d check(s) failed\n", failed);
+	return failed ? 1 : 0;
+}
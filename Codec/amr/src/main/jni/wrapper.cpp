@@ -22,49 +22,202 @@
 #include <amrencode.h>
 #include "interf_dec.h"
 #include "interf_enc.h"
+#include "interf_trans.h"
 #include "opencore/codecs_v2/audio/gsm_amr/amr_nb/enc/src/amrencode.h"
 #include "opencore/codecs_v2/audio/gsm_amr/amr_nb/dec/src/sp_dec.h"
 #include "oscl/osclconfig_limits_typedefs.h"
 #include "opencore/codecs_v2/audio/gsm_amr/amr_nb/dec/src/amrdecode.h"
 #include "opencore/codecs_v2/audio/gsm_amr/amr_nb/common/include/gsm_amr_typedefs.h"
 #include "opencore/codecs_v2/audio/gsm_amr/common/dec/include/pvgsmamrdecoderinterface.h"
+#include <limits.h>
 #include <stdlib.h>
+#include <string.h>
+
+/* Round up to the alignment of the state blocks */
+#define STATE_ALIGN_UP(x) (((x) + AMRNB_STATE_ALIGN - 1) & ~((size_t) AMRNB_STATE_ALIGN - 1))
+
+static void* default_alloc(void* opaque, size_t size) {
+	OSCL_UNUSED_ARG(opaque);
+	return malloc(size);
+}
+
+static void default_free(void* opaque, void* ptr) {
+	OSCL_UNUSED_ARG(opaque);
+	free(ptr);
+}
 
 #ifndef DISABLE_AMRNB_DECODER
+struct decoder_state {
+	void* decCtx;
+	void* mem;
+	void (*free_mem)(void* opaque, void* ptr);
+	void* opaque;
+};
+
+size_t Decoder_Interface_state_size(void) {
+	return STATE_ALIGN_UP(sizeof(struct decoder_state)) + sizeof(Speech_Decode_FrameState);
+}
+
+void* Decoder_Interface_init_mem(void* mem) {
+	struct decoder_state* state = (struct decoder_state*) mem;
+	if (!mem || ((size_t) mem & (AMRNB_STATE_ALIGN - 1)))
+		return NULL;
+	memset(state, 0, sizeof(*state));
+	if (GSMInitDecodeInPlace((char*) mem + STATE_ALIGN_UP(sizeof(*state)), &state->decCtx))
+		return NULL;
+	return state;
+}
+
+void* Decoder_Interface_init_alloc(void* (*alloc_mem)(void* opaque, size_t size),
+                                   void (*free_mem)(void* opaque, void* ptr), void* opaque) {
+	struct decoder_state* state;
+	void* mem = alloc_mem(opaque, Decoder_Interface_state_size() + AMRNB_STATE_ALIGN - 1);
+	if (!mem)
+		return NULL;
+	state = (struct decoder_state*) Decoder_Interface_init_mem((void*) STATE_ALIGN_UP((size_t) mem));
+	if (!state) {
+		free_mem(opaque, mem);
+		return NULL;
+	}
+	state->mem = mem;
+	state->free_mem = free_mem;
+	state->opaque = opaque;
+	return state;
+}
+
 void* Decoder_Interface_init(void) {
-	void* ptr = NULL;
-	GSMInitDecode(&ptr, (int8*)"Decoder");
-	return ptr;
+	return Decoder_Interface_init_alloc(default_alloc, default_free, NULL);
+}
+
+void Decoder_Interface_reset(void* s) {
+	struct decoder_state* state = (struct decoder_state*) s;
+	Speech_Decode_Frame_reset(state->decCtx);
 }
 
-void Decoder_Interface_exit(void* state) {
-	GSMDecodeFrameExit(&state);
+void Decoder_Interface_exit(void* s) {
+	struct decoder_state* state = (struct decoder_state*) s;
+	if (state && state->free_mem)
+		state->free_mem(state->opaque, state->mem);
 }
 
-void Decoder_Interface_Decode(void* state, const unsigned char* in, short* out) {
+void Decoder_Interface_Decode(void* s, const unsigned char* in, short* out) {
+	struct decoder_state* state = (struct decoder_state*) s;
 	unsigned char type = (in[0] >> 3) & 0x0f;
 	in++;
-	AMRDecode(state, (enum Frame_Type_3GPP) type, (UWord8*) in, out, MIME_IETF);
+	AMRDecode(state->decCtx, (enum Frame_Type_3GPP) type, (UWord8*) in, out, MIME_IETF);
+}
+
+int Decoder_Interface_FrameSize(int frame_type) {
+	if (frame_type < 0 || frame_type > AMR_NO_DATA)
+		return -1;
+	return 1 + WmfDecBytesPerFrame[frame_type];
+}
+
+int Decoder_Interface_DecodeStream(void* s, const unsigned char* in, int len,
+                                   short* out, int out_len, int* consumed, int* produced) {
+	struct decoder_state* state = (struct decoder_state*) s;
+	int pos = 0, frames = 0;
+	while (pos < len && (frames + 1) * L_FRAME <= out_len) {
+		enum Frame_Type_3GPP type = (enum Frame_Type_3GPP) ((in[pos] >> 3) & 0x0f);
+		int size = 1 + WmfDecBytesPerFrame[type];
+		if (pos + size > len)
+			break;
+		if (type > AMR_SID && type < AMR_NO_DATA) {
+			/* Not decodable by AMRDecode, conceal it like a lost frame */
+			type = AMR_NO_DATA;
+		}
+		AMRDecode(state->decCtx, type, (UWord8*) in + pos + 1, out + frames * L_FRAME, MIME_IETF);
+		pos += size;
+		frames++;
+	}
+	if (consumed)
+		*consumed = pos;
+	if (produced)
+		*produced = frames * L_FRAME;
+	return frames;
+}
+
+int Decoder_Interface_DecodeParams(void* s, const unsigned char* in, struct amrnb_frame_params* params) {
+	struct decoder_state* state = (struct decoder_state*) s;
+	Speech_Decode_FrameState* dec = (Speech_Decode_FrameState*) state->decCtx;
+	const Decoder_amrParams* p = &dec->decoder_amrState.params;
+	enum Frame_Type_3GPP type = (enum Frame_Type_3GPP) ((in[0] >> 3) & 0x0f);
+	Word16 synth[L_FRAME];
+	int size = 1 + WmfDecBytesPerFrame[type];
+	if (type > AMR_SID && type < AMR_NO_DATA)
+		type = AMR_NO_DATA;
+	dec->decoder_amrState.params_only = 1;
+	AMRDecode(state->decCtx, type, (UWord8*) in + 1, synth, MIME_IETF);
+	dec->decoder_amrState.params_only = 0;
+
+	params->frame_type = type;
+	params->mode = dec->prev_mode;
+	params->speech = p->valid;
+	memcpy(params->lsf, p->lsf, sizeof(params->lsf));
+	memcpy(params->pitch_lag, p->T0, sizeof(params->pitch_lag));
+	memcpy(params->pitch_gain, p->gain_pit, sizeof(params->pitch_gain));
+	memcpy(params->code_gain, p->gain_code, sizeof(params->code_gain));
+	/* Post_Process doubles the synthesis; a full-scale synthesis (30720)
+	   would then be one past the range of a short */
+	params->energy = p->energy > 32767 - 2048 ? 32767 : p->energy + 2048;
+	return size;
 }
 #endif
 
 #ifndef DISABLE_AMRNB_ENCODER
 
-void* Encoder_Interface_init(int dtx) {
-	struct encoder_state* state = (struct encoder_state*) malloc(sizeof(struct encoder_state));
-	AMREncodeInit(&state->encCtx, &state->pidSyncCtx, dtx);
+size_t Encoder_Interface_state_size(void) {
+	return STATE_ALIGN_UP(sizeof(struct encoder_state)) + AMREncodeStateSize();
+}
+
+void* Encoder_Interface_init_mem(void* mem, int dtx) {
+	struct encoder_state* state = (struct encoder_state*) mem;
+	if (!mem || ((size_t) mem & (AMRNB_STATE_ALIGN - 1)))
+		return NULL;
+	memset(state, 0, sizeof(*state));
+	if (AMREncodeInitInPlace((char*) mem + STATE_ALIGN_UP(sizeof(*state)),
+	                         &state->encCtx, &state->pidSyncCtx, dtx))
+		return NULL;
 	return state;
 }
 
+void* Encoder_Interface_init_alloc(int dtx, void* (*alloc_mem)(void* opaque, size_t size),
+                                   void (*free_mem)(void* opaque, void* ptr), void* opaque) {
+	struct encoder_state* state;
+	void* mem = alloc_mem(opaque, Encoder_Interface_state_size() + AMRNB_STATE_ALIGN - 1);
+	if (!mem)
+		return NULL;
+	state = (struct encoder_state*) Encoder_Interface_init_mem((void*) STATE_ALIGN_UP((size_t) mem), dtx);
+	if (!state) {
+		free_mem(opaque, mem);
+		return NULL;
+	}
+	state->mem = mem;
+	state->free_mem = free_mem;
+	state->opaque = opaque;
+	return state;
+}
+
+void* Encoder_Interface_init(int dtx) {
+	return Encoder_Interface_init_alloc(dtx, default_alloc, default_free, NULL);
+}
+
 void Encoder_Interface_reset(void* s){
 	struct encoder_state* state = (struct encoder_state*) s;
-	AMREncodeReset(&state->encCtx,&state->pidSyncCtx);
+	AMREncodeReset(state->encCtx,state->pidSyncCtx);
+}
+
+int Encoder_Interface_SetComplexity(void* s, int complexity) {
+	struct encoder_state* state = (struct encoder_state*) s;
+	if (complexity < 0 || complexity > AMRNB_ENC_COMPLEXITY_MAX)
+		return -1;
+	return AMREncodeSetComplexity(state->encCtx, (Word16) complexity);
 }
 
 void Encoder_Interface_exit(void* s) {
 	struct encoder_state* state = (struct encoder_state*) s;
-	AMREncodeExit(&state->encCtx, &state->pidSyncCtx);
-	free(state);
+	if (state && state->free_mem)
+		state->free_mem(state->opaque, state->mem);
 }
 
 int Encoder_Interface_Encode(void* s, enum Mode mode, const short* in, unsigned char* out) {
@@ -74,5 +227,96 @@ int Encoder_Interface_Encode(void* s, enum Mode mode, const short* in, unsigned
 	out[0] |= 0x04;
 	return ret;
 }
+
+int Encoder_Interface_EncodeBatch(void* s, enum Mode mode, const short* in, int frames,
+                                  unsigned char* out, int* sizes, int* types) {
+	struct encoder_state* state = (struct encoder_state*) s;
+	Word16 speech[L_FRAME];
+	int total = 0;
+	int i;
+	/* keeps frames * 160 samples, and the returned byte count, within an int */
+	if (frames < 0 || frames > INT_MAX / L_FRAME)
+		return -1;
+	for (i = 0; i < frames; i++) {
+		enum Frame_Type_3GPP frame_type = (enum Frame_Type_3GPP) mode;
+		int ret;
+		/* AMREncode pre-processes the speech in place, keep the caller's copy intact */
+		memcpy(speech, in + (size_t) i * L_FRAME, sizeof(speech));
+		ret = AMREncode(state->encCtx, state->pidSyncCtx, mode, speech, out + total, &frame_type, AMR_TX_IETF);
+		if (ret < 0)
+			return -1;
+		out[total] |= 0x04;
+		if (sizes)
+			sizes[i] = ret;
+		if (types)
+			types[i] = frame_type;
+		total += ret;
+	}
+	return total;
+}
 #endif
 
+#if !defined(DISABLE_AMRNB_DECODER) && !defined(DISABLE_AMRNB_ENCODER)
+struct transcoder_state {
+	void* dec;
+	void* enc;
+};
+
+void* Transcoder_Interface_init(int dtx) {
+	struct transcoder_state* state = (struct transcoder_state*) malloc(sizeof(*state));
+	if (!state)
+		return NULL;
+	state->dec = Decoder_Interface_init();
+	state->enc = Encoder_Interface_init(dtx);
+	if (!state->dec || !state->enc) {
+		Transcoder_Interface_exit(state);
+		return NULL;
+	}
+	/* the decoder only records the LSPs and lags the encoder reuses on request */
+	((Speech_Decode_FrameState*) ((struct decoder_state*) state->dec)->decCtx)->decoder_amrState.record_params = 1;
+	return state;
+}
+
+void Transcoder_Interface_reset(void* s) {
+	struct transcoder_state* state = (struct transcoder_state*) s;
+	Decoder_Interface_reset(state->dec);
+	Encoder_Interface_reset(state->enc);
+}
+
+void Transcoder_Interface_exit(void* s) {
+	struct transcoder_state* state = (struct transcoder_state*) s;
+	if (!state)
+		return;
+	Decoder_Interface_exit(state->dec);
+	Encoder_Interface_exit(state->enc);
+	free(state);
+}
+
+int Transcoder_Interface_Transcode(void* s, const unsigned char* in, enum Mode mode, unsigned char* out) {
+	struct transcoder_state* state = (struct transcoder_state*) s;
+	struct decoder_state* dec = (struct decoder_state*) state->dec;
+	struct encoder_state* enc = (struct encoder_state*) state->enc;
+	const Decoder_amrParams* params;
+	short speech[L_FRAME];
+	Word16 lsp_mid[M], lsp_new[M], T_op[2];
+	int i;
+
+	Decoder_Interface_Decode(dec, in, speech);
+	params = &((Speech_Decode_FrameState*) dec->decCtx)->decoder_amrState.params;
+	if (params->valid) {
+		/*
+		 * The encoder codes its input one subframe late: its 2nd and 4th
+		 * subframes are the 1st and 3rd of the source frame, and its two
+		 * open-loop halves end in the source's 1st and 3rd subframe.
+		 */
+		for (i = 0; i < M; i++) {
+			lsp_mid[i] = (params->lsp_old[i] >> 1) + (params->lsp_mid[i] >> 1);
+			lsp_new[i] = (params->lsp_mid[i] >> 1) + (params->lsp_new[i] >> 1);
+		}
+		T_op[0] = params->T0[0];
+		T_op[1] = params->T0[2];
+		AMREncodeSetHints(enc->encCtx, lsp_mid, lsp_new, T_op);
+	}
+	return Encoder_Interface_Encode(enc, mode, speech, out);
+}
+#endif
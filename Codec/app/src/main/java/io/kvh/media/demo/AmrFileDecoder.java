@@ -22,7 +22,7 @@ public class AmrFileDecoder implements Runnable {
     private long mDecoderState;
 
     byte[] readBuffer;
-    byte[] readBufferWithoutCompress;
+    short[] pcmBuffer;
 
     int playerBufferSize = 0;
     // 8 k * 16bit * 1 = 8k shorts
@@ -31,8 +31,10 @@ public class AmrFileDecoder implements Runnable {
     // 0.02 x 8000 x 2 = 320;160 short
     static final int PCM_FRAME_SIZE = 160;
 
-    //using AmrEncoder.Mode.MR122 to encode, generated frame size would be 32
-    static final int AMR_FRAME_SIZE = 32;// see io.kvh.media.sound.Codec
+    // frames are decoded in chunks of up to 50 (one second); any mode, SID
+    // and no-data frames can be mixed, the largest frame is 32 bytes
+    static final int FRAMES_PER_CHUNK = 50;
+    static final int AMR_MAX_FRAME_SIZE = 32;
 
     boolean isRunning;
 
@@ -50,8 +52,8 @@ public class AmrFileDecoder implements Runnable {
         mAudioTrack = new AudioTrack(AudioManager.STREAM_MUSIC, SAMPLE_RATE,
                 AudioFormat.CHANNEL_OUT_MONO, AudioFormat.ENCODING_PCM_16BIT,
                 playerBufferSize, AudioTrack.MODE_STREAM);
-        readBuffer = new byte[AMR_FRAME_SIZE];
-        readBufferWithoutCompress = new byte[PCM_FRAME_SIZE];
+        readBuffer = new byte[FRAMES_PER_CHUNK * AMR_MAX_FRAME_SIZE];
+        pcmBuffer = new short[FRAMES_PER_CHUNK * PCM_FRAME_SIZE];
 
         mInputStream = inputStream;
 
@@ -81,16 +83,28 @@ public class AmrFileDecoder implements Runnable {
 
     @Override
     public void run() {
+        int[] consumed = new int[1];
+        int pending = 0;
         try {
-            while (isRunning && mInputStream.read(readBuffer) != -1) {
-                // amr frame 32 bytes
-                byte[] amrFrame = readBuffer.clone();
-                // pcm frame 160 shorts
-                short[] pcmFrame = new short[PCM_FRAME_SIZE];
-                AmrDecoder.decode(mDecoderState, amrFrame, pcmFrame);
+            int read;
+            while (isRunning && (read = mInputStream.read(readBuffer, pending,
+                    readBuffer.length - pending)) != -1) {
+                pending += read;
+
+                // decode every complete frame in the buffer, whatever its size
+                int produced = AmrDecoder.decodeStream(mDecoderState, readBuffer, 0, pending,
+                        pcmBuffer, consumed);
+                if (produced < 0) {
+                    // bad offset/length: nothing was decoded, so stop here
+                    break;
+                }
+
+                // keep the trailing partial frame for the next read
+                pending -= consumed[0];
+                System.arraycopy(readBuffer, consumed[0], readBuffer, 0, pending);
 
                 // 播放
-                mAudioTrack.write(pcmFrame, 0, pcmFrame.length);
+                mAudioTrack.write(pcmBuffer, 0, produced);
             }
         } catch (IOException e) {
             e.printStackTrace();
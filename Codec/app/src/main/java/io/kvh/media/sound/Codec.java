@@ -19,6 +19,7 @@ public class Codec implements Runnable, Supporter.PcmConsumer, Supporter.OnOffSw
     private boolean isRunning;
 
     private Supporter.AmrConsumer amrConsumer;
+    private long encoderState;
     private Thread runningThread;
     final private Object waitingObject;
 
@@ -63,7 +64,7 @@ public class Codec implements Runnable, Supporter.PcmConsumer, Supporter.OnOffSw
             Log.i(TAG, "start succeed");
         isRunning = true;
 
-        AmrEncoder.init(0);
+        encoderState = AmrEncoder.init(0);
 
         //start
         runningThread = new Thread(this);
@@ -87,7 +88,7 @@ public class Codec implements Runnable, Supporter.PcmConsumer, Supporter.OnOffSw
             short[] buffer = pcmFrames.remove(0);
             byte[] encodedData = new byte[buffer.length];
             //using AmrEncoder.Mode.MR122 to encode, generated frame size would be 32
-            int encodedLength = AmrEncoder.encode(AmrEncoder.Mode.MR122.ordinal(), buffer, encodedData);
+            int encodedLength = AmrEncoder.encode(encoderState, AmrEncoder.Mode.MR122.ordinal(), buffer, encodedData);
 
             if (DEBUG)
                 Log.i(TAG, "clean up encode: length" + encodedLength);
@@ -112,7 +113,7 @@ public class Codec implements Runnable, Supporter.PcmConsumer, Supporter.OnOffSw
                 } else {
                     short[] buffer = pcmFrames.remove(0);
                     byte[] encodedData = new byte[buffer.length];
-                    int encodedLength = AmrEncoder.encode(AmrEncoder.Mode.MR122.ordinal(), buffer, encodedData);
+                    int encodedLength = AmrEncoder.encode(encoderState, AmrEncoder.Mode.MR122.ordinal(), buffer, encodedData);
                     //Log.i(TAG, "encode: length" + encodedLength);
                     if (encodedLength > 0) {
                         amrConsumer.onAmrFeed(encodedData, encodedLength);
@@ -122,6 +123,6 @@ public class Codec implements Runnable, Supporter.PcmConsumer, Supporter.OnOffSw
         }
 
 
-        AmrEncoder.exit();
+        AmrEncoder.exit(encoderState);
     }
 }